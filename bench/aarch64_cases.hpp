@@ -0,0 +1,54 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_BENCH_AARCH64_CASES_HPP_
+#define CPU_IO_BENCH_AARCH64_CASES_HPP_
+
+#include <cstdint>
+
+#include "bench.hpp"
+
+namespace cpu_io::bench::detail {
+
+/**
+ * @brief 用户态可运行的用例
+ * @param options 运行选项
+ * @note ReadCycles() 读取的是系统计数器 (CNTVCT_EL0)，频率远低于核心时钟，
+ * 未校准时结果以系统计数器的计数为单位
+ */
+static void RunArchCases(const Options &options) {
+  Run(options, "CNTVCT_EL0::Read", [] { CNTVCT_EL0::Read(); });
+  Run(options, "isb", [] { __asm__ volatile("isb" ::: "memory"); });
+}
+
+/**
+ * @brief 需要内核态的用例，写入的都是寄存器的原值
+ * @param options 运行选项
+ */
+static void RunPrivilegedArchCases(const Options &options) {
+  Run(options, "SCTLR_EL1::Read", [] { SCTLR_EL1::Read(); });
+  Run(options, "MPIDR_EL1::Read", [] { MPIDR_EL1::Read(); });
+  auto tpidr = TPIDR_EL1::Read();
+  Run(options, "TPIDR_EL1::Write", [tpidr] { TPIDR_EL1::Write(tpidr); });
+  using SctlrInfo = ::cpu_io::detail::register_info::system_reg::SCTLR_EL1Info;
+  auto cache_enabled = SCTLR_EL1::Read() & SctlrInfo::C::kBitMask;
+  Run(options, "SCTLR_EL1::SetBits",
+      [cache_enabled] { SCTLR_EL1::SetBits(cache_enabled); });
+  auto c = SCTLR_EL1::C::Get();
+  Run(options, "SCTLR_EL1::C::Write", [c] { SCTLR_EL1::C::Write(c); });
+
+  auto addr = reinterpret_cast<uint64_t>(samples.data());
+  Run(options, "FlushTLBAddress",
+      [addr] { virtual_memory::FlushTLBAddress(addr); });
+  Run(options, "FlushTLBRange(16 pages)", [addr] {
+    virtual_memory::FlushTLBRange(addr, addr + 16 * 4096);
+  });
+  Run(options, "FlushTLBAllLocal",
+      [] { virtual_memory::FlushTLBAllLocal(); });
+  Run(options, "FlushTLBAll", [] { virtual_memory::FlushTLBAll(); });
+}
+
+}  // namespace cpu_io::bench::detail
+
+#endif /* CPU_IO_BENCH_AARCH64_CASES_HPP_ */
@@ -0,0 +1,216 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_BENCH_BENCH_HPP_
+#define CPU_IO_BENCH_BENCH_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "cpu_io.h"
+
+/**
+ * 寄存器访问微基准
+ * 每个用例连续执行 kBatch 次为一个样本，共 kSamples 个样本，
+ * 扣除空批次的开销后报告单次操作耗时的分位数。
+ * 用户态 (Linux、QEMU user) 只运行不需要特权的用例；
+ * 内核在启动后调用 RunAll() 并设置 Options::privileged 运行全部用例
+ */
+namespace cpu_io::bench {
+
+/// 输出函数，与 printf 相同
+using Printer = int (*)(const char *format, ...);
+
+/**
+ * @brief 运行选项
+ */
+struct Options {
+  /// 输出函数
+  Printer print = nullptr;
+  /// 运行需要内核态的用例 (控制寄存器、MSR、TLB 刷新)，运行时关闭中断
+  bool privileged = false;
+  /// 发送一个 IPI，为空时跳过 IPI 往返用例；
+  /// 目标核心的中断处理程序需调用 AckIpi()
+  void (*send_ipi)() = nullptr;
+};
+
+/**
+ * @brief 单个用例的结果，单位为 1/kScale 个计数或纳秒
+ */
+struct Result {
+  const char *name;
+  uint64_t min;
+  uint64_t p50;
+  uint64_t p90;
+  uint64_t p99;
+  uint64_t max;
+};
+
+/// 样本数
+static constexpr size_t kSamples = 512;
+/// 每个样本连续执行的次数，用于分摊读取计数器的开销与计数器精度
+static constexpr size_t kBatch = 32;
+/// 结果的定点倍数，保留两位小数
+static constexpr uint64_t kScale = 100;
+/// 等待 IPI 应答的最大轮询次数
+static constexpr uint64_t kIpiSpinLimit = 1ULL << 24;
+
+namespace detail {
+/// IPI 应答计数
+inline uint64_t ipi_ack = 0;
+/// 空批次的计数，从每个样本中扣除
+inline uint64_t batch_overhead = 0;
+/// 样本缓冲区，不放在栈上以适应内核的小栈
+inline std::array<uint64_t, kSamples> samples{};
+
+/**
+ * @brief 连续执行 kBatch 次 fn
+ * @return uint64_t 消耗的计数
+ */
+template <class Fn>
+static __always_inline auto SampleBatch(Fn &fn) -> uint64_t {
+  auto start = ReadCyclesSerialized();
+  for (size_t i = 0; i < kBatch; i++) {
+    fn();
+  }
+  return ReadCyclesSerialized() - start;
+}
+
+/**
+ * @brief 测量空批次的开销，取最小值
+ */
+static void MeasureOverhead() {
+  auto empty = [] {};
+  batch_overhead = ~0ULL;
+  for (size_t i = 0; i < kSamples; i++) {
+    batch_overhead = std::min(batch_overhead, SampleBatch(empty));
+  }
+}
+
+/**
+ * @brief 输出一个定点数
+ * @param print 输出函数
+ * @param value 值，单位为 1/kScale
+ */
+static void PrintFixed(Printer print, uint64_t value) {
+  print(" %8lu.%02lu", static_cast<unsigned long>(value / kScale),
+        static_cast<unsigned long>(value % kScale));
+}
+}  // namespace detail
+
+/**
+ * @brief IPI 处理程序中调用，应答 IPI 往返用例
+ */
+static __always_inline void AckIpi() {
+  __atomic_fetch_add(&detail::ipi_ack, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 测量 fn 的单次耗时
+ * @param name 用例名
+ * @param fn 被测操作
+ * @return Result 以计数为单位的分位数
+ */
+template <class Fn>
+static auto Measure(const char *name, Fn fn) -> Result {
+  auto &samples = detail::samples;
+  // 预热缓存与分支预测
+  detail::SampleBatch(fn);
+  for (auto &sample : samples) {
+    auto ticks = detail::SampleBatch(fn);
+    ticks = (ticks > detail::batch_overhead) ? ticks - detail::batch_overhead
+                                             : 0;
+    sample = ticks * kScale / kBatch;
+  }
+  std::sort(samples.begin(), samples.end());
+  auto at = [&samples](size_t percent) {
+    return samples[(kSamples - 1) * percent / 100];
+  };
+  return {name, samples.front(), at(50), at(90), at(99), samples.back()};
+}
+
+/**
+ * @brief 输出结果，已校准时间戳频率时换算为纳秒
+ * @param options 运行选项
+ * @param result 结果
+ */
+static void Report(const Options &options, const Result &result) {
+  auto convert = [](uint64_t value) {
+    return (GetTimestampFrequency() != 0) ? CyclesToNs(value) : value;
+  };
+  options.print("%-28s", result.name);
+  detail::PrintFixed(options.print, convert(result.min));
+  detail::PrintFixed(options.print, convert(result.p50));
+  detail::PrintFixed(options.print, convert(result.p90));
+  detail::PrintFixed(options.print, convert(result.p99));
+  detail::PrintFixed(options.print, convert(result.max));
+  options.print("\n");
+}
+
+/**
+ * @brief 测量并输出
+ * @param options 运行选项
+ * @param name 用例名
+ * @param fn 被测操作
+ */
+template <class Fn>
+static void Run(const Options &options, const char *name, Fn fn) {
+  Report(options, Measure(name, fn));
+}
+
+}  // namespace cpu_io::bench
+
+#ifdef __x86_64__
+#include "x86_64_cases.hpp"
+#elif __riscv
+#include "riscv64_cases.hpp"
+#elif __aarch64__
+#include "aarch64_cases.hpp"
+#endif
+
+namespace cpu_io::bench {
+
+/**
+ * @brief 运行全部用例
+ * @param options 运行选项
+ * @pre 特权用例需在内核态且页表已启用时运行
+ */
+static void RunAll(const Options &options) {
+  detail::MeasureOverhead();
+  options.print("%-28s %11s %11s %11s %11s %11s  (%s/op)\n", "case", "min",
+                "p50", "p90", "p99", "max",
+                (GetTimestampFrequency() != 0) ? "ns" : "ticks");
+
+  Run(options, "ReadCycles", [] { ReadCycles(); });
+  Run(options, "ReadCyclesSerialized", [] { ReadCyclesSerialized(); });
+  Run(options, "Mb", [] { Mb(); });
+  Run(options, "Rmb", [] { Rmb(); });
+  Run(options, "Wmb", [] { Wmb(); });
+
+  detail::RunArchCases(options);
+  if (options.privileged) {
+    // 中断会混入样本，且部分用例临时修改了中断处理程序可能使用的寄存器
+    IrqGuard guard;
+    detail::RunPrivilegedArchCases(options);
+  }
+
+  if (options.send_ipi != nullptr) {
+    Run(options, "IpiRoundTrip", [&options] {
+      auto seen = __atomic_load_n(&detail::ipi_ack, __ATOMIC_ACQUIRE);
+      options.send_ipi();
+      for (uint64_t i = 0; i < kIpiSpinLimit; i++) {
+        if (__atomic_load_n(&detail::ipi_ack, __ATOMIC_ACQUIRE) != seen) {
+          break;
+        }
+        Pause();
+      }
+    });
+  }
+}
+
+}  // namespace cpu_io::bench
+
+#endif /* CPU_IO_BENCH_BENCH_HPP_ */
@@ -0,0 +1,24 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "bench.hpp"
+
+/**
+ * @brief 用户态入口，只运行不需要特权的用例
+ * 用法: cpu_io_bench [计数器频率 (Hz)]
+ * 给出频率时结果换算为纳秒，否则以计数为单位；
+ * 内核中应直接调用 cpu_io::bench::RunAll()
+ */
+auto main(int argc, char **argv) -> int {
+  if (argc > 1) {
+    cpu_io::SetTimestampFrequency(std::strtoull(argv[1], nullptr, 0));
+  }
+  cpu_io::bench::Options options;
+  options.print = std::printf;
+  cpu_io::bench::RunAll(options);
+  return 0;
+}
@@ -0,0 +1,50 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_BENCH_RISCV64_CASES_HPP_
+#define CPU_IO_BENCH_RISCV64_CASES_HPP_
+
+#include <cstdint>
+
+#include "bench.hpp"
+
+namespace cpu_io::bench::detail {
+
+/**
+ * @brief 用户态可运行的用例
+ * @param options 运行选项
+ * @note ReadCycles() 读取的是 time CSR，频率 (timebase-frequency)
+ * 通常远低于核心时钟，未校准时结果以 time 的计数为单位
+ */
+static void RunArchCases(const Options &options) {
+  Run(options, "Time::Read", [] { Time::Read(); });
+  Run(options, "fence.i", [] { __asm__ volatile("fence.i" ::: "memory"); });
+}
+
+/**
+ * @brief 需要内核态的用例，写入的都是寄存器的原值
+ * @param options 运行选项
+ */
+static void RunPrivilegedArchCases(const Options &options) {
+  Run(options, "Sstatus::Read", [] { Sstatus::Read(); });
+  auto scratch = Sscratch::Read();
+  Run(options, "Sscratch::Write", [scratch] { Sscratch::Write(scratch); });
+  auto fs = Sstatus::Read() & SstatusInfo::Fs::kBitMask;
+  Run(options, "Sstatus::SetBits", [fs] { Sstatus::SetBits(fs); });
+  auto spie = Sstatus::Spie::Get();
+  Run(options, "Sstatus::Spie::Write",
+      [spie] { Sstatus::Spie::Write(spie); });
+
+  auto addr = reinterpret_cast<uint64_t>(samples.data());
+  Run(options, "FlushTLBAddress",
+      [addr] { virtual_memory::FlushTLBAddress(addr); });
+  Run(options, "FlushTLBRange(16 pages)", [addr] {
+    virtual_memory::FlushTLBRange(addr, addr + 16 * 4096);
+  });
+  Run(options, "FlushTLBAll", [] { virtual_memory::FlushTLBAll(); });
+}
+
+}  // namespace cpu_io::bench::detail
+
+#endif /* CPU_IO_BENCH_RISCV64_CASES_HPP_ */
@@ -0,0 +1,64 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_BENCH_X86_64_CASES_HPP_
+#define CPU_IO_BENCH_X86_64_CASES_HPP_
+
+#include <cstdint>
+
+#include "bench.hpp"
+
+namespace cpu_io::bench::detail {
+
+/**
+ * @brief 用户态可运行的用例
+ * @param options 运行选项
+ */
+static void RunArchCases(const Options &options) {
+  Run(options, "rdtscp", [] {
+    uint32_t aux;
+    ReadCyclesAux(aux);
+  });
+  Run(options, "cpuid", [] { cpuid::detail::ExecuteCpuid(0); });
+  Run(options, "Rflags::Read", [] { Rflags::Read(); });
+  // pushfq; popfq，用户态下 IF 的修改被忽略
+  Run(options, "Rflags::Df::Write", [] { Rflags::Df::Write(false); });
+  // cld
+  Run(options, "Rflags::Df::Clear", [] { Rflags::Df::Clear(); });
+}
+
+/**
+ * @brief 需要内核态的用例，写入的都是寄存器的原值
+ * @param options 运行选项
+ */
+static void RunPrivilegedArchCases(const Options &options) {
+  Run(options, "Cr0::Read", [] { Cr0::Read(); });
+  Run(options, "Cr4::Read", [] { Cr4::Read(); });
+  auto tpr = Cr8::Read();
+  Run(options, "Cr8::Write", [tpr] { Cr8::Write(tpr); });
+  // 长模式下 PE 总为 1
+  Run(options, "Cr0::SetBits",
+      [] { Cr0::SetBits(Cr0Info::Pe::kBitOffset); });
+  Run(options, "Cr0::Pe::Write", [] { Cr0::Pe::Write(true); });
+
+  Run(options, "rdmsr", [] { Msr::Read(msr::kIa32KernelGsBase); });
+  auto kernel_gs_base = Msr::Read(msr::kIa32KernelGsBase);
+  Run(options, "wrmsr", [kernel_gs_base] {
+    Msr::Write(msr::kIa32KernelGsBase, kernel_gs_base);
+  });
+  CachedMsr<msr::kIa32KernelGsBase> cached;
+  Run(options, "CachedMsr::Read", [&cached] { cached.Read(); });
+
+  auto addr = reinterpret_cast<uint64_t>(samples.data());
+  Run(options, "FlushTLBAddress",
+      [addr] { virtual_memory::FlushTLBAddress(addr); });
+  Run(options, "FlushTLBRange(16 pages)", [addr] {
+    virtual_memory::FlushTLBRange(addr, addr + 16 * 4096);
+  });
+  Run(options, "FlushTLBAll", [] { virtual_memory::FlushTLBAll(); });
+}
+
+}  // namespace cpu_io::bench::detail
+
+#endif /* CPU_IO_BENCH_X86_64_CASES_HPP_ */
@@ -0,0 +1,147 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_AARCH64_CACHE_HPP_
+#define CPU_IO_INCLUDE_AARCH64_CACHE_HPP_
+
+#include <sys/cdefs.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../cache_line.hpp"
+#include "regs.hpp"
+
+namespace cpu_io {
+
+namespace detail::cache {
+using CTR_EL0 = cpu_io::detail::regs::system_reg::CTR_EL0;
+
+/**
+ * @brief 由 CTR_EL0 的行大小字段计算字节数
+ * @param log2_words 行大小，log2(字数)
+ * @return size_t 行大小 (字节)
+ */
+static constexpr auto LineSize(uint8_t log2_words) -> size_t {
+  return static_cast<size_t>(4) << log2_words;
+}
+}  // namespace detail::cache
+
+/**
+ * @brief 将范围内的脏数据写回到一致性点 (PoC)，缓存行保持有效
+ * 用于设备读取 CPU 写入的数据 (非一致性 DMA)
+ * @param addr 起始地址，不需要对齐
+ * @param size 字节数
+ */
+static __always_inline void CleanDcacheRange(const void *addr, size_t size) {
+  auto line_size =
+      detail::cache::LineSize(detail::cache::CTR_EL0::DminLine::Get());
+  detail::ForEachCacheLine(addr, size, line_size, [](uintptr_t line) {
+    __asm__ volatile("dc cvac, %0" ::"r"(line) : "memory");
+  });
+  __asm__ volatile("dsb sy" ::: "memory");
+}
+
+/**
+ * @brief 失效范围内的缓存行，用于 CPU 读取设备写入的数据
+ * 首尾不完整的缓存行与范围外的数据共享，改为写回并失效，避免丢失其修改
+ * @param addr 起始地址，不需要对齐
+ * @param size 字节数
+ */
+static __always_inline void InvalidateDcacheRange(const void *addr,
+                                                  size_t size) {
+  auto line_size =
+      detail::cache::LineSize(detail::cache::CTR_EL0::DminLine::Get());
+  auto start = reinterpret_cast<uintptr_t>(addr);
+  auto end = start + size;
+  auto mask = line_size - 1;
+  detail::ForEachCacheLine(addr, size, line_size, [=](uintptr_t line) {
+    if (line < start || line + mask >= end) {
+      __asm__ volatile("dc civac, %0" ::"r"(line) : "memory");
+    } else {
+      __asm__ volatile("dc ivac, %0" ::"r"(line) : "memory");
+    }
+  });
+  __asm__ volatile("dsb sy" ::: "memory");
+}
+
+/**
+ * @brief 写回并失效范围内的缓存行
+ * @param addr 起始地址，不需要对齐
+ * @param size 字节数
+ */
+static __always_inline void CleanInvalidateDcacheRange(const void *addr,
+                                                       size_t size) {
+  auto line_size =
+      detail::cache::LineSize(detail::cache::CTR_EL0::DminLine::Get());
+  detail::ForEachCacheLine(addr, size, line_size, [](uintptr_t line) {
+    __asm__ volatile("dc civac, %0" ::"r"(line) : "memory");
+  });
+  __asm__ volatile("dsb sy" ::: "memory");
+}
+
+/**
+ * @brief 使写入的指令对取指可见，用于 JIT 与加载模块
+ * 将数据写回到统一点 (PoU) 后失效指令缓存，CTR_EL0.IDC/DIC 置位时跳过对应步骤
+ * @param addr 起始地址，不需要对齐
+ * @param size 字节数
+ * @note 指令缓存的失效广播到内部共享域，
+ * 其它核心在执行新指令前仍需各自执行 isb
+ */
+static __always_inline void SyncIcacheRange(const void *addr, size_t size) {
+  auto ctr = detail::cache::CTR_EL0::Read();
+  if (!detail::cache::CTR_EL0::IDC::Get(ctr)) {
+    auto line_size =
+        detail::cache::LineSize(detail::cache::CTR_EL0::DminLine::Get(ctr));
+    detail::ForEachCacheLine(addr, size, line_size, [](uintptr_t line) {
+      __asm__ volatile("dc cvau, %0" ::"r"(line) : "memory");
+    });
+  }
+  __asm__ volatile("dsb ish" ::: "memory");
+  if (!detail::cache::CTR_EL0::DIC::Get(ctr)) {
+    auto line_size =
+        detail::cache::LineSize(detail::cache::CTR_EL0::IminLine::Get(ctr));
+    detail::ForEachCacheLine(addr, size, line_size, [](uintptr_t line) {
+      __asm__ volatile("ic ivau, %0" ::"r"(line) : "memory");
+    });
+    __asm__ volatile("dsb ish" ::: "memory");
+  }
+  __asm__ volatile("isb" ::: "memory");
+}
+
+/**
+ * @brief 预取缓存行
+ * @tparam kAccess 访问类型
+ * @tparam kLocality 时间局部性，3/2/1 分别预取到 L1/L2/L3，0 为流式访问
+ * @param addr 地址
+ */
+template <PrefetchAccess kAccess = PrefetchAccess::kRead, int kLocality = 3>
+static __always_inline void Prefetch(const void *addr) {
+  static_assert(kLocality >= 0 && kLocality <= 3);
+  if constexpr (kAccess == PrefetchAccess::kWrite) {
+    if constexpr (kLocality == 3) {
+      __asm__ volatile("prfm pstl1keep, [%0]" ::"r"(addr));
+    } else if constexpr (kLocality == 2) {
+      __asm__ volatile("prfm pstl2keep, [%0]" ::"r"(addr));
+    } else if constexpr (kLocality == 1) {
+      __asm__ volatile("prfm pstl3keep, [%0]" ::"r"(addr));
+    } else {
+      __asm__ volatile("prfm pstl1strm, [%0]" ::"r"(addr));
+    }
+  } else {
+    if constexpr (kLocality == 3) {
+      __asm__ volatile("prfm pldl1keep, [%0]" ::"r"(addr));
+    } else if constexpr (kLocality == 2) {
+      __asm__ volatile("prfm pldl2keep, [%0]" ::"r"(addr));
+    } else if constexpr (kLocality == 1) {
+      __asm__ volatile("prfm pldl3keep, [%0]" ::"r"(addr));
+    } else {
+      __asm__ volatile("prfm pldl1strm, [%0]" ::"r"(addr));
+    }
+  }
+}
+
+}  // namespace cpu_io
+
+#endif  // CPU_IO_INCLUDE_AARCH64_CACHE_HPP_
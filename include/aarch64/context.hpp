@@ -189,6 +189,54 @@ struct CalleeSavedContext {
   __always_inline uint64_t& StackPointer() { return sp; }
 };
 
+/**
+ * @brief IRQ 快速路径的寄存器帧
+ * 只保存调用者保存的通用寄存器 (x0-x18)、x29/x30 与异常返回状态，
+ * x19-x28 由中断处理函数按 AAPCS64 自行保存；
+ * 不保存 SIMD/浮点状态，其所有权仍由 LazyFpu 管理
+ *
+ * 21 (x0-x18, x29, x30) + 2 (系统寄存器) + 1 (中断号)
+ *   = 24 个 uint64_t = 192 字节 (16 字节对齐)
+ *
+ * 用于从 EL1 进入的 IRQ，同步异常与来自 EL0 的中断仍使用 TrapContext
+ */
+struct IrqFrame {
+  // x0-x7: 参数/结果寄存器
+  uint64_t x0;
+  uint64_t x1;
+  uint64_t x2;
+  uint64_t x3;
+  uint64_t x4;
+  uint64_t x5;
+  uint64_t x6;
+  uint64_t x7;
+  // x8-x15: 间接结果位置寄存器 + 临时寄存器
+  uint64_t x8;
+  uint64_t x9;
+  uint64_t x10;
+  uint64_t x11;
+  uint64_t x12;
+  uint64_t x13;
+  uint64_t x14;
+  uint64_t x15;
+  // x16-x17: 过程内调用临时寄存器
+  uint64_t x16;
+  uint64_t x17;
+  // x18: 平台寄存器
+  uint64_t x18;
+  // 帧指针
+  uint64_t x29;
+  // 返回地址
+  uint64_t x30;
+
+  // 异常返回地址
+  uint64_t elr_el1;
+  // 保存的处理器状态寄存器
+  uint64_t spsr_el1;
+  // 当前处理的中断号 (ICC_IAR1_EL1.INTID)
+  uint64_t intid;
+};
+
 // 编译时验证结构体大小
 #ifdef CPU_IO_ENABLE_FPU
 static_assert(sizeof(TrapContext) == 896, "TrapContext size must be 896 bytes");
@@ -199,6 +247,7 @@ static_assert(sizeof(TrapContext) == 320, "TrapContext size must be 320 bytes");
 static_assert(sizeof(CalleeSavedContext) == 112,
               "CalleeSavedContext size must be 112 bytes");
 #endif
+static_assert(sizeof(IrqFrame) == 192, "IrqFrame size must be 192 bytes");
 
 }  // namespace cpu_io
 
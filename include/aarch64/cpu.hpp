@@ -5,14 +5,23 @@
 #ifndef CPU_IO_INCLUDE_AARCH64_CPU_HPP_
 #define CPU_IO_INCLUDE_AARCH64_CPU_HPP_
 
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <span>
 #include <type_traits>
 #include <typeinfo>
 
+#include "../clock.hpp"
+#include "../cpu_mask.hpp"
+#include "../per_cpu.hpp"
+#include "cache.hpp"
 #include "context.hpp"
+#include "fpu.hpp"
+#include "gic.hpp"
 #include "psci.hpp"
 #include "regs.hpp"
+#include "trap_entry.hpp"
 #include "virtual_memory.hpp"
 
 /**
@@ -42,14 +51,36 @@ using ESR_EL1 = detail::regs::system_reg::ESR_EL1;
 using FAR_EL1 = detail::regs::system_reg::FAR_EL1;
 using CNTV_CTL_EL0 = detail::regs::system_reg::CNTV_CTL_EL0;
 using CNTV_TVAL_EL0 = detail::regs::system_reg::CNTV_TVAL_EL0;
+using CNTV_CVAL_EL0 = detail::regs::system_reg::CNTV_CVAL_EL0;
 using CNTVCT_EL0 = detail::regs::system_reg::CNTVCT_EL0;
 using CNTFRQ_EL0 = detail::regs::system_reg::CNTFRQ_EL0;
+using CNTKCTL_EL1 = detail::regs::system_reg::CNTKCTL_EL1;
 using ICC_PMR_EL1 = detail::regs::system_reg::ICC_PMR_EL1;
 using ICC_IGRPEN1_EL1 = detail::regs::system_reg::ICC_IGRPEN1_EL1;
 using ICC_SRE_EL1 = detail::regs::system_reg::ICC_SRE_EL1;
 using ICC_IAR1_EL1 = detail::regs::system_reg::ICC_IAR1_EL1;
 using ICC_EOIR1_EL1 = detail::regs::system_reg::ICC_EOIR1_EL1;
 using ICC_SGI1R_EL1 = detail::regs::system_reg::ICC_SGI1R_EL1;
+using ID_AA64ISAR0_EL1 = detail::regs::system_reg::ID_AA64ISAR0_EL1;
+using ID_AA64MMFR0_EL1 = detail::regs::system_reg::ID_AA64MMFR0_EL1;
+using ID_AA64PFR0_EL1 = detail::regs::system_reg::ID_AA64PFR0_EL1;
+using CTR_EL0 = detail::regs::system_reg::CTR_EL0;
+using PMCR_EL0 = detail::regs::system_reg::PMCR_EL0;
+using PMCNTENSET_EL0 = detail::regs::system_reg::PMCNTENSET_EL0;
+using PMCNTENCLR_EL0 = detail::regs::system_reg::PMCNTENCLR_EL0;
+using PMOVSCLR_EL0 = detail::regs::system_reg::PMOVSCLR_EL0;
+using PMINTENSET_EL1 = detail::regs::system_reg::PMINTENSET_EL1;
+using PMINTENCLR_EL1 = detail::regs::system_reg::PMINTENCLR_EL1;
+using PMSELR_EL0 = detail::regs::system_reg::PMSELR_EL0;
+using PMXEVTYPER_EL0 = detail::regs::system_reg::PMXEVTYPER_EL0;
+using PMXEVCNTR_EL0 = detail::regs::system_reg::PMXEVCNTR_EL0;
+using PMCCNTR_EL0 = detail::regs::system_reg::PMCCNTR_EL0;
+using PMCCFILTR_EL0 = detail::regs::system_reg::PMCCFILTR_EL0;
+using PMUSERENR_EL0 = detail::regs::system_reg::PMUSERENR_EL0;
+using TPIDR_EL1 = detail::regs::system_reg::TPIDR_EL1;
+
+template <class Reg>
+using CachedReg = detail::read_write::CachedReg<Reg>;
 
 /**
  * @brief 内存屏障
@@ -72,6 +103,20 @@ static __always_inline auto Wmb() -> void {
   __asm__ volatile("dmb ishst" ::: "memory");
 }
 
+/**
+ * @brief 设备读屏障，在设备读之后调用，保证其先于之后的访存
+ */
+static __always_inline auto IoRmb() -> void {
+  __asm__ volatile("dmb oshld" ::: "memory");
+}
+
+/**
+ * @brief 设备写屏障，在设备写之前调用，保证之前的写先于设备写
+ */
+static __always_inline auto IoWmb() -> void {
+  __asm__ volatile("dmb oshst" ::: "memory");
+}
+
 /**
  * @brief 允许中断
  * @todo
@@ -93,12 +138,78 @@ static __always_inline auto GetInterruptStatus() -> bool {
   return !DAIF::I::Get() && !DAIF::F::Get();
 }
 
+/**
+ * @brief 保存中断状态并屏蔽 IRQ/FIQ
+ * mrs daif 后 msr daifset，不修改 D/A
+ * @return uint64_t 屏蔽前的 DAIF，交给 IrqRestore()
+ */
+static __always_inline auto IrqSave() -> uint64_t {
+  uint64_t flags;
+  __asm__ volatile("mrs %0, daif\n\tmsr daifset, #3"
+                   : "=r"(flags)
+                   :
+                   : "memory");
+  return flags;
+}
+
+/**
+ * @brief 恢复 IrqSave() 保存的中断状态
+ * @param flags IrqSave() 的返回值
+ */
+static __always_inline void IrqRestore(uint64_t flags) {
+  __asm__ volatile("msr daif, %0" : : "r"(flags) : "memory");
+}
+
+namespace detail {
+/// MPIDR 中 CPU_ON 使用的亲和性字段 Aff3 与 Aff2~0
+static constexpr uint64_t kMpidrAffinityMask = 0xFF00FFFFFFULL;
+}  // namespace detail
+
 /**
  * @brief 获取当前 core id
- * @return size_t core id
+ * 取 MPIDR_EL1 的 Aff3~Aff0，多集群与多线程核心上各核心互不相同，
+ * 格式与 StartSecondaryCores() 的 hw_ids 和 PSCI CPU_ON 的目标相同
+ * @return size_t MPIDR_EL1 & 0xFF00FFFFFF，不保证连续，
+ * 作为数组下标时使用 SetPerCpuBase() 之后的 GetPerCpuCoreId()
  */
 static __always_inline auto GetCurrentCoreId() -> size_t {
-  return MPIDR_EL1::Aff0::Get();
+  return MPIDR_EL1::Read() & detail::kMpidrAffinityMask;
+}
+
+/**
+ * @brief 设置当前核心的每核心数据区，写入 TPIDR_EL1
+ * @param header 每核心数据区，core_id 需已填写
+ */
+static __always_inline void SetPerCpuBase(PerCpuHeader *header) {
+  header->self = header;
+  TPIDR_EL1::Write(reinterpret_cast<uint64_t>(header));
+}
+
+/**
+ * @brief 获取当前核心的每核心数据区
+ * @return PerCpuHeader* 每核心数据区，一次 TPIDR_EL1 读
+ */
+static __always_inline auto GetPerCpuBase() -> PerCpuHeader * {
+  return reinterpret_cast<PerCpuHeader *>(TPIDR_EL1::Read());
+}
+
+/**
+ * @brief 从每核心数据区获取逻辑核心 ID
+ * @return size_t core id，与 MPIDR_EL1 的集群布局无关
+ */
+static __always_inline auto GetPerCpuCoreId() -> size_t {
+  return GetPerCpuBase()->core_id;
+}
+
+/**
+ * @brief 获取当前核心的每核心数据
+ * @tparam T 每核心数据类型，第一个成员须为 PerCpuHeader
+ * @return T& 每核心数据
+ */
+template <class T>
+static __always_inline auto PerCpu() -> T & {
+  static_assert(std::is_standard_layout_v<T>);
+  return *reinterpret_cast<T *>(GetPerCpuBase());
 }
 
 /**
@@ -112,6 +223,442 @@ static __always_inline void SetupFpu() { CPACR_EL1::Fpen::Set(); }
  */
 static __always_inline void Pause() { __asm__ volatile("yield" ::: "memory"); }
 
+/**
+ * @brief 自旋等待，直到 *addr 满足条件
+ * ldaxr 读取并设置独占监视器后 wfe 休眠，
+ * 其它核心写该缓存行时清除监视器并唤醒，写方不需要 sev
+ * @tparam T 4 或 8 字节的整数或指针类型
+ * @param addr 等待的地址
+ * @param done 条件，参数为读到的值
+ * @return T 满足条件时读到的值，读带 acquire 语义
+ */
+template <class T, class Pred>
+static __always_inline auto SpinUntil(const T *addr, Pred done) -> T {
+  static_assert(sizeof(T) == 4 || sizeof(T) == 8);
+  T value = __atomic_load_n(addr, __ATOMIC_ACQUIRE);
+  while (!done(value)) {
+    if constexpr (sizeof(T) == 4) {
+      __asm__ volatile("ldaxr %w0, [%1]" : "=&r"(value) : "r"(addr) : "memory");
+    } else {
+      __asm__ volatile("ldaxr %0, [%1]" : "=&r"(value) : "r"(addr) : "memory");
+    }
+    if (done(value)) {
+      break;
+    }
+    __asm__ volatile("wfe" ::: "memory");
+  }
+  return value;
+}
+
+/**
+ * @brief 读取虚拟计数器 CNTVCT_EL0，不等待之前的指令完成
+ * @return uint64_t 计数值
+ */
+static __always_inline auto ReadCycles() -> uint64_t {
+  return CNTVCT_EL0::Read();
+}
+
+/**
+ * @brief 读取虚拟计数器 CNTVCT_EL0，之前的指令全部完成后才读取
+ * @return uint64_t 计数值
+ * @note isb; mrs cntvct_el0
+ */
+static __always_inline auto ReadCyclesSerialized() -> uint64_t {
+  uint64_t value;
+  __asm__ volatile("isb\n\tmrs %0, CNTVCT_EL0" : "=r"(value) : : "memory");
+  return value;
+}
+
+/**
+ * @brief 读取纳秒时间戳，不等待之前的指令完成
+ * @return uint64_t 纳秒，CalibrateTimestamp() 之前为 0
+ */
+static __always_inline auto ReadTimestamp() -> uint64_t {
+  return CyclesToNs(ReadCycles());
+}
+
+/**
+ * @brief 读取纳秒时间戳，之前的指令全部完成后才读取
+ * @return uint64_t 纳秒，CalibrateTimestamp() 之前为 0
+ */
+static __always_inline auto ReadTimestampSerialized() -> uint64_t {
+  return CyclesToNs(ReadCyclesSerialized());
+}
+
+/**
+ * @brief 启用虚拟计数器事件流
+ * 周期性地产生事件唤醒 wfe，使 WaitOnAddress() 的超时得以检查，
+ * 需在每个核心上调用一次
+ * @param period_us 事件间隔 (微秒)，取不大于该值的 2 的幂次计数
+ */
+static __always_inline void EnableEventStream(uint64_t period_us = 100) {
+  auto ticks = CNTFRQ_EL0::Read() * period_us / 1000000;
+  // 选中的位每 2^(n+1) 个计数由 0 变 1 一次
+  uint8_t bit = 0;
+  while (bit < 15 && (2ULL << (bit + 1)) <= ticks) {
+    bit++;
+  }
+  CNTKCTL_EL1::Modify(CNTKCTL_EL1::Evnti::Value(bit),
+                      CNTKCTL_EL1::Evntdir::Value(false),
+                      CNTKCTL_EL1::Evnten::Value(true));
+  __asm__ volatile("isb" ::: "memory");
+}
+
+/**
+ * @brief 等待 *addr 不再等于 expected
+ * ldaxr 设置独占监视器后 wfe，写该缓存行、中断与事件流都会唤醒
+ * @tparam T 4 或 8 字节的整数类型
+ * @param addr 等待的地址
+ * @param expected 继续等待的值
+ * @param timeout_ns 超时 (纳秒)，未 EnableEventStream() 时
+ * 只在其它事件唤醒后检查
+ * @return true *addr 已改变，false 超时
+ */
+template <class T>
+static __always_inline auto WaitOnAddress(const T *addr, T expected,
+                                          uint64_t timeout_ns = kWaitForever)
+    -> bool {
+  static_assert(sizeof(T) == 4 || sizeof(T) == 8);
+  auto deadline = detail::CyclesDeadline(ReadCycles(), timeout_ns);
+  while (true) {
+    T value;
+    if constexpr (sizeof(T) == 4) {
+      __asm__ volatile("ldaxr %w0, [%1]" : "=&r"(value) : "r"(addr) : "memory");
+    } else {
+      __asm__ volatile("ldaxr %0, [%1]" : "=&r"(value) : "r"(addr) : "memory");
+    }
+    if (value != expected) {
+      return true;
+    }
+    if (ReadCycles() >= deadline) {
+      return false;
+    }
+    __asm__ volatile("wfe" ::: "memory");
+  }
+}
+
+/**
+ * @brief 使当前核心进入低功耗状态，直到有中断挂起
+ * 即使 PSTATE 屏蔽了中断，挂起的中断也会唤醒 wfi
+ * @param hint 保留，更深的状态需通过 PSCI CPU_SUSPEND
+ * @pre 已关闭中断，并确认没有待处理的工作
+ */
+static __always_inline void Idle([[maybe_unused]] uint32_t hint = 0) {
+  __asm__ volatile("dsb sy\n\twfi" ::: "memory");
+}
+
+/**
+ * @brief 根据 CNTFRQ_EL0 设置纳秒换算系数
+ * @return uint64_t 计数器频率 (Hz)
+ * @note CNTFRQ_EL0 由固件设置
+ */
+static __always_inline auto CalibrateTimestamp() -> uint64_t {
+  auto frequency = CNTFRQ_EL0::Read();
+  SetTimestampFrequency(frequency);
+  return frequency;
+}
+
+namespace detail {
+/**
+ * @brief 以 PSCI CPU_ON 启动从核心，见 StartSecondaryCores()
+ * CPU_ON 在目标开始上电后即返回，连续调用使各核心并行启动
+ * @param entry 入口物理地址
+ * @param stacks 栈顶地址，作为 context_id 传入 x0
+ * @param hw_ids MPIDR
+ * @return size_t 应完成初始化的从核心数
+ */
+static __always_inline auto StartCores(uint64_t entry,
+                                       std::span<const uint64_t> stacks,
+                                       std::span<const uint64_t> hw_ids)
+    -> size_t {
+  auto count = stacks.size() < hw_ids.size() ? stacks.size() : hw_ids.size();
+  size_t started = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (psci::CpuOn(hw_ids[i] & kMpidrAffinityMask, entry, stacks[i]) ==
+        psci::SUCCESS) {
+      started++;
+    }
+  }
+  return started;
+}
+}  // namespace detail
+
+/**
+ * @brief 本地定时器
+ * 使用 EL1 虚拟定时器 CNTV_*_EL0，周期模式由软件重装
+ * @note 每个核心一个实例
+ */
+class LocalTimer {
+ public:
+  /// @name 构造/析构函数
+  /// @{
+  LocalTimer() = default;
+  LocalTimer(const LocalTimer &) = delete;
+  LocalTimer(LocalTimer &&) = delete;
+  auto operator=(const LocalTimer &) -> LocalTimer & = delete;
+  auto operator=(LocalTimer &&) -> LocalTimer & = delete;
+  ~LocalTimer() = default;
+  /// @}
+
+  /**
+   * @brief 根据 CNTFRQ_EL0 校准定时器频率
+   * @return uint64_t 定时器频率 (Hz)
+   */
+  auto Calibrate() -> uint64_t {
+    if (GetTimestampFrequency() == 0) {
+      CalibrateTimestamp();
+    }
+    return GetTimestampFrequency();
+  }
+
+  /**
+   * @brief 停止定时器
+   */
+  void Stop() {
+    period_ = 0;
+    CNTV_CTL_EL0::Write(0);
+    __asm__ volatile("isb" ::: "memory");
+  }
+
+  /**
+   * @brief 获取定时器频率
+   * @return uint64_t 定时器频率 (Hz)，未校准时为 0
+   */
+  [[nodiscard]] auto GetFrequency() const -> uint64_t {
+    return GetTimestampFrequency();
+  }
+
+  /**
+   * @brief 启动周期模式
+   * 比较值在每次 Acknowledge() 时按周期累加，不随中断延迟漂移
+   * @param period_ns 周期 (纳秒)
+   * @pre 已调用 Calibrate()
+   */
+  void StartPeriodic(uint64_t period_ns) {
+    period_ = NsToCycles(period_ns);
+    if (period_ == 0) {
+      period_ = 1;
+    }
+    deadline_ = ReadCycles() + period_;
+    Arm(deadline_);
+  }
+
+  /**
+   * @brief 启动单次模式
+   * @param delay_ns 距现在的延迟 (纳秒)
+   * @pre 已调用 Calibrate()
+   */
+  void StartOneShot(uint64_t delay_ns) {
+    SetDeadline(ReadCycles() + NsToCycles(delay_ns));
+  }
+
+  /**
+   * @brief 计数器到达 deadline 时触发一次中断
+   * @param deadline 绝对计数值，与 ReadCycles() 同一时基
+   */
+  void SetDeadline(uint64_t deadline) {
+    period_ = 0;
+    deadline_ = deadline;
+    Arm(deadline_);
+  }
+
+  /**
+   * @brief 在定时器中断处理中调用
+   * 周期模式下设置下一次比较值，已错过的周期被跳过；单次模式下停止定时器，
+   * 以撤销电平中断
+   */
+  void Acknowledge() {
+    if (period_ == 0) {
+      Stop();
+      return;
+    }
+    deadline_ += period_;
+    auto now = ReadCycles();
+    if (deadline_ <= now) {
+      deadline_ = now + period_;
+    }
+    Arm(deadline_);
+  }
+
+  /**
+   * @brief 是否支持绝对时间 deadline 模式
+   * @return true 支持
+   */
+  [[nodiscard]] static auto IsDeadlineSupported() -> bool { return true; }
+
+ private:
+  /// 周期 (计数)，0 表示单次模式
+  uint64_t period_ = 0;
+  /// 当前比较值
+  uint64_t deadline_ = 0;
+
+  /**
+   * @brief 写入比较值并启用定时器
+   * @param deadline 绝对计数值
+   */
+  static void Arm(uint64_t deadline) {
+    CNTV_CVAL_EL0::Write(deadline);
+    CNTV_CTL_EL0::Write(
+        detail::register_info::system_reg::CNTV_CTL_EL0Info::ENABLE::kBitMask);
+    __asm__ volatile("isb" ::: "memory");
+  }
+};
+
+/**
+ * @brief GICv3 SGI 发送器
+ * 通过 ICC_SGI1R_EL1 发送 Group 1 SGI。目标为核心集合时按
+ * Aff3.Aff2.Aff1 与 Aff0 的 16 核范围 (RS) 分组，一次写入通过 TargetList
+ * 最多覆盖同组 16 个核心；除自身外的所有核心使用 IRM=1
+ * @note Aff0 大于 15 时需要 GIC 支持 Range Selector (ICC_CTLR_EL1.RSS)；
+ * 每批发送前执行一次 dsb ishst，保证 SGI 处理程序能看到之前的内存写入
+ */
+class IpiSender {
+ public:
+  /**
+   * @brief 构造函数
+   * @param mpidrs 以 core id 为下标的 MPIDR_EL1 值表，生命周期需长于本对象
+   */
+  explicit IpiSender(std::span<const uint64_t> mpidrs) : mpidrs_(mpidrs) {}
+
+  /// @name 构造/析构函数
+  /// @{
+  IpiSender() = delete;
+  IpiSender(const IpiSender &) = delete;
+  IpiSender(IpiSender &&) = delete;
+  auto operator=(const IpiSender &) -> IpiSender & = delete;
+  auto operator=(IpiSender &&) -> IpiSender & = delete;
+  ~IpiSender() = default;
+  /// @}
+
+  /**
+   * @brief 向自身发送 SGI
+   * @param intid SGI 编号 (0-15)
+   */
+  static void SendSelf(uint8_t intid) {
+    auto mpidr = MPIDR_EL1::Read();
+    Fence();
+    Write(GetRoute(mpidr) | GetTargetBit(mpidr) | Command(intid));
+  }
+
+  /**
+   * @brief 向包括自身在内的所有核心发送 SGI
+   * @param intid SGI 编号 (0-15)
+   */
+  static void SendAll(uint8_t intid) {
+    SendAllButSelf(intid);
+    SendSelf(intid);
+  }
+
+  /**
+   * @brief 向除自身外的所有核心发送 SGI
+   * @param intid SGI 编号 (0-15)
+   */
+  static void SendAllButSelf(uint8_t intid) {
+    Fence();
+    Write(detail::register_info::system_reg::ICC_SGI1R_EL1Info::IRM::kBitMask |
+          Command(intid));
+  }
+
+  /**
+   * @brief 向单个核心发送 SGI
+   * @param core_id 目标 core id
+   * @param intid SGI 编号 (0-15)
+   */
+  void Send(size_t core_id, uint8_t intid) const {
+    auto mpidr = mpidrs_[core_id];
+    Fence();
+    Write(GetRoute(mpidr) | GetTargetBit(mpidr) | Command(intid));
+  }
+
+  /**
+   * @brief 向核心集合发送 SGI
+   * 相邻 core id 属于同一组时合并为一次写入，mpidrs 按亲和性升序排列时
+   * 每组只写一次 ICC_SGI1R_EL1
+   * @param mask 目标核心集合
+   * @param intid SGI 编号 (0-15)
+   * @return size_t ICC_SGI1R_EL1 写入次数
+   */
+  template <size_t kMaxCores>
+  auto Send(const CpuMask<kMaxCores> &mask, uint8_t intid) const -> size_t {
+    Fence();
+    size_t writes = 0;
+    uint64_t route = 0;
+    uint64_t targets = 0;
+    mask.ForEach([&](size_t core_id) {
+      auto mpidr = mpidrs_[core_id];
+      if (targets != 0 && GetRoute(mpidr) != route) {
+        Write(route | targets | Command(intid));
+        writes++;
+        targets = 0;
+      }
+      route = GetRoute(mpidr);
+      targets |= GetTargetBit(mpidr);
+    });
+    if (targets != 0) {
+      Write(route | targets | Command(intid));
+      writes++;
+    }
+    return writes;
+  }
+
+ private:
+  /// 以 core id 为下标的 MPIDR_EL1 值表
+  std::span<const uint64_t> mpidrs_;
+
+  /**
+   * @brief 保证之前的内存写入先于 SGI 对目标核心可见
+   */
+  static __always_inline void Fence() {
+    __asm__ volatile("dsb ishst" ::: "memory");
+  }
+
+  /**
+   * @brief 写入 ICC_SGI1R_EL1 并等待生效
+   * @param value 寄存器值
+   */
+  static __always_inline void Write(uint64_t value) {
+    ICC_SGI1R_EL1::Write(value);
+    __asm__ volatile("isb" ::: "memory");
+  }
+
+  /**
+   * @brief 生成 INTID 字段
+   * @param intid SGI 编号 (0-15)
+   * @return uint64_t INTID 字段
+   */
+  static constexpr auto Command(uint8_t intid) -> uint64_t {
+    using Info = detail::register_info::system_reg::ICC_SGI1R_EL1Info;
+    return (static_cast<uint64_t>(intid) << Info::INTID::kBitOffset) &
+           Info::INTID::kBitMask;
+  }
+
+  /**
+   * @brief 由 MPIDR_EL1 生成 Aff3/Aff2/Aff1/RS 字段
+   * @param mpidr MPIDR_EL1 值
+   * @return uint64_t 路由字段，同一组的核心相同
+   */
+  static constexpr auto GetRoute(uint64_t mpidr) -> uint64_t {
+    using Info = detail::register_info::system_reg::ICC_SGI1R_EL1Info;
+    using Mpidr = detail::register_info::system_reg::MPIDR_EL1Info;
+    auto aff3 = (mpidr & Mpidr::Aff3::kBitMask) >> Mpidr::Aff3::kBitOffset;
+    auto aff2 = (mpidr & Mpidr::Aff2::kBitMask) >> Mpidr::Aff2::kBitOffset;
+    auto aff1 = (mpidr & Mpidr::Aff1::kBitMask) >> Mpidr::Aff1::kBitOffset;
+    auto aff0 = (mpidr & Mpidr::Aff0::kBitMask) >> Mpidr::Aff0::kBitOffset;
+    return (aff3 << Info::Aff3::kBitOffset) | (aff2 << Info::Aff2::kBitOffset) |
+           (aff1 << Info::Aff1::kBitOffset) |
+           ((aff0 >> 4) << Info::RS::kBitOffset);
+  }
+
+  /**
+   * @brief 由 MPIDR_EL1 生成 TargetList 中的位
+   * @param mpidr MPIDR_EL1 值
+   * @return uint64_t TargetList 位
+   */
+  static constexpr auto GetTargetBit(uint64_t mpidr) -> uint64_t {
+    return 1ULL << (mpidr & 0xF);
+  }
+};
+
 }  // namespace cpu_io
 
 #endif  // CPU_IO_INCLUDE_AARCH64_CPU_HPP_
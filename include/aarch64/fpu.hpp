@@ -0,0 +1,383 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_AARCH64_FPU_HPP_
+#define CPU_IO_INCLUDE_AARCH64_FPU_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "regs.hpp"
+
+namespace cpu_io {
+
+/// 扩展状态保存区的对齐要求
+static constexpr size_t kExtendedStateAlign = 16;
+
+namespace detail {
+
+/// FPSR/FPCR 所占字节数，位于保存区开头
+static constexpr size_t kFpControlSize = 16;
+/// FP/SIMD 格式保存区大小：FPSR/FPCR + Q0-Q31
+static constexpr size_t kFpSimdStateSize = kFpControlSize + 32 * 16;
+
+/// 扩展状态保存区的大小
+inline size_t extended_state_size = kFpSimdStateSize;
+/// 是否使用 SVE 格式保存
+inline bool extended_state_sve = false;
+
+/**
+ * @brief 修改 FP/SIMD 与 SVE 的访问控制
+ * @param trap CPACR_EL1Info::kTrapAll 或 kTrapNone
+ */
+static __always_inline void SetFpuTrap(uint8_t trap) {
+  using regs::system_reg::CPACR_EL1;
+  if (extended_state_sve) {
+    CPACR_EL1::Modify(CPACR_EL1::Fpen::Value(trap),
+                      CPACR_EL1::Zen::Value(trap));
+  } else {
+    CPACR_EL1::Fpen::Write(trap);
+  }
+  __asm__ volatile("isb" ::: "memory");
+}
+
+}  // namespace detail
+
+/**
+ * @brief 启用 FP/SIMD，处理器实现 SVE 时同时启用 SVE
+ * 保存区大小按当前向量长度计算，需在每个核心上调用一次，
+ * 之后不应再修改 ZCR_EL1.LEN
+ * @return true 使用 SVE 格式保存
+ */
+static __always_inline auto EnableExtendedState() -> bool {
+  detail::extended_state_sve =
+      detail::regs::system_reg::ID_AA64PFR0_EL1::Sve::Get() != 0;
+  detail::SetFpuTrap(
+      detail::register_info::system_reg::CPACR_EL1Info::kTrapNone);
+  if (!detail::extended_state_sve) {
+    detail::extended_state_size = detail::kFpSimdStateSize;
+    return false;
+  }
+  uint64_t vl;
+  __asm__ volatile(
+      ".arch_extension sve\n\t"
+      "rdvl %0, #1"
+      : "=r"(vl));
+  // Z0-Z31 各 VL 字节，P0-P15 与 FFR 各 VL/8 字节
+  detail::extended_state_size =
+      detail::kFpControlSize + 32 * vl + 17 * vl / 8;
+  return true;
+}
+
+/**
+ * @brief 获取扩展状态保存区的大小
+ * @return size_t 字节数
+ */
+static __always_inline auto GetExtendedStateSize() -> size_t {
+  return detail::extended_state_size;
+}
+
+/**
+ * @brief 初始化扩展状态保存区，恢复后所有寄存器为 0
+ * @param area 保存区，kExtendedStateAlign 对齐，大小为 GetExtendedStateSize()
+ */
+static __always_inline void InitExtendedState(void *area) {
+  __builtin_memset(area, 0, detail::extended_state_size);
+}
+
+/**
+ * @brief 保存扩展状态
+ * @param area 保存区，kExtendedStateAlign 对齐
+ */
+static __always_inline void SaveExtendedState(void *area) {
+  if (detail::extended_state_sve) {
+    void *sve = static_cast<uint8_t *>(area) + detail::kFpControlSize;
+    __asm__ volatile(
+        ".arch_extension sve\n\t"
+        "str z0, [%0, #0, mul vl]\n\t"
+        "str z1, [%0, #1, mul vl]\n\t"
+        "str z2, [%0, #2, mul vl]\n\t"
+        "str z3, [%0, #3, mul vl]\n\t"
+        "str z4, [%0, #4, mul vl]\n\t"
+        "str z5, [%0, #5, mul vl]\n\t"
+        "str z6, [%0, #6, mul vl]\n\t"
+        "str z7, [%0, #7, mul vl]\n\t"
+        "str z8, [%0, #8, mul vl]\n\t"
+        "str z9, [%0, #9, mul vl]\n\t"
+        "str z10, [%0, #10, mul vl]\n\t"
+        "str z11, [%0, #11, mul vl]\n\t"
+        "str z12, [%0, #12, mul vl]\n\t"
+        "str z13, [%0, #13, mul vl]\n\t"
+        "str z14, [%0, #14, mul vl]\n\t"
+        "str z15, [%0, #15, mul vl]\n\t"
+        "str z16, [%0, #16, mul vl]\n\t"
+        "str z17, [%0, #17, mul vl]\n\t"
+        "str z18, [%0, #18, mul vl]\n\t"
+        "str z19, [%0, #19, mul vl]\n\t"
+        "str z20, [%0, #20, mul vl]\n\t"
+        "str z21, [%0, #21, mul vl]\n\t"
+        "str z22, [%0, #22, mul vl]\n\t"
+        "str z23, [%0, #23, mul vl]\n\t"
+        "str z24, [%0, #24, mul vl]\n\t"
+        "str z25, [%0, #25, mul vl]\n\t"
+        "str z26, [%0, #26, mul vl]\n\t"
+        "str z27, [%0, #27, mul vl]\n\t"
+        "str z28, [%0, #28, mul vl]\n\t"
+        "str z29, [%0, #29, mul vl]\n\t"
+        "str z30, [%0, #30, mul vl]\n\t"
+        "str z31, [%0, #31, mul vl]\n\t"
+        "addvl %0, %0, #16\n\t"
+        "addvl %0, %0, #16\n\t"
+        "str p0, [%0, #0, mul vl]\n\t"
+        "str p1, [%0, #1, mul vl]\n\t"
+        "str p2, [%0, #2, mul vl]\n\t"
+        "str p3, [%0, #3, mul vl]\n\t"
+        "str p4, [%0, #4, mul vl]\n\t"
+        "str p5, [%0, #5, mul vl]\n\t"
+        "str p6, [%0, #6, mul vl]\n\t"
+        "str p7, [%0, #7, mul vl]\n\t"
+        "str p8, [%0, #8, mul vl]\n\t"
+        "str p9, [%0, #9, mul vl]\n\t"
+        "str p10, [%0, #10, mul vl]\n\t"
+        "str p11, [%0, #11, mul vl]\n\t"
+        "str p12, [%0, #12, mul vl]\n\t"
+        "str p13, [%0, #13, mul vl]\n\t"
+        "str p14, [%0, #14, mul vl]\n\t"
+        "str p15, [%0, #15, mul vl]\n\t"
+        // FFR 经 P0 中转
+        "rdffr p0.b\n\t"
+        "str p0, [%0, #16, mul vl]\n\t"
+        "ldr p0, [%0, #0, mul vl]"
+        : "+r"(sve)
+        :
+        : "memory");
+  } else {
+    __asm__ volatile(
+        "stp q0, q1, [%0, #16]\n\t"
+        "stp q2, q3, [%0, #48]\n\t"
+        "stp q4, q5, [%0, #80]\n\t"
+        "stp q6, q7, [%0, #112]\n\t"
+        "stp q8, q9, [%0, #144]\n\t"
+        "stp q10, q11, [%0, #176]\n\t"
+        "stp q12, q13, [%0, #208]\n\t"
+        "stp q14, q15, [%0, #240]\n\t"
+        "stp q16, q17, [%0, #272]\n\t"
+        "stp q18, q19, [%0, #304]\n\t"
+        "stp q20, q21, [%0, #336]\n\t"
+        "stp q22, q23, [%0, #368]\n\t"
+        "stp q24, q25, [%0, #400]\n\t"
+        "stp q26, q27, [%0, #432]\n\t"
+        "stp q28, q29, [%0, #464]\n\t"
+        "stp q30, q31, [%0, #496]"
+        :
+        : "r"(area)
+        : "memory");
+  }
+  uint64_t tmp;
+  __asm__ volatile(
+      "mrs %0, fpsr\n\t"
+      "str %0, [%1, #0]\n\t"
+      "mrs %0, fpcr\n\t"
+      "str %0, [%1, #8]"
+      : "=&r"(tmp)
+      : "r"(area)
+      : "memory");
+}
+
+/**
+ * @brief 恢复扩展状态
+ * @param area 由 SaveExtendedState() 或 InitExtendedState() 写入的保存区
+ */
+static __always_inline void RestoreExtendedState(const void *area) {
+  if (detail::extended_state_sve) {
+    const void *sve =
+        static_cast<const uint8_t *>(area) + detail::kFpControlSize;
+    __asm__ volatile(
+        ".arch_extension sve\n\t"
+        "ldr z0, [%0, #0, mul vl]\n\t"
+        "ldr z1, [%0, #1, mul vl]\n\t"
+        "ldr z2, [%0, #2, mul vl]\n\t"
+        "ldr z3, [%0, #3, mul vl]\n\t"
+        "ldr z4, [%0, #4, mul vl]\n\t"
+        "ldr z5, [%0, #5, mul vl]\n\t"
+        "ldr z6, [%0, #6, mul vl]\n\t"
+        "ldr z7, [%0, #7, mul vl]\n\t"
+        "ldr z8, [%0, #8, mul vl]\n\t"
+        "ldr z9, [%0, #9, mul vl]\n\t"
+        "ldr z10, [%0, #10, mul vl]\n\t"
+        "ldr z11, [%0, #11, mul vl]\n\t"
+        "ldr z12, [%0, #12, mul vl]\n\t"
+        "ldr z13, [%0, #13, mul vl]\n\t"
+        "ldr z14, [%0, #14, mul vl]\n\t"
+        "ldr z15, [%0, #15, mul vl]\n\t"
+        "ldr z16, [%0, #16, mul vl]\n\t"
+        "ldr z17, [%0, #17, mul vl]\n\t"
+        "ldr z18, [%0, #18, mul vl]\n\t"
+        "ldr z19, [%0, #19, mul vl]\n\t"
+        "ldr z20, [%0, #20, mul vl]\n\t"
+        "ldr z21, [%0, #21, mul vl]\n\t"
+        "ldr z22, [%0, #22, mul vl]\n\t"
+        "ldr z23, [%0, #23, mul vl]\n\t"
+        "ldr z24, [%0, #24, mul vl]\n\t"
+        "ldr z25, [%0, #25, mul vl]\n\t"
+        "ldr z26, [%0, #26, mul vl]\n\t"
+        "ldr z27, [%0, #27, mul vl]\n\t"
+        "ldr z28, [%0, #28, mul vl]\n\t"
+        "ldr z29, [%0, #29, mul vl]\n\t"
+        "ldr z30, [%0, #30, mul vl]\n\t"
+        "ldr z31, [%0, #31, mul vl]\n\t"
+        "addvl %0, %0, #16\n\t"
+        "addvl %0, %0, #16\n\t"
+        // FFR 经 P0 中转
+        "ldr p0, [%0, #16, mul vl]\n\t"
+        "wrffr p0.b\n\t"
+        "ldr p0, [%0, #0, mul vl]\n\t"
+        "ldr p1, [%0, #1, mul vl]\n\t"
+        "ldr p2, [%0, #2, mul vl]\n\t"
+        "ldr p3, [%0, #3, mul vl]\n\t"
+        "ldr p4, [%0, #4, mul vl]\n\t"
+        "ldr p5, [%0, #5, mul vl]\n\t"
+        "ldr p6, [%0, #6, mul vl]\n\t"
+        "ldr p7, [%0, #7, mul vl]\n\t"
+        "ldr p8, [%0, #8, mul vl]\n\t"
+        "ldr p9, [%0, #9, mul vl]\n\t"
+        "ldr p10, [%0, #10, mul vl]\n\t"
+        "ldr p11, [%0, #11, mul vl]\n\t"
+        "ldr p12, [%0, #12, mul vl]\n\t"
+        "ldr p13, [%0, #13, mul vl]\n\t"
+        "ldr p14, [%0, #14, mul vl]\n\t"
+        "ldr p15, [%0, #15, mul vl]"
+        : "+r"(sve)
+        :
+        : "memory");
+  } else {
+    __asm__ volatile(
+        "ldp q0, q1, [%0, #16]\n\t"
+        "ldp q2, q3, [%0, #48]\n\t"
+        "ldp q4, q5, [%0, #80]\n\t"
+        "ldp q6, q7, [%0, #112]\n\t"
+        "ldp q8, q9, [%0, #144]\n\t"
+        "ldp q10, q11, [%0, #176]\n\t"
+        "ldp q12, q13, [%0, #208]\n\t"
+        "ldp q14, q15, [%0, #240]\n\t"
+        "ldp q16, q17, [%0, #272]\n\t"
+        "ldp q18, q19, [%0, #304]\n\t"
+        "ldp q20, q21, [%0, #336]\n\t"
+        "ldp q22, q23, [%0, #368]\n\t"
+        "ldp q24, q25, [%0, #400]\n\t"
+        "ldp q26, q27, [%0, #432]\n\t"
+        "ldp q28, q29, [%0, #464]\n\t"
+        "ldp q30, q31, [%0, #496]"
+        :
+        : "r"(area)
+        : "memory");
+  }
+  uint64_t tmp;
+  __asm__ volatile(
+      "ldr %0, [%1, #0]\n\t"
+      "msr fpsr, %0\n\t"
+      "ldr %0, [%1, #8]\n\t"
+      "msr fpcr, %0"
+      : "=&r"(tmp)
+      : "r"(area)
+      : "memory");
+}
+
+/**
+ * @brief 延迟切换扩展状态，每个核心一个实例
+ * 切换线程时不保存扩展状态，只在下一个线程不是寄存器中状态的所有者时
+ * 把 CPACR_EL1.FPEN/ZEN 设为陷入；该线程首次使用 FP/SIMD/SVE 时产生
+ * 同步异常 (ESR_EL1.EC 为 0x07 或 0x19)，在处理中调用 HandleTrap()
+ * 保存所有者的状态并恢复当前线程的状态。
+ * 从不使用 FP/SIMD 的线程不会产生任何保存/恢复
+ * @note 内核自身使用 FP/SIMD 时同样会陷入；
+ * 线程迁移到其它核心前需在原核心上调用 Flush()
+ */
+class LazyFpu {
+ public:
+  /// @name 构造/析构函数
+  /// @{
+  LazyFpu() = default;
+  LazyFpu(const LazyFpu &) = delete;
+  LazyFpu(LazyFpu &&) = delete;
+  auto operator=(const LazyFpu &) -> LazyFpu & = delete;
+  auto operator=(LazyFpu &&) -> LazyFpu & = delete;
+  ~LazyFpu() = default;
+  /// @}
+
+  /**
+   * @brief 切换线程时调用
+   * @param next 下一个线程的保存区
+   */
+  void Switch(const void *next) { SetAccess(next == owner_); }
+
+  /**
+   * @brief FP/SIMD/SVE 访问陷入处理
+   * @param current 当前线程的保存区
+   */
+  void HandleTrap(void *current) {
+    SetAccess(true);
+    if (owner_ == current) {
+      return;
+    }
+    if (owner_ != nullptr) {
+      SaveExtendedState(owner_);
+    }
+    RestoreExtendedState(current);
+    owner_ = current;
+  }
+
+  /**
+   * @brief 把寄存器中的状态写回所有者的保存区并放弃所有权
+   */
+  void Flush() {
+    if (owner_ == nullptr) {
+      return;
+    }
+    SetAccess(true);
+    SaveExtendedState(owner_);
+    owner_ = nullptr;
+    SetAccess(false);
+  }
+
+  /**
+   * @brief 线程退出时调用，丢弃其寄存器中的状态
+   * @param area 退出线程的保存区
+   */
+  void Release(const void *area) {
+    if (owner_ == area) {
+      owner_ = nullptr;
+    }
+  }
+
+  /**
+   * @brief 获取寄存器中状态的所有者
+   * @return void* 所有者的保存区，没有所有者时为 nullptr
+   */
+  [[nodiscard]] auto GetOwner() const -> void * { return owner_; }
+
+ private:
+  /// 寄存器中状态的所有者
+  void *owner_ = nullptr;
+  /// 当前是否允许访问，避免重复写 CPACR_EL1 与 isb
+  bool access_ = true;
+
+  /**
+   * @brief 允许或禁止访问扩展状态
+   * @param access true 不陷入
+   */
+  void SetAccess(bool access) {
+    if (access == access_) {
+      return;
+    }
+    detail::SetFpuTrap(
+        access ? detail::register_info::system_reg::CPACR_EL1Info::kTrapNone
+               : detail::register_info::system_reg::CPACR_EL1Info::kTrapAll);
+    access_ = access;
+  }
+};
+
+}  // namespace cpu_io
+
+#endif  // CPU_IO_INCLUDE_AARCH64_FPU_HPP_
@@ -0,0 +1,474 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_AARCH64_GIC_HPP_
+#define CPU_IO_INCLUDE_AARCH64_GIC_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "regs.hpp"
+
+namespace cpu_io {
+
+/**
+ * @brief GICv3 分发器 (GICD) 与重分发器 (GICR) 驱动
+ * SPI 的使能、优先级、触发方式与亲和性路由通过 GICD 配置，SGI/PPI 通过
+ * 当前核心的 GICR SGI 帧配置，中断确认与结束通过 ICC_*_EL1 系统寄存器。
+ * 所有中断配置为非安全 Group 1，使用亲和性路由 (ARE)
+ * @see https://developer.arm.com/documentation/ihi0069/latest/
+ * @note 地址为已映射的虚拟地址；Init() 在启动核心上调用一次，
+ * InitCpu() 在每个核心上调用一次
+ */
+class Gic {
+ public:
+  /// 中断配置项，用于 Configure() 批量配置
+  struct IrqConfig {
+    /// 中断号
+    uint32_t intid;
+    /// 优先级，值越小优先级越高
+    uint8_t priority;
+    /// true 为边沿触发，false 为电平触发；SGI 忽略该项
+    bool edge_triggered;
+    /// 配置后是否使能
+    bool enable;
+  };
+
+  /// 第一个 PPI 中断号
+  static constexpr uint32_t kPpiBase = 16;
+  /// 第一个 SPI 中断号
+  static constexpr uint32_t kSpiBase = 32;
+  /// 特殊中断号：没有待处理的中断
+  static constexpr uint32_t kSpurious = 1023;
+  /// 默认优先级
+  static constexpr uint8_t kDefaultPriority = 0xA0;
+
+  /**
+   * @brief 构造函数
+   * @param gicd_base GICD 基址
+   * @param gicr_base 第一个 GICR 帧的基址
+   * @param gicr_stride 相邻 GICR 帧的间隔，GICv3 为 128KB，GICv4 为 256KB
+   */
+  Gic(uint64_t gicd_base, uint64_t gicr_base,
+      uint64_t gicr_stride = kGicrStrideV3)
+      : gicd_base_(gicd_base),
+        gicr_base_(gicr_base),
+        gicr_stride_(gicr_stride) {}
+
+  /// @name 构造/析构函数
+  /// @{
+  Gic() = delete;
+  Gic(const Gic &) = delete;
+  Gic(Gic &&) = delete;
+  auto operator=(const Gic &) -> Gic & = delete;
+  auto operator=(Gic &&) -> Gic & = delete;
+  ~Gic() = default;
+  /// @}
+
+  /**
+   * @brief 初始化分发器
+   * 关闭所有 SPI 并设为 Group 1、电平触发、默认优先级，
+   * 开启亲和性路由后把所有 SPI 路由到当前核心，最后开启 Group 1 分发
+   * @note IROUTER 的复位值由实现定义，不显式设置时 SPI 可能不会送达任何核心；
+   * 需要其它路由时在 Init() 之后调用 SetAffinity()/SetAffinityAny()
+   */
+  void Init() const {
+    Write32(gicd_base_ + kGicdCtlr, 0);
+    WaitGicdRwp();
+    auto max_intid = GetMaxSpi();
+    for (uint32_t intid = kSpiBase; intid <= max_intid; intid += 32) {
+      Write32(gicd_base_ + kGicdIcenabler + intid / 8, UINT32_MAX);
+      Write32(gicd_base_ + kGicdIcpendr + intid / 8, UINT32_MAX);
+      Write32(gicd_base_ + kGicdIgroupr + intid / 8, UINT32_MAX);
+      Write32(gicd_base_ + kGicdIgrpmodr + intid / 8, 0);
+    }
+    for (uint32_t intid = kSpiBase; intid <= max_intid; intid += 16) {
+      Write32(gicd_base_ + kGicdIcfgr + intid / 4, 0);
+    }
+    for (uint32_t intid = kSpiBase; intid <= max_intid; intid += 4) {
+      Write32(gicd_base_ + kGicdIpriorityr + intid,
+              kDefaultPriority * 0x01010101U);
+    }
+    WaitGicdRwp();
+    // ARE 为 0 时 IROUTER 不可访问，需先单独开启亲和性路由
+    Write32(gicd_base_ + kGicdCtlr, kGicdCtlrAreNs);
+    WaitGicdRwp();
+    auto mpidr = detail::regs::system_reg::MPIDR_EL1::Read() & kIrouterAffMask;
+    for (uint32_t intid = kSpiBase; intid <= max_intid; ++intid) {
+      Write64(gicd_base_ + kGicdIrouter + intid * 8, mpidr);
+    }
+    Write32(gicd_base_ + kGicdCtlr, kGicdCtlrAreNs | kGicdCtlrEnableGrp1);
+    WaitGicdRwp();
+  }
+
+  /**
+   * @brief 初始化当前核心的重分发器与 CPU 接口
+   * 唤醒重分发器，关闭所有 SGI/PPI 并设为 Group 1、默认优先级，
+   * 开启系统寄存器接口与 Group 1 中断
+   * @param priority_mask 优先级掩码，优先级数值小于该值的中断才会被响应
+   * @return true 成功，false 未找到当前核心的重分发器
+   */
+  [[nodiscard]] auto InitCpu(uint8_t priority_mask = 0xF0) const -> bool {
+    auto rd = FindRedistributor(detail::regs::system_reg::MPIDR_EL1::Read());
+    if (!rd) {
+      return false;
+    }
+    auto waker = Read32(*rd + kGicrWaker) & ~kGicrWakerProcessorSleep;
+    Write32(*rd + kGicrWaker, waker);
+    while ((Read32(*rd + kGicrWaker) & kGicrWakerChildrenAsleep) != 0) {
+      __asm__ volatile("yield" ::: "memory");
+    }
+
+    auto sgi = *rd + kSgiFrameOffset;
+    Write32(sgi + kGicdIcenabler, UINT32_MAX);
+    Write32(sgi + kGicdIcpendr, UINT32_MAX);
+    Write32(sgi + kGicdIgroupr, UINT32_MAX);
+    Write32(sgi + kGicdIgrpmodr, 0);
+    for (uint32_t intid = 0; intid < kSpiBase; intid += 4) {
+      Write32(sgi + kGicdIpriorityr + intid, kDefaultPriority * 0x01010101U);
+    }
+    WaitGicrRwp(*rd);
+
+    detail::regs::system_reg::ICC_SRE_EL1::SRE::Set();
+    __asm__ volatile("isb" ::: "memory");
+    detail::regs::system_reg::ICC_PMR_EL1::Write(priority_mask);
+    detail::regs::system_reg::ICC_IGRPEN1_EL1::Write(1);
+    __asm__ volatile("isb" ::: "memory");
+    return true;
+  }
+
+  /**
+   * @brief 批量配置中断
+   * 先一次性关闭所有涉及的中断，再写入优先级与触发方式，最后使能。
+   * 同一 32 位寄存器中的使能位合并为一次写入，整批只等待一次 RWP
+   * @param configs 中断配置，按中断号升序排列时合并效果最好
+   * @note SGI/PPI 配置写入当前核心的重分发器
+   */
+  void Configure(std::span<const IrqConfig> configs) const {
+    auto rd = FindRedistributor(detail::regs::system_reg::MPIDR_EL1::Read());
+    WriteEnableBits(configs, kGicdIcenabler, rd, [](const IrqConfig &) {
+      return true;
+    });
+    WaitRwp(configs, rd);
+    for (const auto &config : configs) {
+      auto base = GetFrameBase(config.intid, rd);
+      if (base == 0) {
+        continue;
+      }
+      Write8(base + kGicdIpriorityr + config.intid, config.priority);
+      // SGI 的触发方式固定为边沿触发
+      if (config.intid >= kPpiBase) {
+        auto offset = base + kGicdIcfgr + config.intid / 16 * 4;
+        auto shift = (config.intid % 16) * 2 + 1;
+        auto value = Read32(offset) & ~(1U << shift);
+        if (config.edge_triggered) {
+          value |= 1U << shift;
+        }
+        Write32(offset, value);
+      }
+    }
+    WriteEnableBits(configs, kGicdIsenabler, rd, [](const IrqConfig &config) {
+      return config.enable;
+    });
+  }
+
+  /**
+   * @brief 使能中断
+   * @param intid 中断号
+   */
+  void Enable(uint32_t intid) const {
+    auto base = GetFrameBase(intid, FindPrivateRedistributor(intid));
+    if (base != 0) {
+      Write32(base + kGicdIsenabler + intid / 32 * 4, 1U << (intid % 32));
+    }
+  }
+
+  /**
+   * @brief 关闭中断，返回时中断已不会再被分发
+   * @param intid 中断号
+   */
+  void Disable(uint32_t intid) const {
+    auto rd = FindPrivateRedistributor(intid);
+    auto base = GetFrameBase(intid, rd);
+    if (base == 0) {
+      return;
+    }
+    Write32(base + kGicdIcenabler + intid / 32 * 4, 1U << (intid % 32));
+    if (intid < kSpiBase) {
+      WaitGicrRwp(*rd);
+    } else {
+      WaitGicdRwp();
+    }
+  }
+
+  /**
+   * @brief 设置中断优先级
+   * @param intid 中断号
+   * @param priority 优先级，值越小优先级越高
+   */
+  void SetPriority(uint32_t intid, uint8_t priority) const {
+    auto base = GetFrameBase(intid, FindPrivateRedistributor(intid));
+    if (base != 0) {
+      Write8(base + kGicdIpriorityr + intid, priority);
+    }
+  }
+
+  /**
+   * @brief 将 SPI 路由到指定核心
+   * @param intid SPI 中断号
+   * @param mpidr 目标核心的 MPIDR_EL1 值
+   */
+  void SetAffinity(uint32_t intid, uint64_t mpidr) const {
+    if (intid >= kSpiBase) {
+      Write64(gicd_base_ + kGicdIrouter + intid * 8, mpidr & kIrouterAffMask);
+    }
+  }
+
+  /**
+   * @brief 将 SPI 路由到任意一个参与分发的核心 (IRM=1)
+   * @param intid SPI 中断号
+   */
+  void SetAffinityAny(uint32_t intid) const {
+    if (intid >= kSpiBase) {
+      Write64(gicd_base_ + kGicdIrouter + intid * 8, kIrouterIrm);
+    }
+  }
+
+  /**
+   * @brief 获取实现支持的最大 SPI 中断号
+   * @return uint32_t 最大 SPI 中断号
+   */
+  [[nodiscard]] auto GetMaxSpi() const -> uint32_t {
+    auto lines = Read32(gicd_base_ + kGicdTyper) & kGicdTyperItLinesMask;
+    auto max_intid = 32 * (lines + 1) - 1;
+    return max_intid > 1019 ? 1019 : max_intid;
+  }
+
+  /**
+   * @brief 查找 mpidr 对应核心的重分发器
+   * @param mpidr MPIDR_EL1 值
+   * @return std::optional<uint64_t> 重分发器 RD 帧基址
+   */
+  [[nodiscard]] auto FindRedistributor(uint64_t mpidr) const
+      -> std::optional<uint64_t> {
+    using Mpidr = detail::register_info::system_reg::MPIDR_EL1Info;
+    auto aff3 = (mpidr & Mpidr::Aff3::kBitMask) >> Mpidr::Aff3::kBitOffset;
+    auto affinity = (aff3 << 24) | (mpidr & 0xFFFFFF);
+    for (auto rd = gicr_base_;; rd += gicr_stride_) {
+      auto typer = Read64(rd + kGicrTyper);
+      if ((typer >> 32) == affinity) {
+        return rd;
+      }
+      if ((typer & kGicrTyperLast) != 0) {
+        return std::nullopt;
+      }
+    }
+  }
+
+  /**
+   * @brief 确认中断
+   * @return uint32_t 中断号，没有待处理的中断时为 kSpurious
+   */
+  static auto Acknowledge() -> uint32_t {
+    auto intid = static_cast<uint32_t>(
+        detail::regs::system_reg::ICC_IAR1_EL1::Read() & 0xFFFFFF);
+    __asm__ volatile("dsb sy" ::: "memory");
+    return intid;
+  }
+
+  /**
+   * @brief 结束中断
+   * @param intid Acknowledge() 返回的中断号
+   */
+  static void EndOfInterrupt(uint32_t intid) {
+    detail::regs::system_reg::ICC_EOIR1_EL1::Write(intid);
+    __asm__ volatile("isb" ::: "memory");
+  }
+
+ private:
+  /// GICv3 重分发器帧间隔 (RD_base + SGI_base)
+  static constexpr uint64_t kGicrStrideV3 = 0x20000;
+  /// SGI 帧相对 RD 帧的偏移
+  static constexpr uint64_t kSgiFrameOffset = 0x10000;
+
+  /// @name GICD 寄存器偏移
+  /// IGROUPR 到 IGRPMODR 的偏移与 GICR SGI 帧中的 *R0 寄存器相同
+  /// @{
+  static constexpr uint64_t kGicdCtlr = 0x0000;
+  static constexpr uint64_t kGicdTyper = 0x0004;
+  static constexpr uint64_t kGicdIgroupr = 0x0080;
+  static constexpr uint64_t kGicdIsenabler = 0x0100;
+  static constexpr uint64_t kGicdIcenabler = 0x0180;
+  static constexpr uint64_t kGicdIcpendr = 0x0280;
+  static constexpr uint64_t kGicdIpriorityr = 0x0400;
+  static constexpr uint64_t kGicdIcfgr = 0x0C00;
+  static constexpr uint64_t kGicdIgrpmodr = 0x0D00;
+  static constexpr uint64_t kGicdIrouter = 0x6000;
+  /// @}
+
+  /// @name GICR RD 帧寄存器偏移
+  /// @{
+  static constexpr uint64_t kGicrCtlr = 0x0000;
+  static constexpr uint64_t kGicrTyper = 0x0008;
+  static constexpr uint64_t kGicrWaker = 0x0014;
+  /// @}
+
+  /// GICD_CTLR.RWP: Register Write Pending
+  static constexpr uint32_t kGicdCtlrRwp = 1U << 31;
+  /// GICD_CTLR.ARE_NS: 亲和性路由
+  static constexpr uint32_t kGicdCtlrAreNs = 1U << 4;
+  /// GICD_CTLR.EnableGrp1A: 非安全 Group 1 分发
+  static constexpr uint32_t kGicdCtlrEnableGrp1 = 1U << 1;
+  /// GICD_TYPER.ITLinesNumber
+  static constexpr uint32_t kGicdTyperItLinesMask = 0x1F;
+  /// GICR_CTLR.RWP
+  static constexpr uint32_t kGicrCtlrRwp = 1U << 3;
+  /// GICR_TYPER.Last: 最后一个重分发器
+  static constexpr uint64_t kGicrTyperLast = 1ULL << 4;
+  /// GICR_WAKER.ProcessorSleep
+  static constexpr uint32_t kGicrWakerProcessorSleep = 1U << 1;
+  /// GICR_WAKER.ChildrenAsleep
+  static constexpr uint32_t kGicrWakerChildrenAsleep = 1U << 2;
+  /// GICD_IROUTER.Interrupt_Routing_Mode
+  static constexpr uint64_t kIrouterIrm = 1ULL << 31;
+  /// GICD_IROUTER 亲和性字段 Aff3 [39:32] 与 Aff2-Aff0 [23:0]
+  static constexpr uint64_t kIrouterAffMask = 0xFF00FFFFFFULL;
+
+  /// GICD 基址
+  uint64_t gicd_base_;
+  /// 第一个 GICR 帧基址
+  uint64_t gicr_base_;
+  /// 相邻 GICR 帧间隔
+  uint64_t gicr_stride_;
+
+  /// @name MMIO 访问，地址为寄存器的虚拟地址
+  /// @{
+  static __always_inline auto Read32(uint64_t addr) -> uint32_t {
+    return *reinterpret_cast<volatile uint32_t *>(addr);
+  }
+
+  static __always_inline auto Read64(uint64_t addr) -> uint64_t {
+    return *reinterpret_cast<volatile uint64_t *>(addr);
+  }
+
+  static __always_inline void Write8(uint64_t addr, uint8_t value) {
+    *reinterpret_cast<volatile uint8_t *>(addr) = value;
+  }
+
+  static __always_inline void Write32(uint64_t addr, uint32_t value) {
+    *reinterpret_cast<volatile uint32_t *>(addr) = value;
+  }
+
+  static __always_inline void Write64(uint64_t addr, uint64_t value) {
+    *reinterpret_cast<volatile uint64_t *>(addr) = value;
+  }
+  /// @}
+
+  /**
+   * @brief 等待 GICD 寄存器写入生效
+   */
+  void WaitGicdRwp() const {
+    while ((Read32(gicd_base_ + kGicdCtlr) & kGicdCtlrRwp) != 0) {
+      __asm__ volatile("yield" ::: "memory");
+    }
+  }
+
+  /**
+   * @brief 等待 GICR 寄存器写入生效
+   * @param rd 重分发器 RD 帧基址
+   */
+  static void WaitGicrRwp(uint64_t rd) {
+    while ((Read32(rd + kGicrCtlr) & kGicrCtlrRwp) != 0) {
+      __asm__ volatile("yield" ::: "memory");
+    }
+  }
+
+  /**
+   * @brief 对 SGI/PPI 查找当前核心的重分发器
+   * @param intid 中断号
+   * @return std::optional<uint64_t> SGI/PPI 时为当前核心 RD 帧基址
+   */
+  [[nodiscard]] auto FindPrivateRedistributor(uint32_t intid) const
+      -> std::optional<uint64_t> {
+    if (intid >= kSpiBase) {
+      return std::nullopt;
+    }
+    return FindRedistributor(detail::regs::system_reg::MPIDR_EL1::Read());
+  }
+
+  /**
+   * @brief 获取配置中断所用寄存器帧的基址
+   * @param intid 中断号
+   * @param rd 当前核心的重分发器 RD 帧基址
+   * @return uint64_t SPI 为 GICD 基址，SGI/PPI 为 SGI 帧基址，无效时为 0
+   */
+  [[nodiscard]] auto GetFrameBase(uint32_t intid,
+                                  std::optional<uint64_t> rd) const
+      -> uint64_t {
+    if (intid >= kSpiBase) {
+      return intid <= 1019 ? gicd_base_ : 0;
+    }
+    return rd ? *rd + kSgiFrameOffset : 0;
+  }
+
+  /**
+   * @brief 批量写入 ISENABLER/ICENABLER，同一寄存器的位合并为一次写入
+   * @param configs 中断配置
+   * @param offset kGicdIsenabler 或 kGicdIcenabler
+   * @param rd 当前核心的重分发器 RD 帧基址
+   * @param selected 判断配置项是否需要写入
+   */
+  template <class Predicate>
+  void WriteEnableBits(std::span<const IrqConfig> configs, uint64_t offset,
+                       std::optional<uint64_t> rd, Predicate selected) const {
+    uint64_t pending_addr = 0;
+    uint32_t pending_bits = 0;
+    for (const auto &config : configs) {
+      auto base = GetFrameBase(config.intid, rd);
+      if (base == 0 || !selected(config)) {
+        continue;
+      }
+      auto addr = base + offset + config.intid / 32 * 4;
+      if (pending_bits != 0 && addr != pending_addr) {
+        Write32(pending_addr, pending_bits);
+        pending_bits = 0;
+      }
+      pending_addr = addr;
+      pending_bits |= 1U << (config.intid % 32);
+    }
+    if (pending_bits != 0) {
+      Write32(pending_addr, pending_bits);
+    }
+  }
+
+  /**
+   * @brief 等待配置涉及的 GICD 与 GICR 写入生效
+   * @param configs 中断配置
+   * @param rd 当前核心的重分发器 RD 帧基址
+   */
+  void WaitRwp(std::span<const IrqConfig> configs,
+               std::optional<uint64_t> rd) const {
+    auto has_private = false;
+    auto has_shared = false;
+    for (const auto &config : configs) {
+      if (config.intid < kSpiBase) {
+        has_private = true;
+      } else {
+        has_shared = true;
+      }
+    }
+    if (has_private && rd) {
+      WaitGicrRwp(*rd);
+    }
+    if (has_shared) {
+      WaitGicdRwp();
+    }
+  }
+};
+
+}  // namespace cpu_io
+
+#endif /* CPU_IO_INCLUDE_AARCH64_GIC_HPP_ */
@@ -0,0 +1,237 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_AARCH64_PMU_HPP_
+#define CPU_IO_INCLUDE_AARCH64_PMU_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cpu.hpp"
+#include "regs.hpp"
+
+namespace cpu_io {
+/**
+ * @brief 性能监控计数器 (PMUv3)
+ * 事件计数器 i 对应计数器掩码的第 i 位，周期计数器对应 kCycleCounterBit。
+ * 溢出中断为 PPI (通常为 INTID 23，见设备树)，需在 GIC 中启用
+ * @see ARM DDI 0487 D7 The Performance Monitors Extension
+ */
+namespace pmu {
+
+/// 统计用户态 (EL0)
+static constexpr uint32_t kUser = 1U << 0;
+/// 统计内核态 (EL1)
+static constexpr uint32_t kKernel = 1U << 1;
+/// 溢出时产生中断
+static constexpr uint32_t kInterrupt = 1U << 2;
+
+/**
+ * @brief 通用架构事件号
+ */
+namespace event {
+/// CPU_CYCLES
+static constexpr uint64_t kCpuCycles = 0x11;
+/// INST_RETIRED
+static constexpr uint64_t kInstructions = 0x08;
+/// L1D_CACHE
+static constexpr uint64_t kCacheReferences = 0x04;
+/// L1D_CACHE_REFILL
+static constexpr uint64_t kCacheMisses = 0x03;
+/// PC_WRITE_RETIRED
+static constexpr uint64_t kBranchInstructions = 0x0C;
+/// BR_MIS_PRED
+static constexpr uint64_t kBranchMisses = 0x10;
+}  // namespace event
+
+/// 周期计数器在计数器掩码中的位
+static constexpr uint64_t kCycleCounterBit = 1ULL << 31;
+
+/**
+ * @brief 性能监控能力
+ */
+struct Info {
+  /// 事件计数器数量
+  uint8_t counters;
+};
+
+namespace detail {
+using PMCR_EL0 = cpu_io::detail::regs::system_reg::PMCR_EL0;
+using PMCNTENSET_EL0 = cpu_io::detail::regs::system_reg::PMCNTENSET_EL0;
+using PMCNTENCLR_EL0 = cpu_io::detail::regs::system_reg::PMCNTENCLR_EL0;
+using PMOVSCLR_EL0 = cpu_io::detail::regs::system_reg::PMOVSCLR_EL0;
+using PMINTENSET_EL1 = cpu_io::detail::regs::system_reg::PMINTENSET_EL1;
+using PMINTENCLR_EL1 = cpu_io::detail::regs::system_reg::PMINTENCLR_EL1;
+using PMSELR_EL0 = cpu_io::detail::regs::system_reg::PMSELR_EL0;
+using PMXEVTYPER_EL0 = cpu_io::detail::regs::system_reg::PMXEVTYPER_EL0;
+using PMXEVCNTR_EL0 = cpu_io::detail::regs::system_reg::PMXEVCNTR_EL0;
+using PMCCNTR_EL0 = cpu_io::detail::regs::system_reg::PMCCNTR_EL0;
+using PMCCFILTR_EL0 = cpu_io::detail::regs::system_reg::PMCCFILTR_EL0;
+using PMUSERENR_EL0 = cpu_io::detail::regs::system_reg::PMUSERENR_EL0;
+
+/// PMEVTYPER/PMCCFILTR：不统计 EL1
+static constexpr uint64_t kFilterP = 1ULL << 31;
+/// PMEVTYPER/PMCCFILTR：不统计 EL0
+static constexpr uint64_t kFilterU = 1ULL << 30;
+/// 事件号所占的位
+static constexpr uint64_t kEventMask = 0xFFFF;
+
+/**
+ * @brief 由 kUser/kKernel 生成过滤位
+ * @param flags 计数标志
+ * @return uint64_t PMEVTYPER/PMCCFILTR 的过滤位
+ */
+static constexpr auto Filter(uint32_t flags) -> uint64_t {
+  return ((flags & kUser) ? 0 : kFilterU) |
+         ((flags & kKernel) ? 0 : kFilterP);
+}
+
+/**
+ * @brief 选择事件计数器，之后通过 PMXEV* 访问
+ * @param index 事件计数器
+ * @note 与随后的 PMXEV* 访问之间需以 IrqSave() 屏蔽 IRQ/FIQ，
+ * 避免被同样使用 PMSELR_EL0 的中断处理 (如溢出中断) 打断
+ */
+static __always_inline void Select(size_t index) {
+  PMSELR_EL0::Write(index);
+  __asm__ volatile("isb" ::: "memory");
+}
+
+}  // namespace detail
+
+/**
+ * @brief 停止、清零所有计数器并打开总开关，需在每个核心上调用一次
+ * @return Info 性能监控能力
+ */
+static __always_inline auto Init() -> Info {
+  detail::PMCNTENCLR_EL0::Write(~0ULL);
+  detail::PMINTENCLR_EL1::Write(~0ULL);
+  detail::PMOVSCLR_EL0::Write(~0ULL);
+  detail::PMCR_EL0::Modify(
+      detail::PMCR_EL0::E::Value(true), detail::PMCR_EL0::P::Value(true),
+      detail::PMCR_EL0::C::Value(true), detail::PMCR_EL0::LC::Value(true));
+  __asm__ volatile("isb" ::: "memory");
+  return {detail::PMCR_EL0::N::Get()};
+}
+
+/**
+ * @brief 配置事件计数器并清零
+ * @param index 事件计数器
+ * @param event 事件号，见 pmu::event
+ * @param flags kUser/kKernel/kInterrupt 的组合
+ * @note 通过 PMSELR_EL0 间接访问，使 index 可以是运行时的值；
+ * 选择与写入期间屏蔽中断
+ */
+static __always_inline void Program(size_t index, uint64_t event,
+                                    uint32_t flags) {
+  detail::PMCNTENCLR_EL0::Write(1ULL << index);
+  auto irq_flags = IrqSave();
+  detail::Select(index);
+  detail::PMXEVTYPER_EL0::Write((event & detail::kEventMask) |
+                                detail::Filter(flags));
+  detail::PMXEVCNTR_EL0::Write(0);
+  IrqRestore(irq_flags);
+  if (flags & kInterrupt) {
+    detail::PMINTENSET_EL1::Write(1ULL << index);
+  } else {
+    detail::PMINTENCLR_EL1::Write(1ULL << index);
+  }
+}
+
+/**
+ * @brief 配置周期计数器并清零
+ * @param flags kUser/kKernel/kInterrupt 的组合
+ */
+static __always_inline void ProgramCycleCounter(uint32_t flags) {
+  detail::PMCNTENCLR_EL0::Write(kCycleCounterBit);
+  detail::PMCCFILTR_EL0::Write(detail::Filter(flags));
+  detail::PMCCNTR_EL0::Write(0);
+  if (flags & kInterrupt) {
+    detail::PMINTENSET_EL1::Write(kCycleCounterBit);
+  } else {
+    detail::PMINTENCLR_EL1::Write(kCycleCounterBit);
+  }
+}
+
+/**
+ * @brief 开始计数
+ * @param mask 计数器掩码
+ */
+static __always_inline void Start(uint64_t mask) {
+  detail::PMCNTENSET_EL0::Write(mask);
+}
+
+/**
+ * @brief 停止计数，计数值保持不变
+ * @param mask 计数器掩码
+ */
+static __always_inline void Stop(uint64_t mask) {
+  detail::PMCNTENCLR_EL0::Write(mask);
+}
+
+/**
+ * @brief 读取事件计数器
+ * @param index 事件计数器
+ * @return uint64_t 计数值
+ * @note EL0 使用前需 EnableUserRead()；EL0 不能屏蔽中断，因此读出后
+ * 检查 PMSELR_EL0，选择被中断处理改变时重新读取
+ */
+static __always_inline auto ReadCounter(size_t index) -> uint64_t {
+  uint64_t value;
+  do {
+    detail::Select(index);
+    value = detail::PMXEVCNTR_EL0::Read();
+  } while (detail::PMSELR_EL0::Read() != index);
+  return value;
+}
+
+/**
+ * @brief 读取周期计数器
+ * @return uint64_t 计数值
+ */
+static __always_inline auto ReadCycleCounter() -> uint64_t {
+  return detail::PMCCNTR_EL0::Read();
+}
+
+/**
+ * @brief 设置事件计数器的值，用于采样：写入 -period 后每 period 个事件溢出一次
+ * @param index 事件计数器
+ * @param value 计数值，事件计数器为 32 位
+ * @note 选择与写入期间屏蔽中断
+ */
+static __always_inline void SetCounter(size_t index, uint64_t value) {
+  auto irq_flags = IrqSave();
+  detail::Select(index);
+  detail::PMXEVCNTR_EL0::Write(value);
+  IrqRestore(irq_flags);
+}
+
+/**
+ * @brief 获取溢出的计数器
+ * @return uint64_t 计数器掩码
+ */
+static __always_inline auto GetOverflow() -> uint64_t {
+  return detail::PMOVSCLR_EL0::Read();
+}
+
+/**
+ * @brief 清除溢出状态，同时撤销溢出中断
+ * @param mask 计数器掩码
+ */
+static __always_inline void ClearOverflow(uint64_t mask) {
+  detail::PMOVSCLR_EL0::Write(mask);
+}
+
+/**
+ * @brief 允许 EL0 读取事件计数器与周期计数器
+ */
+static __always_inline void EnableUserRead() {
+  detail::PMUSERENR_EL0::Modify(detail::PMUSERENR_EL0::CR::Value(true),
+                                detail::PMUSERENR_EL0::ER::Value(true));
+}
+
+}  // namespace pmu
+}  // namespace cpu_io
+
+#endif  // CPU_IO_INCLUDE_AARCH64_PMU_HPP_
@@ -5,63 +5,17 @@
 #ifndef CPU_IO_INCLUDE_AARCH64_PSCI_HPP_
 #define CPU_IO_INCLUDE_AARCH64_PSCI_HPP_
 
+#include <bit>
 #include <cstdint>
 
+#include "smccc.hpp"
+
 /**
  * aarch64 cpu 相关定义
  * @note 寄存器读写设计见 arch/README.md
  */
 namespace cpu_io {
 
-/**
- * @brief SMC 调用返回值
- */
-struct SMCReturnValue {
-  uint64_t a0;
-  uint64_t a1;
-  uint64_t a2;
-  uint64_t a3;
-};
-
-/**
- * @brief 调用安全监控
- * @param a0 参数0
- * @param a1 参数1
- * @param a2 参数2
- * @param a3 参数3
- * @param a4 参数4
- * @param a5 参数5
- * @param a6 参数6
- * @param a7 参数7
- * @param res 返回值
- */
-static __always_inline auto SecureMonitorCall(uint64_t a0, uint64_t a1,
-                                              uint64_t a2, uint64_t a3,
-                                              uint64_t a4, uint64_t a5,
-                                              uint64_t a6, uint64_t a7)
-    -> const SMCReturnValue {
-  SMCReturnValue result;
-  register uint64_t x0 __asm__("x0") = a0;
-  register uint64_t x1 __asm__("x1") = a1;
-  register uint64_t x2 __asm__("x2") = a2;
-  register uint64_t x3 __asm__("x3") = a3;
-  register uint64_t x4 __asm__("x4") = a4;
-  register uint64_t x5 __asm__("x5") = a5;
-  register uint64_t x6 __asm__("x6") = a6;
-  register uint64_t x7 __asm__("x7") = a7;
-
-  __asm__ volatile("smc #0"
-                   : "+r"(x0), "+r"(x1), "+r"(x2), "+r"(x3)
-                   : "r"(x4), "r"(x5), "r"(x6), "r"(x7)
-                   : "memory");
-
-  result.a0 = x0;
-  result.a1 = x1;
-  result.a2 = x2;
-  result.a3 = x3;
-  return result;
-}
-
 /**
  * @brief psci 接口
  * @see https://developer.arm.com/documentation/den0022/fb/?lang=en
@@ -115,20 +69,15 @@ enum ErrorCode {
   INVALID_ADDRESS = -9,
 };
 
-/// 电源状态编码
+/// 电源状态编码，PSCI 推荐的 StateID 格式，位域从低位开始分配
 /// @see DEN0022F.b_Power_State_Coordination_Interface.pdf#6.5
 struct StateID {
-  // [15:12] Core is last in Power Level:
-  // 0: Core Level
-  // 1: Cluster Level
-  // 2: System Level
-  uint16_t core_last : 4;
-
-  // [11:8] System Level Local Power State
+  // [3:0] Core Level Local Power State
   // 0: Run
+  // 1: Standby
   // 2: Retention
   // 3: Powerdown
-  uint16_t system_state : 4;
+  uint16_t core_state : 4;
 
   // [7:4] Cluster Level Local Power State
   // 0: Run
@@ -136,36 +85,70 @@ struct StateID {
   // 3: Powerdown
   uint16_t cluster_state : 4;
 
-  // [3:0] Core Level Local Power State
+  // [11:8] System Level Local Power State
   // 0: Run
-  // 1: Standby
   // 2: Retention
   // 3: Powerdown
-  uint16_t core_state : 4;
+  uint16_t system_state : 4;
+
+  // [15:12] Core is last in Power Level:
+  // 0: Core Level
+  // 1: Cluster Level
+  // 2: System Level
+  uint16_t core_last : 4;
 } __attribute__((packed));
 
-/// 电源状态
+/// 电源状态，原始格式 (PSCI_FEATURES(CPU_SUSPEND) 的 bit[1] 为 0)
 /// @see DEN0022F.b_Power_State_Coordination_Interface.pdf#5.4.2
 struct PowerState {
-  // [31:26] Reserved. Must be zero.
-  uint32_t reserved1 : 6;
+  // [15:0] StateID
+  struct StateID state_id;
+  // [16] StateType
+  // 0: Standby or retention，唤醒后从调用处返回
+  // 1: Powerdown，唤醒后从 entry_point_address 开始执行
+  uint32_t state_type : 1;
+  // [23:17] Reserved. Must be zero.
+  uint32_t reserved0 : 7;
   // [25:24] PowerLevel
   // Level 0: for cores
   // Level 1: for clusters
   // Level 2: for system
   uint32_t power_level : 2;
-  // [23:17] Reserved. Must be zero.
-  uint32_t reserved0 : 7;
-  // [16] StateType
-  uint32_t state_type : 1;
-  // [15:0] StateID
-  struct StateID state_id;
+  // [31:26] Reserved. Must be zero.
+  uint32_t reserved1 : 6;
 } __attribute__((packed));
 
+static_assert(sizeof(PowerState) == 4);
+static_assert(std::bit_cast<uint16_t>(StateID{3, 2, 0, 1}) == 0x1023);
+static_assert(std::bit_cast<uint32_t>(PowerState{{3, 2, 0, 1}, 1, 0, 2, 0}) ==
+              0x02011023);
+
+/**
+ * Return the version of PSCI implemented
+ * @return uint32_t major << 16 | minor
+ * @see DEN0022F.b_Power_State_Coordination_Interface.pdf#5.1.1
+ */
+static __always_inline auto Version() -> uint32_t {
+  return static_cast<uint32_t>(SmcccFastCall(kVERSION).a0);
+}
+
+/**
+ * Query whether a PSCI function is implemented
+ * @param function_id 功能号
+ * @return int32_t 不小于 0 时为功能的属性，否则为 NOT_SUPPORTED。
+ * CPU_SUSPEND 的 bit[1] 表示使用扩展的 PowerState 格式
+ * @see DEN0022F.b_Power_State_Coordination_Interface.pdf#5.1.14
+ */
+static __always_inline auto Features(uint64_t function_id) -> int32_t {
+  return static_cast<int32_t>(SmcccFastCall(kFEATURES, function_id).a0);
+}
+
 /**
  * Suspend execution on a core or higher-level topology node.
+ * 待机/保持状态唤醒后直接返回 SUCCESS，延迟远低于掉电状态
  * @param power_state 电源状态
- * @param entry_point_address 用于恢复的地址
+ * @param entry_point_address 用于恢复的地址，掉电状态唤醒后以 MMU 关闭的
+ * 状态从此处执行，x0 为 context_id
  * @param context_id 上下文标识
  * @return ErrorCode 错误码
  * @see DEN0022F.b_Power_State_Coordination_Interface.pdf#5.1.2
@@ -173,10 +156,10 @@ struct PowerState {
 static __always_inline auto CpuSuspend(PowerState power_state,
                                        uint64_t entry_point_address,
                                        uint64_t context_id) -> enum ErrorCode {
-  (void)power_state;
-  (void)entry_point_address;
-  (void)context_id;
-  return SUCCESS;
+  return static_cast<ErrorCode>(static_cast<int32_t>(
+      SmcccFastCall(kCPU_SUSPEND_64, std::bit_cast<uint32_t>(power_state),
+                    entry_point_address, context_id)
+          .a0));
 }
 
 /**
@@ -185,7 +168,8 @@ static __always_inline auto CpuSuspend(PowerState power_state,
  * @see DEN0022F.b_Power_State_Coordination_Interface.pdf#5.1.3
  */
 static __always_inline auto CpuOff() -> enum ErrorCode {
-  return (ErrorCode)SecureMonitorCall(kCPU_OFF, 0, 0, 0, 0, 0, 0, 0).a0;
+  return static_cast<ErrorCode>(
+      static_cast<int32_t>(SmcccFastCall(kCPU_OFF).a0));
 }
 
 /**
@@ -205,10 +189,9 @@ static __always_inline auto CpuOff() -> enum ErrorCode {
 static __always_inline auto CpuOn(uint64_t target_cpu,
                                   uint64_t entry_point_address,
                                   uint64_t context_id) -> enum ErrorCode {
-  return (ErrorCode)SecureMonitorCall(kCPU_ON_64, target_cpu,
-                                      entry_point_address, context_id, 0, 0, 0,
-                                      0)
-      .a0;
+  return static_cast<ErrorCode>(static_cast<int32_t>(
+      SmcccFastCall(kCPU_ON_64, target_cpu, entry_point_address, context_id)
+          .a0));
 }
 
 }  // namespace psci
@@ -26,8 +26,11 @@ namespace cpu_io {
 namespace detail {
 
 namespace regs {
-struct X0 : public read_write::ReadWriteRegBase<register_info::X0Info> {};
-struct X29 : public read_write::ReadWriteRegBase<register_info::X29Info> {};
+/// 通用寄存器不会陷入，不跟踪
+struct X0 : public read_write::ReadWriteRegBase<register_info::X0Info,
+                                                read_write::NoRegTrace> {};
+struct X29 : public read_write::ReadWriteRegBase<register_info::X29Info,
+                                                 read_write::NoRegTrace> {};
 
 namespace system_reg {
 
@@ -36,6 +39,9 @@ struct CPACR_EL1 : public read_write::ReadWriteRegBase<
   using Fpen = read_write::ReadWriteField<
       read_write::ReadWriteRegBase<register_info::system_reg::CPACR_EL1Info>,
       register_info::system_reg::CPACR_EL1Info::Fpen>;
+  using Zen = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::system_reg::CPACR_EL1Info>,
+      register_info::system_reg::CPACR_EL1Info::Zen>;
 };
 
 struct CurrentEL : public read_write::ReadOnlyRegBase<
@@ -164,6 +170,10 @@ struct MAIR_EL1 : public read_write::ReadWriteRegBase<
 
 struct TCR_EL1 : public read_write::ReadWriteRegBase<
                      register_info::system_reg::TCR_EL1Info> {
+  using AS = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::system_reg::TCR_EL1Info>,
+      register_info::system_reg::TCR_EL1Info::AS>;
+
   using IPS = read_write::ReadWriteField<
       read_write::ReadWriteRegBase<register_info::system_reg::TCR_EL1Info>,
       register_info::system_reg::TCR_EL1Info::IPS>;
@@ -172,6 +182,10 @@ struct TCR_EL1 : public read_write::ReadWriteRegBase<
       read_write::ReadWriteRegBase<register_info::system_reg::TCR_EL1Info>,
       register_info::system_reg::TCR_EL1Info::TG1>;
 
+  using A1 = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::system_reg::TCR_EL1Info>,
+      register_info::system_reg::TCR_EL1Info::A1>;
+
   using T1SZ = read_write::ReadWriteField<
       read_write::ReadWriteRegBase<register_info::system_reg::TCR_EL1Info>,
       register_info::system_reg::TCR_EL1Info::T1SZ>;
@@ -345,6 +359,158 @@ struct TTBR1_EL1 : public read_write::ReadWriteRegBase<
       register_info::system_reg::TTBR1_EL1Info::CnP>;
 };
 
+struct ID_AA64ISAR0_EL1 : public read_write::ReadOnlyRegBase<
+                              register_info::system_reg::ID_AA64ISAR0_EL1Info> {
+  using TLB = read_write::ReadOnlyField<
+      read_write::ReadOnlyRegBase<
+          register_info::system_reg::ID_AA64ISAR0_EL1Info>,
+      register_info::system_reg::ID_AA64ISAR0_EL1Info::TLB>;
+};
+
+struct ID_AA64MMFR0_EL1 : public read_write::ReadOnlyRegBase<
+                              register_info::system_reg::ID_AA64MMFR0_EL1Info> {
+  using ASIDBits = read_write::ReadOnlyField<
+      read_write::ReadOnlyRegBase<
+          register_info::system_reg::ID_AA64MMFR0_EL1Info>,
+      register_info::system_reg::ID_AA64MMFR0_EL1Info::ASIDBits>;
+
+  using PARange = read_write::ReadOnlyField<
+      read_write::ReadOnlyRegBase<
+          register_info::system_reg::ID_AA64MMFR0_EL1Info>,
+      register_info::system_reg::ID_AA64MMFR0_EL1Info::PARange>;
+};
+
+/// 不跟踪，跟踪钩子可以通过 GetPerCpuCoreId() 获取核心号
+struct TPIDR_EL1
+    : public read_write::ReadWriteRegBase<
+          register_info::system_reg::TPIDR_EL1Info, read_write::NoRegTrace> {};
+
+struct CNTV_CVAL_EL0 : public read_write::ReadWriteRegBase<
+                           register_info::system_reg::CNTV_CVAL_EL0Info> {};
+
+struct ID_AA64PFR0_EL1 : public read_write::ReadOnlyRegBase<
+                             register_info::system_reg::ID_AA64PFR0_EL1Info> {
+  using Fp = read_write::ReadOnlyField<
+      read_write::ReadOnlyRegBase<
+          register_info::system_reg::ID_AA64PFR0_EL1Info>,
+      register_info::system_reg::ID_AA64PFR0_EL1Info::Fp>;
+
+  using AdvSimd = read_write::ReadOnlyField<
+      read_write::ReadOnlyRegBase<
+          register_info::system_reg::ID_AA64PFR0_EL1Info>,
+      register_info::system_reg::ID_AA64PFR0_EL1Info::AdvSimd>;
+
+  using Sve = read_write::ReadOnlyField<
+      read_write::ReadOnlyRegBase<
+          register_info::system_reg::ID_AA64PFR0_EL1Info>,
+      register_info::system_reg::ID_AA64PFR0_EL1Info::Sve>;
+};
+
+struct CNTKCTL_EL1 : public read_write::ReadWriteRegBase<
+                         register_info::system_reg::CNTKCTL_EL1Info> {
+  using Evnten = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::system_reg::CNTKCTL_EL1Info>,
+      register_info::system_reg::CNTKCTL_EL1Info::Evnten>;
+
+  using Evntdir = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::system_reg::CNTKCTL_EL1Info>,
+      register_info::system_reg::CNTKCTL_EL1Info::Evntdir>;
+
+  using Evnti = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::system_reg::CNTKCTL_EL1Info>,
+      register_info::system_reg::CNTKCTL_EL1Info::Evnti>;
+};
+
+struct PMCR_EL0 : public read_write::ReadWriteRegBase<
+                      register_info::system_reg::PMCR_EL0Info> {
+  using E = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::system_reg::PMCR_EL0Info>,
+      register_info::system_reg::PMCR_EL0Info::E>;
+
+  using P = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::system_reg::PMCR_EL0Info>,
+      register_info::system_reg::PMCR_EL0Info::P>;
+
+  using C = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::system_reg::PMCR_EL0Info>,
+      register_info::system_reg::PMCR_EL0Info::C>;
+
+  using LC = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::system_reg::PMCR_EL0Info>,
+      register_info::system_reg::PMCR_EL0Info::LC>;
+
+  using N = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::system_reg::PMCR_EL0Info>,
+      register_info::system_reg::PMCR_EL0Info::N>;
+};
+
+struct PMCNTENSET_EL0 : public read_write::ReadWriteRegBase<
+                            register_info::system_reg::PMCNTENSET_EL0Info> {};
+
+struct PMCNTENCLR_EL0 : public read_write::ReadWriteRegBase<
+                            register_info::system_reg::PMCNTENCLR_EL0Info> {};
+
+struct PMOVSCLR_EL0 : public read_write::ReadWriteRegBase<
+                          register_info::system_reg::PMOVSCLR_EL0Info> {};
+
+struct PMINTENSET_EL1 : public read_write::ReadWriteRegBase<
+                            register_info::system_reg::PMINTENSET_EL1Info> {};
+
+struct PMINTENCLR_EL1 : public read_write::ReadWriteRegBase<
+                            register_info::system_reg::PMINTENCLR_EL1Info> {};
+
+struct PMSELR_EL0 : public read_write::ReadWriteRegBase<
+                        register_info::system_reg::PMSELR_EL0Info> {};
+
+struct PMXEVTYPER_EL0 : public read_write::ReadWriteRegBase<
+                            register_info::system_reg::PMXEVTYPER_EL0Info> {};
+
+struct PMXEVCNTR_EL0 : public read_write::ReadWriteRegBase<
+                           register_info::system_reg::PMXEVCNTR_EL0Info> {};
+
+struct PMCCNTR_EL0 : public read_write::ReadWriteRegBase<
+                         register_info::system_reg::PMCCNTR_EL0Info> {};
+
+struct PMCCFILTR_EL0 : public read_write::ReadWriteRegBase<
+                           register_info::system_reg::PMCCFILTR_EL0Info> {};
+
+struct PMUSERENR_EL0 : public read_write::ReadWriteRegBase<
+                           register_info::system_reg::PMUSERENR_EL0Info> {
+  using EN = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<
+          register_info::system_reg::PMUSERENR_EL0Info>,
+      register_info::system_reg::PMUSERENR_EL0Info::EN>;
+
+  using CR = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<
+          register_info::system_reg::PMUSERENR_EL0Info>,
+      register_info::system_reg::PMUSERENR_EL0Info::CR>;
+
+  using ER = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<
+          register_info::system_reg::PMUSERENR_EL0Info>,
+      register_info::system_reg::PMUSERENR_EL0Info::ER>;
+};
+
+struct CTR_EL0 : public read_write::ReadOnlyRegBase<
+                     register_info::system_reg::CTR_EL0Info> {
+  using IminLine = read_write::ReadOnlyField<
+      read_write::ReadOnlyRegBase<register_info::system_reg::CTR_EL0Info>,
+      register_info::system_reg::CTR_EL0Info::IminLine>;
+
+  using DminLine = read_write::ReadOnlyField<
+      read_write::ReadOnlyRegBase<register_info::system_reg::CTR_EL0Info>,
+      register_info::system_reg::CTR_EL0Info::DminLine>;
+
+  using IDC = read_write::ReadOnlyField<
+      read_write::ReadOnlyRegBase<register_info::system_reg::CTR_EL0Info>,
+      register_info::system_reg::CTR_EL0Info::IDC>;
+
+  using DIC = read_write::ReadOnlyField<
+      read_write::ReadOnlyRegBase<register_info::system_reg::CTR_EL0Info>,
+      register_info::system_reg::CTR_EL0Info::DIC>;
+};
+
 }  // namespace system_reg
 
 }  // namespace regs
@@ -7,6 +7,7 @@
 
 #include <cstdint>
 
+#include "../../reg_trace.hpp"
 #include "register_info.hpp"
 
 namespace cpu_io {
@@ -15,11 +16,48 @@ namespace detail {
 
 namespace read_write {
 
+/**
+ * 寄存器访问跟踪使用的计数器，直接读取，本身不被跟踪
+ */
+struct TraceClock {
+  static __always_inline auto Read() -> uint64_t {
+    uint64_t value;
+    __asm__ volatile("mrs %0, CNTVCT_EL0" : "=r"(value));
+    return value;
+  }
+};
+
+/// 寄存器访问跟踪策略，定义 CPU_IO_REG_TRACE 时调用 SetRegTraceHook() 的钩子
+#ifdef CPU_IO_REG_TRACE
+using DefaultRegTrace = HookRegTrace<TraceClock>;
+#else
+using DefaultRegTrace = NoRegTrace;
+#endif
+
+/**
+ * 位域值，由位域的掩码与移位后的值组成
+ * @note 多个位域值可以合并后一次性写入寄存器，见 ReadWriteRegBase::Modify
+ */
+struct FieldValue {
+  /// 位域掩码
+  uint64_t mask;
+  /// 已移位到位域位置的值
+  uint64_t value;
+
+  /**
+   * | 重载，合并两个位域值
+   */
+  constexpr auto operator|(const FieldValue &other) const -> FieldValue {
+    return {mask | other.mask, value | other.value};
+  }
+};
+
 /**
  * 只读接口
  * @tparam 寄存器类型
+ * @tparam Trace 访问跟踪策略，见 reg_trace.hpp
  */
-template <class RegInfo>
+template <class RegInfo, class Trace = DefaultRegTrace>
 class ReadOnlyRegBase {
  public:
   /// @name 构造/析构函数
@@ -37,106 +75,9 @@ class ReadOnlyRegBase {
    * @return RegInfo::DataType 寄存器的值
    */
   static __always_inline auto Read() -> typename RegInfo::DataType {
-    typename RegInfo::DataType value{};
-    if constexpr (std::is_same_v<RegInfo, register_info::X0Info>) {
-      __asm__ volatile("mov %0, x0" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::X29Info>) {
-      __asm__ volatile("mov %0, x29" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::CPACR_EL1Info>) {
-      __asm__ volatile("mrs %0, CPACR_EL1" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::CurrentELInfo>) {
-      __asm__ volatile("mrs %0, CurrentEL" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::system_reg::SPSelInfo>) {
-      __asm__ volatile("mrs %0, SPSel" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::system_reg::DAIFInfo>) {
-      __asm__ volatile("mrs %0, DAIF" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::VBAR_EL1Info>) {
-      __asm__ volatile("mrs %0, VBAR_EL1" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo, register_info::system_reg::ELR_EL1Info>) {
-      __asm__ volatile("mrs %0, ELR_EL1" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::SPSR_EL1Info>) {
-      __asm__ volatile("mrs %0, SPSR_EL1" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo, register_info::system_reg::SP_EL0Info>) {
-      __asm__ volatile("mrs %0, SP_EL0" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo, register_info::system_reg::SP_EL1Info>) {
-      __asm__ volatile("mrs %0, SP_EL1" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::MPIDR_EL1Info>) {
-      __asm__ volatile("mrs %0, MPIDR_EL1" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::SCTLR_EL1Info>) {
-      __asm__ volatile("mrs %0, SCTLR_EL1" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::MAIR_EL1Info>) {
-      __asm__ volatile("mrs %0, MAIR_EL1" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo, register_info::system_reg::TCR_EL1Info>) {
-      __asm__ volatile("mrs %0, TCR_EL1" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::TTBR0_EL1Info>) {
-      __asm__ volatile("mrs %0, TTBR0_EL1" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::TTBR1_EL1Info>) {
-      __asm__ volatile("mrs %0, TTBR1_EL1" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo, register_info::system_reg::ESR_EL1Info>) {
-      __asm__ volatile("mrs %0, ESR_EL1" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo, register_info::system_reg::FAR_EL1Info>) {
-      __asm__ volatile("mrs %0, FAR_EL1" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::CNTV_CTL_EL0Info>) {
-      __asm__ volatile("mrs %0, CNTV_CTL_EL0" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::CNTV_TVAL_EL0Info>) {
-      __asm__ volatile("mrs %0, CNTV_TVAL_EL0" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::CNTVCT_EL0Info>) {
-      __asm__ volatile("mrs %0, CNTVCT_EL0" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::CNTFRQ_EL0Info>) {
-      __asm__ volatile("mrs %0, CNTFRQ_EL0" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::ICC_PMR_EL1Info>) {
-      __asm__ volatile("mrs %0, ICC_PMR_EL1" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::ICC_IGRPEN1_EL1Info>) {
-      __asm__ volatile("mrs %0, ICC_IGRPEN1_EL1" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::ICC_SRE_EL1Info>) {
-      __asm__ volatile("mrs %0, ICC_SRE_EL1" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::ICC_IAR1_EL1Info>) {
-      __asm__ volatile("mrs %0, ICC_IAR1_EL1" : "=r"(value) : :);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    auto trace_start = Trace::Begin();
+    auto value = RegInfo::Read();
+    Trace::template End<RegInfo>(RegAccess::kRead, value, trace_start);
     return value;
   }
 
@@ -151,8 +92,9 @@ class ReadOnlyRegBase {
 /**
  * 只写接口
  * @tparam 寄存器类型
+ * @tparam Trace 访问跟踪策略，见 reg_trace.hpp
  */
-template <class RegInfo>
+template <class RegInfo, class Trace = DefaultRegTrace>
 class WriteOnlyRegBase {
  public:
   /// @name 构造/析构函数
@@ -170,97 +112,9 @@ class WriteOnlyRegBase {
    * @param value 要写的值
    */
   static __always_inline void Write(typename RegInfo::DataType value) {
-    if constexpr (std::is_same_v<RegInfo, register_info::X0Info>) {
-      __asm__ volatile("mov x0, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::X29Info>) {
-      __asm__ volatile("mov x29, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::CPACR_EL1Info>) {
-      __asm__ volatile("msr CPACR_EL1, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::system_reg::SPSelInfo>) {
-      __asm__ volatile("msr SPSel, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::system_reg::DAIFInfo>) {
-      __asm__ volatile("msr DAIF, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::VBAR_EL1Info>) {
-      __asm__ volatile("msr VBAR_EL1, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo, register_info::system_reg::ELR_EL1Info>) {
-      __asm__ volatile("msr ELR_EL1, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::SPSR_EL1Info>) {
-      __asm__ volatile("msr SPSR_EL1, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo, register_info::system_reg::SP_EL0Info>) {
-      __asm__ volatile("msr SP_EL0, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo, register_info::system_reg::SP_EL1Info>) {
-      __asm__ volatile("msr SP_EL1, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::SCTLR_EL1Info>) {
-      __asm__ volatile("msr SCTLR_EL1, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::MAIR_EL1Info>) {
-      __asm__ volatile("msr MAIR_EL1, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo, register_info::system_reg::TCR_EL1Info>) {
-      __asm__ volatile("msr TCR_EL1, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::TTBR0_EL1Info>) {
-      __asm__ volatile("msr TTBR0_EL1, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::TTBR1_EL1Info>) {
-      __asm__ volatile("msr TTBR1_EL1, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo, register_info::system_reg::ESR_EL1Info>) {
-      __asm__ volatile("msr ESR_EL1, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo, register_info::system_reg::FAR_EL1Info>) {
-      __asm__ volatile("msr FAR_EL1, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::CNTV_CTL_EL0Info>) {
-      __asm__ volatile("msr CNTV_CTL_EL0, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::CNTV_TVAL_EL0Info>) {
-      __asm__ volatile("msr CNTV_TVAL_EL0, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::CNTFRQ_EL0Info>) {
-      __asm__ volatile("msr CNTFRQ_EL0, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::ICC_PMR_EL1Info>) {
-      __asm__ volatile("msr ICC_PMR_EL1, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::ICC_IGRPEN1_EL1Info>) {
-      __asm__ volatile("msr ICC_IGRPEN1_EL1, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::ICC_SRE_EL1Info>) {
-      __asm__ volatile("msr ICC_SRE_EL1, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::ICC_EOIR1_EL1Info>) {
-      __asm__ volatile("msr ICC_EOIR1_EL1, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::ICC_SGI1R_EL1Info>) {
-      __asm__ volatile("msr ICC_SGI1R_EL1, %0" : : "r"(value) :);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    auto trace_start = Trace::Begin();
+    RegInfo::Write(value);
+    Trace::template End<RegInfo>(RegAccess::kWrite, value, trace_start);
   }
 
   /**
@@ -269,12 +123,7 @@ class WriteOnlyRegBase {
    * @note 只能写 kPSTATEImmOpMask 范围内的值
    */
   static __always_inline void WriteImm(const uint8_t value) {
-    if constexpr (std::is_same_v<RegInfo,
-                                 register_info::system_reg::SPSelInfo>) {
-      __asm__ volatile("msr SPSel, %0" : : "i"(value) :);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    RegInfo::WriteImm(value);
   }
 
   /**
@@ -282,76 +131,11 @@ class WriteOnlyRegBase {
    * @param mask 掩码
    */
   static __always_inline void SetBits(uint64_t mask) {
-    if constexpr (std::is_same_v<RegInfo,
-                                 register_info::system_reg::CPACR_EL1Info>) {
-      typename RegInfo::DataType value = 0;
-      __asm__ volatile("mrs %0, CPACR_EL1" : "=r"(value)::);
-      value |= mask;
-      Write(value);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::system_reg::SPSelInfo>) {
-      typename RegInfo::DataType value = 0;
-      __asm__ volatile("mrs %0, SPSel" : "=r"(value)::);
-      value |= mask;
-      Write(value);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::system_reg::DAIFInfo>) {
-      typename RegInfo::DataType value = 0;
-      __asm__ volatile("mrs %0, DAIF" : "=r"(value)::);
-      value |= mask;
-      Write(value);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::CNTV_CTL_EL0Info>) {
-      typename RegInfo::DataType value = 0;
-      __asm__ volatile("mrs %0, CNTV_CTL_EL0" : "=r"(value)::);
-      value |= mask;
-      Write(value);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::ICC_PMR_EL1Info>) {
-      typename RegInfo::DataType value = 0;
-      __asm__ volatile("mrs %0, ICC_PMR_EL1" : "=r"(value)::);
-      value |= mask;
-      Write(value);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::ICC_SRE_EL1Info>) {
-      typename RegInfo::DataType value = 0;
-      __asm__ volatile("mrs %0, ICC_SRE_EL1" : "=r"(value)::);
-      value |= mask;
-      Write(value);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::ICC_IGRPEN1_EL1Info>) {
-      typename RegInfo::DataType value = 0;
-      __asm__ volatile("mrs %0, ICC_IGRPEN1_EL1" : "=r"(value)::);
-      value |= mask;
-      Write(value);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::SCTLR_EL1Info>) {
-      typename RegInfo::DataType value = 0;
-      __asm__ volatile("mrs %0, SCTLR_EL1" : "=r"(value)::);
-      value |= mask;
-      Write(value);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::TTBR0_EL1Info>) {
-      typename RegInfo::DataType value = 0;
-      __asm__ volatile("mrs %0, TTBR0_EL1" : "=r"(value)::);
-      value |= mask;
-      Write(value);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::TTBR1_EL1Info>) {
-      typename RegInfo::DataType value = 0;
-      __asm__ volatile("mrs %0, TTBR1_EL1" : "=r"(value)::);
-      value |= mask;
-      Write(value);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    auto trace_start = Trace::Begin();
+    auto value = RegInfo::Read();
+    value |= mask;
+    RegInfo::Write(value);
+    Trace::template End<RegInfo>(RegAccess::kSetBits, mask, trace_start);
   }
 
   /**
@@ -359,62 +143,11 @@ class WriteOnlyRegBase {
    * @param mask 掩码
    */
   static __always_inline void ClearBits(uint64_t mask) {
-    if constexpr (std::is_same_v<RegInfo,
-                                 register_info::system_reg::CPACR_EL1Info>) {
-      typename RegInfo::DataType value = 0;
-      __asm__ volatile("mrs %0, CPACR_EL1" : "=r"(value)::);
-      value &= ~mask;
-      Write(value);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::system_reg::SPSelInfo>) {
-      typename RegInfo::DataType value = 0;
-      __asm__ volatile("mrs %0, SPSel" : "=r"(value)::);
-      value &= ~mask;
-      Write(value);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::system_reg::DAIFInfo>) {
-      typename RegInfo::DataType value = 0;
-      __asm__ volatile("mrs %0, DAIF" : "=r"(value)::);
-      value &= ~mask;
-      Write(value);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::CNTV_CTL_EL0Info>) {
-      typename RegInfo::DataType value = 0;
-      __asm__ volatile("mrs %0, CNTV_CTL_EL0" : "=r"(value)::);
-      value &= ~mask;
-      Write(value);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::ICC_IGRPEN1_EL1Info>) {
-      typename RegInfo::DataType value = 0;
-      __asm__ volatile("mrs %0, ICC_IGRPEN1_EL1" : "=r"(value)::);
-      value &= ~mask;
-      Write(value);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::SCTLR_EL1Info>) {
-      typename RegInfo::DataType value = 0;
-      __asm__ volatile("mrs %0, SCTLR_EL1" : "=r"(value)::);
-      value &= ~mask;
-      Write(value);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::TTBR0_EL1Info>) {
-      typename RegInfo::DataType value = 0;
-      __asm__ volatile("mrs %0, TTBR0_EL1" : "=r"(value)::);
-      value &= ~mask;
-      Write(value);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::system_reg::TTBR1_EL1Info>) {
-      typename RegInfo::DataType value = 0;
-      __asm__ volatile("mrs %0, TTBR1_EL1" : "=r"(value)::);
-      value &= ~mask;
-      Write(value);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    auto trace_start = Trace::Begin();
+    auto value = RegInfo::Read();
+    value &= ~mask;
+    RegInfo::Write(value);
+    Trace::template End<RegInfo>(RegAccess::kClearBits, mask, trace_start);
   }
 
   /**
@@ -423,12 +156,7 @@ class WriteOnlyRegBase {
    * @note 只能写 kPSTATEImmOpMask 范围内的值
    */
   static __always_inline void SetBitsImm(const uint8_t mask) {
-    if constexpr (std::is_same_v<RegInfo,
-                                 register_info::system_reg::DAIFInfo>) {
-      __asm__ volatile("msr DAIFSet, %0" : : "i"(mask) : "memory");
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    RegInfo::SetBitsImm(mask);
   }
 
   /**
@@ -437,12 +165,7 @@ class WriteOnlyRegBase {
    * @note 只能写 kPSTATEImmOpMask 范围内的值
    */
   static __always_inline void ClearBitsImm(const uint8_t mask) {
-    if constexpr (std::is_same_v<RegInfo,
-                                 register_info::system_reg::DAIFInfo>) {
-      __asm__ volatile("msr DAIFClr, %0" : : "i"(mask) : "memory");
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    RegInfo::ClearBitsImm(mask);
   }
 
   /**
@@ -491,15 +214,28 @@ class WriteOnlyRegBase {
    * |= 重载
    */
   __always_inline void operator|=(uint64_t mask) { SetBits(mask); }
+
+  /**
+   * 将多个位域值合并后直接写入寄存器，未指定的位写 0
+   * @param first 第一个位域值
+   * @param rest 其余位域值
+   * @note 不读寄存器，适用于只写寄存器或需要整体赋值的场景
+   */
+  template <class... Rest>
+  static __always_inline void WriteFields(FieldValue first, Rest... rest) {
+    static_assert((std::is_same_v<Rest, FieldValue> && ...));
+    Write(static_cast<typename RegInfo::DataType>((first | ... | rest).value));
+  }
 };
 
 /**
  * 读写接口
  * @tparam 寄存器类型
+ * @tparam Trace 访问跟踪策略，见 reg_trace.hpp
  */
-template <class RegInfo>
-class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo>,
-                         public WriteOnlyRegBase<RegInfo> {
+template <class RegInfo, class Trace = DefaultRegTrace>
+class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo, Trace>,
+                         public WriteOnlyRegBase<RegInfo, Trace> {
  public:
   /// @name 构造/析构函数
   /// @{
@@ -518,8 +254,8 @@ class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo>,
    */
   static __always_inline auto ReadWrite(typename RegInfo::DataType value) ->
       typename RegInfo::DataType {
-    auto old_value = ReadOnlyRegBase<RegInfo>::Read();
-    WriteOnlyRegBase<RegInfo>::Write(value);
+    auto old_value = ReadOnlyRegBase<RegInfo, Trace>::Read();
+    WriteOnlyRegBase<RegInfo, Trace>::Write(value);
     return old_value;
   }
   /**
@@ -529,8 +265,8 @@ class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo>,
    */
   static __always_inline auto ReadSetBits(uint64_t mask) ->
       typename RegInfo::DataType {
-    auto old_value = ReadOnlyRegBase<RegInfo>::Read();
-    WriteOnlyRegBase<RegInfo>::SetBits(mask);
+    auto old_value = ReadOnlyRegBase<RegInfo, Trace>::Read();
+    WriteOnlyRegBase<RegInfo, Trace>::SetBits(mask);
     return old_value;
   }
 
@@ -541,10 +277,38 @@ class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo>,
    */
   static __always_inline auto ReadClearBits(uint64_t mask) ->
       typename RegInfo::DataType {
-    auto old_value = ReadOnlyRegBase<RegInfo>::Read();
-    WriteOnlyRegBase<RegInfo>::ClearBits(mask);
+    auto old_value = ReadOnlyRegBase<RegInfo, Trace>::Read();
+    WriteOnlyRegBase<RegInfo, Trace>::ClearBits(mask);
     return old_value;
   }
+
+  /**
+   * 一次读改写同时修改多个位域
+   * @tparam kFields 编译期确定的位域值
+   * @note 只进行一次读与一次写，屏障由调用者在整个配置序列完成后添加
+   */
+  template <FieldValue... kFields>
+  static __always_inline void Modify() {
+    static_assert(sizeof...(kFields) > 0);
+    constexpr auto kMerged = (kFields | ...);
+    Modify(kMerged);
+  }
+
+  /**
+   * 一次读改写同时修改多个位域
+   * @param first 第一个位域值
+   * @param rest 其余位域值
+   * @note 只进行一次读与一次写，屏障由调用者在整个配置序列完成后添加
+   */
+  template <class... Rest>
+  static __always_inline void Modify(FieldValue first, Rest... rest) {
+    static_assert((std::is_same_v<Rest, FieldValue> && ...));
+    auto merged = (first | ... | rest);
+    auto org_value = ReadOnlyRegBase<RegInfo, Trace>::Read();
+    WriteOnlyRegBase<RegInfo, Trace>::Write(
+        static_cast<typename RegInfo::DataType>((org_value & ~merged.mask) |
+                                                merged.value));
+  }
 };
 
 /**
@@ -570,8 +334,7 @@ class ReadOnlyField {
    * @return RegInfo::DataType 指定位值的信息
    */
   static __always_inline auto Get() -> typename RegInfo::DataType {
-    return static_cast<typename RegInfo::DataType>(
-        (Reg::Read() & RegInfo::kBitMask) >> RegInfo::kBitOffset);
+    return RegInfo::Decode(Reg::Read());
   }
 
   /**
@@ -581,8 +344,7 @@ class ReadOnlyField {
    */
   static __always_inline auto Get(uint64_t value) ->
       typename RegInfo::DataType {
-    return static_cast<typename RegInfo::DataType>(
-        (value & RegInfo::kBitMask) >> RegInfo::kBitOffset);
+    return RegInfo::Decode(value);
   }
 };
 
@@ -613,6 +375,15 @@ class WriteOnlyField {
    * 清零对应 Reg 的由 RegInfo 规定的指定位
    */
   static __always_inline void Clear() { Reg::ClearBits(RegInfo::kBitMask); }
+
+  /**
+   * 生成由 RegInfo 规定的位域值，用于批量修改
+   * @param value 位域的值
+   * @return FieldValue 位域值
+   */
+  static constexpr auto Value(typename RegInfo::DataType value) -> FieldValue {
+    return {RegInfo::kBitMask, RegInfo::Encode(value)};
+  }
 };
 
 /**
@@ -640,10 +411,8 @@ class ReadWriteField : public ReadOnlyField<Reg, RegInfo>,
    */
   static __always_inline void Write(typename RegInfo::DataType value) {
     auto org_value = Reg::Read();
-    auto new_value =
-        (org_value & ~RegInfo::kBitMask) |
-        ((static_cast<decltype(org_value)>(value) << RegInfo::kBitOffset) &
-         RegInfo::kBitMask);
+    auto new_value = static_cast<decltype(org_value)>(
+        RegInfo::Insert(org_value, value));
     Reg::Write(new_value);
   }
 
@@ -655,12 +424,115 @@ class ReadWriteField : public ReadOnlyField<Reg, RegInfo>,
   static __always_inline auto ReadWrite(typename RegInfo::DataType value) ->
       typename RegInfo::DataType {
     auto org_value = Reg::Read();
-    auto new_value = (org_value & ~RegInfo::kBitMask) |
-                     ((value << RegInfo::kBitOffset) & RegInfo::kBitMask);
+    auto new_value = static_cast<decltype(org_value)>(
+        RegInfo::Insert(org_value, value));
     Reg::Write(new_value);
-    return static_cast<typename RegInfo::DataType>(
-        (org_value & RegInfo::kBitMask) >> RegInfo::kBitOffset);
+    return RegInfo::Decode(org_value);
+  }
+};
+
+/**
+ * 带软件影子的寄存器接口
+ * @tparam Reg 寄存器类型，需要提供 Read() 与 Write()
+ * @note 对于在虚拟化环境下读操作会陷入的寄存器，读操作由影子提供，
+ *  只有第一次读或 Invalidate() 之后的读会访问硬件。
+ *  影子保存在对象中，每个核心应当持有自己的实例（如放在 per-CPU 数据中）；
+ *  若寄存器被本对象之外的途径修改，需要调用 Invalidate()
+ */
+template <class Reg>
+class CachedReg {
+ public:
+  using DataType = decltype(Reg::Read());
+
+  /// @name 构造/析构函数
+  /// @{
+  CachedReg() = default;
+  CachedReg(const CachedReg &) = delete;
+  CachedReg(CachedReg &&) = delete;
+  auto operator=(const CachedReg &) -> CachedReg & = delete;
+  auto operator=(CachedReg &&) -> CachedReg & = delete;
+  ~CachedReg() = default;
+  /// @}
+
+  /**
+   * 读寄存器，影子有效时不访问硬件
+   * @return DataType 寄存器的值
+   */
+  __always_inline auto Read() -> DataType {
+    if (!valid_) {
+      value_ = Reg::Read();
+      valid_ = true;
+    }
+    return value_;
+  }
+
+  /**
+   * 写寄存器并更新影子
+   * @param value 要写的值
+   */
+  __always_inline void Write(DataType value) {
+    Reg::Write(value);
+    value_ = value;
+    valid_ = true;
   }
+
+  /**
+   * 通过掩码设置寄存器
+   * @param mask 掩码
+   * @note 影子有效时只写不读
+   */
+  __always_inline void SetBits(uint64_t mask) {
+    Write(static_cast<DataType>(Read() | mask));
+  }
+
+  /**
+   * 通过掩码清零寄存器
+   * @param mask 掩码
+   * @note 影子有效时只写不读
+   */
+  __always_inline void ClearBits(uint64_t mask) {
+    Write(static_cast<DataType>(Read() & ~mask));
+  }
+
+  /**
+   * 从影子获取指定位域的值
+   * @tparam Field 位域类型，如 Cr0::Pg
+   * @return 位域的值
+   */
+  template <class Field>
+  __always_inline auto Get() {
+    return Field::Get(static_cast<uint64_t>(Read()));
+  }
+
+  /**
+   * 同时修改多个位域，影子有效时只写不读
+   * @param first 第一个位域值
+   * @param rest 其余位域值
+   */
+  template <class... Rest>
+  __always_inline void Modify(FieldValue first, Rest... rest) {
+    static_assert((std::is_same_v<Rest, FieldValue> && ...));
+    auto merged = (first | ... | rest);
+    Write(static_cast<DataType>((static_cast<uint64_t>(Read()) & ~merged.mask) |
+                                merged.value));
+  }
+
+  /**
+   * 使影子失效，下一次读会访问硬件
+   */
+  __always_inline void Invalidate() { valid_ = false; }
+
+  /**
+   * 影子是否有效
+   * @return true 有效
+   */
+  [[nodiscard]] __always_inline auto IsValid() const -> bool { return valid_; }
+
+ private:
+  /// 影子值
+  DataType value_{};
+  /// 影子是否有效
+  bool valid_{false};
 };
 
 }  // namespace read_write
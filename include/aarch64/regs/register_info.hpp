@@ -5,6 +5,8 @@
 #ifndef CPU_IO_INCLUDE_RISCV64_REGISTER_INFO_HPP_
 #define CPU_IO_INCLUDE_RISCV64_REGISTER_INFO_HPP_
 
+#include <sys/cdefs.h>
+
 #include <array>
 #include <cstdint>
 
@@ -17,8 +19,33 @@ namespace detail {
 namespace register_info {
 
 /// 通用寄存器
-struct X0Info : public RegInfoBase {};
-struct X29Info : public RegInfoBase {};
+struct X0Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mov %0, x0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("mov x0, %0" : : "r"(value) :);
+  }
+};
+
+struct X29Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mov %0, x29" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("mov x29, %0" : : "r"(value) :);
+  }
+};
 
 namespace system_reg {
 /// 立即数掩码，大于这个值需要使用寄存器中转
@@ -32,15 +59,30 @@ static constexpr uint64_t kPSTATEImmOpMask = 0xF;
  * https://developer.arm.com/documentation/ddi0595/2021-03/AArch64-Registers/CPACR-EL1--Architectural-Feature-Access-Control-Register?lang=en
  */
 struct CPACR_EL1Info : public RegInfoBase {
-  struct Fpen {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 20;
-    static constexpr uint64_t kBitWidth = 2;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  /// 访问控制取值：EL0/EL1 均陷入
+  static constexpr uint8_t kTrapAll = 0b00;
+  /// 访问控制取值：仅 EL0 陷入
+  static constexpr uint8_t kTrapEl0 = 0b01;
+  /// 访问控制取值：不陷入
+  static constexpr uint8_t kTrapNone = 0b11;
+
+  /// SVE 访问控制，0b11 表示不陷入
+  struct Zen : public BitField<uint8_t, 16, 2> {};
+
+  /// FP/SIMD 访问控制，0b11 表示不陷入
+  struct Fpen : public BitField<uint8_t, 20, 2> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, CPACR_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr CPACR_EL1, %0" : : "r"(value) :);
+  }
 };
 
 /**
@@ -54,15 +96,14 @@ struct CurrentELInfo : public RegInfoBase {
   static constexpr uint8_t kEL2 = 0b10;
   static constexpr uint8_t kEL3 = 0b11;
 
-  struct EL {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 2;
-    static constexpr uint64_t kBitWidth = 2;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct EL : public BitField<uint8_t, 2, 2> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, CurrentEL" : "=r"(value) : :);
+    return value;
+  }
 };
 
 /**
@@ -74,15 +115,27 @@ struct SPSelInfo : public RegInfoBase {
   static constexpr bool kEL0 = false;
   static constexpr bool kELx = true;
 
-  struct SP {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct SP : public BitField<bool, 0, 1> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, SPSel" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr SPSel, %0" : : "r"(value) :);
+  }
+
+  /**
+   * @brief 以立即数写 SPSel，不通过寄存器中转
+   * @param value 要写的值，须在 kPSTATEImmOpMask 范围内
+   */
+  static __always_inline void WriteImm(const uint8_t value) {
+    __asm__ volatile("msr SPSel, %0" : : "i"(value) :);
+  }
 };
 
 /**
@@ -97,48 +150,44 @@ struct DAIFInfo : public RegInfoBase {
   /// Process state D mask.
   /// Watchpoint, Breakpoint, and Software Step exceptions targeted at the
   /// current Exception level
-  struct D {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 9;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct D : public BitField<bool, 9, 1> {};
 
   /// SError exception mask bit.
-  struct A {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 8;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct A : public BitField<bool, 8, 1> {};
 
   /// IRQ mask bit.
-  struct I {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 7;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct I : public BitField<bool, 7, 1> {};
 
   /// FIQ mask bit.
-  struct F {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 6;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct F : public BitField<bool, 6, 1> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, DAIF" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr DAIF, %0" : : "r"(value) :);
+  }
+
+  /**
+   * @brief 以立即数置位 DAIF，不通过寄存器中转
+   * @param mask 掩码，须在 kPSTATEImmOpMask 范围内
+   */
+  static __always_inline void SetBitsImm(const uint8_t mask) {
+    __asm__ volatile("msr DAIFSet, %0" : : "i"(mask) : "memory");
+  }
+
+  /**
+   * @brief 以立即数清零 DAIF，不通过寄存器中转
+   * @param mask 掩码，须在 kPSTATEImmOpMask 范围内
+   */
+  static __always_inline void ClearBitsImm(const uint8_t mask) {
+    __asm__ volatile("msr DAIFClr, %0" : : "i"(mask) : "memory");
+  }
 };
 
 /**
@@ -147,15 +196,19 @@ struct DAIFInfo : public RegInfoBase {
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/VBAR-EL1--Vector-Base-Address-Register--EL1-
  */
 struct VBAR_EL1Info : public RegInfoBase {
-  struct Base {
-    using DataType = uint64_t;
-    static constexpr uint64_t kBitOffset = 11;
-    static constexpr uint64_t kBitWidth = 53;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Base : public BitField<uint64_t, 11, 53> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, VBAR_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr VBAR_EL1, %0" : : "r"(value) :);
+  }
 };
 
 /**
@@ -163,28 +216,76 @@ struct VBAR_EL1Info : public RegInfoBase {
  * @see
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/ELR-EL1--Exception-Link-Register--EL1-
  */
-struct ELR_EL1Info : public RegInfoBase {};
+struct ELR_EL1Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, ELR_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr ELR_EL1, %0" : : "r"(value) :);
+  }
+};
 
 /**
  * @brief SPSR_EL1 寄存器定义
  * @see
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/SPSR-EL1--Saved-Program-Status-Register--EL1-
  */
-struct SPSR_EL1Info : public RegInfoBase {};
+struct SPSR_EL1Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, SPSR_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr SPSR_EL1, %0" : : "r"(value) :);
+  }
+};
 
 /**
  * @brief SP_EL0 寄存器定义
  * @see
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/SP-EL0--Stack-Pointer--EL0-
  */
-struct SP_EL0Info : public RegInfoBase {};
+struct SP_EL0Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, SP_EL0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr SP_EL0, %0" : : "r"(value) :);
+  }
+};
 
 /**
  * @brief SP_EL1 寄存器定义
  * @see
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/SP-EL1--Stack-Pointer--EL1-
  */
-struct SP_EL1Info : public RegInfoBase {};
+struct SP_EL1Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, SP_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr SP_EL1, %0" : : "r"(value) :);
+  }
+};
 
 /**
  * @brief MPIDR_EL1 寄存器定义
@@ -192,40 +293,16 @@ struct SP_EL1Info : public RegInfoBase {};
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/MPIDR-EL1--Multiprocessor-Affinity-Register
  */
 struct MPIDR_EL1Info : public RegInfoBase {
-  struct Aff3 {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 32;
-    static constexpr uint64_t kBitWidth = 8;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
-
-  struct U {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 30;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
+  struct Aff3 : public BitField<uint8_t, 32, 8> {};
 
+  struct U : public BitField<bool, 30, 1> {
     /// Processor is part of a uniprocessor system.
     static constexpr bool KUniProcessor = false;
     /// Processor is part of a multiprocessor system.
     static constexpr bool kMultiProssor = true;
   };
 
-  struct MT {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 24;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-
+  struct MT : public BitField<bool, 24, 1> {
     /// Performance of PEs with different affinity level 0 values, and the same
     /// values for affinity level 1 and higher, is largely independent.
     static constexpr bool KSingleThread = false;
@@ -235,35 +312,18 @@ struct MPIDR_EL1Info : public RegInfoBase {
     static constexpr bool KMultiThread = true;
   };
 
-  struct Aff2 {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 16;
-    static constexpr uint64_t kBitWidth = 8;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Aff2 : public BitField<uint8_t, 16, 8> {};
 
-  struct Aff1 {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 8;
-    static constexpr uint64_t kBitWidth = 8;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Aff1 : public BitField<uint8_t, 8, 8> {};
 
-  struct Aff0 {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 8;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Aff0 : public BitField<uint8_t, 0, 8> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, MPIDR_EL1" : "=r"(value) : :);
+    return value;
+  }
 };
 
 /**
@@ -272,40 +332,28 @@ struct MPIDR_EL1Info : public RegInfoBase {
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/TTBR0-EL1--Translation-Table-Base-Register-0--EL1-
  */
 struct TTBR0_EL1Info : public RegInfoBase {
-  struct ASID {
-    using DataType = uint16_t;
-    static constexpr uint64_t kBitOffset = 48;
-    static constexpr uint64_t kBitWidth = 16;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
-
-  struct BADDR {
-    using DataType = uint64_t;
-    static constexpr uint64_t kBitOffset = 1;
-    static constexpr uint64_t kBitWidth = 47;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct ASID : public BitField<uint16_t, 48, 16> {};
 
-  struct CnP {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
+  struct BADDR : public BitField<uint64_t, 1, 47> {};
 
+  struct CnP : public BitField<bool, 0, 1> {
     /// No meaning to Common not Private.
     static constexpr bool kNotPrivate = false;
     /// Common not Private.
     static constexpr bool kCommon = true;
   };
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, TTBR0_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr TTBR0_EL1, %0" : : "r"(value) :);
+  }
 };
 
 /**
@@ -314,40 +362,28 @@ struct TTBR0_EL1Info : public RegInfoBase {
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/TTBR1-EL1--Translation-Table-Base-Register-1--EL1-
  */
 struct TTBR1_EL1Info : public RegInfoBase {
-  struct ASID {
-    using DataType = uint16_t;
-    static constexpr uint64_t kBitOffset = 48;
-    static constexpr uint64_t kBitWidth = 16;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
-
-  struct BADDR {
-    using DataType = uint64_t;
-    static constexpr uint64_t kBitOffset = 1;
-    static constexpr uint64_t kBitWidth = 47;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct ASID : public BitField<uint16_t, 48, 16> {};
 
-  struct CnP {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
+  struct BADDR : public BitField<uint64_t, 1, 47> {};
 
+  struct CnP : public BitField<bool, 0, 1> {
     /// No meaning to Common not Private.
     static constexpr bool kNotPrivate = false;
     /// Common not Private.
     static constexpr bool kCommon = true;
   };
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, TTBR1_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr TTBR1_EL1, %0" : : "r"(value) :);
+  }
 };
 
 /**
@@ -388,55 +424,33 @@ struct TCR_EL1Info : public RegInfoBase {
   /// 64KB granule for TTBR1_EL1
   static constexpr uint8_t kTG1_64KB = 0b11;
 
-  struct IPS {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 32;
-    static constexpr uint64_t kBitWidth = 3;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  /// [36] AS: ASID 位宽，0 为 8 位，1 为 16 位
+  struct AS : public BitField<bool, 36, 1> {};
 
-  struct TG1 {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 30;
-    static constexpr uint64_t kBitWidth = 2;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct IPS : public BitField<uint8_t, 32, 3> {};
 
-  struct T1SZ {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 16;
-    static constexpr uint64_t kBitWidth = 6;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct TG1 : public BitField<uint8_t, 30, 2> {};
 
-  struct TG0 {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 14;
-    static constexpr uint64_t kBitWidth = 2;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  /// [22] A1: 0 使用 TTBR0_EL1.ASID，1 使用 TTBR1_EL1.ASID
+  struct A1 : public BitField<bool, 22, 1> {};
 
-  struct T0SZ {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 6;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct T1SZ : public BitField<uint8_t, 16, 6> {};
+
+  struct TG0 : public BitField<uint8_t, 14, 2> {};
+
+  struct T0SZ : public BitField<uint8_t, 0, 6> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, TCR_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr TCR_EL1, %0" : : "r"(value) :);
+  }
 };
 
 /**
@@ -485,85 +499,33 @@ struct MAIR_EL1Info : public RegInfoBase {
   /// 写回缓存，读写时都分配缓存行，性能最优
   static constexpr uint8_t kNormalWriteBackReadWriteAlloc = 0xFF;
 
-  struct Aff7 {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 56;
-    static constexpr uint64_t kBitWidth = 8;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Aff7 : public BitField<uint8_t, 56, 8> {};
 
-  struct Aff6 {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 48;
-    static constexpr uint64_t kBitWidth = 8;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Aff6 : public BitField<uint8_t, 48, 8> {};
 
-  struct Aff5 {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 40;
-    static constexpr uint64_t kBitWidth = 8;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Aff5 : public BitField<uint8_t, 40, 8> {};
 
-  struct Aff4 {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 32;
-    static constexpr uint64_t kBitWidth = 8;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Aff4 : public BitField<uint8_t, 32, 8> {};
 
-  struct Aff3 {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 24;
-    static constexpr uint64_t kBitWidth = 8;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Aff3 : public BitField<uint8_t, 24, 8> {};
 
-  struct Aff2 {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 16;
-    static constexpr uint64_t kBitWidth = 8;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Aff2 : public BitField<uint8_t, 16, 8> {};
 
-  struct Aff1 {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 8;
-    static constexpr uint64_t kBitWidth = 8;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Aff1 : public BitField<uint8_t, 8, 8> {};
 
-  struct Aff0 {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 8;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Aff0 : public BitField<uint8_t, 0, 8> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, MAIR_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr MAIR_EL1, %0" : : "r"(value) :);
+  }
 };
 
 /**
@@ -572,50 +534,38 @@ struct MAIR_EL1Info : public RegInfoBase {
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/SCTLR-EL1--System-Control-Register--EL1-
  */
 struct SCTLR_EL1Info : public RegInfoBase {
-  struct M {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-
+  struct M : public BitField<bool, 0, 1> {
     // EL1&0 stage 1 address translation disabled.
     static constexpr bool KDisabled = false;
     // EL1&0 stage 1 address translation enabled.
     static constexpr bool kEnabled = true;
   };
 
-  struct C {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 2;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-
+  struct C : public BitField<bool, 2, 1> {
     // Stage 1 data caching disabled.
     static constexpr bool kDisabled = false;
     // Stage 1 data caching enabled.
     static constexpr bool kEnabled = true;
   };
 
-  struct I {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 12;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-
+  struct I : public BitField<bool, 12, 1> {
     // Instruction caching disabled.
     static constexpr bool kDisabled = false;
     // Instruction caching enabled.
     static constexpr bool kEnabled = true;
   };
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, SCTLR_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr SCTLR_EL1, %0" : : "r"(value) :);
+  }
 };
 
 /**
@@ -624,35 +574,23 @@ struct SCTLR_EL1Info : public RegInfoBase {
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/ESR-EL1--Exception-Syndrome-Register--EL1-
  */
 struct ESR_EL1Info : public RegInfoBase {
-  struct ISS2 {
-    using DataType = uint32_t;
-    static constexpr uint64_t kBitOffset = 32;
-    static constexpr uint64_t kBitWidth = 24;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct ISS2 : public BitField<uint32_t, 32, 24> {};
 
-  struct EC {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 26;
-    static constexpr uint64_t kBitWidth = 6;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct EC : public BitField<uint8_t, 26, 6> {};
 
-  struct ISS {
-    using DataType = uint32_t;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 25;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct ISS : public BitField<uint32_t, 0, 25> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, ESR_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr ESR_EL1, %0" : : "r"(value) :);
+  }
 };
 
 /**
@@ -661,50 +599,38 @@ struct ESR_EL1Info : public RegInfoBase {
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/CNTV-CTL-EL0--Counter-timer-Virtual-Timer-Control-Register
  */
 struct CNTV_CTL_EL0Info : public RegInfoBase {
-  struct ISTATUS {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 2;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-
+  struct ISTATUS : public BitField<bool, 2, 1> {
     /// Timer condition is not met.
     static constexpr bool KNotMet = false;
     /// Timer condition is met.
     static constexpr bool KMet = true;
   };
 
-  struct IMASK {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 1;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-
+  struct IMASK : public BitField<bool, 1, 1> {
     /// Timer interrupt is not masked by the IMASK bit.
     static constexpr bool KNotMasked = false;
     /// Timer interrupt is masked by the IMASK bit.
     static constexpr bool KMasked = true;
   };
 
-  struct ENABLE {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-
+  struct ENABLE : public BitField<bool, 0, 1> {
     /// Timer disabled.
     static constexpr bool KDisable = false;
     /// Timer enabled.
     static constexpr bool KEnable = true;
   };
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, CNTV_CTL_EL0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr CNTV_CTL_EL0, %0" : : "r"(value) :);
+  }
 };
 
 /**
@@ -713,15 +639,19 @@ struct CNTV_CTL_EL0Info : public RegInfoBase {
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/CNTV-TVAL-EL0--Counter-timer-Virtual-Timer-TimerValue-Register
  */
 struct CNTV_TVAL_EL0Info : public RegInfoBase {
-  struct TimerValue {
-    using DataType = uint32_t;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 32;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct TimerValue : public BitField<uint32_t, 0, 32> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, CNTV_TVAL_EL0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr CNTV_TVAL_EL0, %0" : : "r"(value) :);
+  }
 };
 
 /**
@@ -729,14 +659,33 @@ struct CNTV_TVAL_EL0Info : public RegInfoBase {
  * @see
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/FAR-EL1--Fault-Address-Register--EL1-
  */
-struct FAR_EL1Info : public RegInfoBase {};
+struct FAR_EL1Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, FAR_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr FAR_EL1, %0" : : "r"(value) :);
+  }
+};
 
 /**
  * @brief CNTVCT_EL0 寄存器定义
  * @see
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/CNTVCT-EL0--Counter-timer-Virtual-Count-Register
  */
-struct CNTVCT_EL0Info : public RegInfoBase {};
+struct CNTVCT_EL0Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, CNTVCT_EL0" : "=r"(value) : :);
+    return value;
+  }
+};
 
 /**
  * @brief CNTFRQ_EL0 寄存器定义
@@ -745,6 +694,18 @@ struct CNTVCT_EL0Info : public RegInfoBase {};
  */
 struct CNTFRQ_EL0Info : public RegInfoBase {
   using DataType = uint32_t;
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, CNTFRQ_EL0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr CNTFRQ_EL0, %0" : : "r"(value) :);
+  }
 };
 
 /**
@@ -753,15 +714,19 @@ struct CNTFRQ_EL0Info : public RegInfoBase {
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/ICC-PMR-EL1--Interrupt-Controller-Interrupt-Priority-Mask-Register
  */
 struct ICC_PMR_EL1Info : public RegInfoBase {
-  struct Priority {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 8;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Priority : public BitField<uint8_t, 0, 8> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, ICC_PMR_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr ICC_PMR_EL1, %0" : : "r"(value) :);
+  }
 };
 
 /**
@@ -770,21 +735,25 @@ struct ICC_PMR_EL1Info : public RegInfoBase {
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/ICC-IGRPEN1-EL1--Interrupt-Controller-Interrupt-Group-1-Enable-Register
  */
 struct ICC_IGRPEN1_EL1Info : public RegInfoBase {
-  struct Enable {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-
+  struct Enable : public BitField<bool, 0, 1> {
     /// Group 1 interrupts are disabled for the current Security state.
     static constexpr bool kDisabel = false;
 
     /// Group 1 interrupts are enabled for the current Security state.
     static constexpr bool kEnabel = true;
   };
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, ICC_IGRPEN1_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr ICC_IGRPEN1_EL1, %0" : : "r"(value) :);
+  }
 };
 
 /**
@@ -793,15 +762,7 @@ struct ICC_IGRPEN1_EL1Info : public RegInfoBase {
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/ICC-SRE-EL1--Interrupt-Controller-System-Register-Enable-Register--EL1-
  */
 struct ICC_SRE_EL1Info : public RegInfoBase {
-  struct DIB {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 2;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-
+  struct DIB : public BitField<bool, 2, 1> {
     /// IRQ bypass enabled.
     static constexpr bool kEnabel = false;
 
@@ -809,15 +770,7 @@ struct ICC_SRE_EL1Info : public RegInfoBase {
     static constexpr bool kDisabel = true;
   };
 
-  struct DFB {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 1;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-
+  struct DFB : public BitField<bool, 1, 1> {
     /// FIQ bypass enabled.
     static constexpr bool kEnabel = false;
 
@@ -825,15 +778,7 @@ struct ICC_SRE_EL1Info : public RegInfoBase {
     static constexpr bool kDisabel = true;
   };
 
-  struct SRE {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct SRE : public BitField<bool, 0, 1> {};
 
   /// The memory-mapped interface must be used. Access at EL1 to any ICC_*
   /// System register other than ICC_SRE_EL1 is trapped to EL1.
@@ -841,6 +786,18 @@ struct ICC_SRE_EL1Info : public RegInfoBase {
 
   /// The System register interface for the current Security state is enabled.
   static constexpr bool kEnabel = true;
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, ICC_SRE_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr ICC_SRE_EL1, %0" : : "r"(value) :);
+  }
 };
 
 /**
@@ -849,15 +806,14 @@ struct ICC_SRE_EL1Info : public RegInfoBase {
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/ICC-IAR1-EL1--Interrupt-Controller-Interrupt-Acknowledge-Register-1
  */
 struct ICC_IAR1_EL1Info : public RegInfoBase {
-  struct INTID {
-    using DataType = uint32_t;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 24;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct INTID : public BitField<uint32_t, 0, 24> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, ICC_IAR1_EL1" : "=r"(value) : :);
+    return value;
+  }
 };
 
 /**
@@ -866,21 +822,18 @@ struct ICC_IAR1_EL1Info : public RegInfoBase {
  * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/ICC-EOIR1-EL1--Interrupt-Controller-End-Of-Interrupt-Register-1
  */
 struct ICC_EOIR1_EL1Info : public RegInfoBase {
-  struct INTID {
-    using DataType = uint32_t;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 24;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-
+  struct INTID : public BitField<uint32_t, 0, 24> {
     /// Group 1 interrupts are disabled for the current Security state.
     static constexpr bool kDisabel = false;
 
     /// Group 1 interrupts are enabled for the current Security state.
     static constexpr bool kEnabel = true;
   };
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr ICC_EOIR1_EL1, %0" : : "r"(value) :);
+  }
 };
 
 /**
@@ -892,36 +845,13 @@ struct ICC_SGI1R_EL1Info : public RegInfoBase {
   using DataType = uint64_t;
   
   /// [55:48] Aff3: Affinity level 3
-  struct Aff3 {
-    using DataType = uint64_t;
-    static constexpr uint64_t kBitOffset = 48;
-    static constexpr uint64_t kBitWidth = 8;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Aff3 : public BitField<uint64_t, 48, 8> {};
   
   /// [47:44] RS: RangeSelector
-  struct RS {
-    using DataType = uint64_t;
-    static constexpr uint64_t kBitOffset = 44;
-    static constexpr uint64_t kBitWidth = 4;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct RS : public BitField<uint64_t, 44, 4> {};
   
   /// [40] IRM: Interrupt Routing Mode
-  struct IRM {
-    using DataType = uint64_t;
-    static constexpr uint64_t kBitOffset = 40;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
+  struct IRM : public BitField<uint64_t, 40, 1> {
     
     /// Route to specific PEs
     static constexpr uint64_t kSpecific = 0;
@@ -930,48 +860,437 @@ struct ICC_SGI1R_EL1Info : public RegInfoBase {
   };
   
   /// [39:32] Aff2: Affinity level 2
-  struct Aff2 {
-    using DataType = uint64_t;
-    static constexpr uint64_t kBitOffset = 32;
-    static constexpr uint64_t kBitWidth = 8;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Aff2 : public BitField<uint64_t, 32, 8> {};
   
   /// [27:24] INTID: Interrupt ID (SGI 0-15)
-  struct INTID {
-    using DataType = uint64_t;
-    static constexpr uint64_t kBitOffset = 24;
-    static constexpr uint64_t kBitWidth = 4;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct INTID : public BitField<uint64_t, 24, 4> {};
   
   /// [23:16] Aff1: Affinity level 1
-  struct Aff1 {
-    using DataType = uint64_t;
-    static constexpr uint64_t kBitOffset = 16;
-    static constexpr uint64_t kBitWidth = 8;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Aff1 : public BitField<uint64_t, 16, 8> {};
   
   /// [15:0] TargetList: Target list
-  struct TargetList {
-    using DataType = uint64_t;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 16;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct TargetList : public BitField<uint64_t, 0, 16> {};
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr ICC_SGI1R_EL1, %0" : : "r"(value) :);
+  }
+};
+
+/**
+ * @brief ID_AA64ISAR0_EL1 寄存器定义
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/ID-AA64ISAR0-EL1--AArch64-Instruction-Set-Attribute-Register-0
+ */
+struct ID_AA64ISAR0_EL1Info : public RegInfoBase {
+  /// 支持外部共享 TLB 维护指令
+  static constexpr uint8_t kTlbOuterShareable = 0b0001;
+  /// 支持外部共享以及范围 TLB 维护指令 (FEAT_TLBIRANGE)
+  static constexpr uint8_t kTlbRange = 0b0010;
+
+  /// [59:56] TLB: TLB 维护指令支持情况
+  struct TLB : public BitField<uint8_t, 56, 4> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, ID_AA64ISAR0_EL1" : "=r"(value) : :);
+    return value;
+  }
+};
+
+/**
+ * @brief ID_AA64MMFR0_EL1 寄存器定义
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/ID-AA64MMFR0-EL1--AArch64-Memory-Model-Feature-Register-0
+ */
+struct ID_AA64MMFR0_EL1Info : public RegInfoBase {
+  /// 8 位 ASID
+  static constexpr uint8_t kAsid8Bits = 0b0000;
+  /// 16 位 ASID
+  static constexpr uint8_t kAsid16Bits = 0b0010;
+
+  /// [7:4] ASIDBits: 支持的 ASID 位数
+  struct ASIDBits : public BitField<uint8_t, 4, 4> {};
+
+  /// [3:0] PARange: 支持的物理地址位数
+  struct PARange : public BitField<uint8_t, 0, 4> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, ID_AA64MMFR0_EL1" : "=r"(value) : :);
+    return value;
+  }
+};
+
+/**
+ * @brief TPIDR_EL1 寄存器定义
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/TPIDR-EL1--EL1-Software-Thread-ID-Register
+ */
+struct TPIDR_EL1Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, TPIDR_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr TPIDR_EL1, %0" : : "r"(value) :);
+  }
+};
+
+/**
+ * @brief CNTV_CVAL_EL0 寄存器定义
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/CNTV-CVAL-EL0--Counter-timer-Virtual-Timer-CompareValue-Register
+ */
+struct CNTV_CVAL_EL0Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, CNTV_CVAL_EL0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr CNTV_CVAL_EL0, %0" : : "r"(value) :);
+  }
+};
+
+/**
+ * @brief ID_AA64PFR0_EL1 寄存器定义
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/ID-AA64PFR0-EL1--AArch64-Processor-Feature-Register-0
+ */
+struct ID_AA64PFR0_EL1Info : public RegInfoBase {
+  /// 浮点支持，0xF 表示未实现
+  struct Fp : public BitField<uint8_t, 16, 4> {};
+
+  /// Advanced SIMD 支持，0xF 表示未实现
+  struct AdvSimd : public BitField<uint8_t, 20, 4> {};
+
+  /// SVE 支持，非 0 表示已实现
+  struct Sve : public BitField<uint8_t, 32, 4> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, ID_AA64PFR0_EL1" : "=r"(value) : :);
+    return value;
+  }
+};
+
+/**
+ * @brief CNTKCTL_EL1 寄存器定义
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/CNTKCTL-EL1--Counter-timer-Kernel-Control-Register
+ */
+struct CNTKCTL_EL1Info : public RegInfoBase {
+  /// 启用事件流
+  struct Evnten : public BitField<bool, 2, 1> {};
+
+  /// 0: Evnti 选中的位由 0 变 1 时产生事件
+  struct Evntdir : public BitField<bool, 3, 1> {};
+
+  /// 产生事件的虚拟计数器位
+  struct Evnti : public BitField<uint8_t, 4, 4> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, CNTKCTL_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr CNTKCTL_EL1, %0" : : "r"(value) :);
+  }
+};
+
+/**
+ * @brief PMCR_EL0 寄存器定义
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/PMCR-EL0--Performance-Monitors-Control-Register
+ */
+struct PMCR_EL0Info : public RegInfoBase {
+  /// 启用所有计数器
+  struct E : public BitField<bool, 0, 1> {};
+
+  /// 写 1 清零所有事件计数器
+  struct P : public BitField<bool, 1, 1> {};
+
+  /// 写 1 清零周期计数器
+  struct C : public BitField<bool, 2, 1> {};
+
+  /// 周期计数器在 64 位溢出
+  struct LC : public BitField<bool, 6, 1> {};
+
+  /// 事件计数器数量
+  struct N : public BitField<uint8_t, 11, 5> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, PMCR_EL0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr PMCR_EL0, %0" : : "r"(value) :);
+  }
+};
+
+/**
+ * @brief PMCNTENSET_EL0 寄存器定义
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/PMCNTENSET-EL0--Performance-Monitors-Count-Enable-Set-Register
+ */
+struct PMCNTENSET_EL0Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, PMCNTENSET_EL0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr PMCNTENSET_EL0, %0" : : "r"(value) :);
+  }
+};
+
+/**
+ * @brief PMCNTENCLR_EL0 寄存器定义
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/PMCNTENCLR-EL0--Performance-Monitors-Count-Enable-Clear-Register
+ */
+struct PMCNTENCLR_EL0Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, PMCNTENCLR_EL0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr PMCNTENCLR_EL0, %0" : : "r"(value) :);
+  }
+};
+
+/**
+ * @brief PMOVSCLR_EL0 寄存器定义
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/PMOVSCLR-EL0--Performance-Monitors-Overflow-Flag-Status-Clear-Register
+ */
+struct PMOVSCLR_EL0Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, PMOVSCLR_EL0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr PMOVSCLR_EL0, %0" : : "r"(value) :);
+  }
+};
+
+/**
+ * @brief PMINTENSET_EL1 寄存器定义
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/PMINTENSET-EL1--Performance-Monitors-Interrupt-Enable-Set-Register
+ */
+struct PMINTENSET_EL1Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, PMINTENSET_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr PMINTENSET_EL1, %0" : : "r"(value) :);
+  }
+};
+
+/**
+ * @brief PMINTENCLR_EL1 寄存器定义
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/PMINTENCLR-EL1--Performance-Monitors-Interrupt-Enable-Clear-Register
+ */
+struct PMINTENCLR_EL1Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, PMINTENCLR_EL1" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr PMINTENCLR_EL1, %0" : : "r"(value) :);
+  }
+};
+
+/**
+ * @brief PMSELR_EL0 寄存器定义
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/PMSELR-EL0--Performance-Monitors-Event-Counter-Selection-Register
+ */
+struct PMSELR_EL0Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, PMSELR_EL0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr PMSELR_EL0, %0" : : "r"(value) :);
+  }
+};
+
+/**
+ * @brief PMXEVTYPER_EL0 寄存器定义
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/PMXEVTYPER-EL0--Performance-Monitors-Selected-Event-Type-Register
+ */
+struct PMXEVTYPER_EL0Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, PMXEVTYPER_EL0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr PMXEVTYPER_EL0, %0" : : "r"(value) :);
+  }
+};
+
+/**
+ * @brief PMXEVCNTR_EL0 寄存器定义
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/PMXEVCNTR-EL0--Performance-Monitors-Selected-Event-Count-Register
+ */
+struct PMXEVCNTR_EL0Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, PMXEVCNTR_EL0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr PMXEVCNTR_EL0, %0" : : "r"(value) :);
+  }
+};
+
+/**
+ * @brief PMCCNTR_EL0 寄存器定义
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/PMCCNTR-EL0--Performance-Monitors-Cycle-Count-Register
+ */
+struct PMCCNTR_EL0Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, PMCCNTR_EL0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr PMCCNTR_EL0, %0" : : "r"(value) :);
+  }
+};
+
+/**
+ * @brief PMCCFILTR_EL0 寄存器定义
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/PMCCFILTR-EL0--Performance-Monitors-Cycle-Count-Filter-Register
+ */
+struct PMCCFILTR_EL0Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, PMCCFILTR_EL0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr PMCCFILTR_EL0, %0" : : "r"(value) :);
+  }
+};
+
+/**
+ * @brief PMUSERENR_EL0 寄存器定义
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/PMUSERENR-EL0--Performance-Monitors-User-Enable-Register
+ */
+struct PMUSERENR_EL0Info : public RegInfoBase {
+  /// 允许 EL0 访问性能监控寄存器
+  struct EN : public BitField<bool, 0, 1> {};
+
+  /// 允许 EL0 读周期计数器
+  struct CR : public BitField<bool, 2, 1> {};
+
+  /// 允许 EL0 读事件计数器
+  struct ER : public BitField<bool, 3, 1> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, PMUSERENR_EL0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("msr PMUSERENR_EL0, %0" : : "r"(value) :);
+  }
+};
+
+/**
+ * @brief CTR_EL0 寄存器定义 (缓存类型寄存器)
+ * @see
+ * https://developer.arm.com/documentation/ddi0601/2024-12/AArch64-Registers/CTR-EL0--Cache-Type-Register
+ */
+struct CTR_EL0Info : public RegInfoBase {
+  using DataType = uint64_t;
+
+  /// 指令缓存最小行大小，log2(字数)
+  struct IminLine : public BitField<uint8_t, 0, 4> {};
+
+  /// 数据缓存最小行大小，log2(字数)
+  struct DminLine : public BitField<uint8_t, 16, 4> {};
+
+  /// 写入 PoU 不需要清理数据缓存
+  struct IDC : public BitField<bool, 28, 1> {};
+
+  /// 写入 PoU 不需要失效指令缓存
+  struct DIC : public BitField<bool, 29, 1> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mrs %0, CTR_EL0" : "=r"(value) : :);
+    return value;
+  }
 };
 
 }  // namespace system_reg
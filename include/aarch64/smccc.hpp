@@ -0,0 +1,244 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_AARCH64_SMCCC_HPP_
+#define CPU_IO_INCLUDE_AARCH64_SMCCC_HPP_
+
+#include <cstdint>
+
+/**
+ * aarch64 cpu 相关定义
+ * @note 寄存器读写设计见 arch/README.md
+ */
+namespace cpu_io {
+
+/**
+ * @brief SMC 调用返回值
+ */
+struct SMCReturnValue {
+  uint64_t a0;
+  uint64_t a1;
+  uint64_t a2;
+  uint64_t a3;
+};
+
+/**
+ * @brief SMCCC 调用指令
+ * 默认为 SMC，定义 CPU_IO_AARCH64_SMCCC_HVC 时为 HVC，
+ * 运行时可根据设备树 psci 节点的 method 或 ACPI FADT 的
+ * PSCI_USE_HVC 通过 InitSmccc() 选择
+ */
+enum class SmcccConduit {
+  /// smc #0，直接调用安全固件
+  kSmc,
+  /// hvc #0，运行在虚拟机中时由虚拟机监控器处理
+  kHvc,
+};
+
+/**
+ * @brief SMC 调用约定 (SMCCC) 接口
+ * @see https://developer.arm.com/documentation/den0028/latest
+ */
+namespace smccc {
+static constexpr uint64_t kVERSION = 0x80000000;
+static constexpr uint64_t kARCH_FEATURES = 0x80000001;
+static constexpr uint64_t kARCH_SOC_ID = 0x80000002;
+
+/// SMCCC 1.0，版本号为 major << 16 | minor
+static constexpr int32_t kVersion1_0 = 0x10000;
+/// SMCCC 1.1，之后的快速调用保留 x4~x17
+static constexpr int32_t kVersion1_1 = 0x10001;
+
+/// 错误码
+enum ErrorCode {
+  SUCCESS = 0,
+  NOT_SUPPORTED = -1,
+  NOT_REQUIRED = -2,
+  INVALID_PARAMETER = -3,
+};
+}  // namespace smccc
+
+namespace detail::smccc {
+/// 当前的调用指令
+#ifdef CPU_IO_AARCH64_SMCCC_HVC
+inline SmcccConduit conduit = SmcccConduit::kHvc;
+#else
+inline SmcccConduit conduit = SmcccConduit::kSmc;
+#endif
+/// InitSmccc() 读取的版本，0 表示尚未读取，按 1.0 处理
+inline int32_t version = 0;
+
+/**
+ * @brief 按 SMCCC 1.0 调用，x4~x17 可能被破坏
+ * @tparam kConduit 调用指令
+ * @return SMCReturnValue x0~x3
+ */
+template <SmcccConduit kConduit>
+static __always_inline auto Call(uint64_t a0, uint64_t a1, uint64_t a2,
+                                 uint64_t a3, uint64_t a4, uint64_t a5,
+                                 uint64_t a6, uint64_t a7) -> SMCReturnValue {
+  register uint64_t x0 __asm__("x0") = a0;
+  register uint64_t x1 __asm__("x1") = a1;
+  register uint64_t x2 __asm__("x2") = a2;
+  register uint64_t x3 __asm__("x3") = a3;
+  register uint64_t x4 __asm__("x4") = a4;
+  register uint64_t x5 __asm__("x5") = a5;
+  register uint64_t x6 __asm__("x6") = a6;
+  register uint64_t x7 __asm__("x7") = a7;
+
+  if constexpr (kConduit == SmcccConduit::kHvc) {
+    __asm__ volatile("hvc #0"
+                     : "+r"(x0), "+r"(x1), "+r"(x2), "+r"(x3), "+r"(x4),
+                       "+r"(x5), "+r"(x6), "+r"(x7)
+                     :
+                     : "x8", "x9", "x10", "x11", "x12", "x13", "x14", "x15",
+                       "x16", "x17", "memory");
+  } else {
+    __asm__ volatile("smc #0"
+                     : "+r"(x0), "+r"(x1), "+r"(x2), "+r"(x3), "+r"(x4),
+                       "+r"(x5), "+r"(x6), "+r"(x7)
+                     :
+                     : "x8", "x9", "x10", "x11", "x12", "x13", "x14", "x15",
+                       "x16", "x17", "memory");
+  }
+  return {x0, x1, x2, x3};
+}
+
+/**
+ * @brief 按 SMCCC 1.1 快速调用，只修改 x0~x3
+ * @tparam kConduit 调用指令
+ * @return SMCReturnValue x0~x3
+ */
+template <SmcccConduit kConduit>
+static __always_inline auto FastCall(uint64_t a0, uint64_t a1, uint64_t a2,
+                                     uint64_t a3) -> SMCReturnValue {
+  register uint64_t x0 __asm__("x0") = a0;
+  register uint64_t x1 __asm__("x1") = a1;
+  register uint64_t x2 __asm__("x2") = a2;
+  register uint64_t x3 __asm__("x3") = a3;
+
+  if constexpr (kConduit == SmcccConduit::kHvc) {
+    __asm__ volatile("hvc #0"
+                     : "+r"(x0), "+r"(x1), "+r"(x2), "+r"(x3)
+                     :
+                     : "memory");
+  } else {
+    __asm__ volatile("smc #0"
+                     : "+r"(x0), "+r"(x1), "+r"(x2), "+r"(x3)
+                     :
+                     : "memory");
+  }
+  return {x0, x1, x2, x3};
+}
+}  // namespace detail::smccc
+
+/**
+ * @brief 调用固件，x0~x7 为参数，x4~x17 可能被破坏
+ * @param a0 功能号
+ * @param a1 参数1
+ * @param a2 参数2
+ * @param a3 参数3
+ * @param a4 参数4
+ * @param a5 参数5
+ * @param a6 参数6
+ * @param a7 参数7
+ * @return SMCReturnValue 返回值
+ */
+static __always_inline auto SmcccCall(uint64_t a0, uint64_t a1, uint64_t a2,
+                                      uint64_t a3, uint64_t a4, uint64_t a5,
+                                      uint64_t a6, uint64_t a7)
+    -> SMCReturnValue {
+  if (detail::smccc::conduit == SmcccConduit::kHvc) {
+    return detail::smccc::Call<SmcccConduit::kHvc>(a0, a1, a2, a3, a4, a5, a6,
+                                                   a7);
+  }
+  return detail::smccc::Call<SmcccConduit::kSmc>(a0, a1, a2, a3, a4, a5, a6,
+                                                 a7);
+}
+
+/**
+ * @brief 快速调用固件，最多 3 个参数
+ * SMCCC 1.1 及之后只修改 x0~x3，编译器可以在调用前后保留其它寄存器；
+ * 尚未 InitSmccc() 或固件为 1.0 时按 SmcccCall() 调用
+ * @param function_id 功能号
+ * @param a1 参数1
+ * @param a2 参数2
+ * @param a3 参数3
+ * @return SMCReturnValue 返回值
+ */
+static __always_inline auto SmcccFastCall(uint64_t function_id,
+                                          uint64_t a1 = 0, uint64_t a2 = 0,
+                                          uint64_t a3 = 0) -> SMCReturnValue {
+  if (detail::smccc::version < smccc::kVersion1_1) [[unlikely]] {
+    return SmcccCall(function_id, a1, a2, a3, 0, 0, 0, 0);
+  }
+  if (detail::smccc::conduit == SmcccConduit::kHvc) {
+    return detail::smccc::FastCall<SmcccConduit::kHvc>(function_id, a1, a2,
+                                                       a3);
+  }
+  return detail::smccc::FastCall<SmcccConduit::kSmc>(function_id, a1, a2, a3);
+}
+
+/**
+ * @brief 调用安全监控
+ * @param a0 参数0
+ * @param a1 参数1
+ * @param a2 参数2
+ * @param a3 参数3
+ * @param a4 参数4
+ * @param a5 参数5
+ * @param a6 参数6
+ * @param a7 参数7
+ * @return SMCReturnValue 返回值
+ * @note 使用 InitSmccc() 选择的调用指令，与 SmcccCall() 相同
+ */
+static __always_inline auto SecureMonitorCall(uint64_t a0, uint64_t a1,
+                                              uint64_t a2, uint64_t a3,
+                                              uint64_t a4, uint64_t a5,
+                                              uint64_t a6, uint64_t a7)
+    -> const SMCReturnValue {
+  return SmcccCall(a0, a1, a2, a3, a4, a5, a6, a7);
+}
+
+/**
+ * @brief 选择调用指令并读取 SMCCC 版本，之后的快速调用只修改 x0~x3
+ * @param conduit 调用指令
+ * @return int32_t 版本号，major << 16 | minor
+ */
+static __always_inline auto InitSmccc(SmcccConduit conduit) -> int32_t {
+  detail::smccc::conduit = conduit;
+  // SMCCC 1.0 的固件对未知功能号返回 NOT_SUPPORTED
+  auto version =
+      static_cast<int32_t>(SmcccCall(smccc::kVERSION, 0, 0, 0, 0, 0, 0, 0).a0);
+  detail::smccc::version = (version < 0) ? smccc::kVersion1_0 : version;
+  return detail::smccc::version;
+}
+
+/**
+ * @brief 获取 InitSmccc() 读取的 SMCCC 版本
+ * @return int32_t 版本号，尚未读取时为 0
+ */
+static __always_inline auto GetSmcccVersion() -> int32_t {
+  return detail::smccc::version;
+}
+
+/**
+ * @brief 查询固件是否实现了 SMCCC 架构功能 (如漏洞缓解)
+ * @param function_id 功能号
+ * @return int32_t 不小于 0 表示已实现 (含义由功能定义)，
+ * 否则为 smccc::ErrorCode
+ * @note 需要 SMCCC 1.1
+ */
+static __always_inline auto SmcccArchFeatures(uint64_t function_id)
+    -> int32_t {
+  if (detail::smccc::version < smccc::kVersion1_1) {
+    return smccc::NOT_SUPPORTED;
+  }
+  return static_cast<int32_t>(
+      SmcccFastCall(smccc::kARCH_FEATURES, function_id).a0);
+}
+
+}  // namespace cpu_io
+
+#endif  // CPU_IO_INCLUDE_AARCH64_SMCCC_HPP_
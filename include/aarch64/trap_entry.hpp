@@ -0,0 +1,196 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_AARCH64_TRAP_ENTRY_HPP_
+#define CPU_IO_INCLUDE_AARCH64_TRAP_ENTRY_HPP_
+
+#include <sys/cdefs.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "context.hpp"
+#include "regs.hpp"
+
+/**
+ * @brief 完整现场的异常入口，由内核定义
+ * 向量表把对应类别的异常转到这里，进入时的寄存器与直接放在向量表中时
+ * 完全相同，来源 (EL0/EL1、SP_EL0/SP_EL1、AArch32) 可由 SPSR_EL1.M 区分
+ * @{
+ */
+extern "C" void cpu_io_aarch64_sync_entry();
+extern "C" void cpu_io_aarch64_irq_entry();
+extern "C" void cpu_io_aarch64_fiq_entry();
+extern "C" void cpu_io_aarch64_serror_entry();
+/// @}
+
+namespace cpu_io {
+
+static_assert(offsetof(IrqFrame, x0) == 0);
+static_assert(offsetof(IrqFrame, x16) == 128);
+static_assert(offsetof(IrqFrame, x18) == 144);
+static_assert(offsetof(IrqFrame, x29) == 152);
+static_assert(offsetof(IrqFrame, x30) == 160);
+static_assert(offsetof(IrqFrame, elr_el1) == 168);
+static_assert(offsetof(IrqFrame, spsr_el1) == 176);
+static_assert(offsetof(IrqFrame, intid) == 184);
+
+/**
+ * @brief 快速路径的 IRQ 处理函数
+ * @param frame 被打断时的调用者保存寄存器，修改后在返回时生效
+ * @param intid 已由入口确认的中断号，返回后由入口写 ICC_EOIR1_EL1
+ * @note 在屏蔽 IRQ 的状态下运行，不能解除屏蔽；
+ * 不能使用 SIMD/浮点寄存器 (以 -mgeneral-regs-only 编译)
+ */
+using IrqHandler = void (*)(IrqFrame *frame, uint32_t intid);
+
+namespace detail::trap {
+
+/**
+ * @brief 未设置处理函数时的默认处理，只由入口结束中断
+ */
+inline void IgnoreIrq(IrqFrame *, uint32_t) {}
+
+/// 快速路径的处理函数，入口汇编以固定的符号名访问
+[[gnu::used]] inline IrqHandler irq_handler __asm__(
+    "cpu_io_aarch64_irq_handler") = IgnoreIrq;
+
+}  // namespace detail::trap
+
+/**
+ * @brief 从 EL1 (SP_EL1) 进入的 IRQ 的快速入口
+ * 在被打断的内核栈上分配 IrqFrame，只保存调用者保存的通用寄存器。
+ * 确认与分发合并在入口中：读 ICC_IAR1_EL1 后直接调用 SetIrqHandler()
+ * 设置的处理函数，写 ICC_EOIR1_EL1 后继续读 IAR，
+ * 直到没有待处理的中断 (INTID 1020-1023) 再 eret，
+ * 连续到达的中断不必重新进入异常
+ * @note 偏移与 IrqFrame 的 static_assert 一致
+ */
+void IrqEntry() __asm__("cpu_io_aarch64_irq_fast_entry");
+__attribute__((naked, noinline, used)) inline void IrqEntry() {
+  __asm__(
+      "sub sp, sp, #192\n\t"
+      "stp x0, x1, [sp, #0]\n\t"
+      "stp x2, x3, [sp, #16]\n\t"
+      "stp x4, x5, [sp, #32]\n\t"
+      "stp x6, x7, [sp, #48]\n\t"
+      "stp x8, x9, [sp, #64]\n\t"
+      "stp x10, x11, [sp, #80]\n\t"
+      "stp x12, x13, [sp, #96]\n\t"
+      "stp x14, x15, [sp, #112]\n\t"
+      "stp x16, x17, [sp, #128]\n\t"
+      "stp x18, x29, [sp, #144]\n\t"
+      "mrs x0, elr_el1\n\t"
+      "mrs x1, spsr_el1\n\t"
+      "stp x30, x0, [sp, #160]\n\t"
+      "str x1, [sp, #176]\n"
+      "1:\n\t"
+      "mrs x1, ICC_IAR1_EL1\n\t"
+      "and x1, x1, #0xffffff\n\t"
+      "dsb sy\n\t"
+      // 只有 1020-1023 表示没有待处理的中断，扩展 PPI/SPI 与 LPI 照常分发
+      "sub x2, x1, #1020\n\t"
+      "cmp x2, #3\n\t"
+      "b.ls 2f\n\t"
+      "str x1, [sp, #184]\n\t"
+      "adrp x2, cpu_io_aarch64_irq_handler\n\t"
+      "ldr x2, [x2, :lo12:cpu_io_aarch64_irq_handler]\n\t"
+      "mov x0, sp\n\t"
+      "blr x2\n\t"
+      "ldr x1, [sp, #184]\n\t"
+      "msr ICC_EOIR1_EL1, x1\n\t"
+      "isb\n\t"
+      "b 1b\n"
+      "2:\n\t"
+      "ldp x30, x0, [sp, #160]\n\t"
+      "ldr x1, [sp, #176]\n\t"
+      "msr elr_el1, x0\n\t"
+      "msr spsr_el1, x1\n\t"
+      "ldp x0, x1, [sp, #0]\n\t"
+      "ldp x2, x3, [sp, #16]\n\t"
+      "ldp x4, x5, [sp, #32]\n\t"
+      "ldp x6, x7, [sp, #48]\n\t"
+      "ldp x8, x9, [sp, #64]\n\t"
+      "ldp x10, x11, [sp, #80]\n\t"
+      "ldp x12, x13, [sp, #96]\n\t"
+      "ldp x14, x15, [sp, #112]\n\t"
+      "ldp x16, x17, [sp, #128]\n\t"
+      "ldp x18, x29, [sp, #144]\n\t"
+      "add sp, sp, #192\n\t"
+      "eret");
+}
+
+/**
+ * @brief VBAR_EL1 向量表，16 项，每项 128 字节
+ * 当前 EL 使用 SP_EL1 时的 IRQ 转到 IrqEntry()，其余各项按类别
+ * (同步/IRQ/FIQ/SError) 转到内核的完整现场入口；来自 EL0 的 IRQ
+ * 仍走完整现场，便于返回用户态前调度
+ * @note 入口需在向量表 ±128 MiB 范围内
+ */
+__attribute__((naked, noinline, aligned(2048))) inline void VectorTable() {
+  __asm__(
+      // 当前 EL，SP_EL0
+      "b cpu_io_aarch64_sync_entry\n\t"
+      ".balign 128\n\t"
+      "b cpu_io_aarch64_irq_entry\n\t"
+      ".balign 128\n\t"
+      "b cpu_io_aarch64_fiq_entry\n\t"
+      ".balign 128\n\t"
+      "b cpu_io_aarch64_serror_entry\n\t"
+      ".balign 128\n\t"
+      // 当前 EL，SP_EL1
+      "b cpu_io_aarch64_sync_entry\n\t"
+      ".balign 128\n\t"
+      "b cpu_io_aarch64_irq_fast_entry\n\t"
+      ".balign 128\n\t"
+      "b cpu_io_aarch64_fiq_entry\n\t"
+      ".balign 128\n\t"
+      "b cpu_io_aarch64_serror_entry\n\t"
+      ".balign 128\n\t"
+      // 低 EL，AArch64
+      "b cpu_io_aarch64_sync_entry\n\t"
+      ".balign 128\n\t"
+      "b cpu_io_aarch64_irq_entry\n\t"
+      ".balign 128\n\t"
+      "b cpu_io_aarch64_fiq_entry\n\t"
+      ".balign 128\n\t"
+      "b cpu_io_aarch64_serror_entry\n\t"
+      ".balign 128\n\t"
+      // 低 EL，AArch32
+      "b cpu_io_aarch64_sync_entry\n\t"
+      ".balign 128\n\t"
+      "b cpu_io_aarch64_irq_entry\n\t"
+      ".balign 128\n\t"
+      "b cpu_io_aarch64_fiq_entry\n\t"
+      ".balign 128\n\t"
+      "b cpu_io_aarch64_serror_entry\n\t"
+      ".balign 128");
+}
+
+/**
+ * @brief 设置快速路径的 IRQ 处理函数
+ * @param handler 处理函数
+ * @return bool handler 为空时返回 false
+ */
+static __always_inline auto SetIrqHandler(IrqHandler handler) -> bool {
+  if (handler == nullptr) {
+    return false;
+  }
+  __atomic_store_n(&detail::trap::irq_handler, handler, __ATOMIC_RELAXED);
+  return true;
+}
+
+/**
+ * @brief 把 VectorTable() 写入 VBAR_EL1
+ * @note 安装前应先设置处理函数，每个核心调用一次
+ */
+static __always_inline void InstallVectorTable() {
+  detail::regs::system_reg::VBAR_EL1::Write(
+      reinterpret_cast<uint64_t>(&VectorTable));
+  __asm__ volatile("isb" ::: "memory");
+}
+
+}  // namespace cpu_io
+
+#endif /* CPU_IO_INCLUDE_AARCH64_TRAP_ENTRY_HPP_ */
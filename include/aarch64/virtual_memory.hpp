@@ -12,6 +12,142 @@
 
 namespace cpu_io {
 
+namespace detail {
+
+namespace tlb {
+
+/// TLBI 操作使用的页粒度位数 (4KB)
+static constexpr uint64_t kPageShift = 12;
+/// TLBI 操作数中 ASID 的位偏移
+static constexpr uint64_t kAsidOffset = 48;
+/// TLBI 操作数中虚拟地址字段的掩码 (VA[55:12])
+static constexpr uint64_t kVaMask = (1ULL << 44) - 1;
+/// 范围 TLBI 操作数中基地址字段的掩码 (VA[48:12])
+static constexpr uint64_t kRangeBaseMask = (1ULL << 37) - 1;
+/// 范围 TLBI 操作数中的 TG 字段，0b01 表示 4KB 粒度
+static constexpr uint64_t kRangeTg4KB = 1ULL << 46;
+/// 单条范围 TLBI 指令最多能覆盖的页数 (NUM=31, SCALE=3)
+static constexpr size_t kMaxRangePages = 32ULL << 16;
+
+/// FEAT_TLBIRANGE 支持状态缓存：-1 未检测，0 不支持，1 支持
+inline int8_t tlbi_range_support = -1;
+
+/**
+ * @brief 检查是否支持范围 TLBI 指令，结果只检测一次
+ * @return true 支持 FEAT_TLBIRANGE
+ * @note ID 寄存器在虚拟化环境下可能陷入，因此缓存检测结果
+ */
+static __always_inline auto HasTlbiRange() -> bool {
+  if (tlbi_range_support < 0) {
+    auto tlb = regs::system_reg::ID_AA64ISAR0_EL1::TLB::Get();
+    tlbi_range_support =
+        (tlb >= register_info::system_reg::ID_AA64ISAR0_EL1Info::kTlbRange)
+            ? 1
+            : 0;
+  }
+  return tlbi_range_support != 0;
+}
+
+/**
+ * @brief 生成单页 TLBI 指令的操作数
+ * @param virtual_addr 虚拟地址
+ * @param asid 地址空间标识符
+ * @return uint64_t 操作数
+ */
+static __always_inline auto PageOperand(uint64_t virtual_addr, uint64_t asid)
+    -> uint64_t {
+  return ((virtual_addr >> kPageShift) & kVaMask) | (asid << kAsidOffset);
+}
+
+/**
+ * @brief 生成范围 TLBI 指令的操作数
+ * @param virtual_addr 起始虚拟地址
+ * @param asid 地址空间标识符
+ * @param scale 范围指数
+ * @param num 范围基数，覆盖 (num + 1) * 2^(5 * scale + 1) 页
+ * @return uint64_t 操作数
+ */
+static __always_inline auto RangeOperand(uint64_t virtual_addr, uint64_t asid,
+                                         uint64_t scale, uint64_t num)
+    -> uint64_t {
+  return (asid << kAsidOffset) | kRangeTg4KB | (scale << 44) | (num << 39) |
+         ((virtual_addr >> kPageShift) & kRangeBaseMask);
+}
+
+/**
+ * @brief 发出单页 TLBI，不含屏障
+ * @param virtual_addr 虚拟地址
+ * @param asid 地址空间标识符，0 表示所有 ASID
+ */
+static __always_inline void InvalidatePage(uint64_t virtual_addr,
+                                           uint64_t asid) {
+  if (asid == 0) {
+    __asm__ volatile("tlbi vaae1is, %0"
+                     :
+                     : "r"(PageOperand(virtual_addr, 0))
+                     : "memory");
+  } else {
+    __asm__ volatile("tlbi vae1is, %0"
+                     :
+                     : "r"(PageOperand(virtual_addr, asid))
+                     : "memory");
+  }
+}
+
+/**
+ * @brief 发出范围 TLBI，不含屏障
+ * @param operand 由 RangeOperand 生成的操作数
+ * @param asid 地址空间标识符，0 表示所有 ASID
+ * @note 使用 sys 编码，不依赖汇编器对 armv8.4-a 的支持
+ */
+static __always_inline void InvalidateRange(uint64_t operand, uint64_t asid) {
+  if (asid == 0) {
+    // TLBI RVAAE1IS
+    __asm__ volatile("sys #0, c8, c2, #3, %0" : : "r"(operand) : "memory");
+  } else {
+    // TLBI RVAE1IS
+    __asm__ volatile("sys #0, c8, c2, #1, %0" : : "r"(operand) : "memory");
+  }
+}
+
+/**
+ * @brief 失效连续的多个页，不含屏障
+ * @param virtual_addr 页对齐的起始虚拟地址
+ * @param page_count 页数，使用范围指令时需小于 kMaxRangePages
+ * @param asid 地址空间标识符，0 表示所有 ASID
+ * @param use_range 是否使用范围 TLBI 指令
+ * @note 范围指令每次覆盖 (num + 1) * 2^(5 * scale + 1) 页，
+ * scale 从小到大依次消去页数的低位，奇数页单独失效
+ */
+static __always_inline void InvalidatePages(uint64_t virtual_addr,
+                                            size_t page_count, uint64_t asid,
+                                            bool use_range) {
+  uint64_t scale = 0;
+  while (page_count > 0) {
+    if (!use_range || (page_count % 2) == 1) {
+      InvalidatePage(virtual_addr, asid);
+      virtual_addr += 1ULL << kPageShift;
+      page_count--;
+      continue;
+    }
+    auto num =
+        static_cast<int64_t>((page_count >> (5 * scale + 1)) & 0x1F) - 1;
+    if (num >= 0) {
+      auto pages = static_cast<size_t>(num + 1) << (5 * scale + 1);
+      InvalidateRange(
+          RangeOperand(virtual_addr, asid, scale, static_cast<uint64_t>(num)),
+          asid);
+      virtual_addr += static_cast<uint64_t>(pages) << kPageShift;
+      page_count -= pages;
+    }
+    scale++;
+  }
+}
+
+}  // namespace tlb
+
+}  // namespace detail
+
 namespace virtual_memory {
 /// 页表项位偏移定义
 static constexpr uint8_t kValidOffset = 0;
@@ -46,6 +182,10 @@ static constexpr size_t kKernelOffset = 0x0;
 
 /// 页表项属性位数
 static constexpr size_t kPteAttributeBits = 12;
+/// 页表项输出地址掩码 [47:12]
+static constexpr uint64_t kPteAddressMask = 0x0000FFFFFFFFF000ULL;
+/// 页表项高位属性掩码 [63:50]，包括 DBM/Contiguous/PXN/UXN 与软件位
+static constexpr uint64_t kPteUpperAttributeMask = 0xFFFC000000000000ULL;
 /// 页内偏移位数
 static constexpr size_t kPageOffsetBits = 12;
 /// 虚拟页号位数
@@ -54,6 +194,8 @@ static constexpr size_t kVpnBits = 9;
 static constexpr size_t kVpnMask = 0x1FF;
 /// 页表级数（四级页表）
 static constexpr size_t kPageTableLevels = 4;
+/// FlushTLBRange 的默认阈值，超过该页数时改为整体刷新
+static constexpr size_t kFlushTLBRangeThreshold = 64;
 
 /// 页表项权限标志
 static constexpr uint64_t kPteValid = kValid;
@@ -96,6 +238,37 @@ static constexpr uint64_t kAttrNormalWt = 2ULL << kAttrIndxOffset;
 /// 普通内存，写回
 static constexpr uint64_t kAttrNormalWb = 3ULL << kAttrIndxOffset;
 
+/**
+ * @brief 内存类型，值为 ConfigureMAIR() 安装的属性索引
+ */
+enum class MemoryType : uint8_t {
+  /// 设备内存 (Device-nGnRnE)，适用于 MMIO
+  kDevice = 0,
+  /// 普通内存，非缓存，允许写合并，适用于帧缓冲与设备环形缓冲区
+  kNonCacheable = 1,
+  /// 普通内存，写透
+  kWriteThrough = 2,
+  /// 普通内存，写回
+  kWriteBack = 3,
+  /// 与 x86_64 同名的类型
+  kWriteCombining = kNonCacheable,
+  kUncached = kDevice,
+};
+
+/**
+ * @brief 获取内存类型对应的页表项标志
+ * 设备内存同时禁止执行，避免对 MMIO 的推测取指
+ * @param memory_type 内存类型
+ * @return uint64_t AttrIndx 与 PXN/UXN 的组合
+ */
+static constexpr auto GetMemoryTypeFlags(MemoryType memory_type) -> uint64_t {
+  auto flags = static_cast<uint64_t>(memory_type) << kAttrIndxOffset;
+  if (memory_type == MemoryType::kDevice) {
+    flags |= kPxn | kUxn;
+  }
+  return flags;
+}
+
 /**
  * @brief 配置内存属性间接寄存器 (MAIR_EL1)
  * @note 配置四种内存类型：
@@ -106,26 +279,23 @@ static constexpr uint64_t kAttrNormalWb = 3ULL << kAttrIndxOffset;
  */
 static __always_inline void ConfigureMAIR() {
   namespace reg_info = detail::register_info::system_reg;
-
-  // Attr0: Device-nGnRnE memory
-  // 最严格的设备内存，适用于 MMIO
-  detail::regs::system_reg::MAIR_EL1::Aff0::Write(
-      reg_info::MAIR_EL1Info::kDeviceNGnRnE);
-
-  // Attr1: Normal memory, Non-cacheable
-  // 不使用缓存，但允许内存访问重排序和合并
-  detail::regs::system_reg::MAIR_EL1::Aff1::Write(
-      reg_info::MAIR_EL1Info::kNormalNonCacheable);
-
-  // Attr2: Normal memory, Write-through, Read-allocate
-  // 写透缓存，读分配（写入时直接写入内存，读取时分配缓存行）
-  detail::regs::system_reg::MAIR_EL1::Aff2::Write(
-      reg_info::MAIR_EL1Info::kNormalWriteThroughReadAlloc);
-
-  // Attr3: Normal memory, Write-back, Read/Write-allocate
-  // 写回缓存，读写分配，性能最优，适用于普通内存访问
-  detail::regs::system_reg::MAIR_EL1::Aff3::Write(
-      reg_info::MAIR_EL1Info::kNormalWriteBackReadWriteAlloc);
+  using MAIR_EL1 = detail::regs::system_reg::MAIR_EL1;
+
+  MAIR_EL1::Modify<
+      // Attr0: Device-nGnRnE memory
+      // 最严格的设备内存，适用于 MMIO
+      MAIR_EL1::Aff0::Value(reg_info::MAIR_EL1Info::kDeviceNGnRnE),
+      // Attr1: Normal memory, Non-cacheable
+      // 不使用缓存，但允许内存访问重排序和合并
+      MAIR_EL1::Aff1::Value(reg_info::MAIR_EL1Info::kNormalNonCacheable),
+      // Attr2: Normal memory, Write-through, Read-allocate
+      // 写透缓存，读分配（写入时直接写入内存，读取时分配缓存行）
+      MAIR_EL1::Aff2::Value(
+          reg_info::MAIR_EL1Info::kNormalWriteThroughReadAlloc),
+      // Attr3: Normal memory, Write-back, Read/Write-allocate
+      // 写回缓存，读写分配，性能最优，适用于普通内存访问
+      MAIR_EL1::Aff3::Value(
+          reg_info::MAIR_EL1Info::kNormalWriteBackReadWriteAlloc)>();
 
   // 指令同步屏障，确保 MAIR 配置生效
   __asm__ volatile("isb");
@@ -146,25 +316,28 @@ static __always_inline void ConfigureMAIR() {
  */
 static __always_inline void ConfigureTCR(uint8_t t0sz = 16, uint8_t t1sz = 16) {
   namespace reg_info = detail::register_info::system_reg;
-
-  // 配置 TTBR0_EL1 的地址空间大小
-  // T0SZ = 16 表示 48 位虚拟地址空间 (2^48 = 256TB)
-  detail::regs::system_reg::TCR_EL1::T0SZ::Write(t0sz);
-
-  // 配置 TTBR1_EL1 的地址空间大小
-  // T1SZ = 16 表示 48 位虚拟地址空间
-  detail::regs::system_reg::TCR_EL1::T1SZ::Write(t1sz);
-
-  // 配置 TTBR0_EL1 页粒度为 4KB
-  detail::regs::system_reg::TCR_EL1::TG0::Write(reg_info::TCR_EL1Info::kTG_4KB);
-
-  // 配置 TTBR1_EL1 页粒度为 4KB
-  detail::regs::system_reg::TCR_EL1::TG1::Write(
-      reg_info::TCR_EL1Info::kTG1_4KB);
-
-  // 配置中间物理地址大小为 48 位 (支持 256TB 物理地址空间)
-  detail::regs::system_reg::TCR_EL1::IPS::Write(
-      reg_info::TCR_EL1Info::kIPS_48Bits);
+  using TCR_EL1 = detail::regs::system_reg::TCR_EL1;
+  using ID_AA64MMFR0_EL1 = detail::regs::system_reg::ID_AA64MMFR0_EL1;
+
+  auto asid16 = ID_AA64MMFR0_EL1::ASIDBits::Get() ==
+                reg_info::ID_AA64MMFR0_EL1Info::kAsid16Bits;
+
+  // 所有位域合并为一次读改写，减少虚拟化环境下的系统寄存器陷入
+  TCR_EL1::Modify(
+      // 配置 TTBR0_EL1 的地址空间大小
+      // T0SZ = 16 表示 48 位虚拟地址空间 (2^48 = 256TB)
+      TCR_EL1::T0SZ::Value(t0sz),
+      // 配置 TTBR1_EL1 的地址空间大小
+      // T1SZ = 16 表示 48 位虚拟地址空间
+      TCR_EL1::T1SZ::Value(t1sz),
+      // 配置 TTBR0_EL1 页粒度为 4KB
+      TCR_EL1::TG0::Value(reg_info::TCR_EL1Info::kTG_4KB),
+      // 配置 TTBR1_EL1 页粒度为 4KB
+      TCR_EL1::TG1::Value(reg_info::TCR_EL1Info::kTG1_4KB),
+      // 配置中间物理地址大小为 48 位 (支持 256TB 物理地址空间)
+      TCR_EL1::IPS::Value(reg_info::TCR_EL1Info::kIPS_48Bits),
+      // ASID 取自 TTBR0_EL1，硬件支持时使用 16 位 ASID
+      TCR_EL1::A1::Value(false), TCR_EL1::AS::Value(asid16));
 
   // 指令同步屏障，确保 TCR 配置生效
   __asm__ volatile("isb");
@@ -224,6 +397,37 @@ static __always_inline auto GetPageDirectory() -> uint64_t {
   return detail::regs::system_reg::TTBR1_EL1::Read();
 }
 
+/**
+ * @brief 切换用户地址空间，一次写 TTBR0_EL1 同时设置 ASID 与页表基址
+ * @param pgd 页表物理地址
+ * @param asid 地址空间标识符，需小于 1 << GetAsidBits()
+ * @note 不广播 TLB 失效。TCR_EL1.A1 为 0 时 ASID 取自 TTBR0_EL1，
+ * TTBR1_EL1 中的内核映射应为全局映射
+ */
+static __always_inline void SwitchAddressSpace(uint64_t pgd, uint16_t asid) {
+  using TTBR0_EL1Info = detail::register_info::system_reg::TTBR0_EL1Info;
+  detail::regs::system_reg::TTBR0_EL1::Write(
+      (static_cast<uint64_t>(asid) << TTBR0_EL1Info::ASID::kBitOffset) |
+      (pgd & TTBR0_EL1Info::BADDR::kBitMask));
+  __asm__ volatile("isb" ::: "memory");
+}
+
+/**
+ * @brief 获取当前 ASID
+ * @return uint16_t TTBR0_EL1.ASID
+ */
+static __always_inline auto GetCurrentAsid() -> uint16_t {
+  return detail::regs::system_reg::TTBR0_EL1::ASID::Get();
+}
+
+/**
+ * @brief 获取当前使用的 ASID 位数
+ * @return size_t TCR_EL1.AS 为 1 时为 16，否则为 8
+ */
+static __always_inline auto GetAsidBits() -> size_t {
+  return detail::regs::system_reg::TCR_EL1::AS::Get() ? 16 : 8;
+}
+
 /**
  * @brief 物理地址转换为页表项
  * @param physical_addr 物理地址
@@ -233,8 +437,9 @@ static __always_inline auto GetPageDirectory() -> uint64_t {
 static __always_inline auto PhysicalToPageTableEntry(uint64_t physical_addr,
                                                      uint64_t flags)
     -> uint64_t {
-  return ((physical_addr >> kPageOffsetBits) << kPteAttributeBits) |
-         (flags & ((1ULL << kPteAttributeBits) - 1));
+  return (physical_addr & kPteAddressMask) |
+         (flags & ((1ULL << kPteAttributeBits) - 1)) |
+         (flags & kPteUpperAttributeMask);
 }
 
 /**
@@ -243,7 +448,7 @@ static __always_inline auto PhysicalToPageTableEntry(uint64_t physical_addr,
  * @return uint64_t 物理地址
  */
 static __always_inline auto PageTableEntryToPhysical(uint64_t pte) -> uint64_t {
-  return (pte >> kPteAttributeBits) << kPageOffsetBits;
+  return pte & kPteAddressMask;
 }
 
 /**
@@ -276,6 +481,56 @@ static __always_inline auto GetPageTableLevelShift(size_t level) -> size_t {
   return kPageOffsetBits + (level * kVpnBits);
 }
 
+/**
+ * @brief 获取指定级别页表项映射的大小
+ * @param level 页表级别，0 为 4KB 页
+ * @return uint64_t 映射大小
+ */
+static __always_inline auto GetLevelPageSize(size_t level) -> uint64_t {
+  return 1ULL << GetPageTableLevelShift(level);
+}
+
+/**
+ * @brief 获取可用于块映射的最高页表级别
+ * 4KB 粒度下 level 1 为 2MB 块（L2），level 2 为 1GB 块（L1）
+ * @return size_t 最高块映射级别
+ */
+static __always_inline auto GetMaxBlockLevel() -> size_t { return 2; }
+
+/**
+ * @brief 创建指定级别的叶子描述符
+ * level 0 为页描述符（bits[1:0] = 0b11），更高级别为块描述符（0b01）
+ * @param level 页表级别
+ * @param physical_addr 物理地址，需按 GetLevelPageSize(level) 对齐
+ * @param flags 页表项标志位，同 PhysicalToPageTableEntry
+ * @return uint64_t 页表项值
+ */
+static __always_inline auto CreateBlockEntry(size_t level,
+                                             uint64_t physical_addr,
+                                             uint64_t flags) -> uint64_t {
+  flags |= kValid;
+  if (level > 0) {
+    flags &= ~kTable;
+  } else {
+    flags |= kTable;
+  }
+  return PhysicalToPageTableEntry(physical_addr, flags);
+}
+
+/**
+ * @brief 检查描述符是否为有效的叶子项（页描述符或块描述符）
+ * @param pte 页表项
+ * @param level 页表项所在的级别
+ * @return true 叶子页表项
+ * @return false 无效项或表描述符
+ */
+static __always_inline auto IsLeafEntry(uint64_t pte, size_t level) -> bool {
+  if (!IsPageTableEntryValid(pte)) {
+    return false;
+  }
+  return level == 0 || (pte & kTable) == 0;
+}
+
 /**
  * @brief 虚拟地址转物理地址（简单的内核空间映射）
  * @param virtual_addr 虚拟地址
@@ -341,12 +596,14 @@ static __always_inline auto GetPageOffset(uint64_t addr) -> uint64_t {
  * @param executable 可执行标志
  * @param user_accessible 用户可访问标志
  * @param global 全局标志
+ * @param memory_type 内存类型
  * @return uint64_t 页表项
  */
 static __always_inline auto CreatePageTableEntry(
     uint64_t physical_addr, [[maybe_unused]] bool readable = true,
     bool writable = false, bool executable = false,
-    bool user_accessible = false, bool global = false) -> uint64_t {
+    bool user_accessible = false, bool global = false,
+    MemoryType memory_type = MemoryType::kWriteBack) -> uint64_t {
   uint64_t flags = kValid | kTable | kAf;
 
   // 设置访问权限
@@ -378,8 +635,8 @@ static __always_inline auto CreatePageTableEntry(
     flags |= kNg;  // AArch64的nG位表示非全局
   }
 
-  // 设置默认内存属性（普通内存，写回缓存）
-  flags |= kAttrNormalWb | kShInnerShareable;
+  // 设置内存属性，默认为普通内存，写回缓存
+  flags |= GetMemoryTypeFlags(memory_type) | kShInnerShareable;
 
   return PhysicalToPageTableEntry(physical_addr, flags);
 }
@@ -432,14 +689,14 @@ static __always_inline auto CheckPageTableEntryPermissions(
 /**
  * @brief 刷新特定地址的 TLB
  * @param virtual_addr 要刷新的虚拟地址
- * @param asid 地址空间标识符（当前忽略）
+ * @param asid 地址空间标识符，0 表示所有 ASID
  */
-static __always_inline void FlushTLBAddress(
-    uint64_t virtual_addr, [[maybe_unused]] uint64_t asid = 0) {
-  __asm__ volatile("dsb sy");
-  __asm__ volatile("tlbi vae1is, %0" : : "r"(virtual_addr >> 12));
-  __asm__ volatile("dsb sy");
-  __asm__ volatile("isb");
+static __always_inline void FlushTLBAddress(uint64_t virtual_addr,
+                                            uint64_t asid = 0) {
+  __asm__ volatile("dsb ishst" ::: "memory");
+  detail::tlb::InvalidatePage(virtual_addr, asid);
+  __asm__ volatile("dsb ish" ::: "memory");
+  __asm__ volatile("isb" ::: "memory");
 }
 
 /**
@@ -452,6 +709,34 @@ static __always_inline void FlushTLBAll() {
   __asm__ volatile("isb");
 }
 
+/**
+ * @brief 只刷新当前核心的所有 TLB 条目，不广播
+ */
+static __always_inline void FlushTLBAllLocal() {
+  __asm__ volatile("dsb nshst" ::: "memory");
+  __asm__ volatile("tlbi vmalle1" ::: "memory");
+  __asm__ volatile("dsb nsh" ::: "memory");
+  __asm__ volatile("isb" ::: "memory");
+}
+
+/**
+ * @brief 刷新指定 ASID 的所有 TLB 条目（不含全局项）
+ * @param asid 地址空间标识符，0 表示刷新全部
+ */
+static __always_inline void FlushTLBAsid(uint64_t asid) {
+  if (asid == 0) {
+    FlushTLBAll();
+    return;
+  }
+  __asm__ volatile("dsb ishst" ::: "memory");
+  __asm__ volatile("tlbi aside1is, %0"
+                   :
+                   : "r"(asid << detail::tlb::kAsidOffset)
+                   : "memory");
+  __asm__ volatile("dsb ish" ::: "memory");
+  __asm__ volatile("isb" ::: "memory");
+}
+
 /**
  * @brief 计算地址范围包含的页数
  * @param start_addr 起始地址
@@ -465,6 +750,36 @@ static __always_inline auto GetPageCount(uint64_t start_addr, uint64_t end_addr)
   return (aligned_end - aligned_start) / kPageSize;
 }
 
+/**
+ * @brief 刷新虚拟地址范围内的 TLB
+ * @param start_addr 起始虚拟地址
+ * @param end_addr 结束虚拟地址（不包含）
+ * @param asid 地址空间标识符，0 表示所有 ASID
+ * @param threshold 不支持范围 TLBI 时，页数超过该值改为整体刷新
+ * @note 支持 FEAT_TLBIRANGE 时使用 rvae1is 覆盖 2 的幂次块，
+ * 否则连续发出 vae1is；所有 TLBI 共用一组 dsb ish + isb
+ */
+static __always_inline void FlushTLBRange(
+    uint64_t start_addr, uint64_t end_addr, uint64_t asid = 0,
+    size_t threshold = kFlushTLBRangeThreshold) {
+  auto page_count = GetPageCount(start_addr, end_addr);
+  if (page_count == 0) {
+    return;
+  }
+  auto use_range = detail::tlb::HasTlbiRange();
+  if ((use_range && page_count >= detail::tlb::kMaxRangePages) ||
+      (!use_range && page_count > threshold)) {
+    FlushTLBAsid(asid);
+    return;
+  }
+
+  __asm__ volatile("dsb ishst" ::: "memory");
+  detail::tlb::InvalidatePages(PageAlign(start_addr), page_count, asid,
+                               use_range);
+  __asm__ volatile("dsb ish" ::: "memory");
+  __asm__ volatile("isb" ::: "memory");
+}
+
 /**
  * @brief 获取页表中间项权限
  * @return uint64_t 页表中间项权限标志
@@ -482,11 +797,13 @@ static __always_inline auto GetTableEntryPermissions() -> uint64_t {
  * @param writable 可写标志
  * @param executable 可执行标志
  * @param global 全局标志
+ * @param memory_type 内存类型
  * @return uint64_t 内核页表权限标志
  */
 static __always_inline auto GetKernelPagePermissions(
     [[maybe_unused]] bool readable = true, bool writable = true,
-    bool executable = true, bool global = true) -> uint64_t {
+    bool executable = true, bool global = true,
+    MemoryType memory_type = MemoryType::kWriteBack) -> uint64_t {
   // 基础标志
   uint64_t flags = kValid | kTable | kAf;
 
@@ -511,8 +828,8 @@ static __always_inline auto GetKernelPagePermissions(
     flags |= kNg;
   }
 
-  // 设置默认内存属性（普通内存，写回缓存，内部共享）
-  flags |= kAttrNormalWb | kShInnerShareable;
+  // 设置内存属性，默认为普通内存，写回缓存，内部共享
+  flags |= GetMemoryTypeFlags(memory_type) | kShInnerShareable;
 
   return flags;
 }
@@ -523,11 +840,13 @@ static __always_inline auto GetKernelPagePermissions(
  * @param writable 可写标志
  * @param executable 可执行标志
  * @param global 全局标志
+ * @param memory_type 内存类型
  * @return uint64_t 用户页表权限标志
  */
 static __always_inline auto GetUserPagePermissions(
     [[maybe_unused]] bool readable = true, bool writable = false,
-    bool executable = false, bool global = false) -> uint64_t {
+    bool executable = false, bool global = false,
+    MemoryType memory_type = MemoryType::kWriteBack) -> uint64_t {
   // 基础标志
   uint64_t flags = kValid | kTable | kAf;
 
@@ -552,13 +871,52 @@ static __always_inline auto GetUserPagePermissions(
     flags |= kNg;
   }
 
-  // 设置默认内存属性（普通内存，写回缓存，内部共享）
-  flags |= kAttrNormalWb | kShInnerShareable;
+  // 设置内存属性，默认为普通内存，写回缓存，内部共享
+  flags |= GetMemoryTypeFlags(memory_type) | kShInnerShareable;
 
   return flags;
 }
 
 }  // namespace virtual_memory
+
+namespace detail::tlb {
+
+/**
+ * @brief TlbBatch 使用的 AArch64 失效操作
+ */
+struct BatchFlushPolicy {
+  /// 支持范围 TLBI 时失效开销与页数无关，只受单条指令的页数上限限制
+  static __always_inline auto ShouldFlushAll(size_t pages, size_t threshold,
+                                             uint64_t /*asid*/) -> bool {
+    if (HasTlbiRange()) {
+      return pages >= kMaxRangePages;
+    }
+    return pages > threshold;
+  }
+
+  static __always_inline void FlushAll(uint64_t asid) {
+    virtual_memory::FlushTLBAsid(asid);
+  }
+
+  /// ranges 为 TlbRange 序列，定义见 tlb_batch.hpp
+  template <class Ranges>
+  static __always_inline void FlushRanges(const Ranges &ranges,
+                                          uint64_t asid) {
+    auto use_range = HasTlbiRange();
+    // 所有 TLBI 连续发出，只使用一组屏障
+    __asm__ volatile("dsb ishst" ::: "memory");
+    for (const auto &range : ranges) {
+      InvalidatePages(range.start,
+                      (range.end - range.start) / virtual_memory::kPageSize,
+                      asid, use_range);
+    }
+    __asm__ volatile("dsb ish" ::: "memory");
+    __asm__ volatile("isb" ::: "memory");
+  }
+};
+
+}  // namespace detail::tlb
+
 }  // namespace cpu_io
 
 #endif  // CPU_IO_INCLUDE_AARCH64_VIRTUAL_MEMORY_HPP_
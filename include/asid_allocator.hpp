@@ -0,0 +1,219 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_ASID_ALLOCATOR_HPP_
+#define CPU_IO_INCLUDE_ASID_ALLOCATOR_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "cpu_io.h"
+
+namespace cpu_io {
+namespace virtual_memory {
+
+/**
+ * @brief 地址空间的 ASID 上下文
+ * id 的低 asid_bits 位为 ASID，高位为分配时的代数，0 表示尚未分配
+ */
+struct AsidContext {
+  uint64_t id = 0;
+};
+
+/**
+ * @brief 带代数回绕的 ASID 分配器
+ * ASID 用尽时代数加一并清空分配位图，各核心正在使用的 ASID 在新一代中保留，
+ * 各核心在下一次切换时刷新本地 TLB。代数未变的地址空间切换只需一次
+ * SwitchAddressSpace，不需要任何 TLB 失效
+ * @tparam kMaxCores 最大核心数
+ * @note 不是线程安全的，多核共享同一实例时调用者需加锁。ASID 0 保留给内核。
+ * 不支持 ASID (asid_bits 为 0)，或去掉 ASID 0 后的 ASID 数不多于 kMaxCores、
+ * 回绕后可能没有空闲 ASID 时，不使用 ASID，每次切换都刷新本地 TLB
+ */
+template <size_t kMaxCores = 64>
+class AsidAllocator {
+ public:
+  /**
+   * @brief 构造函数
+   * @param asid_bits ASID 位数，通常为开启分页后 GetAsidBits() 的结果
+   * @note RISC-V 的 GetAsidBits() 需修改 satp 探测，不在构造时隐式调用
+   */
+  explicit AsidAllocator(size_t asid_bits)
+      : asid_bits_(asid_bits),
+        asid_mask_((1ULL << asid_bits) - 1),
+        generation_(1ULL << asid_bits),
+        enabled_(asid_mask_ > kMaxCores) {
+    bitmap_[0] = 1;
+  }
+
+  /// @name 构造/析构函数
+  /// @{
+  AsidAllocator(const AsidAllocator &) = delete;
+  AsidAllocator(AsidAllocator &&) = delete;
+  auto operator=(const AsidAllocator &) -> AsidAllocator & = delete;
+  auto operator=(AsidAllocator &&) -> AsidAllocator & = delete;
+  ~AsidAllocator() = default;
+  /// @}
+
+  /**
+   * @brief 在 core_id 上切换到 context 对应的地址空间，按需分配 ASID
+   * @param core_id 当前核心 ID
+   * @param context 地址空间的 ASID 上下文
+   * @param pgd 页表物理地址
+   * @return uint16_t 使用的 ASID
+   * @pre core_id < kMaxCores，超出时无法记录该核心的 ASID，
+   * 与不使用 ASID 时一样以 ASID 0 切换并刷新本地 TLB
+   */
+  auto Switch(size_t core_id, AsidContext &context, uint64_t pgd) -> uint16_t {
+    if (!enabled_ || core_id >= kMaxCores) {
+      SwitchAddressSpace(pgd, 0);
+      FlushTLBAllLocal();
+      return 0;
+    }
+    if (!IsCurrentGeneration(context.id)) {
+      context.id = NewContext(context.id);
+    }
+    if (flush_pending_[core_id]) {
+      flush_pending_[core_id] = false;
+      FlushTLBAllLocal();
+    }
+    active_[core_id] = context.id;
+    auto asid = static_cast<uint16_t>(context.id & asid_mask_);
+    SwitchAddressSpace(pgd, asid);
+    return asid;
+  }
+
+  /**
+   * @brief 获取 ASID 位数
+   * @return size_t ASID 位数
+   */
+  [[nodiscard]] auto GetBits() const -> size_t { return asid_bits_; }
+
+  /**
+   * @brief 是否使用 ASID
+   * @return false 每次切换都刷新本地 TLB
+   */
+  [[nodiscard]] auto IsEnabled() const -> bool { return enabled_; }
+
+ private:
+  /// 位图容量，按最大 16 位 ASID 计算
+  static constexpr size_t kBitmapWords = (1U << 16) / 64;
+
+  /// ASID 位数
+  size_t asid_bits_;
+  /// ASID 掩码
+  uint64_t asid_mask_;
+  /// 当前代数，位于 asid_bits_ 之上
+  uint64_t generation_;
+  /// ASID 空间足够大，回绕后总有空闲的 ASID
+  bool enabled_;
+  /// 下一次分配开始查找的 ASID
+  uint64_t next_asid_ = 1;
+  /// 当前代已分配的 ASID
+  std::array<uint64_t, kBitmapWords> bitmap_{};
+  /// 各核心正在使用的上下文 id
+  std::array<uint64_t, kMaxCores> active_{};
+  /// 回绕时各核心保留的上下文 id
+  std::array<uint64_t, kMaxCores> reserved_{};
+  /// 各核心是否需要在下一次切换时刷新本地 TLB
+  std::array<bool, kMaxCores> flush_pending_{};
+
+  /**
+   * @brief 检查上下文 id 是否属于当前代
+   * @param id 上下文 id
+   * @return true 属于当前代
+   */
+  [[nodiscard]] auto IsCurrentGeneration(uint64_t id) const -> bool {
+    return id != 0 && (id & ~asid_mask_) == generation_;
+  }
+
+  /**
+   * @brief 测试并设置位图中的 ASID
+   * @param asid ASID
+   * @return true 该 ASID 之前已被分配
+   */
+  auto TestAndSet(uint64_t asid) -> bool {
+    auto &word = bitmap_[asid / 64];
+    auto bit = 1ULL << (asid % 64);
+    auto old = (word & bit) != 0;
+    word |= bit;
+    return old;
+  }
+
+  /**
+   * @brief 从 start 开始查找未分配的 ASID
+   * @param start 起始 ASID
+   * @return uint64_t 未分配的 ASID，全部已分配时返回 0
+   */
+  [[nodiscard]] auto FindFree(uint64_t start) const -> uint64_t {
+    for (auto asid = start; asid <= asid_mask_; asid++) {
+      if ((bitmap_[asid / 64] & (1ULL << (asid % 64))) == 0) {
+        return asid;
+      }
+    }
+    return 0;
+  }
+
+  /**
+   * @brief 开始新的一代
+   * 各核心正在使用（或上次回绕时保留且尚未切换走）的 ASID 保留到新一代
+   */
+  void Rollover() {
+    generation_ += 1ULL << asid_bits_;
+    bitmap_ = {};
+    bitmap_[0] = 1;
+    for (size_t i = 0; i < kMaxCores; i++) {
+      if (active_[i] != 0) {
+        reserved_[i] = active_[i];
+        active_[i] = 0;
+      }
+      if (reserved_[i] != 0) {
+        TestAndSet(reserved_[i] & asid_mask_);
+      }
+      flush_pending_[i] = true;
+    }
+    next_asid_ = 1;
+  }
+
+  /**
+   * @brief 为旧代或未分配的上下文分配当前代的 id
+   * @param id 原上下文 id
+   * @return uint64_t 新的上下文 id
+   */
+  auto NewContext(uint64_t id) -> uint64_t {
+    if (id != 0) {
+      auto asid = id & asid_mask_;
+      auto new_id = generation_ | asid;
+      // 回绕时仍在某个核心上运行的 ASID 沿用原值
+      auto reserved = false;
+      for (auto &entry : reserved_) {
+        if (entry == id) {
+          entry = new_id;
+          reserved = true;
+        }
+      }
+      if (reserved) {
+        return new_id;
+      }
+      if (!TestAndSet(asid)) {
+        return new_id;
+      }
+    }
+    auto asid = FindFree(next_asid_);
+    if (asid == 0) {
+      // 保留的 ASID 最多 kMaxCores 个，enabled_ 保证回绕后仍有空闲的 ASID
+      Rollover();
+      asid = FindFree(1);
+    }
+    TestAndSet(asid);
+    next_asid_ = asid + 1;
+    return generation_ | asid;
+  }
+};
+
+}  // namespace virtual_memory
+}  // namespace cpu_io
+
+#endif /* CPU_IO_INCLUDE_ASID_ALLOCATOR_HPP_ */
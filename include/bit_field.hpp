@@ -0,0 +1,101 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_BIT_FIELD_HPP_
+#define CPU_IO_INCLUDE_BIT_FIELD_HPP_
+
+#include <cstdint>
+
+namespace cpu_io {
+
+namespace detail {
+
+/**
+ * @brief 位域描述
+ * 寄存器的每个字段只需声明一次类型、起始位与位宽，掩码与编解码由此生成：
+ * struct Field : public BitField<uint8_t, 4, 2> {};
+ * 字段值与枚举常量可以在派生结构中追加
+ * @tparam T 字段的数据类型
+ * @tparam kOffset 起始位
+ * @tparam kWidth 位宽
+ */
+template <class T, uint64_t kOffset, uint64_t kWidth>
+struct BitField {
+  static_assert(kWidth > 0 && kOffset + kWidth <= 64);
+
+  /// 字段数据类型
+  using DataType = T;
+  /// 起始位
+  static constexpr uint64_t kBitOffset = kOffset;
+  /// 位宽
+  static constexpr uint64_t kBitWidth = kWidth;
+  /// 对应位置位掩码
+  static constexpr uint64_t kAllSetMask =
+      (kWidth < 64) ? ((1ULL << kWidth) - 1) : ~0ULL;
+  /// 掩码，(val & kBitMask) == 对应当前位的值
+  static constexpr uint64_t kBitMask = kAllSetMask << kOffset;
+
+  /**
+   * @brief 将字段值移动到寄存器中的位置
+   * @param value 字段值，超出位宽的部分被丢弃
+   * @return uint64_t 只含该字段的寄存器值
+   */
+  static constexpr auto Encode(T value) -> uint64_t {
+    return (static_cast<uint64_t>(value) & kAllSetMask) << kOffset;
+  }
+
+  /**
+   * @brief 从寄存器值中取出字段值
+   * @param reg 寄存器值
+   * @return T 字段值
+   */
+  static constexpr auto Decode(uint64_t reg) -> T {
+    return static_cast<T>((reg & kBitMask) >> kOffset);
+  }
+
+  /**
+   * @brief 替换寄存器值中的字段，其它位不变
+   * @param reg 寄存器值
+   * @param value 字段值
+   * @return uint64_t 新的寄存器值
+   */
+  static constexpr auto Insert(uint64_t reg, T value) -> uint64_t {
+    return (reg & ~kBitMask) | Encode(value);
+  }
+};
+
+/**
+ * @brief 多个字段是否互不重叠
+ * @tparam Fields 字段描述
+ */
+template <class... Fields>
+inline constexpr bool kFieldsDisjoint =
+    (__builtin_popcountll(Fields::kBitMask) + ... + 0) ==
+    __builtin_popcountll((Fields::kBitMask | ... | 0ULL));
+
+/**
+ * @brief 将多个字段值合并为一个寄存器值，用于一次写入多个字段
+ * @tparam Fields 字段描述，互相重叠时编译失败
+ * @param values 与 Fields 一一对应的字段值
+ * @return uint64_t 寄存器值
+ */
+template <class... Fields>
+static constexpr auto EncodeFields(typename Fields::DataType... values)
+    -> uint64_t {
+  static_assert(kFieldsDisjoint<Fields...>, "EncodeFields: fields overlap");
+  return (Fields::Encode(values) | ... | 0ULL);
+}
+
+static_assert(BitField<uint8_t, 4, 2>::kBitMask == 0x30);
+static_assert(BitField<uint64_t, 0, 64>::kBitMask == ~0ULL);
+static_assert(BitField<uint8_t, 4, 2>::Insert(0xFF, 1) == 0xDF);
+static_assert(BitField<bool, 63, 1>::Decode(1ULL << 63));
+static_assert(EncodeFields<BitField<uint8_t, 0, 4>, BitField<bool, 8, 1>>(
+                  0xA, true) == 0x10A);
+
+}  // namespace detail
+
+}  // namespace cpu_io
+
+#endif  // CPU_IO_INCLUDE_BIT_FIELD_HPP_
@@ -0,0 +1,60 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_CACHE_LINE_HPP_
+#define CPU_IO_INCLUDE_CACHE_LINE_HPP_
+
+#include <sys/cdefs.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cpu_io {
+
+/**
+ * @brief 预取的访问类型
+ */
+enum class PrefetchAccess {
+  /// 之后将读取
+  kRead,
+  /// 之后将写入，预取时即取得独占权
+  kWrite,
+};
+
+namespace detail {
+
+/**
+ * @brief 对覆盖 [addr, addr + size) 的每个缓存行执行 op
+ * 每次处理 4 行以减少循环判断，缓存维护指令之间没有依赖，可以连续发射；
+ * 屏障由调用者在全部完成后执行一次
+ * @tparam Op 接受行地址 (uintptr_t) 的可调用对象
+ * @param addr 起始地址，不需要对齐
+ * @param size 字节数
+ * @param line_size 缓存行大小，需为 2 的幂
+ * @param op 对一行执行的操作
+ */
+template <class Op>
+static __always_inline void ForEachCacheLine(const void *addr, size_t size,
+                                             size_t line_size, Op op) {
+  if (size == 0) {
+    return;
+  }
+  auto start = reinterpret_cast<uintptr_t>(addr);
+  auto end = start + size;
+  auto line = start & ~(line_size - 1);
+  for (; line + 4 * line_size <= end; line += 4 * line_size) {
+    op(line);
+    op(line + line_size);
+    op(line + 2 * line_size);
+    op(line + 3 * line_size);
+  }
+  for (; line < end; line += line_size) {
+    op(line);
+  }
+}
+
+}  // namespace detail
+}  // namespace cpu_io
+
+#endif /* CPU_IO_INCLUDE_CACHE_LINE_HPP_ */
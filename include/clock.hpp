@@ -0,0 +1,142 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_CLOCK_HPP_
+#define CPU_IO_INCLUDE_CLOCK_HPP_
+
+#include <sys/cdefs.h>
+
+#include <cstdint>
+
+namespace cpu_io {
+
+/**
+ * @brief 定点频率换算系数
+ * 将 from_hz 下的计数换算为 to_hz 下的计数：(value * mult) >> shift，
+ * 乘积使用 128 位，只需一次乘法与移位，不需要除法
+ */
+struct ClockScale {
+  /// 乘数
+  uint64_t mult = 0;
+  /// 右移位数
+  uint32_t shift = 0;
+
+  /// 每秒纳秒数
+  static constexpr uint64_t kNsPerSec = 1000000000;
+
+  /**
+   * @brief 计算从 from_hz 到 to_hz 的换算系数
+   * 选择使 mult 不超过 64 位的最大 shift，以获得最高精度
+   * @param from_hz 源频率
+   * @param to_hz 目标频率
+   * @return ClockScale 换算系数，任一频率为 0 时为全 0
+   */
+  static constexpr auto Make(uint64_t from_hz, uint64_t to_hz) -> ClockScale {
+    if (from_hz == 0 || to_hz == 0) {
+      return {};
+    }
+    auto to = static_cast<unsigned __int128>(to_hz);
+    uint32_t shift = 0;
+    while (shift < kMaxShift && ((to << (shift + 1)) / from_hz) >> 64 == 0) {
+      shift++;
+    }
+    // 向上取整，使整数结果不会因截断少 1
+    auto mult = ((to << shift) + from_hz - 1) / from_hz;
+    if (mult >> 64 != 0) {
+      shift--;
+      mult = ((to << shift) + from_hz - 1) / from_hz;
+    }
+    return {static_cast<uint64_t>(mult), shift};
+  }
+
+  /**
+   * @brief 换算，结果向下取整
+   * @param value 源频率下的计数
+   * @return uint64_t 目标频率下的计数
+   */
+  [[nodiscard]] constexpr auto Apply(uint64_t value) const -> uint64_t {
+    return static_cast<uint64_t>(
+        (static_cast<unsigned __int128>(value) * mult) >> (shift & kMaxShift));
+  }
+
+ private:
+  /// 最大右移位数，保证 to_hz << shift 不超过 128 位
+  static constexpr uint32_t kMaxShift = 63;
+};
+
+static_assert(ClockScale::Make(1000000, ClockScale::kNsPerSec).Apply(3) ==
+              3000);
+static_assert(ClockScale::Make(ClockScale::kNsPerSec, 24000000).Apply(1000) ==
+              24);
+static_assert(ClockScale::Make(3000000000, ClockScale::kNsPerSec)
+                  .Apply(3000000000ULL * 3600) == 3600ULL * 1000000000);
+
+namespace detail {
+/// 时间戳计数器频率，0 表示尚未校准
+inline uint64_t timestamp_frequency = 0;
+/// 计数到纳秒的换算系数
+inline ClockScale timestamp_to_ns{};
+/// 纳秒到计数的换算系数
+inline ClockScale ns_to_timestamp{};
+}  // namespace detail
+
+/**
+ * @brief 设置时间戳计数器频率，并计算纳秒换算系数
+ * @param frequency 计数器频率 (Hz)
+ */
+static __always_inline void SetTimestampFrequency(uint64_t frequency) {
+  detail::timestamp_frequency = frequency;
+  detail::timestamp_to_ns = ClockScale::Make(frequency, ClockScale::kNsPerSec);
+  detail::ns_to_timestamp = ClockScale::Make(ClockScale::kNsPerSec, frequency);
+}
+
+/**
+ * @brief 获取时间戳计数器频率
+ * @return uint64_t 计数器频率 (Hz)，尚未校准时为 0
+ */
+static __always_inline auto GetTimestampFrequency() -> uint64_t {
+  return detail::timestamp_frequency;
+}
+
+/**
+ * @brief 将时间戳计数换算为纳秒
+ * @param cycles 计数
+ * @return uint64_t 纳秒，尚未校准时为 0
+ */
+static __always_inline auto CyclesToNs(uint64_t cycles) -> uint64_t {
+  return detail::timestamp_to_ns.Apply(cycles);
+}
+
+/**
+ * @brief 将纳秒换算为时间戳计数
+ * @param ns 纳秒
+ * @return uint64_t 计数，尚未校准时为 0
+ */
+static __always_inline auto NsToCycles(uint64_t ns) -> uint64_t {
+  return detail::ns_to_timestamp.Apply(ns);
+}
+
+/// WaitOnAddress() 不超时
+static constexpr uint64_t kWaitForever = ~0ULL;
+
+namespace detail {
+/**
+ * @brief 计算超时对应的截止计数
+ * @param now 当前计数
+ * @param timeout_ns 超时 (纳秒)，kWaitForever 表示不超时
+ * @return uint64_t 截止计数，溢出时为最大值
+ */
+static __always_inline auto CyclesDeadline(uint64_t now, uint64_t timeout_ns)
+    -> uint64_t {
+  if (timeout_ns == kWaitForever) {
+    return ~0ULL;
+  }
+  auto deadline = now + NsToCycles(timeout_ns);
+  return deadline < now ? ~0ULL : deadline;
+}
+}  // namespace detail
+
+}  // namespace cpu_io
+
+#endif /* CPU_IO_INCLUDE_CLOCK_HPP_ */
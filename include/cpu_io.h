@@ -11,6 +11,19 @@
 #include "riscv64/cpu.hpp"
 #elif __aarch64__
 #include "aarch64/cpu.hpp"
+#include "aarch64/pmu.hpp"
+#endif
+
+#include "irq_guard.hpp"
+#include "mmio.hpp"
+#include "page_table.hpp"
+#include "smp.hpp"
+#include "spinlock.hpp"
+#include "time_source.hpp"
+#include "tlb_batch.hpp"
+
+#if defined(__riscv) || defined(__aarch64__)
+#include "asid_allocator.hpp"
 #endif
 
 #endif /* CPU_IO_INCLUDE_CPU_IO_H_ */
@@ -0,0 +1,91 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_CPU_MASK_HPP_
+#define CPU_IO_INCLUDE_CPU_MASK_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace cpu_io {
+
+/**
+ * @brief 核心集合，按逻辑 core id 索引的位图
+ * @tparam kMaxCores 最大核心数
+ */
+template <size_t kMaxCores = 256>
+class CpuMask {
+ public:
+  /// @name 构造/析构函数
+  /// @{
+  constexpr CpuMask() = default;
+  constexpr CpuMask(const CpuMask &) = default;
+  constexpr CpuMask(CpuMask &&) = default;
+  constexpr auto operator=(const CpuMask &) -> CpuMask & = default;
+  constexpr auto operator=(CpuMask &&) -> CpuMask & = default;
+  ~CpuMask() = default;
+  /// @}
+
+  /**
+   * @brief 加入核心
+   * @param core_id core id
+   */
+  constexpr void Set(size_t core_id) {
+    words_[core_id / 64] |= 1ULL << (core_id % 64);
+  }
+
+  /**
+   * @brief 移除核心
+   * @param core_id core id
+   */
+  constexpr void Clear(size_t core_id) {
+    words_[core_id / 64] &= ~(1ULL << (core_id % 64));
+  }
+
+  /**
+   * @brief 检查核心是否在集合中
+   * @param core_id core id
+   * @return true 在集合中
+   */
+  [[nodiscard]] constexpr auto Test(size_t core_id) const -> bool {
+    return (words_[core_id / 64] & (1ULL << (core_id % 64))) != 0;
+  }
+
+  /**
+   * @brief 检查集合是否为空
+   * @return true 为空
+   */
+  [[nodiscard]] constexpr auto IsEmpty() const -> bool {
+    for (auto word : words_) {
+      if (word != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief 按 core id 从小到大遍历集合中的核心
+   * @param visitor 以 core id 为参数调用
+   */
+  template <class Visitor>
+  constexpr void ForEach(Visitor &&visitor) const {
+    for (size_t i = 0; i < kWords; i++) {
+      for (auto word = words_[i]; word != 0; word &= word - 1) {
+        visitor(i * 64 + static_cast<size_t>(__builtin_ctzll(word)));
+      }
+    }
+  }
+
+ private:
+  /// 位图字数
+  static constexpr size_t kWords = (kMaxCores + 63) / 64;
+  /// 位图
+  std::array<uint64_t, kWords> words_{};
+};
+
+}  // namespace cpu_io
+
+#endif /* CPU_IO_INCLUDE_CPU_MASK_HPP_ */
@@ -0,0 +1,37 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_IRQ_GUARD_HPP_
+#define CPU_IO_INCLUDE_IRQ_GUARD_HPP_
+
+#include <cstdint>
+
+#include "cpu_io.h"
+
+namespace cpu_io {
+
+/**
+ * @brief 在作用域内关闭中断，离开时恢复进入前的状态
+ * 可嵌套：内层恢复时中断仍保持关闭
+ */
+class IrqGuard {
+ public:
+  /// @name 构造/析构函数
+  /// @{
+  IrqGuard() : flags_(IrqSave()) {}
+  IrqGuard(const IrqGuard &) = delete;
+  IrqGuard(IrqGuard &&) = delete;
+  auto operator=(const IrqGuard &) -> IrqGuard & = delete;
+  auto operator=(IrqGuard &&) -> IrqGuard & = delete;
+  ~IrqGuard() { IrqRestore(flags_); }
+  /// @}
+
+ private:
+  /// IrqSave() 保存的中断状态
+  uint64_t flags_;
+};
+
+}  // namespace cpu_io
+
+#endif /* CPU_IO_INCLUDE_IRQ_GUARD_HPP_ */
@@ -0,0 +1,129 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_MMIO_HPP_
+#define CPU_IO_INCLUDE_MMIO_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "cpu_io.h"
+
+namespace cpu_io {
+
+/**
+ * @brief 内存映射设备寄存器
+ * 寄存器描述与系统寄存器相同：RegInfo 给出 DataType (访问宽度)，
+ * 嵌套的位域描述给出 DataType/kBitOffset/kBitMask。
+ * Relaxed 访问不带屏障，只保证对同一设备的访问按程序顺序到达；
+ * ReadAcquire()/WriteRelease() 使用各架构开销最小的设备屏障
+ * (x86_64 只阻止编译器重排，AArch64 为 dmb oshld/oshst，
+ * RISC-V 为 fence i,ir/fence w,o)，用于与 DMA 内存等普通访存排序。
+ * 连续配置寄存器时应使用 Relaxed 访问，只在需要与内存排序处使用屏障
+ * @tparam RegInfo 寄存器描述
+ * @tparam kOffset 寄存器在寄存器块中的偏移
+ */
+template <class RegInfo, size_t kOffset>
+class Mmio {
+ public:
+  /// 寄存器数据类型，同时决定访问宽度
+  using DataType = typename RegInfo::DataType;
+  static_assert(std::is_integral_v<DataType> &&
+                sizeof(DataType) <= sizeof(uint64_t));
+
+  /// @name 构造/析构函数
+  /// @{
+  Mmio() = delete;
+  Mmio(const Mmio &) = delete;
+  Mmio(Mmio &&) = delete;
+  auto operator=(const Mmio &) -> Mmio & = delete;
+  auto operator=(Mmio &&) -> Mmio & = delete;
+  ~Mmio() = default;
+  /// @}
+
+  /**
+   * @brief 读寄存器，不带屏障
+   * @param base 寄存器块基址
+   * @return DataType 寄存器的值
+   */
+  static __always_inline auto ReadRelaxed(uintptr_t base) -> DataType {
+    return *reinterpret_cast<const volatile DataType *>(base + kOffset);
+  }
+
+  /**
+   * @brief 写寄存器，不带屏障
+   * @param base 寄存器块基址
+   * @param value 要写的值
+   */
+  static __always_inline void WriteRelaxed(uintptr_t base, DataType value) {
+    *reinterpret_cast<volatile DataType *>(base + kOffset) = value;
+  }
+
+  /**
+   * @brief 读寄存器，之后的访存不会提前到读之前
+   * @param base 寄存器块基址
+   * @return DataType 寄存器的值
+   */
+  static __always_inline auto ReadAcquire(uintptr_t base) -> DataType {
+    auto value = ReadRelaxed(base);
+    IoRmb();
+    return value;
+  }
+
+  /**
+   * @brief 写寄存器，之前的写 (如 DMA 描述符) 先于本次写到达
+   * @param base 寄存器块基址
+   * @param value 要写的值
+   */
+  static __always_inline void WriteRelease(uintptr_t base, DataType value) {
+    IoWmb();
+    WriteRelaxed(base, value);
+  }
+
+  /**
+   * @brief 从寄存器值中取出位域
+   * @tparam Field 位域描述
+   * @param value 寄存器的值
+   * @return Field::DataType 位域的值
+   */
+  template <class Field>
+  static constexpr auto Get(DataType value) -> typename Field::DataType {
+    return static_cast<typename Field::DataType>(
+        (static_cast<uint64_t>(value) & Field::kBitMask) >> Field::kBitOffset);
+  }
+
+  /**
+   * @brief 生成只包含一个位域的寄存器值，可用 | 合并
+   * @tparam Field 位域描述
+   * @param value 位域的值
+   * @return DataType 寄存器值
+   */
+  template <class Field>
+  static constexpr auto Make(typename Field::DataType value) -> DataType {
+    return static_cast<DataType>((static_cast<uint64_t>(value)
+                                  << Field::kBitOffset) &
+                                 Field::kBitMask);
+  }
+
+  /**
+   * @brief 读-改-写一个位域，不带屏障
+   * @tparam Field 位域描述
+   * @param base 寄存器块基址
+   * @param value 位域的值
+   * @note 不是原子操作，需由调用者保证没有并发修改
+   */
+  template <class Field>
+  static __always_inline void SetFieldRelaxed(uintptr_t base,
+                                              typename Field::DataType value) {
+    auto org = ReadRelaxed(base);
+    WriteRelaxed(base, static_cast<DataType>(
+                           (org & ~static_cast<DataType>(Field::kBitMask)) |
+                           Make<Field>(value)));
+  }
+};
+
+}  // namespace cpu_io
+
+#endif /* CPU_IO_INCLUDE_MMIO_HPP_ */
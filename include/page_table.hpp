@@ -0,0 +1,339 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_PAGE_TABLE_HPP_
+#define CPU_IO_INCLUDE_PAGE_TABLE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "cpu_io.h"
+
+namespace cpu_io {
+namespace virtual_memory {
+
+/**
+ * @brief 页表遍历与映射
+ * 基于当前架构的页表项辅助函数（PhysicalToPageTableEntry、
+ * GetVirtualPageNumber 等）实现。对一个地址范围的操作只从根页表向下
+ * 遍历一次，同一张中间页表下的相邻页直接复用已找到的页表指针。
+ * 范围内虚拟地址与物理地址同时按某一级大小对齐时，Map 自动使用该级的
+ * 大页（块）映射；Unmap/Protect 只覆盖大页的一部分时会先将其拆分
+ * @tparam Allocator 页表页分配器，需提供 `auto Allocate() -> void *`，
+ * 返回按 kPageSize 对齐且已清零的页，失败时返回 nullptr。
+ * 返回的地址需能通过 VirtualToPhysical 转换为物理地址
+ * @note 不会主动刷新 TLB，修改已有映射（包括拆分大页）后由调用者通过
+ * FlushTLBRange 或 TlbBatch 失效；Unmap 不回收中间页表
+ */
+template <class Allocator>
+class PageTable {
+ public:
+  /**
+   * @brief 构造函数
+   * @param root 根页表（虚拟地址）
+   * @param allocator 页表页分配器
+   */
+  PageTable(uint64_t *root, Allocator &allocator)
+      : root_(root),
+        allocator_(allocator),
+        max_block_level_(GetMaxBlockLevel()) {}
+
+  /// @name 构造/析构函数
+  /// @{
+  PageTable(const PageTable &) = delete;
+  PageTable(PageTable &&) = delete;
+  auto operator=(const PageTable &) -> PageTable & = delete;
+  auto operator=(PageTable &&) -> PageTable & = delete;
+  ~PageTable() = default;
+  /// @}
+
+  /**
+   * @brief 获取根页表
+   * @return uint64_t* 根页表（虚拟地址）
+   */
+  [[nodiscard]] auto GetRoot() const -> uint64_t * { return root_; }
+
+  /**
+   * @brief 设置 Map 可使用的最高大页级别
+   * @param level 最高级别，0 表示只使用 4KB 页，超过 GetMaxBlockLevel()
+   * 时取 GetMaxBlockLevel()
+   */
+  void SetMaxBlockLevel(size_t level) {
+    max_block_level_ = level < GetMaxBlockLevel() ? level : GetMaxBlockLevel();
+  }
+
+  /**
+   * @brief 将 [virtual_addr, virtual_addr + size) 映射到 physical_addr
+   * @param virtual_addr 起始虚拟地址，向下按页对齐
+   * @param physical_addr 起始物理地址，向下按页对齐
+   * @param size 映射大小，末尾向上按页对齐。为 0 时不做任何操作，范围可以
+   * 结束于地址空间顶端
+   * @param flags 叶子页表项标志，如 GetKernelPagePermissions()
+   * @return true 成功
+   * @return false 分配页表失败，已建立的部分映射保持不变
+   * @note 已存在的映射会被覆盖。已指向下一级页表的项不会被替换为大页，
+   * 以免丢失其下的页表
+   */
+  auto Map(uint64_t virtual_addr, uint64_t physical_addr, size_t size,
+           uint64_t flags) -> bool {
+    if (size == 0) {
+      return true;
+    }
+    return MapRange(root_, kPageTableLevels - 1, PageAlign(virtual_addr),
+                    GetRangeLast(virtual_addr, size), PageAlign(physical_addr),
+                    flags);
+  }
+
+  /**
+   * @brief 取消 [virtual_addr, virtual_addr + size) 的映射
+   * @param virtual_addr 起始虚拟地址
+   * @param size 大小
+   * @return size_t 被清除的叶子页表项（含大页）数量
+   * @note 拆分大页时分配页表失败，该大页保持不变且不计入返回值
+   */
+  auto Unmap(uint64_t virtual_addr, size_t size) -> size_t {
+    if (size == 0) {
+      return 0;
+    }
+    auto clear = [](uint64_t &entry, size_t) { entry = 0; };
+    return VisitLeaves(root_, kPageTableLevels - 1, PageAlign(virtual_addr),
+                       GetRangeLast(virtual_addr, size), clear);
+  }
+
+  /**
+   * @brief 修改 [virtual_addr, virtual_addr + size) 中已映射页的标志
+   * @param virtual_addr 起始虚拟地址
+   * @param size 大小
+   * @param flags 新的叶子页表项标志，物理地址保持不变
+   * @return size_t 被修改的叶子页表项（含大页）数量
+   * @note 拆分大页时分配页表失败，该大页保持不变且不计入返回值
+   */
+  auto Protect(uint64_t virtual_addr, size_t size, uint64_t flags) -> size_t {
+    if (size == 0) {
+      return 0;
+    }
+    auto update = [flags](uint64_t &entry, size_t level) {
+      entry = CreateBlockEntry(level, GetEntryBase(entry, level), flags);
+    };
+    return VisitLeaves(root_, kPageTableLevels - 1, PageAlign(virtual_addr),
+                       GetRangeLast(virtual_addr, size), update);
+  }
+
+  /**
+   * @brief 查询虚拟地址对应的物理地址
+   * @param virtual_addr 虚拟地址
+   * @return std::optional<uint64_t> 物理地址（包含页内偏移），未映射时为空
+   */
+  [[nodiscard]] auto Translate(uint64_t virtual_addr) const
+      -> std::optional<uint64_t> {
+    size_t level = 0;
+    auto *entry = FindEntry(virtual_addr, &level);
+    if (entry == nullptr) {
+      return std::nullopt;
+    }
+    return GetEntryBase(*entry, level) |
+           (virtual_addr & (GetLevelPageSize(level) - 1));
+  }
+
+  /**
+   * @brief 查找虚拟地址对应的叶子页表项
+   * @param virtual_addr 虚拟地址
+   * @param level 输出叶子页表项所在的级别，可为 nullptr
+   * @return uint64_t* 有效的叶子页表项，未映射时为 nullptr
+   */
+  [[nodiscard]] auto FindEntry(uint64_t virtual_addr,
+                               size_t *level = nullptr) const -> uint64_t * {
+    auto *table = root_;
+    for (size_t i = kPageTableLevels; i-- > 0;) {
+      auto *entry = &table[GetVirtualPageNumber(virtual_addr, i)];
+      if (!IsPageTableEntryValid(*entry)) {
+        return nullptr;
+      }
+      if (IsLeafEntry(*entry, i)) {
+        if (level != nullptr) {
+          *level = i;
+        }
+        return entry;
+      }
+      table = GetNextTable(*entry);
+    }
+    return nullptr;
+  }
+
+ private:
+  /// 根页表（虚拟地址）
+  uint64_t *root_;
+  /// 页表页分配器
+  Allocator &allocator_;
+  /// Map 可使用的最高大页级别
+  size_t max_block_level_;
+
+  /**
+   * @brief 获取中间页表项指向的下一级页表
+   * @param entry 中间页表项
+   * @return uint64_t* 下一级页表（虚拟地址）
+   */
+  static auto GetNextTable(uint64_t entry) -> uint64_t * {
+    return reinterpret_cast<uint64_t *>(
+        PhysicalToVirtual(PageTableEntryToPhysical(entry)));
+  }
+
+  /**
+   * @brief 获取叶子页表项映射的物理基地址
+   * @param entry 叶子页表项
+   * @param level 页表项所在的级别
+   * @return uint64_t 按该级大小对齐的物理地址
+   */
+  static auto GetEntryBase(uint64_t entry, size_t level) -> uint64_t {
+    return PageTableEntryToPhysical(entry) & ~(GetLevelPageSize(level) - 1);
+  }
+
+  /**
+   * @brief 分配一张清零的页表
+   * @param entry 输出指向新页表的中间页表项
+   * @return uint64_t* 新页表（虚拟地址），失败时为 nullptr
+   */
+  auto AllocateTable(uint64_t &entry) -> uint64_t * {
+    auto *table = static_cast<uint64_t *>(allocator_.Allocate());
+    if (table != nullptr) {
+      entry = PhysicalToPageTableEntry(
+          VirtualToPhysical(reinterpret_cast<uint64_t>(table)),
+          GetTableEntryPermissions());
+    }
+    return table;
+  }
+
+  /**
+   * @brief 将大页拆分为下一级的一整张页表，映射与标志保持不变
+   * @param entry level 级的大页页表项，成功后指向新页表
+   * @param level 大页所在的级别
+   * @return true 成功
+   * @return false 分配页表失败，entry 保持不变
+   */
+  auto SplitBlock(uint64_t &entry, size_t level) -> bool {
+    auto base = GetEntryBase(entry, level);
+    auto flags = entry ^ PhysicalToPageTableEntry(
+                             PageTableEntryToPhysical(entry), 0);
+    uint64_t table_entry = 0;
+    auto *table = AllocateTable(table_entry);
+    if (table == nullptr) {
+      return false;
+    }
+    auto child_size = GetLevelPageSize(level - 1);
+    for (size_t i = 0; i <= kVpnMask; i++) {
+      table[i] = CreateBlockEntry(level - 1, base + i * child_size, flags);
+    }
+    entry = table_entry;
+    return true;
+  }
+
+  /**
+   * @brief 计算 [virtual_addr, virtual_addr + size) 按页对齐后的最后一个字节
+   * 使用包含的结束地址，结束于地址空间顶端的范围不会回绕为 0
+   * @param virtual_addr 起始虚拟地址
+   * @param size 大小，不为 0
+   * @return uint64_t 最后一页的最后一个字节
+   */
+  static auto GetRangeLast(uint64_t virtual_addr, size_t size) -> uint64_t {
+    return (virtual_addr + (size - 1)) | (kPageSize - 1);
+  }
+
+  /**
+   * @brief 计算 virtual_addr 所在的 level 级表项覆盖范围的最后一个字节
+   * @param virtual_addr 虚拟地址
+   * @param last_addr 操作范围的最后一个字节，结果不超过该值
+   * @param level 页表级别
+   * @return uint64_t 最后一个字节（包含）
+   */
+  static auto GetEntryLast(uint64_t virtual_addr, uint64_t last_addr,
+                           size_t level) -> uint64_t {
+    auto entry_last =
+        virtual_addr | ((1ULL << GetPageTableLevelShift(level)) - 1);
+    return entry_last > last_addr ? last_addr : entry_last;
+  }
+
+  /**
+   * @brief 在 table 中建立 [virtual_addr, last_addr] 的映射，按需分配下级页表
+   * @param table 当前页表
+   * @param level 当前页表级别
+   * @param virtual_addr 起始虚拟地址
+   * @param last_addr 最后一个字节的虚拟地址（包含），不小于 virtual_addr
+   * @param physical_addr 起始物理地址
+   * @param flags 叶子页表项标志
+   * @return true 成功
+   * @return false 分配页表失败
+   */
+  auto MapRange(uint64_t *table, size_t level, uint64_t virtual_addr,
+                uint64_t last_addr, uint64_t physical_addr, uint64_t flags)
+      -> bool {
+    while (true) {
+      auto entry_last = GetEntryLast(virtual_addr, last_addr, level);
+      auto &entry = table[GetVirtualPageNumber(virtual_addr, level)];
+      auto block_size = GetLevelPageSize(level);
+      if (level == 0 ||
+          (level <= max_block_level_ &&
+           entry_last - virtual_addr == block_size - 1 &&
+           (physical_addr & (block_size - 1)) == 0 &&
+           (!IsPageTableEntryValid(entry) || IsLeafEntry(entry, level)))) {
+        entry = CreateBlockEntry(level, physical_addr, flags);
+      } else {
+        if (!IsPageTableEntryValid(entry)) {
+          if (AllocateTable(entry) == nullptr) {
+            return false;
+          }
+        } else if (IsLeafEntry(entry, level) && !SplitBlock(entry, level)) {
+          return false;
+        }
+        if (!MapRange(GetNextTable(entry), level - 1, virtual_addr,
+                      entry_last, physical_addr, flags)) {
+          return false;
+        }
+      }
+      if (entry_last == last_addr) {
+        return true;
+      }
+      physical_addr += entry_last - virtual_addr + 1;
+      virtual_addr = entry_last + 1;
+    }
+  }
+
+  /**
+   * @brief 对 [virtual_addr, last_addr] 中有效的叶子页表项调用 visitor
+   * @param table 当前页表
+   * @param level 当前页表级别
+   * @param virtual_addr 起始虚拟地址
+   * @param last_addr 最后一个字节的虚拟地址（包含），不小于 virtual_addr
+   * @param visitor 以 `uint64_t &entry, size_t level` 为参数的回调
+   * @return size_t 访问的叶子页表项数量
+   * @note 只有一部分落在范围内的大页会先被拆分
+   */
+  template <class Visitor>
+  auto VisitLeaves(uint64_t *table, size_t level, uint64_t virtual_addr,
+                   uint64_t last_addr, Visitor &visitor) -> size_t {
+    size_t count = 0;
+    while (true) {
+      auto entry_last = GetEntryLast(virtual_addr, last_addr, level);
+      auto &entry = table[GetVirtualPageNumber(virtual_addr, level)];
+      if (IsLeafEntry(entry, level) &&
+          entry_last - virtual_addr == GetLevelPageSize(level) - 1) {
+        visitor(entry, level);
+        count++;
+      } else if (IsPageTableEntryValid(entry) &&
+                 (!IsLeafEntry(entry, level) || SplitBlock(entry, level))) {
+        count += VisitLeaves(GetNextTable(entry), level - 1, virtual_addr,
+                             entry_last, visitor);
+      }
+      if (entry_last == last_addr) {
+        return count;
+      }
+      virtual_addr = entry_last + 1;
+    }
+  }
+};
+
+}  // namespace virtual_memory
+}  // namespace cpu_io
+
+#endif /* CPU_IO_INCLUDE_PAGE_TABLE_HPP_ */
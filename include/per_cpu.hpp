@@ -0,0 +1,34 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_PER_CPU_HPP_
+#define CPU_IO_INCLUDE_PER_CPU_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cpu_io {
+
+/// 缓存行大小，用于避免不同核心写入的数据发生伪共享
+static constexpr size_t kCacheLineSize = 64;
+
+/**
+ * @brief 每核心数据区的头部
+ * 每核心数据结构须以该结构作为第一个成员，并通过 SetPerCpuBase()
+ * 安装到当前核心的基址寄存器中。self 与 core_id 的偏移由各架构的
+ * 快速访问路径直接使用，不能改变
+ */
+struct PerCpuHeader {
+  /// 指向自身，x86_64 通过 %gs:0 一次读出基址
+  PerCpuHeader *self;
+  /// 逻辑核心 ID
+  size_t core_id;
+};
+
+static_assert(offsetof(PerCpuHeader, self) == 0);
+static_assert(offsetof(PerCpuHeader, core_id) == 8);
+
+}  // namespace cpu_io
+
+#endif /* CPU_IO_INCLUDE_PER_CPU_HPP_ */
@@ -0,0 +1,218 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_REG_TRACE_HPP_
+#define CPU_IO_INCLUDE_REG_TRACE_HPP_
+
+#include <sys/cdefs.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "per_cpu.hpp"
+
+namespace cpu_io {
+
+/**
+ * @brief 寄存器访问类型
+ */
+enum class RegAccess : uint8_t {
+  kRead,
+  kWrite,
+  kSetBits,
+  kClearBits,
+};
+
+/**
+ * @brief 一次寄存器访问的记录
+ */
+struct RegTraceEvent {
+  /// 寄存器标识，指向 RegInfo 的类型名字符串，同一寄存器的地址相同
+  const char *reg;
+  /// 读到或写入的值，SetBits/ClearBits 为掩码 (x86_64 为位偏移)
+  uint64_t value;
+  /// 访问开始时的计数器值
+  uint64_t timestamp;
+  /// 访问耗时 (计数)，在虚拟机中包含陷入与模拟的开销
+  uint64_t cycles;
+  /// MSR 编号，其它寄存器为 0
+  uint32_t index;
+  /// 访问类型
+  RegAccess access;
+};
+
+/**
+ * @brief 寄存器访问钩子，在访问完成后调用
+ * @note 钩子中不能访问被跟踪的寄存器，否则会递归
+ */
+using RegTraceHook = void (*)(const RegTraceEvent &event);
+
+namespace detail::read_write {
+/// 当前的跟踪钩子，为空时每次访问只读取一次钩子指针，不读取计数器
+inline RegTraceHook reg_trace_hook = nullptr;
+
+/// HookRegTrace::Begin() 的结果，End() 使用同一个钩子
+struct RegTraceStart {
+  /// 访问开始时的钩子，为空时不记录
+  RegTraceHook hook;
+  /// 访问开始时的计数器值，hook 为空时为 0
+  uint64_t timestamp;
+};
+
+/**
+ * @brief 寄存器标识
+ * @tparam RegInfo 寄存器描述
+ * @return const char* 包含 RegInfo 类型名的字符串
+ */
+template <class RegInfo>
+static constexpr auto RegTraceName() -> const char * {
+  return __PRETTY_FUNCTION__;
+}
+
+/**
+ * @brief 将寄存器的值转换为记录中的 64 位值
+ * @param value 寄存器的值，结构体 (如 GDTR) 记录为 0
+ * @return uint64_t 记录的值
+ */
+template <class T>
+static __always_inline auto RegTraceValue(const T &value) -> uint64_t {
+  if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+    return static_cast<uint64_t>(value);
+  } else if constexpr (std::is_pointer_v<T>) {
+    return reinterpret_cast<uint64_t>(value);
+  } else {
+    return 0;
+  }
+}
+
+/**
+ * @brief 不跟踪，Begin()/End() 都是空操作，不增加任何指令
+ */
+struct NoRegTrace {
+  static constexpr bool kEnabled = false;
+
+  static __always_inline auto Begin() -> uint64_t { return 0; }
+
+  template <class RegInfo, class T>
+  static __always_inline void End(RegAccess, const T &, uint64_t,
+                                  uint32_t = 0) {}
+};
+
+/**
+ * @brief 访问前后读取计数器，访问完成后调用 SetRegTraceHook() 设置的钩子
+ * Begin() 读取钩子指针，为空时不读取计数器，End() 直接返回
+ * @tparam Clock 提供 static uint64_t Read() 的计数器，
+ * 由各架构直接以汇编读取，本身不被跟踪
+ * @note 访问期间设置或清除的钩子从下一次访问开始生效
+ */
+template <class Clock>
+struct HookRegTrace {
+  static constexpr bool kEnabled = true;
+
+  static __always_inline auto Begin() -> RegTraceStart {
+    auto hook = __atomic_load_n(&reg_trace_hook, __ATOMIC_RELAXED);
+    if (hook == nullptr) {
+      return {nullptr, 0};
+    }
+    return {hook, Clock::Read()};
+  }
+
+  template <class RegInfo, class T>
+  static __always_inline void End(RegAccess access, const T &value,
+                                  const RegTraceStart &start,
+                                  uint32_t index = 0) {
+    if (start.hook == nullptr) {
+      return;
+    }
+    auto cycles = Clock::Read() - start.timestamp;
+    start.hook({RegTraceName<RegInfo>(), RegTraceValue(value), start.timestamp,
+                cycles, index, access});
+  }
+};
+}  // namespace detail::read_write
+
+/**
+ * @brief 设置寄存器访问钩子
+ * @param hook 钩子，nullptr 表示停止记录
+ * @note 只在定义 CPU_IO_REG_TRACE 时生效，未定义时寄存器访问不含任何跟踪代码
+ */
+static __always_inline void SetRegTraceHook(RegTraceHook hook) {
+  __atomic_store_n(&detail::read_write::reg_trace_hook, hook,
+                   __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief 每核心的寄存器访问记录环
+ * 每个核心写自己的环，写满后覆盖最旧的记录，以原子加领取槽位，
+ * 同一核心上被中断打断的记录也不会互相覆盖
+ * @tparam kCapacity 每个核心的记录数，必须是 2 的幂
+ * @tparam kMaxCores 最大核心数
+ * @note 读取应在停止记录 (SetRegTraceHook(nullptr)) 后进行
+ */
+template <size_t kCapacity, size_t kMaxCores = 64>
+class RegTraceRings {
+  static_assert(kCapacity != 0 && (kCapacity & (kCapacity - 1)) == 0);
+
+ public:
+  /// @name 构造/析构函数
+  /// @{
+  RegTraceRings() = default;
+  RegTraceRings(const RegTraceRings &) = delete;
+  RegTraceRings(RegTraceRings &&) = delete;
+  auto operator=(const RegTraceRings &) -> RegTraceRings & = delete;
+  auto operator=(RegTraceRings &&) -> RegTraceRings & = delete;
+  ~RegTraceRings() = default;
+  /// @}
+
+  /**
+   * @brief 记录一次访问
+   * @param core 当前核心，需以不被跟踪的方式获得 (如每核心数据区)
+   * @param event 访问记录
+   */
+  void Record(size_t core, const RegTraceEvent &event) {
+    auto &ring = rings_[core];
+    auto slot = __atomic_fetch_add(&ring.head, 1, __ATOMIC_RELAXED);
+    ring.events[slot & kMask] = event;
+  }
+
+  /**
+   * @brief 获取核心记录过的访问总数，包括已被覆盖的
+   * @param core 核心
+   * @return uint64_t 访问总数
+   */
+  [[nodiscard]] auto Count(size_t core) const -> uint64_t {
+    return __atomic_load_n(&rings_[core].head, __ATOMIC_ACQUIRE);
+  }
+
+  /**
+   * @brief 从旧到新遍历核心保留的记录
+   * @param core 核心
+   * @param visitor 接受 const RegTraceEvent& 的可调用对象
+   */
+  template <class Visitor>
+  void ForEach(size_t core, Visitor visitor) const {
+    auto head = Count(core);
+    auto first = (head > kCapacity) ? head - kCapacity : 0;
+    for (auto i = first; i < head; i++) {
+      visitor(rings_[core].events[i & kMask]);
+    }
+  }
+
+ private:
+  static constexpr uint64_t kMask = kCapacity - 1;
+
+  /// 单个核心的记录环，与其它核心不共享缓存行
+  struct alignas(kCacheLineSize) Ring {
+    uint64_t head = 0;
+    std::array<RegTraceEvent, kCapacity> events{};
+  };
+
+  std::array<Ring, kMaxCores> rings_{};
+};
+
+}  // namespace cpu_io
+
+#endif /* CPU_IO_INCLUDE_REG_TRACE_HPP_ */
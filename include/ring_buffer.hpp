@@ -0,0 +1,130 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_RING_BUFFER_HPP_
+#define CPU_IO_INCLUDE_RING_BUFFER_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "per_cpu.hpp"
+
+namespace cpu_io {
+
+/**
+ * @brief 单生产者单消费者无锁环形缓冲区
+ * 生产者只写 head_，消费者只写 tail_，两者位于不同缓存行；
+ * 生产者与消费者可以是不同核心，也可以是同一核心上的普通代码与中断处理
+ * @tparam T 元素类型，需可平凡复制
+ * @tparam kCapacity 容量，必须是 2 的幂
+ */
+template <class T, size_t kCapacity>
+class SpscRing {
+  static_assert(kCapacity != 0 && (kCapacity & (kCapacity - 1)) == 0);
+
+ public:
+  /// @name 构造/析构函数
+  /// @{
+  SpscRing() = default;
+  SpscRing(const SpscRing &) = delete;
+  SpscRing(SpscRing &&) = delete;
+  auto operator=(const SpscRing &) -> SpscRing & = delete;
+  auto operator=(SpscRing &&) -> SpscRing & = delete;
+  ~SpscRing() = default;
+  /// @}
+
+  /**
+   * @brief 写入尽可能多的元素，由生产者调用
+   * @param data 要写入的元素
+   * @return size_t 实际写入的元素数
+   */
+  auto Push(std::span<const T> data) -> size_t {
+    auto head = __atomic_load_n(&head_, __ATOMIC_RELAXED);
+    auto tail = __atomic_load_n(&tail_, __ATOMIC_ACQUIRE);
+    auto count = kCapacity - (head - tail);
+    if (count > data.size()) {
+      count = data.size();
+    }
+    for (size_t i = 0; i < count; i++) {
+      buffer_[(head + i) & kMask] = data[i];
+    }
+    __atomic_store_n(&head_, head + count, __ATOMIC_RELEASE);
+    return count;
+  }
+
+  /**
+   * @brief 写入一个元素，由生产者调用
+   * @param value 要写入的元素
+   * @return true 成功，false 缓冲区已满
+   */
+  auto Push(const T &value) -> bool {
+    return Push(std::span<const T>(&value, 1)) == 1;
+  }
+
+  /**
+   * @brief 读出尽可能多的元素，由消费者调用
+   * @param data 输出缓冲区
+   * @return size_t 实际读出的元素数
+   */
+  auto Pop(std::span<T> data) -> size_t {
+    auto tail = __atomic_load_n(&tail_, __ATOMIC_RELAXED);
+    auto head = __atomic_load_n(&head_, __ATOMIC_ACQUIRE);
+    auto count = head - tail;
+    if (count > data.size()) {
+      count = data.size();
+    }
+    for (size_t i = 0; i < count; i++) {
+      data[i] = buffer_[(tail + i) & kMask];
+    }
+    __atomic_store_n(&tail_, tail + count, __ATOMIC_RELEASE);
+    return count;
+  }
+
+  /**
+   * @brief 读出一个元素，由消费者调用
+   * @param value 输出
+   * @return true 成功，false 缓冲区为空
+   */
+  auto Pop(T &value) -> bool { return Pop(std::span<T>(&value, 1)) == 1; }
+
+  /**
+   * @brief 获取当前元素数，并发修改时为近似值
+   * @return size_t 元素数
+   */
+  [[nodiscard]] auto Size() const -> size_t {
+    return __atomic_load_n(&head_, __ATOMIC_ACQUIRE) -
+           __atomic_load_n(&tail_, __ATOMIC_ACQUIRE);
+  }
+
+  /**
+   * @brief 检查是否为空
+   * @return true 为空
+   */
+  [[nodiscard]] auto IsEmpty() const -> bool { return Size() == 0; }
+
+  /**
+   * @brief 获取容量
+   * @return size_t 容量
+   */
+  [[nodiscard]] static constexpr auto Capacity() -> size_t {
+    return kCapacity;
+  }
+
+ private:
+  /// 下标掩码
+  static constexpr size_t kMask = kCapacity - 1;
+
+  /// 写位置，只由生产者修改
+  alignas(kCacheLineSize) size_t head_ = 0;
+  /// 读位置，只由消费者修改
+  alignas(kCacheLineSize) size_t tail_ = 0;
+  /// 数据
+  alignas(kCacheLineSize) std::array<T, kCapacity> buffer_{};
+};
+
+}  // namespace cpu_io
+
+#endif /* CPU_IO_INCLUDE_RING_BUFFER_HPP_ */
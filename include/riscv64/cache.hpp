@@ -0,0 +1,142 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_RISCV64_CACHE_HPP_
+#define CPU_IO_INCLUDE_RISCV64_CACHE_HPP_
+
+#include <sys/cdefs.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../cache_line.hpp"
+
+namespace cpu_io {
+
+namespace detail::cache {
+/// Zicbom 的缓存块大小，0 表示不支持 Zicbom
+inline size_t cbom_block_size = 0;
+
+/// cbo.inval
+static constexpr int kCboInval = 0;
+/// cbo.clean
+static constexpr int kCboClean = 1;
+/// cbo.flush
+static constexpr int kCboFlush = 2;
+
+/**
+ * @brief 对一个缓存块执行 Zicbom 操作，以 .insn 编码以免依赖汇编器支持
+ * @tparam kOp 操作：kCboInval/kCboClean/kCboFlush
+ * @param line 缓存块内的地址
+ */
+template <int kOp>
+static __always_inline void Cbo(uintptr_t line) {
+  __asm__ volatile(".insn i 0x0F, 2, x0, %0, %1" ::"r"(line), "i"(kOp)
+                   : "memory");
+}
+
+/**
+ * @brief 对范围内的缓存块执行 Zicbom 操作
+ * @tparam kOp 操作：kCboInval/kCboClean/kCboFlush
+ * @param addr 起始地址
+ * @param size 字节数
+ * @note 不支持 Zicbom 时认为平台的缓存与设备一致，只执行屏障
+ */
+template <int kOp>
+static __always_inline void CboRange(const void *addr, size_t size) {
+  if (cbom_block_size != 0) {
+    ForEachCacheLine(addr, size, cbom_block_size,
+                     [](uintptr_t line) { Cbo<kOp>(line); });
+  }
+  __asm__ volatile("fence iorw, iorw" ::: "memory");
+}
+}  // namespace detail::cache
+
+/**
+ * @brief 设置 Zicbom 的缓存块大小，启用缓存块操作
+ * @param size 缓存块大小，来自设备树的 riscv,cbom-block-size，0 表示不支持
+ * @note 需要 M 模式固件已在 menvcfg 中允许 S 模式执行 cbo.*
+ */
+static __always_inline void SetCacheBlockSize(size_t size) {
+  detail::cache::cbom_block_size = size;
+}
+
+/**
+ * @brief 将范围内的脏数据写回内存，缓存块保持有效
+ * 用于设备读取 CPU 写入的数据 (非一致性 DMA)
+ * @param addr 起始地址，不需要对齐
+ * @param size 字节数
+ */
+static __always_inline void CleanDcacheRange(const void *addr, size_t size) {
+  detail::cache::CboRange<detail::cache::kCboClean>(addr, size);
+}
+
+/**
+ * @brief 失效范围内的缓存块，用于 CPU 读取设备写入的数据
+ * 首尾不完整的缓存块与范围外的数据共享，改为 cbo.flush，避免丢失其修改
+ * @param addr 起始地址，不需要对齐
+ * @param size 字节数
+ * @note 固件也可能将 cbo.inval 配置为 cbo.flush
+ */
+static __always_inline void InvalidateDcacheRange(const void *addr,
+                                                  size_t size) {
+  auto block_size = detail::cache::cbom_block_size;
+  if (block_size != 0) {
+    auto start = reinterpret_cast<uintptr_t>(addr);
+    auto end = start + size;
+    auto mask = block_size - 1;
+    detail::ForEachCacheLine(addr, size, block_size, [=](uintptr_t line) {
+      if (line < start || line + mask >= end) {
+        detail::cache::Cbo<detail::cache::kCboFlush>(line);
+      } else {
+        detail::cache::Cbo<detail::cache::kCboInval>(line);
+      }
+    });
+  }
+  __asm__ volatile("fence iorw, iorw" ::: "memory");
+}
+
+/**
+ * @brief 写回并失效范围内的缓存块
+ * @param addr 起始地址，不需要对齐
+ * @param size 字节数
+ */
+static __always_inline void CleanInvalidateDcacheRange(const void *addr,
+                                                       size_t size) {
+  detail::cache::CboRange<detail::cache::kCboFlush>(addr, size);
+}
+
+/**
+ * @brief 使写入的指令对取指可见，用于 JIT 与加载模块
+ * @param addr 起始地址
+ * @param size 字节数
+ * @note fence.i 只作用于当前核心，其它核心需各自执行
+ */
+static __always_inline void SyncIcacheRange([[maybe_unused]] const void *addr,
+                                            [[maybe_unused]] size_t size) {
+  __asm__ volatile("fence.i" ::: "memory");
+}
+
+/**
+ * @brief 预取缓存块 (Zicbop)
+ * 编码为 ori x0，不支持 Zicbop 的处理器上为空操作
+ * @tparam kAccess 访问类型
+ * @tparam kLocality 时间局部性，Zicbop 不区分，只检查范围
+ * @param addr 地址
+ */
+template <PrefetchAccess kAccess = PrefetchAccess::kRead, int kLocality = 3>
+static __always_inline void Prefetch(const void *addr) {
+  static_assert(kLocality >= 0 && kLocality <= 3);
+  if constexpr (kAccess == PrefetchAccess::kWrite) {
+    // prefetch.w
+    __asm__ volatile(".insn i 0x13, 6, x0, %0, 3" ::"r"(addr));
+  } else {
+    // prefetch.r
+    __asm__ volatile(".insn i 0x13, 6, x0, %0, 1" ::"r"(addr));
+  }
+}
+
+}  // namespace cpu_io
+
+#endif  // CPU_IO_INCLUDE_RISCV64_CACHE_HPP_
@@ -190,6 +190,55 @@ struct CalleeSavedContext {
   __always_inline uint64_t& StackPointer() { return sp; }
 };
 
+/**
+ * @brief 中断快速路径的寄存器帧
+ * 只保存调用者保存的寄存器 (ra, t0-t6, a0-a7)、被打断时的 sp/gp/tp 与 CSR，
+ * s0-s11 由中断处理函数按调用约定自行保存。
+ * 从用户态进入时 gp 换成内核的 __global_pointer$，返回前恢复
+ *
+ * 19 (x1-x7, x10-x17, x28-x31) + 3 (CSR)
+ *   = 22 个 64 位值，共 176 字节 (16 字节对齐)
+ *
+ * 用于定时器/外部中断等异步中断，系统调用与异常仍使用 TrapContext
+ */
+struct InterruptFrame {
+  // x1: Return Address
+  uint64_t ra;
+  // x2: Stack Pointer (保存中断发生时的 SP)
+  uint64_t sp;
+  // x4: Thread Pointer
+  uint64_t tp;
+  // x5-x7: Temporary
+  uint64_t t0;
+  uint64_t t1;
+  uint64_t t2;
+  // x10-x17: Function Argument
+  uint64_t a0;
+  uint64_t a1;
+  uint64_t a2;
+  uint64_t a3;
+  uint64_t a4;
+  uint64_t a5;
+  uint64_t a6;
+  uint64_t a7;
+  // x28-x31: Temporary
+  uint64_t t3;
+  uint64_t t4;
+  uint64_t t5;
+  uint64_t t6;
+  // Supervisor Exception Program Counter
+  uint64_t sepc;
+  // Supervisor Status
+  uint64_t sstatus;
+  // Supervisor Cause
+  uint64_t scause;
+  // x3: Global Pointer，放在末尾以保持其它成员的偏移
+  uint64_t gp;
+};
+
+static_assert(sizeof(InterruptFrame) == 176,
+              "InterruptFrame size must be 176 bytes");
+
 #ifdef CPU_IO_ENABLE_FPU
 static_assert(sizeof(TrapContext) == 544, "TrapContext size must be 544 bytes");
 static_assert(sizeof(CalleeSavedContext) == 208,
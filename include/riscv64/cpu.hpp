@@ -7,11 +7,19 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <span>
 #include <type_traits>
 #include <typeinfo>
 
+#include "../clock.hpp"
+#include "../per_cpu.hpp"
+#include "cache.hpp"
 #include "context.hpp"
+#include "fpu.hpp"
+#include "pmu.hpp"
 #include "regs.hpp"
+#include "sbi.hpp"
+#include "trap_entry.hpp"
 #include "virtual_memory.hpp"
 
 namespace cpu_io {
@@ -32,6 +40,8 @@ using Sie = detail::regs::csr::Sie;
 using Time = detail::regs::csr::Time;
 using Cycle = detail::regs::csr::Cycle;
 using Instret = detail::regs::csr::Instret;
+using Scounteren = detail::regs::csr::Scounteren;
+using Scountovf = detail::regs::csr::Scountovf;
 using Sscratch = detail::regs::csr::Sscratch;
 using Sepc = detail::regs::csr::Sepc;
 using Scause = detail::regs::csr::Scause;
@@ -39,6 +49,9 @@ using Stval = detail::regs::csr::Stval;
 using Satp = detail::regs::csr::Satp;
 using Stimecmp = detail::regs::csr::Stimecmp;
 
+template <class Reg>
+using CachedReg = detail::read_write::CachedReg<Reg>;
+
 /**
  * @brief 内存屏障
  */
@@ -60,6 +73,20 @@ static __always_inline auto Wmb() -> void {
   __asm__ volatile("fence ow, ow" ::: "memory");
 }
 
+/**
+ * @brief 设备读屏障，在设备读之后调用，保证其先于之后的读
+ */
+static __always_inline auto IoRmb() -> void {
+  __asm__ volatile("fence i, ir" ::: "memory");
+}
+
+/**
+ * @brief 设备写屏障，在设备写之前调用，保证之前的写先于设备写
+ */
+static __always_inline auto IoWmb() -> void {
+  __asm__ volatile("fence w, o" ::: "memory");
+}
+
 /**
  * @brief 允许中断
  */
@@ -78,18 +105,363 @@ static __always_inline auto GetInterruptStatus() -> bool {
   return Sstatus::Sie::Get();
 }
 
+/**
+ * @brief 保存中断状态并关闭中断
+ * 一条 csrrci 同时读出 sstatus 并清除 SIE
+ * @return uint64_t 关闭前的 sstatus，交给 IrqRestore()
+ */
+static __always_inline auto IrqSave() -> uint64_t {
+  uint64_t flags;
+  __asm__ volatile("csrrci %0, sstatus, %1"
+                   : "=r"(flags)
+                   : "i"(SstatusInfo::Sie::kBitMask)
+                   : "memory");
+  return flags;
+}
+
+/**
+ * @brief 恢复 IrqSave() 保存的中断状态
+ * 只恢复 SIE，不影响期间被修改的 FS/VS 等其它位
+ * @param flags IrqSave() 的返回值
+ */
+static __always_inline void IrqRestore(uint64_t flags) {
+  __asm__ volatile("csrs sstatus, %0"
+                   :
+                   : "r"(flags & SstatusInfo::Sie::kBitMask)
+                   : "memory");
+}
+
 /**
  * @brief 获取当前 core id
  * @return size_t core id
  */
 static __always_inline auto GetCurrentCoreId() -> size_t { return Tp::Read(); }
 
+/**
+ * @brief 设置当前核心的每核心数据区
+ * 基址保存在 sscratch 中，tp 仍保存 core id
+ * @param header 每核心数据区，core_id 需已填写
+ * @note trap 入口若借用 sscratch 交换栈指针，返回前需恢复其值
+ */
+static __always_inline void SetPerCpuBase(PerCpuHeader *header) {
+  header->self = header;
+  Sscratch::Write(reinterpret_cast<uint64_t>(header));
+  Tp::Write(header->core_id);
+}
+
+/**
+ * @brief 获取当前核心的每核心数据区
+ * @return PerCpuHeader* 每核心数据区，一次 sscratch 读
+ */
+static __always_inline auto GetPerCpuBase() -> PerCpuHeader * {
+  return reinterpret_cast<PerCpuHeader *>(Sscratch::Read());
+}
+
+/**
+ * @brief 获取逻辑核心 ID
+ * @return size_t core id，直接读取 tp
+ */
+static __always_inline auto GetPerCpuCoreId() -> size_t { return Tp::Read(); }
+
+/**
+ * @brief 获取当前核心的每核心数据
+ * @tparam T 每核心数据类型，第一个成员须为 PerCpuHeader
+ * @return T& 每核心数据
+ */
+template <class T>
+static __always_inline auto PerCpu() -> T & {
+  static_assert(std::is_standard_layout_v<T>);
+  return *reinterpret_cast<T *>(GetPerCpuBase());
+}
+
 /**
  * @brief CPU 空转指令
  * @note RISC-V pause hint 指令
  */
 static __always_inline void Pause() { __asm__ volatile("pause" ::: "memory"); }
 
+/**
+ * @brief 自旋等待，直到 *addr 满足条件
+ * 以支持 Zawrs 的 -march 编译时，lr 设置保留集后 wrs.nto 休眠，
+ * 其它核心写该地址时唤醒；否则每次读之间执行 pause
+ * @tparam T 4 或 8 字节的整数或指针类型
+ * @param addr 等待的地址
+ * @param done 条件，参数为读到的值
+ * @return T 满足条件时读到的值，读带 acquire 语义
+ */
+template <class T, class Pred>
+static __always_inline auto SpinUntil(const T *addr, Pred done) -> T {
+  static_assert(sizeof(T) == 4 || sizeof(T) == 8);
+  T value = __atomic_load_n(addr, __ATOMIC_ACQUIRE);
+  while (!done(value)) {
+#ifdef __riscv_zawrs
+    if constexpr (sizeof(T) == 4) {
+      __asm__ volatile("lr.w.aq %0, (%1)"
+                       : "=&r"(value)
+                       : "r"(addr)
+                       : "memory");
+    } else {
+      __asm__ volatile("lr.d.aq %0, (%1)"
+                       : "=&r"(value)
+                       : "r"(addr)
+                       : "memory");
+    }
+    if (done(value)) {
+      break;
+    }
+    __asm__ volatile("wrs.nto" ::: "memory");
+#else
+    Pause();
+    value = __atomic_load_n(addr, __ATOMIC_ACQUIRE);
+#endif
+  }
+  return value;
+}
+
+/**
+ * @brief 读取 time CSR，不等待之前的指令完成
+ * @return uint64_t 计数值
+ * @note 使用固定频率的 time 而不是随核心频率变化的 cycle
+ */
+static __always_inline auto ReadCycles() -> uint64_t { return Time::Read(); }
+
+/**
+ * @brief 读取 time CSR，之前的访存完成后才读取
+ * @return uint64_t 计数值
+ * @note fence; rdtime
+ */
+static __always_inline auto ReadCyclesSerialized() -> uint64_t {
+  uint64_t value;
+  __asm__ volatile("fence\n\tcsrr %0, time" : "=r"(value) : : "memory");
+  return value;
+}
+
+/**
+ * @brief 读取纳秒时间戳，不等待之前的指令完成
+ * @return uint64_t 纳秒，CalibrateTimestamp() 之前为 0
+ */
+static __always_inline auto ReadTimestamp() -> uint64_t {
+  return CyclesToNs(ReadCycles());
+}
+
+/**
+ * @brief 读取纳秒时间戳，之前的访存完成后才读取
+ * @return uint64_t 纳秒，CalibrateTimestamp() 之前为 0
+ */
+static __always_inline auto ReadTimestampSerialized() -> uint64_t {
+  return CyclesToNs(ReadCyclesSerialized());
+}
+
+/**
+ * @brief 等待 *addr 不再等于 expected
+ * 以支持 Zawrs 的 -march 编译时，lr 设置保留集后 wrs.sto 短暂休眠，
+ * 写该地址时提前唤醒；否则每次读之间执行 pause
+ * @tparam T 4 或 8 字节的整数类型
+ * @param addr 等待的地址
+ * @param expected 继续等待的值
+ * @param timeout_ns 超时 (纳秒)，需先 CalibrateTimestamp()
+ * @return true *addr 已改变，false 超时
+ */
+template <class T>
+static __always_inline auto WaitOnAddress(const T *addr, T expected,
+                                          uint64_t timeout_ns = kWaitForever)
+    -> bool {
+  static_assert(sizeof(T) == 4 || sizeof(T) == 8);
+  auto deadline = detail::CyclesDeadline(ReadCycles(), timeout_ns);
+  while (true) {
+    T value;
+#ifdef __riscv_zawrs
+    if constexpr (sizeof(T) == 4) {
+      __asm__ volatile("lr.w.aq %0, (%1)"
+                       : "=&r"(value)
+                       : "r"(addr)
+                       : "memory");
+    } else {
+      __asm__ volatile("lr.d.aq %0, (%1)"
+                       : "=&r"(value)
+                       : "r"(addr)
+                       : "memory");
+    }
+#else
+    value = __atomic_load_n(addr, __ATOMIC_ACQUIRE);
+#endif
+    if (value != expected) {
+      return true;
+    }
+    if (ReadCycles() >= deadline) {
+      return false;
+    }
+#ifdef __riscv_zawrs
+    __asm__ volatile("wrs.sto" ::: "memory");
+#else
+    Pause();
+#endif
+  }
+}
+
+/**
+ * @brief 使当前核心进入低功耗状态，直到有中断挂起
+ * sie 中允许的中断挂起时 wfi 返回，与 sstatus.SIE 无关
+ * @param hint 保留，更深的状态需通过 SBI HSM hart_suspend
+ * @pre 已关闭中断，并确认没有待处理的工作
+ */
+static __always_inline void Idle([[maybe_unused]] uint32_t hint = 0) {
+  __asm__ volatile("wfi" ::: "memory");
+}
+
+/**
+ * @brief 设置 time CSR 的频率与纳秒换算系数
+ * @param timebase_frequency time 频率 (Hz)，来自设备树
+ * /cpus/timebase-frequency
+ * @return uint64_t time 频率 (Hz)
+ */
+static __always_inline auto CalibrateTimestamp(uint64_t timebase_frequency)
+    -> uint64_t {
+  SetTimestampFrequency(timebase_frequency);
+  return timebase_frequency;
+}
+
+namespace detail {
+/**
+ * @brief 以 SBI HSM hart_start 启动从核心，见 StartSecondaryCores()
+ * hart_start 在固件发出启动请求后即返回，连续调用使各核心并行启动
+ * @param entry 入口物理地址
+ * @param stacks 栈顶地址，作为 opaque 传入 a1
+ * @param hw_ids hart ID
+ * @return size_t 应完成初始化的从核心数
+ */
+static __always_inline auto StartCores(uint64_t entry,
+                                       std::span<const uint64_t> stacks,
+                                       std::span<const uint64_t> hw_ids)
+    -> size_t {
+  auto count = stacks.size() < hw_ids.size() ? stacks.size() : hw_ids.size();
+  size_t started = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (sbi::HartStart(hw_ids[i], entry, stacks[i]).error == sbi::SUCCESS) {
+      started++;
+    }
+  }
+  return started;
+}
+}  // namespace detail
+
+/**
+ * @brief 本地定时器
+ * 使用 Sstc 扩展的 stimecmp，周期模式由软件重装
+ * @note 每个核心一个实例
+ */
+class LocalTimer {
+ public:
+  /// @name 构造/析构函数
+  /// @{
+  LocalTimer() = default;
+  LocalTimer(const LocalTimer &) = delete;
+  LocalTimer(LocalTimer &&) = delete;
+  auto operator=(const LocalTimer &) -> LocalTimer & = delete;
+  auto operator=(LocalTimer &&) -> LocalTimer & = delete;
+  ~LocalTimer() = default;
+  /// @}
+
+  /**
+   * @brief 设置 time CSR 的频率
+   * @param timebase_frequency time 频率 (Hz)，来自设备树
+   * /cpus/timebase-frequency
+   * @return uint64_t 定时器频率 (Hz)
+   */
+  auto Calibrate(uint64_t timebase_frequency) -> uint64_t {
+    return CalibrateTimestamp(timebase_frequency);
+  }
+
+  /**
+   * @brief 停止定时器
+   */
+  void Stop() {
+    period_ = 0;
+    Stimecmp::Write(UINT64_MAX);
+  }
+
+  /**
+   * @brief 获取定时器频率
+   * @return uint64_t 定时器频率 (Hz)，未校准时为 0
+   */
+  [[nodiscard]] auto GetFrequency() const -> uint64_t {
+    return GetTimestampFrequency();
+  }
+
+  /**
+   * @brief 启动周期模式
+   * 比较值在每次 Acknowledge() 时按周期累加，不随中断延迟漂移
+   * @param period_ns 周期 (纳秒)
+   * @pre 已调用 Calibrate()
+   */
+  void StartPeriodic(uint64_t period_ns) {
+    period_ = NsToCycles(period_ns);
+    if (period_ == 0) {
+      period_ = 1;
+    }
+    deadline_ = ReadCycles() + period_;
+    Arm(deadline_);
+  }
+
+  /**
+   * @brief 启动单次模式
+   * @param delay_ns 距现在的延迟 (纳秒)
+   * @pre 已调用 Calibrate()
+   */
+  void StartOneShot(uint64_t delay_ns) {
+    SetDeadline(ReadCycles() + NsToCycles(delay_ns));
+  }
+
+  /**
+   * @brief 计数器到达 deadline 时触发一次中断
+   * @param deadline 绝对计数值，与 ReadCycles() 同一时基
+   */
+  void SetDeadline(uint64_t deadline) {
+    period_ = 0;
+    deadline_ = deadline;
+    Arm(deadline_);
+  }
+
+  /**
+   * @brief 在定时器中断处理中调用
+   * 周期模式下设置下一次比较值，已错过的周期被跳过；单次模式下停止定时器，
+   * 以撤销电平中断
+   */
+  void Acknowledge() {
+    if (period_ == 0) {
+      Stop();
+      return;
+    }
+    deadline_ += period_;
+    auto now = ReadCycles();
+    if (deadline_ <= now) {
+      deadline_ = now + period_;
+    }
+    Arm(deadline_);
+  }
+
+  /**
+   * @brief 是否支持绝对时间 deadline 模式
+   * @return true 支持
+   */
+  [[nodiscard]] static auto IsDeadlineSupported() -> bool { return true; }
+
+ private:
+  /// 周期 (计数)，0 表示单次模式
+  uint64_t period_ = 0;
+  /// 当前比较值
+  uint64_t deadline_ = 0;
+
+  /**
+   * @brief 写入比较值并允许定时器中断
+   * @param deadline 绝对计数值
+   */
+  static void Arm(uint64_t deadline) {
+    Stimecmp::Write(deadline);
+    Sie::Stie::Set();
+  }
+};
+
 }  // namespace cpu_io
 
 #endif  // CPU_IO_INCLUDE_RISCV64_CPU_HPP_
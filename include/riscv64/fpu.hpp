@@ -0,0 +1,404 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_RISCV64_FPU_HPP_
+#define CPU_IO_INCLUDE_RISCV64_FPU_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "regs.hpp"
+
+namespace cpu_io {
+
+/// 扩展状态保存区的对齐要求
+static constexpr size_t kExtendedStateAlign = 16;
+
+namespace detail {
+
+/// 浮点部分大小：fcsr + f0-f31，向上对齐到 16 字节
+static constexpr size_t kFpStateSize = 272;
+/// 向量控制寄存器所占字节数：vstart, vl, vtype, vcsr
+static constexpr size_t kVectorControlSize = 32;
+
+/// 扩展状态保存区的大小
+inline size_t extended_state_size = kFpStateSize;
+/// 是否实现向量扩展
+inline bool extended_state_vector = false;
+
+using SstatusInfo = register_info::csr::SstatusInfo;
+using Sstatus = regs::csr::Sstatus;
+
+/**
+ * @brief 保存浮点寄存器
+ * @param area 保存区
+ */
+static __always_inline void SaveFpState(void *area) {
+  uint64_t tmp;
+  __asm__ volatile(
+      ".option push\n\t"
+      ".option arch, +d\n\t"
+      "frcsr %0\n\t"
+      "sd %0, 0(%1)\n\t"
+      "fsd f0, 8(%1)\n\t"
+      "fsd f1, 16(%1)\n\t"
+      "fsd f2, 24(%1)\n\t"
+      "fsd f3, 32(%1)\n\t"
+      "fsd f4, 40(%1)\n\t"
+      "fsd f5, 48(%1)\n\t"
+      "fsd f6, 56(%1)\n\t"
+      "fsd f7, 64(%1)\n\t"
+      "fsd f8, 72(%1)\n\t"
+      "fsd f9, 80(%1)\n\t"
+      "fsd f10, 88(%1)\n\t"
+      "fsd f11, 96(%1)\n\t"
+      "fsd f12, 104(%1)\n\t"
+      "fsd f13, 112(%1)\n\t"
+      "fsd f14, 120(%1)\n\t"
+      "fsd f15, 128(%1)\n\t"
+      "fsd f16, 136(%1)\n\t"
+      "fsd f17, 144(%1)\n\t"
+      "fsd f18, 152(%1)\n\t"
+      "fsd f19, 160(%1)\n\t"
+      "fsd f20, 168(%1)\n\t"
+      "fsd f21, 176(%1)\n\t"
+      "fsd f22, 184(%1)\n\t"
+      "fsd f23, 192(%1)\n\t"
+      "fsd f24, 200(%1)\n\t"
+      "fsd f25, 208(%1)\n\t"
+      "fsd f26, 216(%1)\n\t"
+      "fsd f27, 224(%1)\n\t"
+      "fsd f28, 232(%1)\n\t"
+      "fsd f29, 240(%1)\n\t"
+      "fsd f30, 248(%1)\n\t"
+      "fsd f31, 256(%1)\n\t"
+      ".option pop"
+      : "=&r"(tmp)
+      : "r"(area)
+      : "memory");
+}
+
+/**
+ * @brief 恢复浮点寄存器
+ * @param area 保存区
+ */
+static __always_inline void RestoreFpState(const void *area) {
+  uint64_t tmp;
+  __asm__ volatile(
+      ".option push\n\t"
+      ".option arch, +d\n\t"
+      "ld %0, 0(%1)\n\t"
+      "fscsr %0\n\t"
+      "fld f0, 8(%1)\n\t"
+      "fld f1, 16(%1)\n\t"
+      "fld f2, 24(%1)\n\t"
+      "fld f3, 32(%1)\n\t"
+      "fld f4, 40(%1)\n\t"
+      "fld f5, 48(%1)\n\t"
+      "fld f6, 56(%1)\n\t"
+      "fld f7, 64(%1)\n\t"
+      "fld f8, 72(%1)\n\t"
+      "fld f9, 80(%1)\n\t"
+      "fld f10, 88(%1)\n\t"
+      "fld f11, 96(%1)\n\t"
+      "fld f12, 104(%1)\n\t"
+      "fld f13, 112(%1)\n\t"
+      "fld f14, 120(%1)\n\t"
+      "fld f15, 128(%1)\n\t"
+      "fld f16, 136(%1)\n\t"
+      "fld f17, 144(%1)\n\t"
+      "fld f18, 152(%1)\n\t"
+      "fld f19, 160(%1)\n\t"
+      "fld f20, 168(%1)\n\t"
+      "fld f21, 176(%1)\n\t"
+      "fld f22, 184(%1)\n\t"
+      "fld f23, 192(%1)\n\t"
+      "fld f24, 200(%1)\n\t"
+      "fld f25, 208(%1)\n\t"
+      "fld f26, 216(%1)\n\t"
+      "fld f27, 224(%1)\n\t"
+      "fld f28, 232(%1)\n\t"
+      "fld f29, 240(%1)\n\t"
+      "fld f30, 248(%1)\n\t"
+      "fld f31, 256(%1)\n\t"
+      ".option pop"
+      : "=&r"(tmp)
+      : "r"(area)
+      : "memory");
+}
+
+/**
+ * @brief 保存向量寄存器
+ * 整寄存器存取不依赖 vl/vtype，vl/vtype 本身单独保存
+ * @param area 保存区
+ */
+static __always_inline void SaveVectorState(void *area) {
+  auto base = static_cast<uint8_t *>(area) + kFpStateSize;
+  uint64_t tmp;
+  uint64_t step;
+  __asm__ volatile(
+      ".option push\n\t"
+      ".option arch, +v\n\t"
+      "csrr %0, vstart\n\t"
+      "sd %0, 0(%2)\n\t"
+      "csrr %0, vl\n\t"
+      "sd %0, 8(%2)\n\t"
+      "csrr %0, vtype\n\t"
+      "sd %0, 16(%2)\n\t"
+      "csrr %0, vcsr\n\t"
+      "sd %0, 24(%2)\n\t"
+      "addi %2, %2, 32\n\t"
+      // 每组 8 个寄存器
+      "csrr %1, vlenb\n\t"
+      "slli %1, %1, 3\n\t"
+      "vs8r.v v0, (%2)\n\t"
+      "add %2, %2, %1\n\t"
+      "vs8r.v v8, (%2)\n\t"
+      "add %2, %2, %1\n\t"
+      "vs8r.v v16, (%2)\n\t"
+      "add %2, %2, %1\n\t"
+      "vs8r.v v24, (%2)\n\t"
+      ".option pop"
+      : "=&r"(tmp), "=&r"(step), "+r"(base)
+      :
+      : "memory");
+}
+
+/**
+ * @brief 恢复向量寄存器
+ * @param area 保存区
+ */
+static __always_inline void RestoreVectorState(const void *area) {
+  auto base = static_cast<const uint8_t *>(area) + kFpStateSize;
+  uint64_t tmp;
+  uint64_t step;
+  __asm__ volatile(
+      ".option push\n\t"
+      ".option arch, +v\n\t"
+      "addi %2, %2, 32\n\t"
+      "csrr %1, vlenb\n\t"
+      "slli %1, %1, 3\n\t"
+      "vl8re8.v v0, (%2)\n\t"
+      "add %2, %2, %1\n\t"
+      "vl8re8.v v8, (%2)\n\t"
+      "add %2, %2, %1\n\t"
+      "vl8re8.v v16, (%2)\n\t"
+      "add %2, %2, %1\n\t"
+      "vl8re8.v v24, (%2)\n\t"
+      "addi %2, %2, -32\n\t"
+      "sub %2, %2, %1\n\t"
+      "sub %2, %2, %1\n\t"
+      "sub %2, %2, %1\n\t"
+      // vsetvl 会清零 vstart，需最后恢复
+      "ld %0, 8(%2)\n\t"
+      "ld %1, 16(%2)\n\t"
+      "vsetvl zero, %0, %1\n\t"
+      "ld %0, 24(%2)\n\t"
+      "csrw vcsr, %0\n\t"
+      "ld %0, 0(%2)\n\t"
+      "csrw vstart, %0\n\t"
+      ".option pop"
+      : "=&r"(tmp), "=&r"(step), "+r"(base)
+      :
+      : "memory");
+}
+
+}  // namespace detail
+
+/**
+ * @brief 启用浮点扩展，调用者确认实现了向量扩展时同时启用向量扩展
+ * S 模式无法读取 misa，未实现向量扩展时 sstatus.VS 也不保证恒为 0，
+ * 因此由调用者根据设备树 riscv,isa / riscv,isa-extensions 判断，
+ * 未实现时不修改 VS，也不读取 vlenb；需在每个核心上调用一次
+ * @param has_vector 处理器实现了向量扩展 (V)
+ * @return true 已启用向量扩展
+ */
+static __always_inline auto EnableExtendedState(bool has_vector = false)
+    -> bool {
+  if (has_vector) {
+    detail::Sstatus::Modify(
+        detail::Sstatus::Fs::Value(detail::SstatusInfo::kExtensionInitial),
+        detail::Sstatus::Vs::Value(detail::SstatusInfo::kExtensionInitial));
+  } else {
+    detail::Sstatus::Fs::Write(detail::SstatusInfo::kExtensionInitial);
+  }
+  detail::extended_state_vector = has_vector;
+  detail::extended_state_size = detail::kFpStateSize;
+  if (detail::extended_state_vector) {
+    uint64_t vlenb;
+    __asm__ volatile("csrr %0, vlenb" : "=r"(vlenb));
+    detail::extended_state_size += detail::kVectorControlSize + 32 * vlenb;
+  }
+  return detail::extended_state_vector;
+}
+
+/**
+ * @brief 获取扩展状态保存区的大小
+ * @return size_t 字节数
+ */
+static __always_inline auto GetExtendedStateSize() -> size_t {
+  return detail::extended_state_size;
+}
+
+/**
+ * @brief 初始化扩展状态保存区，恢复后所有寄存器为 0
+ * @param area 保存区，kExtendedStateAlign 对齐，大小为 GetExtendedStateSize()
+ */
+static __always_inline void InitExtendedState(void *area) {
+  __builtin_memset(area, 0, detail::extended_state_size);
+}
+
+/**
+ * @brief 保存全部扩展状态
+ * @param area 保存区，kExtendedStateAlign 对齐
+ * @pre sstatus.FS/VS 不为 Off
+ */
+static __always_inline void SaveExtendedState(void *area) {
+  detail::SaveFpState(area);
+  if (detail::extended_state_vector) {
+    detail::SaveVectorState(area);
+  }
+}
+
+/**
+ * @brief 恢复全部扩展状态
+ * @param area 由 SaveExtendedState() 或 InitExtendedState() 写入的保存区
+ * @pre sstatus.FS/VS 不为 Off
+ */
+static __always_inline void RestoreExtendedState(const void *area) {
+  detail::RestoreFpState(area);
+  if (detail::extended_state_vector) {
+    detail::RestoreVectorState(area);
+  }
+}
+
+/**
+ * @brief 延迟切换扩展状态，每个核心一个实例
+ * 利用 sstatus.FS/VS 的 Dirty 状态：切换线程时只保存被修改过的部分，
+ * 下一个线程不是寄存器中状态的所有者时把 FS/VS 设为 Off；
+ * 该线程首次使用浮点/向量指令时产生非法指令异常，
+ * 在处理中判断 IsTrapped() 后调用 HandleTrap() 恢复当前线程的状态。
+ * 从不使用浮点/向量的线程不会产生任何保存/恢复
+ * @note 陷入返回路径若从 TrapContext 恢复 sstatus，需先用 MergeStatus()
+ * 更新其中的 FS/VS；线程迁移到其它核心前需在原核心上调用 Flush()
+ */
+class LazyFpu {
+ public:
+  /// @name 构造/析构函数
+  /// @{
+  LazyFpu() = default;
+  LazyFpu(const LazyFpu &) = delete;
+  LazyFpu(LazyFpu &&) = delete;
+  auto operator=(const LazyFpu &) -> LazyFpu & = delete;
+  auto operator=(LazyFpu &&) -> LazyFpu & = delete;
+  ~LazyFpu() = default;
+  /// @}
+
+  /**
+   * @brief 切换线程时调用
+   * @param next 下一个线程的保存区
+   */
+  void Switch(const void *next) {
+    SaveDirty();
+    SetStatus(next == owner_ ? detail::SstatusInfo::kExtensionClean
+                             : detail::SstatusInfo::kExtensionOff);
+  }
+
+  /**
+   * @brief 浮点/向量访问陷入处理
+   * @param current 当前线程的保存区
+   */
+  void HandleTrap(void *current) {
+    SetStatus(detail::SstatusInfo::kExtensionClean);
+    if (owner_ != current) {
+      // 原所有者的修改已在 Switch() 中保存
+      RestoreExtendedState(current);
+      owner_ = current;
+    }
+  }
+
+  /**
+   * @brief 把寄存器中被修改的状态写回所有者的保存区并放弃所有权
+   */
+  void Flush() {
+    SaveDirty();
+    owner_ = nullptr;
+    SetStatus(detail::SstatusInfo::kExtensionOff);
+  }
+
+  /**
+   * @brief 线程退出时调用，丢弃其寄存器中的状态
+   * @param area 退出线程的保存区
+   */
+  void Release(const void *area) {
+    if (owner_ == area) {
+      owner_ = nullptr;
+    }
+  }
+
+  /**
+   * @brief 获取寄存器中状态的所有者
+   * @return void* 所有者的保存区，没有所有者时为 nullptr
+   */
+  [[nodiscard]] auto GetOwner() const -> void * { return owner_; }
+
+  /**
+   * @brief 非法指令异常是否由关闭的浮点扩展引起
+   * @return true 当前 sstatus.FS 为 Off
+   * @note 访问向量寄存器时同样可能因 VS 为 Off 陷入，二者同时开关
+   */
+  [[nodiscard]] static auto IsTrapped() -> bool {
+    return detail::Sstatus::Fs::Get() == detail::SstatusInfo::kExtensionOff;
+  }
+
+  /**
+   * @brief 用当前 sstatus 的 FS/VS 替换保存的 sstatus 中的对应位
+   * @param saved TrapContext 中保存的 sstatus
+   * @return uint64_t 更新后的 sstatus
+   */
+  [[nodiscard]] static auto MergeStatus(uint64_t saved) -> uint64_t {
+    constexpr auto kMask =
+        detail::SstatusInfo::Fs::kBitMask | detail::SstatusInfo::Vs::kBitMask;
+    return (saved & ~kMask) | (detail::Sstatus::Read() & kMask);
+  }
+
+ private:
+  /// 寄存器中状态的所有者
+  void *owner_ = nullptr;
+
+  /**
+   * @brief 保存所有者被修改过的部分，FS/VS 由调用者随后修改
+   */
+  void SaveDirty() {
+    if (owner_ == nullptr) {
+      return;
+    }
+    auto status = detail::Sstatus::Read();
+    auto dirty = detail::SstatusInfo::kExtensionDirty;
+    if (detail::Sstatus::Fs::Get(status) == dirty) {
+      detail::SaveFpState(owner_);
+    }
+    if (detail::extended_state_vector &&
+        detail::Sstatus::Vs::Get(status) == dirty) {
+      detail::SaveVectorState(owner_);
+    }
+  }
+
+  /**
+   * @brief 同时设置 FS 与 VS
+   * @param state SstatusInfo::kExtension*
+   */
+  static void SetStatus(uint8_t state) {
+    if (detail::extended_state_vector) {
+      detail::Sstatus::Modify(detail::Sstatus::Fs::Value(state),
+                              detail::Sstatus::Vs::Value(state));
+    } else {
+      detail::Sstatus::Fs::Write(state);
+    }
+  }
+};
+
+}  // namespace cpu_io
+
+#endif  // CPU_IO_INCLUDE_RISCV64_FPU_HPP_
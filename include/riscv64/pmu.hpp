@@ -0,0 +1,270 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_RISCV64_PMU_HPP_
+#define CPU_IO_INCLUDE_RISCV64_PMU_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "regs.hpp"
+#include "sbi.hpp"
+
+namespace cpu_io {
+/**
+ * @brief 性能监控计数器 (SBI PMU 扩展)
+ * S 模式不能配置 mhpmevent，事件的选择、启停由固件完成，
+ * 硬件计数器直接读对应的 CSR。
+ * 计数器 i 为 SBI 的逻辑计数器号，对应计数器掩码的第 i 位；
+ * cycle/instret 事件只能配置到对应的固定计数器 (通常为 0 与 2)
+ * @see https://github.com/riscv-non-isa/riscv-sbi-doc
+ */
+namespace pmu {
+
+/// 统计用户态 (U 模式)
+static constexpr uint32_t kUser = 1U << 0;
+/// 统计内核态 (S 模式)
+static constexpr uint32_t kKernel = 1U << 1;
+/// 溢出时产生中断，RISC-V 上由 EnableOverflowInterrupt() 统一控制
+static constexpr uint32_t kInterrupt = 1U << 2;
+
+/**
+ * @brief SBI 硬件通用事件，[19:16] 为事件类型 0
+ */
+namespace event {
+/// SBI_PMU_HW_CPU_CYCLES
+static constexpr uint64_t kCpuCycles = 1;
+/// SBI_PMU_HW_INSTRUCTIONS
+static constexpr uint64_t kInstructions = 2;
+/// SBI_PMU_HW_CACHE_REFERENCES
+static constexpr uint64_t kCacheReferences = 3;
+/// SBI_PMU_HW_CACHE_MISSES
+static constexpr uint64_t kCacheMisses = 4;
+/// SBI_PMU_HW_BRANCH_INSTRUCTIONS
+static constexpr uint64_t kBranchInstructions = 5;
+/// SBI_PMU_HW_BRANCH_MISSES
+static constexpr uint64_t kBranchMisses = 6;
+}  // namespace event
+
+/**
+ * @brief 性能监控能力
+ */
+struct Info {
+  /// 计数器数量 (硬件与固件)，0 表示固件不支持 PMU 扩展
+  uint8_t counters;
+};
+
+namespace detail {
+/// 支持的最大计数器数量，与计数器掩码的位数相同
+static constexpr size_t kMaxCounters = 64;
+/// hpmcounter 的起始 CSR
+static constexpr uint32_t kCounterCsrBase = 0xC00;
+/// hpmcounter CSR 的数量
+static constexpr size_t kCounterCsrCount = 32;
+
+/// counter_get_info 返回值中的 CSR 号
+static constexpr uint64_t kInfoCsrMask = 0xFFF;
+/// counter_get_info 返回值中的类型位，置位表示固件计数器
+static constexpr uint64_t kInfoFirmware = 1ULL << 63;
+
+/// counter_config_matching 的标志
+static constexpr uint64_t kConfigClearValue = 1ULL << 1;
+static constexpr uint64_t kConfigSetUinh = 1ULL << 5;
+static constexpr uint64_t kConfigSetSinh = 1ULL << 6;
+static constexpr uint64_t kConfigSetMinh = 1ULL << 7;
+/// counter_start 的标志：设置初值
+static constexpr uint64_t kStartSetInitValue = 1ULL << 0;
+/// counter_stop 的标志：释放计数器与事件的绑定
+static constexpr uint64_t kStopReset = 1ULL << 0;
+
+/// Init() 读取的计数器数量
+inline size_t counters = 0;
+/// 每个计数器的 CSR 号，0 表示固件计数器
+inline uint16_t counter_csr[kMaxCounters]{};
+
+/**
+ * @brief 读取 CSR 号为常量的计数器
+ * @tparam kCsr CSR 号
+ * @return uint64_t 计数值
+ */
+template <uint32_t kCsr>
+static __always_inline auto ReadCsr() -> uint64_t {
+  uint64_t value;
+  __asm__ volatile("csrr %0, %1" : "=r"(value) : "i"(kCsr));
+  return value;
+}
+
+/**
+ * @brief 读取 CSR 号在运行时确定的计数器
+ * csrr 只接受立即数，展开为对 hpmcounter0~31 的比较
+ * @param offset CSR 号相对于 kCounterCsrBase 的偏移
+ * @return uint64_t 计数值
+ */
+template <size_t... kOffsets>
+static __always_inline auto ReadCounterCsr(size_t offset,
+                                           std::index_sequence<kOffsets...>)
+    -> uint64_t {
+  uint64_t value = 0;
+  ((offset == kOffsets &&
+    (value = ReadCsr<kCounterCsrBase + kOffsets>(), true)) ||
+   ...);
+  return value;
+}
+
+/**
+ * @brief 由计数器数量生成计数器掩码
+ * @param count 计数器数量
+ * @return uint64_t 计数器掩码
+ */
+static constexpr auto CounterMask(size_t count) -> uint64_t {
+  return (count < 64) ? (1ULL << count) - 1 : ~0ULL;
+}
+}  // namespace detail
+
+/**
+ * @brief 查询固件的计数器并停止所有计数器，需在每个核心上调用一次
+ * @return Info 性能监控能力
+ */
+static __always_inline auto Init() -> Info {
+  detail::counters = 0;
+  if (!sbi::ProbeExtension(sbi::kPMU)) {
+    return {0};
+  }
+  auto num = SbiCall(sbi::kPMU, sbi::kPMU_NUM_COUNTERS);
+  if (num.error != sbi::SUCCESS || num.value <= 0) {
+    return {0};
+  }
+  detail::counters = static_cast<size_t>(num.value) < detail::kMaxCounters
+                         ? static_cast<size_t>(num.value)
+                         : detail::kMaxCounters;
+  for (size_t i = 0; i < detail::counters; i++) {
+    auto info = SbiCall(sbi::kPMU, sbi::kPMU_COUNTER_GET_INFO, i);
+    auto value = static_cast<uint64_t>(info.value);
+    if (info.error != sbi::SUCCESS || (value & detail::kInfoFirmware) != 0) {
+      detail::counter_csr[i] = 0;
+    } else {
+      detail::counter_csr[i] = value & detail::kInfoCsrMask;
+    }
+  }
+  // 未启动的计数器返回 ALREADY_STOPPED，忽略
+  SbiCall(sbi::kPMU, sbi::kPMU_COUNTER_STOP, 0,
+          detail::CounterMask(detail::counters), detail::kStopReset);
+  return {static_cast<uint8_t>(detail::counters)};
+}
+
+/**
+ * @brief 配置计数器并清零，不开始计数
+ * @param index 计数器
+ * @param event 事件，见 pmu::event
+ * @param flags kUser/kKernel/kInterrupt 的组合
+ * @return true 成功，false 计数器不能统计该事件
+ */
+static __always_inline auto Program(size_t index, uint64_t event,
+                                    uint32_t flags) -> bool {
+  // 释放之前的绑定，否则固件不允许重新配置
+  SbiCall(sbi::kPMU, sbi::kPMU_COUNTER_STOP, index, 1, detail::kStopReset);
+  uint64_t config = detail::kConfigClearValue | detail::kConfigSetMinh;
+  if ((flags & kUser) == 0) {
+    config |= detail::kConfigSetUinh;
+  }
+  if ((flags & kKernel) == 0) {
+    config |= detail::kConfigSetSinh;
+  }
+  auto ret = SbiCall(sbi::kPMU, sbi::kPMU_COUNTER_CONFIG_MATCHING, index, 1,
+                     config, event, 0);
+  return ret.error == sbi::SUCCESS && static_cast<size_t>(ret.value) == index;
+}
+
+/**
+ * @brief 开始计数
+ * @param mask 计数器掩码
+ */
+static __always_inline void Start(uint64_t mask) {
+  SbiCall(sbi::kPMU, sbi::kPMU_COUNTER_START, 0, mask, 0, 0);
+}
+
+/**
+ * @brief 停止计数，计数值保持不变
+ * @param mask 计数器掩码
+ */
+static __always_inline void Stop(uint64_t mask) {
+  SbiCall(sbi::kPMU, sbi::kPMU_COUNTER_STOP, 0, mask, 0);
+}
+
+/**
+ * @brief 读取计数器
+ * 硬件计数器直接读 CSR，固件计数器通过 SBI 读取
+ * @param index 计数器
+ * @return uint64_t 计数值
+ * @note U 模式使用前需 EnableUserRead()
+ */
+static __always_inline auto ReadCounter(size_t index) -> uint64_t {
+  auto csr = detail::counter_csr[index];
+  if (csr == 0) {
+    return SbiCall(sbi::kPMU, sbi::kPMU_COUNTER_FW_READ, index).value;
+  }
+  return detail::ReadCounterCsr(
+      csr - detail::kCounterCsrBase,
+      std::make_index_sequence<detail::kCounterCsrCount>{});
+}
+
+/**
+ * @brief 设置计数器的值，用于采样：写入 -period 后每 period 个事件溢出一次
+ * @param index 计数器
+ * @param value 计数值
+ * @note SBI 只能在启动时设置初值，计数器会在设置后开始计数，
+ * 同时清除其溢出标志
+ */
+static __always_inline void SetCounter(size_t index, uint64_t value) {
+  SbiCall(sbi::kPMU, sbi::kPMU_COUNTER_STOP, index, 1, 0);
+  SbiCall(sbi::kPMU, sbi::kPMU_COUNTER_START, index, 1,
+          detail::kStartSetInitValue, value);
+}
+
+/**
+ * @brief 获取溢出的计数器，需要 Sscofpmf
+ * @return uint64_t 计数器掩码
+ */
+static __always_inline auto GetOverflow() -> uint64_t {
+  // scountovf 按 CSR 编号，转换为计数器号
+  auto overflow = cpu_io::detail::regs::csr::Scountovf::Read();
+  uint64_t mask = 0;
+  for (size_t i = 0; i < detail::counters; i++) {
+    auto csr = detail::counter_csr[i];
+    if (csr != 0 && ((overflow >> (csr - detail::kCounterCsrBase)) & 1) != 0) {
+      mask |= 1ULL << i;
+    }
+  }
+  return mask;
+}
+
+/**
+ * @brief 清除溢出中断
+ * @param mask 计数器掩码
+ * @note 计数器的溢出标志由固件在 SetCounter() 时清除，此处只清除 sip.LCOFIP
+ */
+static __always_inline void ClearOverflow([[maybe_unused]] uint64_t mask) {
+  cpu_io::detail::regs::csr::Sip::Lcofip::Clear();
+}
+
+/**
+ * @brief 允许计数器溢出中断 (scause 为 13)，需要 Sscofpmf
+ */
+static __always_inline void EnableOverflowInterrupt() {
+  cpu_io::detail::regs::csr::Sie::Lcofie::Set();
+}
+
+/**
+ * @brief 允许 U 模式读取所有计数器
+ * @note 需要 M 模式固件已在 mcounteren 中允许 S 模式访问
+ */
+static __always_inline void EnableUserRead() {
+  cpu_io::detail::regs::csr::Scounteren::Write(0xFFFFFFFF);
+}
+
+}  // namespace pmu
+}  // namespace cpu_io
+
+#endif  // CPU_IO_INCLUDE_RISCV64_PMU_HPP_
@@ -31,8 +31,11 @@ namespace cpu_io {
 namespace detail {
 
 namespace regs {
-struct Fp : public read_write::ReadWriteRegBase<register_info::FpInfo> {};
-struct Tp : public read_write::ReadWriteRegBase<register_info::TpInfo> {};
+/// 通用寄存器不会陷入，不跟踪；跟踪钩子可以通过 GetCurrentCoreId() 获取核心号
+struct Fp : public read_write::ReadWriteRegBase<register_info::FpInfo,
+                                                read_write::NoRegTrace> {};
+struct Tp : public read_write::ReadWriteRegBase<register_info::TpInfo,
+                                                read_write::NoRegTrace> {};
 
 namespace csr {
 
@@ -47,6 +50,15 @@ struct Sstatus
   using Spp = read_write::ReadWriteField<
       read_write::ReadWriteRegBase<register_info::csr::SstatusInfo>,
       register_info::csr::SstatusInfo::Spp>;
+  using Vs = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::csr::SstatusInfo>,
+      register_info::csr::SstatusInfo::Vs>;
+  using Fs = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::csr::SstatusInfo>,
+      register_info::csr::SstatusInfo::Fs>;
+  using Sd = read_write::ReadOnlyField<
+      read_write::ReadWriteRegBase<register_info::csr::SstatusInfo>,
+      register_info::csr::SstatusInfo::Sd>;
 };
 
 struct Stvec
@@ -67,6 +79,19 @@ struct Stvec
     Mode::Write(register_info::csr::StvecInfo::kDirect);
     return true;
   }
+
+  /**
+   * @brief 以 Vectored 模式设置 stvec，一次写入基址与模式
+   * @param table 向量表地址，中断 n 进入 table + 4 * n，异常进入 table
+   * @return bool 地址未 4 字节对齐时返回 false
+   */
+  static __always_inline bool SetVectored(uint64_t table) {
+    if ((table & 0x3) != 0) {
+      return false;
+    }
+    Write(table | register_info::csr::StvecInfo::kVectored);
+    return true;
+  }
 };
 
 struct Sip : public read_write::ReadWriteRegBase<register_info::csr::SipInfo> {
@@ -79,6 +104,9 @@ struct Sip : public read_write::ReadWriteRegBase<register_info::csr::SipInfo> {
   using Seip = read_write::ReadWriteField<
       read_write::ReadWriteRegBase<register_info::csr::SipInfo>,
       register_info::csr::SipInfo::Seip>;
+  using Lcofip = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::csr::SipInfo>,
+      register_info::csr::SipInfo::Lcofip>;
 };
 
 struct Sie : public read_write::ReadWriteRegBase<register_info::csr::SieInfo> {
@@ -91,6 +119,9 @@ struct Sie : public read_write::ReadWriteRegBase<register_info::csr::SieInfo> {
   using Seie = read_write::ReadWriteField<
       read_write::ReadWriteRegBase<register_info::csr::SieInfo>,
       register_info::csr::SieInfo::Seie>;
+  using Lcofie = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::csr::SieInfo>,
+      register_info::csr::SieInfo::Lcofie>;
 };
 
 struct Time : public read_write::ReadOnlyRegBase<register_info::csr::TimeInfo> {
@@ -102,6 +133,25 @@ struct Cycle
 struct Instret
     : public read_write::ReadOnlyRegBase<register_info::csr::InstretInfo> {};
 
+struct Scounteren
+    : public read_write::ReadWriteRegBase<register_info::csr::ScounterenInfo> {
+  using Cy = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::csr::ScounterenInfo>,
+      register_info::csr::ScounterenInfo::Cy>;
+  using Tm = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::csr::ScounterenInfo>,
+      register_info::csr::ScounterenInfo::Tm>;
+  using Ir = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::csr::ScounterenInfo>,
+      register_info::csr::ScounterenInfo::Ir>;
+  using Hpm = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::csr::ScounterenInfo>,
+      register_info::csr::ScounterenInfo::Hpm>;
+};
+
+struct Scountovf
+    : public read_write::ReadOnlyRegBase<register_info::csr::ScountovfInfo> {};
+
 struct Sscratch
     : public read_write::ReadWriteRegBase<register_info::csr::SscratchInfo> {};
 
@@ -135,7 +185,7 @@ struct Satp
 };
 
 struct Stimecmp
-    : public read_write::ReadOnlyRegBase<register_info::csr::StimecmpInfo> {};
+    : public read_write::ReadWriteRegBase<register_info::csr::StimecmpInfo> {};
 
 }  // namespace csr
 
@@ -7,6 +7,7 @@
 
 #include <cstdint>
 
+#include "../../reg_trace.hpp"
 #include "register_info.hpp"
 
 namespace cpu_io {
@@ -14,11 +15,49 @@ namespace cpu_io {
 namespace detail {
 
 namespace read_write {
+
+/**
+ * 寄存器访问跟踪使用的计数器，直接读取，本身不被跟踪
+ */
+struct TraceClock {
+  static __always_inline auto Read() -> uint64_t {
+    uint64_t value;
+    __asm__ volatile("csrr %0, time" : "=r"(value));
+    return value;
+  }
+};
+
+/// 寄存器访问跟踪策略，定义 CPU_IO_REG_TRACE 时调用 SetRegTraceHook() 的钩子
+#ifdef CPU_IO_REG_TRACE
+using DefaultRegTrace = HookRegTrace<TraceClock>;
+#else
+using DefaultRegTrace = NoRegTrace;
+#endif
+
+/**
+ * 位域值，由位域的掩码与移位后的值组成
+ * @note 多个位域值可以合并后一次性写入寄存器，见 ReadWriteRegBase::Modify
+ */
+struct FieldValue {
+  /// 位域掩码
+  uint64_t mask;
+  /// 已移位到位域位置的值
+  uint64_t value;
+
+  /**
+   * | 重载，合并两个位域值
+   */
+  constexpr auto operator|(const FieldValue &other) const -> FieldValue {
+    return {mask | other.mask, value | other.value};
+  }
+};
+
 /**
  * 只读接口
  * @tparam 寄存器类型
+ * @tparam Trace 访问跟踪策略，见 reg_trace.hpp
  */
-template <class RegInfo>
+template <class RegInfo, class Trace = DefaultRegTrace>
 class ReadOnlyRegBase {
  public:
   /// @name 构造/析构函数
@@ -36,51 +75,9 @@ class ReadOnlyRegBase {
    * @return RegInfo::DataType 寄存器的值
    */
   static __always_inline auto Read() -> typename RegInfo::DataType {
-    typename RegInfo::DataType value{};
-    if constexpr (std::is_same_v<RegInfo, register_info::FpInfo>) {
-      __asm__ volatile("mv %0, fp" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::TpInfo>) {
-      __asm__ volatile("mv %0, tp" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SstatusInfo>) {
-      __asm__ volatile("csrr %0, sstatus" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvecInfo>) {
-      __asm__ volatile("csrr %0, stvec" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SipInfo>) {
-      __asm__ volatile("csrr %0, sip" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SieInfo>) {
-      __asm__ volatile("csrr %0, sie" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::TimeInfo>) {
-      __asm__ volatile("csrr %0, time" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::CycleInfo>) {
-      __asm__ volatile("csrr %0, cycle" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::InstretInfo>) {
-      __asm__ volatile("csrr %0, instret" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SscratchInfo>) {
-      __asm__ volatile("csrr %0, sscratch" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SepcInfo>) {
-      __asm__ volatile("csrr %0, sepc" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::ScauseInfo>) {
-      __asm__ volatile("csrr %0, scause" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvalInfo>) {
-      __asm__ volatile("csrr %0, stval" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SatpInfo>) {
-      __asm__ volatile("csrr %0, satp" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StimecmpInfo>) {
-      __asm__ volatile("csrr %0, stimecmp" : "=r"(value) : :);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    auto trace_start = Trace::Begin();
+    auto value = RegInfo::Read();
+    Trace::template End<RegInfo>(RegAccess::kRead, value, trace_start);
     return value;
   }
 
@@ -95,8 +92,9 @@ class ReadOnlyRegBase {
 /**
  * 只写接口
  * @tparam 寄存器类型
+ * @tparam Trace 访问跟踪策略，见 reg_trace.hpp
  */
-template <class RegInfo>
+template <class RegInfo, class Trace = DefaultRegTrace>
 class WriteOnlyRegBase {
  public:
   /// @name 构造/析构函数
@@ -114,38 +112,9 @@ class WriteOnlyRegBase {
    * @param value 要写的值
    */
   static __always_inline void Write(typename RegInfo::DataType value) {
-    if constexpr (std::is_same_v<RegInfo, register_info::FpInfo>) {
-      __asm__ volatile("mv fp, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::TpInfo>) {
-      __asm__ volatile("mv tp, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SstatusInfo>) {
-      __asm__ volatile("csrw sstatus, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvecInfo>) {
-      __asm__ volatile("csrw stvec, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SipInfo>) {
-      __asm__ volatile("csrw sip, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SieInfo>) {
-      __asm__ volatile("csrw sie, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SscratchInfo>) {
-      __asm__ volatile("csrw sscratch, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SepcInfo>) {
-      __asm__ volatile("csrw sepc, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::ScauseInfo>) {
-      __asm__ volatile("csrw scause, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvalInfo>) {
-      __asm__ volatile("csrw stval, %0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SatpInfo>) {
-      __asm__ volatile("csrw satp, %0" : : "r"(value) :);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    auto trace_start = Trace::Begin();
+    RegInfo::Write(value);
+    Trace::template End<RegInfo>(RegAccess::kWrite, value, trace_start);
   }
 
   /**
@@ -154,33 +123,7 @@ class WriteOnlyRegBase {
    * @note 只能写 kCsrImmOpMask 范围内的值
    */
   static __always_inline void WriteImm(const uint8_t value) {
-    if constexpr (std::is_same_v<RegInfo, register_info::csr::SstatusInfo>) {
-      __asm__ volatile("csrwi sstatus, %0" : : "i"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvecInfo>) {
-      __asm__ volatile("csrwi stvec, %0" : : "i"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SipInfo>) {
-      __asm__ volatile("csrwi sip, %0" : : "i"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SieInfo>) {
-      __asm__ volatile("csrwi sie, %0" : : "i"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SscratchInfo>) {
-      __asm__ volatile("csrwi sscratch, %0" : : "i"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SepcInfo>) {
-      __asm__ volatile("csrwi sepc, %0" : : "i"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::ScauseInfo>) {
-      __asm__ volatile("csrwi scause, %0" : : "i"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvalInfo>) {
-      __asm__ volatile("csrwi stval, %0" : : "i"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SatpInfo>) {
-      __asm__ volatile("csrwi satp, %0" : : "i"(value) :);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    RegInfo::WriteImm(value);
   }
 
   /**
@@ -188,33 +131,9 @@ class WriteOnlyRegBase {
    * @param mask 掩码
    */
   static __always_inline void SetBits(uint64_t mask) {
-    if constexpr (std::is_same_v<RegInfo, register_info::csr::SstatusInfo>) {
-      __asm__ volatile("csrrs zero, sstatus, %0" : : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvecInfo>) {
-      __asm__ volatile("csrrs zero, stvec, %0" : : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SipInfo>) {
-      __asm__ volatile("csrrs zero, sip, %0" : : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SieInfo>) {
-      __asm__ volatile("csrrs zero, sie, %0" : : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SscratchInfo>) {
-      __asm__ volatile("csrrs zero, sscratch, %0" : : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SepcInfo>) {
-      __asm__ volatile("csrrs zero, sepc, %0" : : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::ScauseInfo>) {
-      __asm__ volatile("csrrs zero, scause, %0" : : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvalInfo>) {
-      __asm__ volatile("csrrs zero, stval, %0" : : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SatpInfo>) {
-      __asm__ volatile("csrrs zero, satp, %0" : : "r"(mask) :);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    auto trace_start = Trace::Begin();
+    RegInfo::SetBits(mask);
+    Trace::template End<RegInfo>(RegAccess::kSetBits, mask, trace_start);
   }
 
   /**
@@ -222,33 +141,9 @@ class WriteOnlyRegBase {
    * @param mask 掩码
    */
   static __always_inline void ClearBits(uint64_t mask) {
-    if constexpr (std::is_same_v<RegInfo, register_info::csr::SstatusInfo>) {
-      __asm__ volatile("csrrc zero, sstatus, %0" : : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvecInfo>) {
-      __asm__ volatile("csrrc zero, stvec, %0" : : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SipInfo>) {
-      __asm__ volatile("csrrc zero, sip, %0" : : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SieInfo>) {
-      __asm__ volatile("csrrc zero, sie, %0" : : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SscratchInfo>) {
-      __asm__ volatile("csrrc zero, sscratch, %0" : : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SepcInfo>) {
-      __asm__ volatile("csrrc zero, sepc, %0" : : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::ScauseInfo>) {
-      __asm__ volatile("csrrc zero, scause, %0" : : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvalInfo>) {
-      __asm__ volatile("csrrc zero, stval, %0" : : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SatpInfo>) {
-      __asm__ volatile("csrrc zero, satp, %0" : : "r"(mask) :);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    auto trace_start = Trace::Begin();
+    RegInfo::ClearBits(mask);
+    Trace::template End<RegInfo>(RegAccess::kClearBits, mask, trace_start);
   }
 
   /**
@@ -257,33 +152,7 @@ class WriteOnlyRegBase {
    * @note 只能写 kCsrImmOpMask 范围内的值
    */
   static __always_inline void SetBitsImm(const uint8_t mask) {
-    if constexpr (std::is_same_v<RegInfo, register_info::csr::SstatusInfo>) {
-      __asm__ volatile("csrrsi zero, sstatus, %0" : : "i"(mask) : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvecInfo>) {
-      __asm__ volatile("csrrsi zero, stvec, %0" : : "i"(mask) : "memory");
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SipInfo>) {
-      __asm__ volatile("csrrsi zero, sip, %0" : : "i"(mask) : "memory");
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SieInfo>) {
-      __asm__ volatile("csrrsi zero, sie, %0" : : "i"(mask) : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SscratchInfo>) {
-      __asm__ volatile("csrrsi zero, sscratch, %0" : : "i"(mask) : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SepcInfo>) {
-      __asm__ volatile("csrrsi zero, sepc, %0" : : "i"(mask) : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::ScauseInfo>) {
-      __asm__ volatile("csrrsi zero, scause, %0" : : "i"(mask) : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvalInfo>) {
-      __asm__ volatile("csrrsi zero, stval, %0" : : "i"(mask) : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SatpInfo>) {
-      __asm__ volatile("csrrsi zero, satp, %0" : : "i"(mask) : "memory");
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    RegInfo::SetBitsImm(mask);
   }
 
   /**
@@ -292,33 +161,7 @@ class WriteOnlyRegBase {
    * @note 只能写 kCsrImmOpMask 范围内的值
    */
   static __always_inline void ClearBitsImm(const uint8_t mask) {
-    if constexpr (std::is_same_v<RegInfo, register_info::csr::SstatusInfo>) {
-      __asm__ volatile("csrrci zero, sstatus, %0" : : "i"(mask) : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvecInfo>) {
-      __asm__ volatile("csrrci zero, stvec, %0" : : "i"(mask) : "memory");
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SipInfo>) {
-      __asm__ volatile("csrrci zero, sip, %0" : : "i"(mask) : "memory");
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SieInfo>) {
-      __asm__ volatile("csrrci zero, sie, %0" : : "i"(mask) : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SscratchInfo>) {
-      __asm__ volatile("csrrci zero, sscratch, %0" : : "i"(mask) : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SepcInfo>) {
-      __asm__ volatile("csrrci zero, sepc, %0" : : "i"(mask) : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::ScauseInfo>) {
-      __asm__ volatile("csrrci zero, scause, %0" : : "i"(mask) : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvalInfo>) {
-      __asm__ volatile("csrrci zero, stval, %0" : : "i"(mask) : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SatpInfo>) {
-      __asm__ volatile("csrrci zero, satp, %0" : : "i"(mask) : "memory");
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    RegInfo::ClearBitsImm(mask);
   }
 
   /**
@@ -364,15 +207,28 @@ class WriteOnlyRegBase {
    * |= 重载
    */
   __always_inline void operator|=(uint64_t mask) { SetBits(mask); }
+
+  /**
+   * 将多个位域值合并后直接写入寄存器，未指定的位写 0
+   * @param first 第一个位域值
+   * @param rest 其余位域值
+   * @note 不读寄存器，适用于只写寄存器或需要整体赋值的场景
+   */
+  template <class... Rest>
+  static __always_inline void WriteFields(FieldValue first, Rest... rest) {
+    static_assert((std::is_same_v<Rest, FieldValue> && ...));
+    Write(static_cast<typename RegInfo::DataType>((first | ... | rest).value));
+  }
 };
 
 /**
  * 读写接口
  * @tparam 寄存器类型
+ * @tparam Trace 访问跟踪策略，见 reg_trace.hpp
  */
-template <class RegInfo>
-class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo>,
-                         public WriteOnlyRegBase<RegInfo> {
+template <class RegInfo, class Trace = DefaultRegTrace>
+class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo, Trace>,
+                         public WriteOnlyRegBase<RegInfo, Trace> {
  public:
   /// @name 构造/析构函数
   /// @{
@@ -391,40 +247,9 @@ class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo>,
    */
   static __always_inline auto ReadWrite(typename RegInfo::DataType value) ->
       typename RegInfo::DataType {
-    typename RegInfo::DataType old_value{};
-    if constexpr (std::is_same_v<RegInfo, register_info::csr::SstatusInfo>) {
-      __asm__ volatile("csrrw %0, sstatus, %1"
-                       : "=r"(old_value)
-                       : "r"(value)
-                       :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvecInfo>) {
-      __asm__ volatile("csrrw %0, stvec, %1" : "=r"(old_value) : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SipInfo>) {
-      __asm__ volatile("csrrw %0, sip, %1" : "=r"(old_value) : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SieInfo>) {
-      __asm__ volatile("csrrw %0, sie, %1" : "=r"(old_value) : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SscratchInfo>) {
-      __asm__ volatile("csrrw %0, sscratch, %1"
-                       : "=r"(old_value)
-                       : "r"(value)
-                       :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SepcInfo>) {
-      __asm__ volatile("csrrw %0, sepc, %1" : "=r"(old_value) : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::ScauseInfo>) {
-      __asm__ volatile("csrrw %0, scause, %1" : "=r"(old_value) : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvalInfo>) {
-      __asm__ volatile("csrrw %0, stval, %1" : "=r"(old_value) : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SatpInfo>) {
-      __asm__ volatile("csrrw %0, satp, %1" : "=r"(old_value) : "r"(value) :);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    auto trace_start = Trace::Begin();
+    auto old_value = RegInfo::ReadWrite(value);
+    Trace::template End<RegInfo>(RegAccess::kWrite, value, trace_start);
     return old_value;
   }
 
@@ -436,44 +261,7 @@ class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo>,
    */
   static __always_inline auto ReadWriteImm(const uint8_t value) ->
       typename RegInfo::DataType {
-    typename RegInfo::DataType old_value{};
-    if constexpr (std::is_same_v<RegInfo, register_info::csr::SstatusInfo>) {
-      __asm__ volatile("csrrwi %0, sstatus, %1"
-                       : "=r"(old_value)
-                       : "i"(value)
-                       :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvecInfo>) {
-      __asm__ volatile("csrrwi %0, stvec, %1" : "=r"(old_value) : "i"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SipInfo>) {
-      __asm__ volatile("csrrwi %0, sip, %1" : "=r"(old_value) : "i"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SieInfo>) {
-      __asm__ volatile("csrrwi %0, sie, %1" : "=r"(old_value) : "i"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SscratchInfo>) {
-      __asm__ volatile("csrrwi %0, sscratch, %1"
-                       : "=r"(old_value)
-                       : "i"(value)
-                       :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SepcInfo>) {
-      __asm__ volatile("csrrwi %0, sepc, %1" : "=r"(old_value) : "i"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::ScauseInfo>) {
-      __asm__ volatile("csrrwi %0, scause, %1"
-                       : "=r"(old_value)
-                       : "i"(value)
-                       :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvalInfo>) {
-      __asm__ volatile("csrrwi %0, stval, %1" : "=r"(old_value) : "i"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SatpInfo>) {
-      __asm__ volatile("csrrwi %0, satp, %1" : "=r"(old_value) : "i"(value) :);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
-    return old_value;
+    return RegInfo::ReadWriteImm(value);
   }
 
   /**
@@ -484,7 +272,7 @@ class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo>,
   template <uint64_t value>
   static __always_inline auto ReadWriteConst() -> typename RegInfo::DataType {
     if constexpr ((value & register_info::csr::kCsrImmOpMask) == value) {
-      return ReadWriteRegBase<RegInfo>::ReadWriteImm(value);
+      return ReadWriteRegBase<RegInfo, Trace>::ReadWriteImm(value);
     } else {
       return ReadWrite(value);
     }
@@ -497,34 +285,9 @@ class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo>,
    */
   static __always_inline auto ReadSetBits(uint64_t mask) ->
       typename RegInfo::DataType {
-    typename RegInfo::DataType value{};
-    if constexpr (std::is_same_v<RegInfo, register_info::csr::SstatusInfo>) {
-      __asm__ volatile("csrrs %0, sstatus, %1" : "=r"(value) : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvecInfo>) {
-      __asm__ volatile("csrrs %0, stvec, %1" : "=r"(value) : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SipInfo>) {
-      __asm__ volatile("csrrs %0, sip, %1" : "=r"(value) : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SieInfo>) {
-      __asm__ volatile("csrrs %0, sie, %1" : "=r"(value) : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SscratchInfo>) {
-      __asm__ volatile("csrrs %0, sscratch, %1" : "=r"(value) : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SepcInfo>) {
-      __asm__ volatile("csrrs %0, sepc, %1" : "=r"(value) : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::ScauseInfo>) {
-      __asm__ volatile("csrrs %0, scause, %1" : "=r"(value) : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvalInfo>) {
-      __asm__ volatile("csrrs %0, stval, %1" : "=r"(value) : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SatpInfo>) {
-      __asm__ volatile("csrrs %0, satp, %1" : "=r"(value) : "r"(mask) :);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    auto trace_start = Trace::Begin();
+    auto value = RegInfo::ReadSetBits(mask);
+    Trace::template End<RegInfo>(RegAccess::kSetBits, mask, trace_start);
     return value;
   }
 
@@ -535,62 +298,7 @@ class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo>,
    */
   static __always_inline auto ReadSetBitsImm(const uint8_t mask) ->
       typename RegInfo::DataType {
-    typename RegInfo::DataType value{};
-    if constexpr (std::is_same_v<RegInfo, register_info::csr::SstatusInfo>) {
-      __asm__ volatile("csrrsi %0, sstatus, %1"
-                       : "=r"(value)
-                       : "i"(mask)
-                       : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvecInfo>) {
-      __asm__ volatile("csrrsi %0, stvec, %1"
-                       : "=r"(value)
-                       : "i"(mask)
-                       : "memory");
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SipInfo>) {
-      __asm__ volatile("csrrsi %0, sip, %1"
-                       : "=r"(value)
-                       : "i"(mask)
-                       : "memory");
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SieInfo>) {
-      __asm__ volatile("csrrsi %0, sie, %1"
-                       : "=r"(value)
-                       : "i"(mask)
-                       : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SscratchInfo>) {
-      __asm__ volatile("csrrsi %0, sscratch, %1"
-                       : "=r"(value)
-                       : "i"(mask)
-                       : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SepcInfo>) {
-      __asm__ volatile("csrrsi %0, sepc, %1"
-                       : "=r"(value)
-                       : "i"(mask)
-                       : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::ScauseInfo>) {
-      __asm__ volatile("csrrsi %0, scause, %1"
-                       : "=r"(value)
-                       : "i"(mask)
-                       : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvalInfo>) {
-      __asm__ volatile("csrrsi %0, stval, %1"
-                       : "=r"(value)
-                       : "i"(mask)
-                       : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SatpInfo>) {
-      __asm__ volatile("csrrsi %0, satp, %1"
-                       : "=r"(value)
-                       : "i"(mask)
-                       : "memory");
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
-    return value;
+    return RegInfo::ReadSetBitsImm(mask);
   }
 
   /**
@@ -614,34 +322,9 @@ class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo>,
    */
   static __always_inline auto ReadClearBits(uint64_t mask) ->
       typename RegInfo::DataType {
-    typename RegInfo::DataType value{};
-    if constexpr (std::is_same_v<RegInfo, register_info::csr::SstatusInfo>) {
-      __asm__ volatile("csrrc %0, sstatus, %1" : "=r"(value) : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvecInfo>) {
-      __asm__ volatile("csrrc %0, stvec, %1" : "=r"(value) : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SipInfo>) {
-      __asm__ volatile("csrrc %0, sip, %1" : "=r"(value) : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SieInfo>) {
-      __asm__ volatile("csrrc %0, sie, %1" : "=r"(value) : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SscratchInfo>) {
-      __asm__ volatile("csrrc %0, sscratch, %1" : "=r"(value) : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SepcInfo>) {
-      __asm__ volatile("csrrc %0, sepc, %1" : "=r"(value) : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::ScauseInfo>) {
-      __asm__ volatile("csrrc %0, scause, %1" : "=r"(value) : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvalInfo>) {
-      __asm__ volatile("csrrc %0, stval, %1" : "=r"(value) : "r"(mask) :);
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SatpInfo>) {
-      __asm__ volatile("csrrc %0, satp, %1" : "=r"(value) : "r"(mask) :);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    auto trace_start = Trace::Begin();
+    auto value = RegInfo::ReadClearBits(mask);
+    Trace::template End<RegInfo>(RegAccess::kClearBits, mask, trace_start);
     return value;
   }
 
@@ -652,62 +335,7 @@ class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo>,
    */
   static __always_inline auto ReadClearBitsImm(const uint8_t mask) ->
       typename RegInfo::DataType {
-    typename RegInfo::DataType value{};
-    if constexpr (std::is_same_v<RegInfo, register_info::csr::SstatusInfo>) {
-      __asm__ volatile("csrrci %0, sstatus, %1"
-                       : "=r"(value)
-                       : "i"(mask)
-                       : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvecInfo>) {
-      __asm__ volatile("csrrci %0, stvec, %1"
-                       : "=r"(value)
-                       : "i"(mask)
-                       : "memory");
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SipInfo>) {
-      __asm__ volatile("csrrci %0, sip, %1"
-                       : "=r"(value)
-                       : "i"(mask)
-                       : "memory");
-    } else if constexpr (std::is_same_v<RegInfo, register_info::csr::SieInfo>) {
-      __asm__ volatile("csrrci %0, sie, %1"
-                       : "=r"(value)
-                       : "i"(mask)
-                       : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SscratchInfo>) {
-      __asm__ volatile("csrrci %0, sscratch, %1"
-                       : "=r"(value)
-                       : "i"(mask)
-                       : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SepcInfo>) {
-      __asm__ volatile("csrrci %0, sepc, %1"
-                       : "=r"(value)
-                       : "i"(mask)
-                       : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::ScauseInfo>) {
-      __asm__ volatile("csrrci %0, scause, %1"
-                       : "=r"(value)
-                       : "i"(mask)
-                       : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::StvalInfo>) {
-      __asm__ volatile("csrrci %0, stval, %1"
-                       : "=r"(value)
-                       : "i"(mask)
-                       : "memory");
-    } else if constexpr (std::is_same_v<RegInfo,
-                                        register_info::csr::SatpInfo>) {
-      __asm__ volatile("csrrci %0, satp, %1"
-                       : "=r"(value)
-                       : "i"(mask)
-                       : "memory");
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
-    return value;
+    return RegInfo::ReadClearBitsImm(mask);
   }
 
   /**
@@ -719,11 +347,39 @@ class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo>,
   static __always_inline auto ReadClearBitsConst() ->
       typename RegInfo::DataType {
     if constexpr ((mask & register_info::csr::kCsrImmOpMask) == mask) {
-      return WriteOnlyRegBase<RegInfo>::ReadClearBitsImm(mask);
+      return ReadClearBitsImm(mask);
     } else {
       return ReadClearBits(mask);
     }
   }
+
+  /**
+   * 一次读改写同时修改多个位域
+   * @tparam kFields 编译期确定的位域值
+   * @note 只进行一次读与一次写，屏障由调用者在整个配置序列完成后添加
+   */
+  template <FieldValue... kFields>
+  static __always_inline void Modify() {
+    static_assert(sizeof...(kFields) > 0);
+    constexpr auto kMerged = (kFields | ...);
+    Modify(kMerged);
+  }
+
+  /**
+   * 一次读改写同时修改多个位域
+   * @param first 第一个位域值
+   * @param rest 其余位域值
+   * @note 只进行一次读与一次写，屏障由调用者在整个配置序列完成后添加
+   */
+  template <class... Rest>
+  static __always_inline void Modify(FieldValue first, Rest... rest) {
+    static_assert((std::is_same_v<Rest, FieldValue> && ...));
+    auto merged = (first | ... | rest);
+    auto org_value = ReadOnlyRegBase<RegInfo, Trace>::Read();
+    WriteOnlyRegBase<RegInfo, Trace>::Write(
+        static_cast<typename RegInfo::DataType>((org_value & ~merged.mask) |
+                                                merged.value));
+  }
 };
 
 /**
@@ -749,8 +405,7 @@ class ReadOnlyField {
    * @return RegInfo::DataType 指定位值的信息
    */
   static __always_inline auto Get() -> typename RegInfo::DataType {
-    return static_cast<typename RegInfo::DataType>(
-        (Reg::Read() & RegInfo::kBitMask) >> RegInfo::kBitOffset);
+    return RegInfo::Decode(Reg::Read());
   }
 
   /**
@@ -760,8 +415,7 @@ class ReadOnlyField {
    */
   static __always_inline auto Get(uint64_t value) ->
       typename RegInfo::DataType {
-    return static_cast<typename RegInfo::DataType>(
-        (value & RegInfo::kBitMask) >> RegInfo::kBitOffset);
+    return RegInfo::Decode(value);
   }
 };
 
@@ -806,6 +460,15 @@ class WriteOnlyField {
       Reg::ClearBits(RegInfo::kBitMask);
     }
   }
+
+  /**
+   * 生成由 RegInfo 规定的位域值，用于批量修改
+   * @param value 位域的值
+   * @return FieldValue 位域值
+   */
+  static constexpr auto Value(typename RegInfo::DataType value) -> FieldValue {
+    return {RegInfo::kBitMask, RegInfo::Encode(value)};
+  }
 };
 
 /**
@@ -833,10 +496,8 @@ class ReadWriteField : public ReadOnlyField<Reg, RegInfo>,
    */
   static __always_inline void Write(typename RegInfo::DataType value) {
     auto org_value = Reg::Read();
-    auto new_value =
-        (org_value & ~RegInfo::kBitMask) |
-        ((static_cast<decltype(org_value)>(value) << RegInfo::kBitOffset) &
-         RegInfo::kBitMask);
+    auto new_value = static_cast<decltype(org_value)>(
+        RegInfo::Insert(org_value, value));
     Reg::Write(new_value);
   }
 
@@ -848,16 +509,117 @@ class ReadWriteField : public ReadOnlyField<Reg, RegInfo>,
   static __always_inline auto ReadWrite(typename RegInfo::DataType value) ->
       typename RegInfo::DataType {
     auto org_value = Reg::Read();
-    auto new_value =
-        (org_value & ~RegInfo::kBitMask) |
-        ((static_cast<decltype(org_value)>(value) << RegInfo::kBitOffset) &
-         RegInfo::kBitMask);
+    auto new_value = static_cast<decltype(org_value)>(
+        RegInfo::Insert(org_value, value));
     Reg::Write(new_value);
-    return static_cast<typename RegInfo::DataType>(
-        (org_value & RegInfo::kBitMask) >> RegInfo::kBitOffset);
+    return RegInfo::Decode(org_value);
   }
 };
 
+/**
+ * 带软件影子的寄存器接口
+ * @tparam Reg 寄存器类型，需要提供 Read() 与 Write()
+ * @note 对于在虚拟化环境下读操作会陷入的寄存器，读操作由影子提供，
+ *  只有第一次读或 Invalidate() 之后的读会访问硬件。
+ *  影子保存在对象中，每个核心应当持有自己的实例（如放在 per-CPU 数据中）；
+ *  若寄存器被本对象之外的途径修改，需要调用 Invalidate()
+ */
+template <class Reg>
+class CachedReg {
+ public:
+  using DataType = decltype(Reg::Read());
+
+  /// @name 构造/析构函数
+  /// @{
+  CachedReg() = default;
+  CachedReg(const CachedReg &) = delete;
+  CachedReg(CachedReg &&) = delete;
+  auto operator=(const CachedReg &) -> CachedReg & = delete;
+  auto operator=(CachedReg &&) -> CachedReg & = delete;
+  ~CachedReg() = default;
+  /// @}
+
+  /**
+   * 读寄存器，影子有效时不访问硬件
+   * @return DataType 寄存器的值
+   */
+  __always_inline auto Read() -> DataType {
+    if (!valid_) {
+      value_ = Reg::Read();
+      valid_ = true;
+    }
+    return value_;
+  }
+
+  /**
+   * 写寄存器并更新影子
+   * @param value 要写的值
+   */
+  __always_inline void Write(DataType value) {
+    Reg::Write(value);
+    value_ = value;
+    valid_ = true;
+  }
+
+  /**
+   * 通过掩码设置寄存器
+   * @param mask 掩码
+   * @note 影子有效时只写不读
+   */
+  __always_inline void SetBits(uint64_t mask) {
+    Write(static_cast<DataType>(Read() | mask));
+  }
+
+  /**
+   * 通过掩码清零寄存器
+   * @param mask 掩码
+   * @note 影子有效时只写不读
+   */
+  __always_inline void ClearBits(uint64_t mask) {
+    Write(static_cast<DataType>(Read() & ~mask));
+  }
+
+  /**
+   * 从影子获取指定位域的值
+   * @tparam Field 位域类型，如 Cr0::Pg
+   * @return 位域的值
+   */
+  template <class Field>
+  __always_inline auto Get() {
+    return Field::Get(static_cast<uint64_t>(Read()));
+  }
+
+  /**
+   * 同时修改多个位域，影子有效时只写不读
+   * @param first 第一个位域值
+   * @param rest 其余位域值
+   */
+  template <class... Rest>
+  __always_inline void Modify(FieldValue first, Rest... rest) {
+    static_assert((std::is_same_v<Rest, FieldValue> && ...));
+    auto merged = (first | ... | rest);
+    Write(static_cast<DataType>((static_cast<uint64_t>(Read()) & ~merged.mask) |
+                                merged.value));
+  }
+
+  /**
+   * 使影子失效，下一次读会访问硬件
+   */
+  __always_inline void Invalidate() { valid_ = false; }
+
+  /**
+   * 影子是否有效
+   * @return true 有效
+   */
+  [[nodiscard]] __always_inline auto IsValid() const -> bool { return valid_; }
+
+ private:
+  /// 影子值
+  DataType value_{};
+  /// 影子是否有效
+  bool valid_{false};
+};
+
 }  // namespace read_write
 
 }  // namespace detail
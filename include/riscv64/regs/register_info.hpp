@@ -5,6 +5,8 @@
 #ifndef CPU_IO_INCLUDE_RISCV64_REGISTER_INFO_HPP_
 #define CPU_IO_INCLUDE_RISCV64_REGISTER_INFO_HPP_
 
+#include <sys/cdefs.h>
+
 #include <array>
 #include <cstdint>
 
@@ -17,8 +19,33 @@ namespace detail {
 namespace register_info {
 
 /// 通用寄存器
-struct FpInfo : public RegInfoBase {};
-struct TpInfo : public RegInfoBase {};
+struct FpInfo : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mv %0, fp" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("mv fp, %0" : : "r"(value) :);
+  }
+};
+
+struct TpInfo : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mv %0, tp" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("mv tp, %0" : : "r"(value) :);
+  }
+};
 
 namespace csr {
 /// 立即数掩码，大于这个值需要使用寄存器中转
@@ -28,64 +55,61 @@ static constexpr uint64_t kCsrImmOpMask = 0x1F;
  * @brief sstatus 寄存器定义
  * @see priv-isa.pdf#10.1.1
  */
-struct SstatusInfo : public RegInfoBase {
-  struct Sie {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 1;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+struct SstatusInfo : public CsrInfoBase<0x100> {
+  /// FS/VS 取值：关闭，访问产生非法指令异常
+  static constexpr uint8_t kExtensionOff = 0b00;
+  /// FS/VS 取值：初始状态
+  static constexpr uint8_t kExtensionInitial = 0b01;
+  /// FS/VS 取值：与保存区一致
+  static constexpr uint8_t kExtensionClean = 0b10;
+  /// FS/VS 取值：已被修改
+  static constexpr uint8_t kExtensionDirty = 0b11;
 
-  struct Spie {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 5;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Sie : public BitField<bool, 1, 1> {};
 
-  struct Spp {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 8;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Spie : public BitField<bool, 5, 1> {};
+
+  struct Spp : public BitField<bool, 8, 1> {};
+
+  /// 向量扩展状态
+  struct Vs : public BitField<uint8_t, 9, 2> {};
+
+  /// 浮点扩展状态
+  struct Fs : public BitField<uint8_t, 13, 2> {};
+
+  /// FS/VS/XS 任一为 Dirty
+  struct Sd : public BitField<bool, 63, 1> {};
 };
 
 /**
  * @brief stvec 寄存器定义
  * @see priv-isa.pdf#10.1.2
  */
-struct StvecInfo : public RegInfoBase {
+struct StvecInfo : public CsrInfoBase<0x105> {
   /// 中断模式 直接
   static constexpr uint64_t kDirect = 0x0;
   /// 中断模式 向量
   static constexpr uint64_t kVectored = 0x1;
 
-  struct Mode {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 2;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Mode : public BitField<uint8_t, 0, 2> {};
 
+  /// 基地址按原值保存 (低 2 位为 Mode)，不做移位
   struct Base {
     using DataType = uint64_t;
     static constexpr uint64_t kBitOffset = 0;
     static constexpr uint64_t kBitWidth = 62;
     static constexpr uint64_t kBitMask = ~0x3;
     static constexpr uint64_t kAllSetMask = ~0x3;
+
+    static constexpr auto Encode(uint64_t value) -> uint64_t {
+      return value & kBitMask;
+    }
+    static constexpr auto Decode(uint64_t reg) -> uint64_t {
+      return reg & kBitMask;
+    }
+    static constexpr auto Insert(uint64_t reg, uint64_t value) -> uint64_t {
+      return (reg & ~kBitMask) | Encode(value);
+    }
   };
 };
 
@@ -93,109 +117,90 @@ struct StvecInfo : public RegInfoBase {
  * @brief sip 寄存器定义
  * @see priv-isa.pdf#10.1.3
  */
-struct SipInfo : public RegInfoBase {
-  struct Ssip {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 1;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+struct SipInfo : public CsrInfoBase<0x144> {
+  struct Ssip : public BitField<bool, 1, 1> {};
 
-  struct Stip {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 5;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Stip : public BitField<bool, 5, 1> {};
 
-  struct Seip {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 9;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Seip : public BitField<bool, 9, 1> {};
+
+  /// 计数器溢出中断等待 (Sscofpmf)
+  struct Lcofip : public BitField<bool, 13, 1> {};
 };
 
 /**
  * @brief sip 寄存器定义
  * @see priv-isa.pdf#10.1.3
  */
-struct SieInfo : public RegInfoBase {
-  struct Ssie {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 1;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+struct SieInfo : public CsrInfoBase<0x104> {
+  struct Ssie : public BitField<bool, 1, 1> {};
 
-  struct Stie {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 5;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Stie : public BitField<bool, 5, 1> {};
 
-  struct Seie {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 9;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Seie : public BitField<bool, 9, 1> {};
+
+  /// 计数器溢出中断使能 (Sscofpmf)
+  struct Lcofie : public BitField<bool, 13, 1> {};
 };
 
 /**
  * @brief time 寄存器定义
  * @see priv-isa.pdf#10.1.4
  */
-struct TimeInfo : public RegInfoBase {};
+struct TimeInfo : public CsrInfoBase<0xC01> {};
 
 /**
  * @brief cycle 寄存器定义
  * @see priv-isa.pdf#10.1.4
  */
-struct CycleInfo : public RegInfoBase {};
+struct CycleInfo : public CsrInfoBase<0xC00> {};
 
 /**
  * @brief instret 寄存器定义
  * @see priv-isa.pdf#10.1.4
  */
-struct InstretInfo : public RegInfoBase {};
+struct InstretInfo : public CsrInfoBase<0xC02> {};
+
+/**
+ * @brief scounteren 寄存器定义
+ * 置位的计数器允许 U 模式读取
+ * @see priv-isa.pdf#10.1.5
+ */
+struct ScounterenInfo : public CsrInfoBase<0x106> {
+  struct Cy : public BitField<bool, 0, 1> {};
+
+  struct Tm : public BitField<bool, 1, 1> {};
+
+  struct Ir : public BitField<bool, 2, 1> {};
+
+  /// hpmcounter3~31
+  struct Hpm : public BitField<uint32_t, 3, 29> {};
+};
+
+/**
+ * @brief scountovf 寄存器定义 (Sscofpmf)
+ * 第 i 位为 hpmcounteri 的溢出标志
+ * @see https://github.com/riscv/riscv-count-overflow
+ */
+struct ScountovfInfo : public CsrInfoBase<0xDA0> {};
 
 /**
  * @brief sscratch 寄存器定义
  * @see priv-isa.pdf#10.1.6
  */
-struct SscratchInfo : public RegInfoBase {};
+struct SscratchInfo : public CsrInfoBase<0x140> {};
 
 /**
  * @brief sepc 寄存器定义
  * @see priv-isa.pdf#10.1.7
  */
-struct SepcInfo : public RegInfoBase {};
+struct SepcInfo : public CsrInfoBase<0x141> {};
 
 /**
  * @brief scause 寄存器定义
  * @see priv-isa.pdf#10.1.8
  */
-struct ScauseInfo : public RegInfoBase {
+struct ScauseInfo : public CsrInfoBase<0x142> {
   enum {
     // 中断
     kInterrupt = 1ULL << 63,
@@ -265,38 +270,22 @@ struct ScauseInfo : public RegInfoBase {
           "HardwareError",
       };
 
-  struct ExceptionCode {
-    using DataType = uint64_t;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 63;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct ExceptionCode : public BitField<uint64_t, 0, 63> {};
 
-  struct Interrupt {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 63;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Interrupt : public BitField<bool, 63, 1> {};
 };
 
 /**
  * @brief stval 寄存器定义
  * @see priv-isa.pdf#10.1.9
  */
-struct StvalInfo : public RegInfoBase {};
+struct StvalInfo : public CsrInfoBase<0x143> {};
 
 /**
  * @brief satp 寄存器定义
  * @see priv-isa.pdf#10.1.11
  */
-struct SatpInfo : public RegInfoBase {
+struct SatpInfo : public CsrInfoBase<0x180> {
   enum : uint8_t {
     kBare = 0,
     kSv39 = 8,
@@ -315,40 +304,16 @@ struct SatpInfo : public RegInfoBase {
 
   static constexpr uint64_t kPpnOffset = 12;
 
-  struct Ppn {
-    using DataType = uint64_t;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 44;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
-  struct Asid {
-    using DataType = uint16_t;
-    static constexpr uint64_t kBitOffset = 44;
-    static constexpr uint64_t kBitWidth = 16;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
-  struct Mode {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 60;
-    static constexpr uint64_t kBitWidth = 4;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Ppn : public BitField<uint64_t, 0, 44> {};
+  struct Asid : public BitField<uint16_t, 44, 16> {};
+  struct Mode : public BitField<uint8_t, 60, 4> {};
 };
 
 /**
  * @brief stimecmp 寄存器定义
  * @see priv-isa.pdf#16.1.1
  */
-struct StimecmpInfo : public RegInfoBase {};
+struct StimecmpInfo : public CsrInfoBase<0x14D> {};
 
 }  // namespace csr
 
@@ -5,27 +5,134 @@
 #ifndef CPU_IO_INCLUDE_RISCV64_REGISTER_INFO_BASE_H_
 #define CPU_IO_INCLUDE_RISCV64_REGISTER_INFO_BASE_H_
 
+#include <sys/cdefs.h>
+
 #include <cstdint>
 
+#include "../../bit_field.hpp"
+
 namespace cpu_io {
 
 namespace detail {
 
 namespace register_info {
 
-struct RegInfoBase {
-  /// 寄存器数据类型
-  using DataType = uint64_t;
-  /// 起始位
-  static constexpr uint64_t kBitOffset = 0;
-  /// 位宽
-  static constexpr uint64_t kBitWidth = 64;
-  /// 掩码，(val & kBitMask) == 对应当前位的值
-  static constexpr uint64_t kBitMask =
-      (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-  /// 对应位置位掩码
-  static constexpr uint64_t kAllSetMask =
-      (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
+/**
+ * @brief 寄存器描述的基类，整个寄存器视为一个 64 位的字段
+ * 派生的寄存器描述以静态成员 Read()/Write() 等给出该寄存器的访问指令，
+ * read_write.hpp 的访问接口直接调用这些成员并负责跟踪
+ */
+struct RegInfoBase : public BitField<uint64_t, 0, 64> {};
+
+/**
+ * @brief CSR 描述的基类，提供该 CSR 的全部访问指令
+ * CSR 以编号作为立即数操作数传给 csr* 指令，每个 CSR 只需声明编号，
+ * 不依赖汇编器是否认识 CSR 名 (如 stimecmp/scountovf)
+ * @tparam kCsr CSR 编号
+ * @note *Imm 版本的参数只能是 kCsrImmOpMask 范围内的编译期常数
+ */
+template <uint32_t kCsr>
+struct CsrInfoBase : public RegInfoBase {
+  /// CSR 编号
+  static constexpr uint32_t kCsrNumber = kCsr;
+
+  /// csrr
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("csrr %0, %1" : "=r"(value) : "i"(kCsr) :);
+    return value;
+  }
+
+  /// csrw
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("csrw %0, %1" : : "i"(kCsr), "r"(value) :);
+  }
+
+  /// csrwi
+  static __always_inline void WriteImm(const uint8_t value) {
+    __asm__ volatile("csrwi %0, %1" : : "i"(kCsr), "i"(value) :);
+  }
+
+  /// csrs
+  static __always_inline void SetBits(uint64_t mask) {
+    __asm__ volatile("csrrs zero, %0, %1" : : "i"(kCsr), "r"(mask) :);
+  }
+
+  /// csrc
+  static __always_inline void ClearBits(uint64_t mask) {
+    __asm__ volatile("csrrc zero, %0, %1" : : "i"(kCsr), "r"(mask) :);
+  }
+
+  /// csrsi
+  static __always_inline void SetBitsImm(const uint8_t mask) {
+    __asm__ volatile("csrrsi zero, %0, %1" : : "i"(kCsr), "i"(mask) : "memory");
+  }
+
+  /// csrci
+  static __always_inline void ClearBitsImm(const uint8_t mask) {
+    __asm__ volatile("csrrci zero, %0, %1" : : "i"(kCsr), "i"(mask) : "memory");
+  }
+
+  /// csrrw，返回旧值
+  static __always_inline auto ReadWrite(DataType value) -> DataType {
+    DataType old_value{};
+    __asm__ volatile("csrrw %0, %1, %2"
+                     : "=r"(old_value)
+                     : "i"(kCsr), "r"(value)
+                     :);
+    return old_value;
+  }
+
+  /// csrrwi，返回旧值
+  static __always_inline auto ReadWriteImm(const uint8_t value) -> DataType {
+    DataType old_value{};
+    __asm__ volatile("csrrwi %0, %1, %2"
+                     : "=r"(old_value)
+                     : "i"(kCsr), "i"(value)
+                     :);
+    return old_value;
+  }
+
+  /// csrrs，返回旧值
+  static __always_inline auto ReadSetBits(uint64_t mask) -> DataType {
+    DataType value{};
+    __asm__ volatile("csrrs %0, %1, %2"
+                     : "=r"(value)
+                     : "i"(kCsr), "r"(mask)
+                     :);
+    return value;
+  }
+
+  /// csrrsi，返回旧值
+  static __always_inline auto ReadSetBitsImm(const uint8_t mask) -> DataType {
+    DataType value{};
+    __asm__ volatile("csrrsi %0, %1, %2"
+                     : "=r"(value)
+                     : "i"(kCsr), "i"(mask)
+                     : "memory");
+    return value;
+  }
+
+  /// csrrc，返回旧值
+  static __always_inline auto ReadClearBits(uint64_t mask) -> DataType {
+    DataType value{};
+    __asm__ volatile("csrrc %0, %1, %2"
+                     : "=r"(value)
+                     : "i"(kCsr), "r"(mask)
+                     :);
+    return value;
+  }
+
+  /// csrrci，返回旧值
+  static __always_inline auto ReadClearBitsImm(const uint8_t mask) ->
+      DataType {
+    DataType value{};
+    __asm__ volatile("csrrci %0, %1, %2"
+                     : "=r"(value)
+                     : "i"(kCsr), "i"(mask)
+                     : "memory");
+    return value;
+  }
 };
 
 }  // namespace register_info
@@ -0,0 +1,425 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_RISCV64_SBI_HPP_
+#define CPU_IO_INCLUDE_RISCV64_SBI_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "../cpu_mask.hpp"
+
+/**
+ * riscv64 cpu 相关定义
+ * @note 寄存器读写设计见 arch/README.md
+ */
+namespace cpu_io {
+
+/**
+ * @brief SBI 调用返回值
+ */
+struct SbiRet {
+  /// 错误码，见 sbi::ErrorCode
+  long error;
+  /// 返回值
+  long value;
+};
+
+/**
+ * @brief 调用 SBI
+ * @param eid 扩展号，a7
+ * @param fid 功能号，a6
+ * @param arg0 参数0
+ * @param arg1 参数1
+ * @param arg2 参数2
+ * @param arg3 参数3
+ * @param arg4 参数4
+ * @param arg5 参数5
+ * @return SbiRet 返回值
+ */
+static __always_inline auto SbiCall(uint64_t eid, uint64_t fid,
+                                    uint64_t arg0 = 0, uint64_t arg1 = 0,
+                                    uint64_t arg2 = 0, uint64_t arg3 = 0,
+                                    uint64_t arg4 = 0, uint64_t arg5 = 0)
+    -> SbiRet {
+  register uint64_t a0 __asm__("a0") = arg0;
+  register uint64_t a1 __asm__("a1") = arg1;
+  register uint64_t a2 __asm__("a2") = arg2;
+  register uint64_t a3 __asm__("a3") = arg3;
+  register uint64_t a4 __asm__("a4") = arg4;
+  register uint64_t a5 __asm__("a5") = arg5;
+  register uint64_t a6 __asm__("a6") = fid;
+  register uint64_t a7 __asm__("a7") = eid;
+
+  __asm__ volatile("ecall"
+                   : "+r"(a0), "+r"(a1)
+                   : "r"(a2), "r"(a3), "r"(a4), "r"(a5), "r"(a6), "r"(a7)
+                   : "memory");
+
+  return {static_cast<long>(a0), static_cast<long>(a1)};
+}
+
+/**
+ * @brief sbi 接口
+ * @see https://github.com/riscv-non-isa/riscv-sbi-doc
+ */
+namespace sbi {
+/// Base 扩展
+static constexpr uint64_t kBASE = 0x10;
+static constexpr uint64_t kBASE_GET_SPEC_VERSION = 0;
+static constexpr uint64_t kBASE_GET_IMPL_ID = 1;
+static constexpr uint64_t kBASE_GET_IMPL_VERSION = 2;
+static constexpr uint64_t kBASE_PROBE_EXTENSION = 3;
+
+/// TIME 扩展
+static constexpr uint64_t kTIME = 0x54494D45;
+static constexpr uint64_t kTIME_SET_TIMER = 0;
+
+/// IPI 扩展
+static constexpr uint64_t kIPI = 0x735049;
+static constexpr uint64_t kIPI_SEND_IPI = 0;
+
+/// RFENCE 扩展
+static constexpr uint64_t kRFENCE = 0x52464E43;
+static constexpr uint64_t kRFENCE_REMOTE_FENCE_I = 0;
+static constexpr uint64_t kRFENCE_REMOTE_SFENCE_VMA = 1;
+static constexpr uint64_t kRFENCE_REMOTE_SFENCE_VMA_ASID = 2;
+
+/// HSM (Hart State Management) 扩展
+static constexpr uint64_t kHSM = 0x48534D;
+static constexpr uint64_t kHSM_HART_START = 0;
+static constexpr uint64_t kHSM_HART_STOP = 1;
+static constexpr uint64_t kHSM_HART_GET_STATUS = 2;
+static constexpr uint64_t kHSM_HART_SUSPEND = 3;
+
+/// PMU 扩展
+static constexpr uint64_t kPMU = 0x504D55;
+static constexpr uint64_t kPMU_NUM_COUNTERS = 0;
+static constexpr uint64_t kPMU_COUNTER_GET_INFO = 1;
+static constexpr uint64_t kPMU_COUNTER_CONFIG_MATCHING = 2;
+static constexpr uint64_t kPMU_COUNTER_START = 3;
+static constexpr uint64_t kPMU_COUNTER_STOP = 4;
+static constexpr uint64_t kPMU_COUNTER_FW_READ = 5;
+
+/// 错误码
+enum ErrorCode {
+  SUCCESS = 0,
+  FAILED = -1,
+  NOT_SUPPORTED = -2,
+  INVALID_PARAM = -3,
+  DENIED = -4,
+  INVALID_ADDRESS = -5,
+  ALREADY_AVAILABLE = -6,
+  ALREADY_STARTED = -7,
+  ALREADY_STOPPED = -8,
+  NO_SHMEM = -9,
+  INVALID_STATE = -10,
+  BAD_RANGE = -11,
+};
+
+/// hart 状态 (HSM)
+enum HartState {
+  STARTED = 0,
+  STOPPED = 1,
+  START_PENDING = 2,
+  STOP_PENDING = 3,
+  SUSPENDED = 4,
+  SUSPEND_PENDING = 5,
+  RESUME_PENDING = 6,
+};
+
+/// hart_suspend 类型：保持状态，唤醒后从调用处返回
+static constexpr uint32_t kSuspendRetentive = 0x00000000;
+/// hart_suspend 类型：不保持状态，唤醒后从 resume_addr 开始执行
+static constexpr uint32_t kSuspendNonRetentive = 0x80000000;
+
+/// remote_sfence_vma 的 size 为该值时刷新全部地址
+static constexpr uint64_t kFlushAll = ~0ULL;
+
+/**
+ * @brief hart 掩码，mask 的第 i 位表示 hart base + i，
+ * 一次 SBI 调用最多覆盖 64 个 hart ID 连续的 hart
+ */
+struct HartMask {
+  /// base 为该值时表示所有 hart，忽略 mask
+  static constexpr uint64_t kAllHarts = ~0ULL;
+
+  /// 目标位图
+  uint64_t mask = 0;
+  /// 第 0 位对应的 hart ID
+  uint64_t base = 0;
+
+  /**
+   * @brief 所有 hart
+   * @return HartMask 掩码
+   */
+  static constexpr auto All() -> HartMask { return {0, kAllHarts}; }
+
+  /**
+   * @brief 加入 hart，必要时向下移动窗口
+   * @param hart_id hart ID
+   * @return true 成功，false 不能与已有的 hart 放在同一个 64 位窗口中
+   */
+  constexpr auto Add(uint64_t hart_id) -> bool {
+    if (mask == 0) {
+      base = hart_id;
+      mask = 1;
+      return true;
+    }
+    if (hart_id < base) {
+      auto shift = base - hart_id;
+      if (shift >= 64 || (mask >> (64 - shift)) != 0) {
+        return false;
+      }
+      mask = (mask << shift) | 1;
+      base = hart_id;
+      return true;
+    }
+    if (hart_id - base >= 64) {
+      return false;
+    }
+    mask |= 1ULL << (hart_id - base);
+    return true;
+  }
+
+  /**
+   * @brief 检查掩码是否为空
+   * @return true 为空
+   */
+  [[nodiscard]] constexpr auto IsEmpty() const -> bool {
+    return mask == 0 && base != kAllHarts;
+  }
+};
+
+static_assert([] {
+  HartMask mask;
+  return mask.Add(70) && mask.Add(7) && !mask.Add(6) && !mask.Add(71) &&
+         mask.base == 7 && mask.mask == ((1ULL << 63) | 1);
+}());
+
+/// 按 hart 掩码分批调用 SBI 的结果
+struct BatchRet {
+  /// 第一个失败调用的错误码，全部成功时为 SUCCESS
+  long error = SUCCESS;
+  /// SBI 调用次数
+  size_t calls = 0;
+
+  /**
+   * @brief 记录一次调用的返回值，只保留第一个错误
+   * @param ret 返回值
+   */
+  constexpr void Record(const SbiRet &ret) {
+    if (error == SUCCESS) {
+      error = ret.error;
+    }
+  }
+};
+
+/**
+ * @brief 固件是否实现了扩展
+ * @param eid 扩展号
+ * @return true 已实现
+ */
+static __always_inline auto ProbeExtension(uint64_t eid) -> bool {
+  auto ret = SbiCall(kBASE, kBASE_PROBE_EXTENSION, eid);
+  return ret.error == SUCCESS && ret.value != 0;
+}
+
+/**
+ * @brief 将核心集合转换为 hart 掩码
+ * 按 core id 顺序合并，hart ID 随 core id 递增时每 64 个 hart 只需一个掩码
+ * @param cores 核心集合
+ * @param hart_ids 以 core id 为下标的 hart ID 表
+ * @param visitor 以 HartMask 为参数调用
+ * @return size_t 生成的掩码数
+ */
+template <size_t kMaxCores, class Visitor>
+static __always_inline auto ForEachHartMask(const CpuMask<kMaxCores> &cores,
+                                            std::span<const uint64_t> hart_ids,
+                                            Visitor &&visitor) -> size_t {
+  size_t count = 0;
+  HartMask mask;
+  cores.ForEach([&](size_t core_id) {
+    if (!mask.Add(hart_ids[core_id])) {
+      visitor(mask);
+      count++;
+      mask = {};
+      mask.Add(hart_ids[core_id]);
+    }
+  });
+  if (!mask.IsEmpty()) {
+    visitor(mask);
+    count++;
+  }
+  return count;
+}
+
+/**
+ * @brief 获取 SBI 规范版本
+ * @return long [30:24] 为主版本号，[23:0] 为次版本号
+ */
+static __always_inline auto GetSpecVersion() -> long {
+  return SbiCall(kBASE, kBASE_GET_SPEC_VERSION).value;
+}
+
+/**
+ * @brief 获取 SBI 实现 ID (0 为 BBL，1 为 OpenSBI ...)
+ * @return long 实现 ID
+ */
+static __always_inline auto GetImplId() -> long {
+  return SbiCall(kBASE, kBASE_GET_IMPL_ID).value;
+}
+
+/**
+ * @brief 获取 SBI 实现的版本
+ * @return long 版本，编码由实现定义
+ */
+static __always_inline auto GetImplVersion() -> long {
+  return SbiCall(kBASE, kBASE_GET_IMPL_VERSION).value;
+}
+
+/**
+ * @brief 设置下一次定时器中断的时间，同时清除挂起的定时器中断
+ * @param stime_value 绝对时间 (time CSR 计数)，~0 表示不再触发
+ * @return SbiRet 返回值
+ * @note 支持 Sstc 时直接写 stimecmp
+ */
+static __always_inline auto SetTimer(uint64_t stime_value) -> SbiRet {
+  return SbiCall(kTIME, kTIME_SET_TIMER, stime_value);
+}
+
+/**
+ * @brief 向一组 hart 发送 IPI，目标的 sip.SSIP 被置位
+ * @param harts 目标
+ * @return SbiRet 返回值
+ */
+static __always_inline auto SendIpi(HartMask harts) -> SbiRet {
+  return SbiCall(kIPI, kIPI_SEND_IPI, harts.mask, harts.base);
+}
+
+/**
+ * @brief 向核心集合发送 IPI
+ * @param cores 核心集合
+ * @param hart_ids 以 core id 为下标的 hart ID 表
+ * @return BatchRet 第一个错误与 SBI 调用次数
+ * @note 某次调用失败时仍继续处理其余的 hart
+ */
+template <size_t kMaxCores>
+static __always_inline auto SendIpi(const CpuMask<kMaxCores> &cores,
+                                    std::span<const uint64_t> hart_ids)
+    -> BatchRet {
+  BatchRet result;
+  result.calls = ForEachHartMask(cores, hart_ids, [&](HartMask harts) {
+    result.Record(SendIpi(harts));
+  });
+  return result;
+}
+
+/**
+ * @brief 在一组 hart 上执行 fence.i
+ * @param harts 目标
+ * @return SbiRet 返回值
+ */
+static __always_inline auto RemoteFenceI(HartMask harts) -> SbiRet {
+  return SbiCall(kRFENCE, kRFENCE_REMOTE_FENCE_I, harts.mask, harts.base);
+}
+
+/**
+ * @brief 在一组 hart 上刷新所有 ASID 中的地址范围
+ * @param harts 目标
+ * @param start 起始虚拟地址
+ * @param size 字节数，0 或 kFlushAll 表示刷新全部地址
+ * @return SbiRet 返回值
+ */
+static __always_inline auto RemoteSfenceVma(HartMask harts, uint64_t start,
+                                            uint64_t size) -> SbiRet {
+  return SbiCall(kRFENCE, kRFENCE_REMOTE_SFENCE_VMA, harts.mask, harts.base,
+                 start, size);
+}
+
+/**
+ * @brief 在一组 hart 上刷新一个 ASID 中的地址范围
+ * @param harts 目标
+ * @param start 起始虚拟地址
+ * @param size 字节数，0 或 kFlushAll 表示刷新全部地址
+ * @param asid 地址空间标识符
+ * @return SbiRet 返回值
+ */
+static __always_inline auto RemoteSfenceVmaAsid(HartMask harts, uint64_t start,
+                                                uint64_t size, uint64_t asid)
+    -> SbiRet {
+  return SbiCall(kRFENCE, kRFENCE_REMOTE_SFENCE_VMA_ASID, harts.mask,
+                 harts.base, start, size, asid);
+}
+
+/**
+ * @brief 在核心集合上刷新一个 ASID 中的地址范围
+ * 每 64 个 hart 一次 SBI 调用，而不是每个 hart 一次 IPI
+ * @param cores 核心集合
+ * @param hart_ids 以 core id 为下标的 hart ID 表
+ * @param start 起始虚拟地址
+ * @param size 字节数，0 或 kFlushAll 表示刷新全部地址
+ * @param asid 地址空间标识符
+ * @return BatchRet 第一个错误与 SBI 调用次数
+ * @note 某次调用失败时仍继续处理其余的 hart
+ */
+template <size_t kMaxCores>
+static __always_inline auto RemoteSfenceVmaAsid(
+    const CpuMask<kMaxCores> &cores, std::span<const uint64_t> hart_ids,
+    uint64_t start, uint64_t size, uint64_t asid) -> BatchRet {
+  BatchRet result;
+  result.calls = ForEachHartMask(cores, hart_ids, [&](HartMask harts) {
+    result.Record(RemoteSfenceVmaAsid(harts, start, size, asid));
+  });
+  return result;
+}
+
+/**
+ * @brief 启动一个 hart
+ * 目标从 start_addr 开始以 S 模式执行，satp 为 0，a0 为 hart ID，a1 为 opaque
+ * @param hart_id 目标 hart ID
+ * @param start_addr 入口物理地址
+ * @param opaque 传给目标的参数
+ * @return SbiRet 返回值，请求已发出时 error 为 SUCCESS
+ */
+static __always_inline auto HartStart(uint64_t hart_id, uint64_t start_addr,
+                                      uint64_t opaque) -> SbiRet {
+  return SbiCall(kHSM, kHSM_HART_START, hart_id, start_addr, opaque);
+}
+
+/**
+ * @brief 停止当前 hart，成功时不返回
+ * @return SbiRet 返回值
+ */
+static __always_inline auto HartStop() -> SbiRet {
+  return SbiCall(kHSM, kHSM_HART_STOP);
+}
+
+/**
+ * @brief 获取 hart 的状态
+ * @param hart_id 目标 hart ID
+ * @return SbiRet value 为 HartState
+ */
+static __always_inline auto HartGetStatus(uint64_t hart_id) -> SbiRet {
+  return SbiCall(kHSM, kHSM_HART_GET_STATUS, hart_id);
+}
+
+/**
+ * @brief 挂起当前 hart
+ * @param suspend_type kSuspendRetentive/kSuspendNonRetentive 或平台定义的值
+ * @param resume_addr 不保持状态时唤醒后的入口物理地址
+ * @param opaque 不保持状态时传入 a1 的参数
+ * @return SbiRet 返回值，保持状态时唤醒后返回 SUCCESS
+ */
+static __always_inline auto HartSuspend(uint32_t suspend_type,
+                                        uint64_t resume_addr = 0,
+                                        uint64_t opaque = 0) -> SbiRet {
+  return SbiCall(kHSM, kHSM_HART_SUSPEND, suspend_type, resume_addr, opaque);
+}
+
+}  // namespace sbi
+}  // namespace cpu_io
+
+#endif  // CPU_IO_INCLUDE_RISCV64_SBI_HPP_
@@ -0,0 +1,267 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_RISCV64_TRAP_ENTRY_HPP_
+#define CPU_IO_INCLUDE_RISCV64_TRAP_ENTRY_HPP_
+
+#include <sys/cdefs.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../per_cpu.hpp"
+#include "context.hpp"
+#include "regs.hpp"
+
+/**
+ * @brief 完整现场的 trap 入口，由内核定义
+ * 向量表把异常 (含系统调用) 与未注册快速路径的中断转到这里，
+ * 进入时的寄存器与 Direct 模式的 stvec 入口完全相同
+ */
+extern "C" void cpu_io_riscv64_trap_entry();
+
+namespace cpu_io {
+
+/**
+ * @brief 使用快速中断入口时的每核心数据区头部
+ * 每核心数据结构须以该结构作为第一个成员，header 的要求与 PerCpuHeader 相同
+ */
+struct TrapPerCpuHeader {
+  PerCpuHeader header;
+  /// 从用户态进入中断时使用的内核栈顶，切换线程时更新
+  uint64_t kernel_sp;
+  /// 入口暂存 t0 的位置
+  uint64_t scratch;
+};
+
+static_assert(offsetof(TrapPerCpuHeader, header) == 0);
+static_assert(offsetof(TrapPerCpuHeader, kernel_sp) == 16);
+static_assert(offsetof(TrapPerCpuHeader, scratch) == 24);
+
+static_assert(offsetof(InterruptFrame, ra) == 0);
+static_assert(offsetof(InterruptFrame, sp) == 8);
+static_assert(offsetof(InterruptFrame, tp) == 16);
+static_assert(offsetof(InterruptFrame, t0) == 24);
+static_assert(offsetof(InterruptFrame, t1) == 32);
+static_assert(offsetof(InterruptFrame, t2) == 40);
+static_assert(offsetof(InterruptFrame, a0) == 48);
+static_assert(offsetof(InterruptFrame, a7) == 104);
+static_assert(offsetof(InterruptFrame, t3) == 112);
+static_assert(offsetof(InterruptFrame, t6) == 136);
+static_assert(offsetof(InterruptFrame, sepc) == 144);
+static_assert(offsetof(InterruptFrame, sstatus) == 152);
+static_assert(offsetof(InterruptFrame, scause) == 160);
+static_assert(offsetof(InterruptFrame, gp) == 168);
+
+/**
+ * @brief 快速路径的中断处理函数
+ * @param frame 被打断时的调用者保存寄存器，修改后在返回时生效
+ * @note 在关中断状态下运行，不能打开中断，不能使用浮点/向量寄存器
+ */
+using InterruptHandler = void (*)(InterruptFrame *frame);
+
+/// 向量表的项数，对应 ScauseInfo::kInterruptMaxCount
+static constexpr size_t kVectorTableEntries = 16;
+
+namespace detail::trap {
+
+/**
+ * @brief 未注册中断的默认处理，在 sie 中关闭该中断，避免反复进入
+ * @param frame 中断帧
+ */
+inline void MaskUnhandledInterrupt(InterruptFrame *frame) {
+  regs::csr::Sie::ClearBits(uint64_t{1}
+                            << (frame->scause & (kVectorTableEntries - 1)));
+}
+
+/// 以中断号为下标的处理函数表，入口汇编以固定的符号名访问
+[[gnu::used]] inline InterruptHandler
+    interrupt_handlers[kVectorTableEntries] __asm__(
+        "cpu_io_riscv64_interrupt_handlers") = {
+        MaskUnhandledInterrupt, MaskUnhandledInterrupt, MaskUnhandledInterrupt,
+        MaskUnhandledInterrupt, MaskUnhandledInterrupt, MaskUnhandledInterrupt,
+        MaskUnhandledInterrupt, MaskUnhandledInterrupt, MaskUnhandledInterrupt,
+        MaskUnhandledInterrupt, MaskUnhandledInterrupt, MaskUnhandledInterrupt,
+        MaskUnhandledInterrupt, MaskUnhandledInterrupt, MaskUnhandledInterrupt,
+        MaskUnhandledInterrupt,
+};
+
+}  // namespace detail::trap
+
+/**
+ * @brief 快速中断入口
+ * 以 sscratch 中的 TrapPerCpuHeader 暂存 t0 并找到栈：从内核态进入时
+ * 在被打断的栈上分配 InterruptFrame，从用户态进入时使用 kernel_sp，
+ * 并与 Linux 一样保存用户的 gp 后装入内核的 __global_pointer$。
+ * 只保存调用者保存的寄存器，tp 换成 core id 后按 scause 调用
+ * SetInterruptHandler() 注册的处理函数，返回时恢复 sepc/sstatus/gp 并 sret
+ * @note 偏移与 InterruptFrame、TrapPerCpuHeader 的 static_assert 一致；
+ * 处理函数运行期间 sscratch 保持为每核心数据区，GetPerCpuBase() 可用；
+ * 内核的链接脚本须定义 __global_pointer$
+ */
+void InterruptEntry() __asm__("cpu_io_riscv64_interrupt_entry");
+__attribute__((naked, noinline, used)) inline void InterruptEntry() {
+  __asm__(
+      // sp = 每核心数据区，sscratch = 被打断时的 sp
+      "csrrw sp, sscratch, sp\n\t"
+      "sd t0, 24(sp)\n\t"
+      // sstatus.SPP: 从内核态进入时沿用原来的栈
+      "csrr t0, sstatus\n\t"
+      "andi t0, t0, 0x100\n\t"
+      "bnez t0, 1f\n\t"
+      // 从用户态进入: 保存用户的 gp 后换成内核的 gp，
+      // norelax 避免 lla 被松弛为基于旧 gp 的寻址
+      "ld t0, 16(sp)\n\t"
+      "addi t0, t0, -176\n\t"
+      "sd gp, 168(t0)\n\t"
+      ".option push\n\t"
+      ".option norelax\n\t"
+      "lla gp, __global_pointer$\n\t"
+      ".option pop\n\t"
+      "j 2f\n"
+      "1:\n\t"
+      "csrr t0, sscratch\n\t"
+      "addi t0, t0, -176\n\t"
+      "sd gp, 168(t0)\n"
+      "2:\n\t"
+      "sd ra, 0(t0)\n\t"
+      "sd tp, 16(t0)\n\t"
+      "sd t1, 32(t0)\n\t"
+      "sd t2, 40(t0)\n\t"
+      "sd a0, 48(t0)\n\t"
+      "sd a1, 56(t0)\n\t"
+      "sd a2, 64(t0)\n\t"
+      "sd a3, 72(t0)\n\t"
+      "sd a4, 80(t0)\n\t"
+      "sd a5, 88(t0)\n\t"
+      "sd a6, 96(t0)\n\t"
+      "sd a7, 104(t0)\n\t"
+      "sd t3, 112(t0)\n\t"
+      "sd t4, 120(t0)\n\t"
+      "sd t5, 128(t0)\n\t"
+      "sd t6, 136(t0)\n\t"
+      // 原来的 t0 与 sp
+      "ld t1, 24(sp)\n\t"
+      "sd t1, 24(t0)\n\t"
+      "csrr t1, sscratch\n\t"
+      "sd t1, 8(t0)\n\t"
+      // sscratch 恢复为每核心数据区，tp = core id
+      "csrw sscratch, sp\n\t"
+      "ld tp, 8(sp)\n\t"
+      "mv sp, t0\n\t"
+      "csrr t0, sepc\n\t"
+      "sd t0, 144(sp)\n\t"
+      "csrr t0, sstatus\n\t"
+      "sd t0, 152(sp)\n\t"
+      "csrr t0, scause\n\t"
+      "sd t0, 160(sp)\n\t"
+      // 左移同时去掉 Interrupt 位
+      "slli t0, t0, 3\n\t"
+      "lla t1, cpu_io_riscv64_interrupt_handlers\n\t"
+      "add t1, t1, t0\n\t"
+      "ld t1, 0(t1)\n\t"
+      "mv a0, sp\n\t"
+      "jalr t1\n\t"
+      "ld t0, 144(sp)\n\t"
+      "csrw sepc, t0\n\t"
+      "ld t0, 152(sp)\n\t"
+      "csrw sstatus, t0\n\t"
+      "ld ra, 0(sp)\n\t"
+      "ld gp, 168(sp)\n\t"
+      "ld tp, 16(sp)\n\t"
+      "ld t0, 24(sp)\n\t"
+      "ld t1, 32(sp)\n\t"
+      "ld t2, 40(sp)\n\t"
+      "ld a0, 48(sp)\n\t"
+      "ld a1, 56(sp)\n\t"
+      "ld a2, 64(sp)\n\t"
+      "ld a3, 72(sp)\n\t"
+      "ld a4, 80(sp)\n\t"
+      "ld a5, 88(sp)\n\t"
+      "ld a6, 96(sp)\n\t"
+      "ld a7, 104(sp)\n\t"
+      "ld t3, 112(sp)\n\t"
+      "ld t4, 120(sp)\n\t"
+      "ld t5, 128(sp)\n\t"
+      "ld t6, 136(sp)\n\t"
+      "ld sp, 8(sp)\n\t"
+      "sret");
+}
+
+/**
+ * @brief Vectored 模式的向量表
+ * 异常转到 cpu_io_riscv64_trap_entry 保存完整现场，
+ * 软件/定时器/外部/计数器溢出中断转到 InterruptEntry()，
+ * 其余保留的中断号也走完整现场
+ * @note 每项是一条 4 字节的 j，入口需在向量表 ±1 MiB 范围内；
+ * 16 及以上的平台自定义中断须保持在 sie 中关闭
+ */
+__attribute__((naked, noinline, aligned(64))) inline void VectorTable() {
+  __asm__(
+      ".option push\n\t"
+      ".option norvc\n\t"
+      "j cpu_io_riscv64_trap_entry\n\t"
+      // 1: Supervisor Software Interrupt
+      "j cpu_io_riscv64_interrupt_entry\n\t"
+      "j cpu_io_riscv64_trap_entry\n\t"
+      "j cpu_io_riscv64_trap_entry\n\t"
+      "j cpu_io_riscv64_trap_entry\n\t"
+      // 5: Supervisor Timer Interrupt
+      "j cpu_io_riscv64_interrupt_entry\n\t"
+      "j cpu_io_riscv64_trap_entry\n\t"
+      "j cpu_io_riscv64_trap_entry\n\t"
+      "j cpu_io_riscv64_trap_entry\n\t"
+      // 9: Supervisor External Interrupt
+      "j cpu_io_riscv64_interrupt_entry\n\t"
+      "j cpu_io_riscv64_trap_entry\n\t"
+      "j cpu_io_riscv64_trap_entry\n\t"
+      "j cpu_io_riscv64_trap_entry\n\t"
+      // 13: Counter-overflow Interrupt
+      "j cpu_io_riscv64_interrupt_entry\n\t"
+      "j cpu_io_riscv64_trap_entry\n\t"
+      "j cpu_io_riscv64_trap_entry\n\t"
+      ".option pop");
+}
+
+/**
+ * @brief 注册快速路径的中断处理函数
+ * @param cause 中断号 (scause 去掉 Interrupt 位)，应为 1/5/9/13
+ * @param handler 处理函数
+ * @return bool 中断号越界或 handler 为空时返回 false
+ */
+static __always_inline auto SetInterruptHandler(uint64_t cause,
+                                                InterruptHandler handler)
+    -> bool {
+  if (cause >= kVectorTableEntries || handler == nullptr) {
+    return false;
+  }
+  __atomic_store_n(&detail::trap::interrupt_handlers[cause], handler,
+                   __ATOMIC_RELAXED);
+  return true;
+}
+
+/**
+ * @brief 设置从用户态进入快速中断入口时使用的内核栈
+ * @param kernel_sp 当前线程的内核栈顶，16 字节对齐
+ * @note 每核心数据区须以 TrapPerCpuHeader 开头并已通过 SetPerCpuBase() 安装
+ */
+static __always_inline void SetTrapKernelStack(uint64_t kernel_sp) {
+  auto header = reinterpret_cast<TrapPerCpuHeader *>(
+      detail::regs::csr::Sscratch::Read());
+  header->kernel_sp = kernel_sp;
+}
+
+/**
+ * @brief 以 Vectored 模式安装 VectorTable()
+ * @return bool 安装是否成功
+ * @note 安装前应先注册处理函数并设置内核栈
+ */
+static __always_inline auto InstallVectorTable() -> bool {
+  return detail::regs::csr::Stvec::SetVectored(
+      reinterpret_cast<uint64_t>(&VectorTable));
+}
+
+}  // namespace cpu_io
+
+#endif /* CPU_IO_INCLUDE_RISCV64_TRAP_ENTRY_HPP_ */
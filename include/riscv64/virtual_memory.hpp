@@ -12,6 +12,17 @@
 
 namespace cpu_io {
 
+namespace detail {
+
+namespace tlb {
+
+/// 已实现的 ASID 位数，-1 表示尚未探测
+inline int8_t asid_bits = -1;
+
+}  // namespace tlb
+
+}  // namespace detail
+
 namespace virtual_memory {
 /// 页表项位偏移定义
 static constexpr uint8_t kValidOffset = 0;
@@ -40,22 +51,40 @@ static constexpr size_t kKernelOffset = 0x0;
 
 /// 页表项属性位数
 static constexpr size_t kPteAttributeBits = 10;
+/// 页表项 PPN 掩码 [53:10]
+static constexpr uint64_t kPtePpnMask = 0x003FFFFFFFFFFC00ULL;
+/// 页表项高位属性掩码 [63:54]，包括 Svpbmt 与 Svnapot 位
+static constexpr uint64_t kPteUpperAttributeMask = 0xFFC0000000000000ULL;
 /// 页内偏移位数
 static constexpr size_t kPageOffsetBits = 12;
 /// 虚拟页号位数
 static constexpr size_t kVpnBits = 9;
 /// 虚拟页号位掩码
 static constexpr size_t kVpnMask = 0x1FF;
-/// 页表级数（三级页表）
+/// 页表级数与 satp 分页模式，默认 Sv39，可通过
+/// CPU_IO_RISCV64_SV48 / CPU_IO_RISCV64_SV57 选择
+#if defined(CPU_IO_RISCV64_SV57)
+static constexpr size_t kPageTableLevels = 5;
+static constexpr uint8_t kPagingMode =
+    detail::register_info::csr::SatpInfo::kSv57;
+#elif defined(CPU_IO_RISCV64_SV48)
+static constexpr size_t kPageTableLevels = 4;
+static constexpr uint8_t kPagingMode =
+    detail::register_info::csr::SatpInfo::kSv48;
+#else
 static constexpr size_t kPageTableLevels = 3;
+static constexpr uint8_t kPagingMode =
+    detail::register_info::csr::SatpInfo::kSv39;
+#endif
+/// FlushTLBRange 的默认阈值，超过该页数时改为整体刷新
+static constexpr size_t kFlushTLBRangeThreshold = 64;
 
 /**
  * @brief 开启分页
  */
 static __always_inline void EnablePage() {
   detail::regs::csr::Satp::Asid::Write(0);
-  detail::regs::csr::Satp::Mode::Write(
-      detail::register_info::csr::SatpInfo::kSv39);
+  detail::regs::csr::Satp::Mode::Write(kPagingMode);
 }
 
 /**
@@ -84,6 +113,75 @@ static __always_inline auto GetPageDirectory() -> uint64_t {
          << detail::register_info::csr::SatpInfo::kPpnOffset;
 }
 
+/**
+ * @brief 切换地址空间，一次写 satp 同时设置模式、ASID 与根页表
+ * @param pgd 根页表物理地址
+ * @param asid 地址空间标识符，需小于 1 << GetAsidBits()
+ * @note 不刷新 TLB，ASID 被重新分配给其它地址空间时需先 FlushTLBAsid
+ */
+static __always_inline void SwitchAddressSpace(uint64_t pgd, uint16_t asid) {
+  using SatpInfo = detail::register_info::csr::SatpInfo;
+  detail::regs::csr::Satp::Write(
+      (static_cast<uint64_t>(kPagingMode) << SatpInfo::Mode::kBitOffset) |
+      ((static_cast<uint64_t>(asid) << SatpInfo::Asid::kBitOffset) &
+       SatpInfo::Asid::kBitMask) |
+      ((pgd >> SatpInfo::kPpnOffset) & SatpInfo::Ppn::kBitMask));
+}
+
+/**
+ * @brief 获取当前 ASID
+ * @return uint16_t satp.ASID
+ */
+static __always_inline auto GetCurrentAsid() -> uint16_t {
+  return detail::regs::csr::Satp::Asid::Get();
+}
+
+/**
+ * @brief 获取已实现的 ASID 位数（ASIDLEN）
+ * 首次调用时向 satp.ASID 写全 1 后读回探测，结果缓存
+ * @return size_t ASID 位数，0 表示不支持 ASID 或尚未开启分页
+ * @pre 已开启分页 (satp.MODE 不为 Bare)，satp.MODE 为 Bare 时写 satp.ASID
+ * 的结果未规定，此时不探测也不缓存，返回 0
+ * @note 探测会临时修改当前 ASID 并刷新本核心 TLB，应在启动阶段调用
+ */
+static __always_inline auto GetAsidBits() -> size_t {
+  if (detail::tlb::asid_bits < 0) {
+    using SatpInfo = detail::register_info::csr::SatpInfo;
+    auto old_value = detail::regs::csr::Satp::Read();
+    if ((old_value & SatpInfo::Mode::kBitMask) == 0) {
+      return 0;
+    }
+    detail::regs::csr::Satp::Write(old_value | SatpInfo::Asid::kBitMask);
+    auto asid = (detail::regs::csr::Satp::Read() & SatpInfo::Asid::kBitMask) >>
+                SatpInfo::Asid::kBitOffset;
+    detail::regs::csr::Satp::Write(old_value);
+    __asm__ volatile("sfence.vma zero, zero" : : : "memory");
+    detail::tlb::asid_bits = static_cast<int8_t>(__builtin_popcountll(asid));
+  }
+  return static_cast<size_t>(detail::tlb::asid_bits);
+}
+
+/**
+ * @brief 检查是否支持指定的分页模式
+ * 按规范，写入不支持的模式时 satp 保持不变，写入后读回即可判断
+ * @param mode 分页模式，如 SatpInfo::kSv48
+ * @param pgd 该模式下的根页表物理地址，需恒等映射当前执行的代码
+ * @return true 支持该模式
+ * @return false 不支持该模式
+ * @note 需在 satp 为 Bare 时调用，返回前恢复 Bare 并刷新 TLB
+ */
+static __always_inline auto IsPagingModeSupported(uint8_t mode, uint64_t pgd)
+    -> bool {
+  using SatpInfo = detail::register_info::csr::SatpInfo;
+  detail::regs::csr::Satp::Write(
+      (static_cast<uint64_t>(mode) << SatpInfo::Mode::kBitOffset) |
+      ((pgd >> SatpInfo::kPpnOffset) & SatpInfo::Ppn::kBitMask));
+  auto supported = detail::regs::csr::Satp::Mode::Get() == mode;
+  detail::regs::csr::Satp::Write(0);
+  __asm__ volatile("sfence.vma zero, zero" : : : "memory");
+  return supported;
+}
+
 /**
  * @brief 物理地址转换为页表项
  * @param physical_addr 物理地址
@@ -93,8 +191,10 @@ static __always_inline auto GetPageDirectory() -> uint64_t {
 static __always_inline auto PhysicalToPageTableEntry(uint64_t physical_addr,
                                                      uint64_t flags)
     -> uint64_t {
-  return ((physical_addr >> kPageOffsetBits) << kPteAttributeBits) |
-         (flags & ((1ULL << kPteAttributeBits) - 1));
+  return (((physical_addr >> kPageOffsetBits) << kPteAttributeBits) &
+          kPtePpnMask) |
+         (flags & ((1ULL << kPteAttributeBits) - 1)) |
+         (flags & kPteUpperAttributeMask);
 }
 
 /**
@@ -103,7 +203,7 @@ static __always_inline auto PhysicalToPageTableEntry(uint64_t physical_addr,
  * @return uint64_t 物理地址
  */
 static __always_inline auto PageTableEntryToPhysical(uint64_t pte) -> uint64_t {
-  return (pte >> kPteAttributeBits) << kPageOffsetBits;
+  return ((pte & kPtePpnMask) >> kPteAttributeBits) << kPageOffsetBits;
 }
 
 /**
@@ -136,6 +236,50 @@ static __always_inline auto GetPageTableLevelShift(size_t level) -> size_t {
   return kPageOffsetBits + (level * kVpnBits);
 }
 
+/**
+ * @brief 获取指定级别页表项映射的大小
+ * @param level 页表级别，0 为 4KB 页
+ * @return uint64_t 映射大小
+ */
+static __always_inline auto GetLevelPageSize(size_t level) -> uint64_t {
+  return 1ULL << GetPageTableLevelShift(level);
+}
+
+/**
+ * @brief 获取可用于大页映射的最高页表级别
+ * Sv39 下 level 1 为 2MB megapage，level 2 为 1GB gigapage
+ * @return size_t 最高大页级别
+ */
+static __always_inline auto GetMaxBlockLevel() -> size_t {
+  return kPageTableLevels - 1;
+}
+
+/**
+ * @brief 创建指定级别的叶子页表项
+ * RISC-V 各级叶子项格式相同，设置了 R/W/X 的项即为叶子
+ * @param level 页表级别
+ * @param physical_addr 物理地址，需按 GetLevelPageSize(level) 对齐
+ * @param flags 页表项标志位，需包含 R/W/X 中至少一位
+ * @return uint64_t 页表项值
+ */
+static __always_inline auto CreateBlockEntry([[maybe_unused]] size_t level,
+                                             uint64_t physical_addr,
+                                             uint64_t flags) -> uint64_t {
+  return PhysicalToPageTableEntry(physical_addr, flags);
+}
+
+/**
+ * @brief 检查页表项是否为有效的叶子项（4KB 页或大页）
+ * @param pte 页表项
+ * @param level 页表项所在的级别
+ * @return true 叶子页表项
+ * @return false 无效项或指向下一级页表
+ */
+static __always_inline auto IsLeafEntry(uint64_t pte,
+                                        [[maybe_unused]] size_t level) -> bool {
+  return IsPageTableEntryValid(pte) && (pte & (kRead | kWrite | kExec)) != 0;
+}
+
 /**
  * @brief 虚拟地址转物理地址（简单的内核空间映射）
  * @param virtual_addr 虚拟地址
@@ -243,11 +387,18 @@ static __always_inline auto CheckPageTableEntryPermissions(
 /**
  * @brief 刷新特定地址的 TLB
  * @param virtual_addr 要刷新的虚拟地址
- * @param asid 地址空间标识符（当前忽略）
+ * @param asid 地址空间标识符，0 表示所有地址空间
  */
-static __always_inline void FlushTLBAddress(
-    uint64_t virtual_addr, [[maybe_unused]] uint64_t asid = 0) {
-  __asm__ volatile("sfence.vma %0, zero" : : "r"(virtual_addr));
+static __always_inline void FlushTLBAddress(uint64_t virtual_addr,
+                                            uint64_t asid = 0) {
+  if (asid == 0) {
+    __asm__ volatile("sfence.vma %0, zero" : : "r"(virtual_addr) : "memory");
+  } else {
+    __asm__ volatile("sfence.vma %0, %1"
+                     :
+                     : "r"(virtual_addr), "r"(asid)
+                     : "memory");
+  }
 }
 
 /**
@@ -257,6 +408,24 @@ static __always_inline void FlushTLBAll() {
   __asm__ volatile("sfence.vma zero, zero");
 }
 
+/**
+ * @brief 只刷新当前核心的所有 TLB 条目
+ * @note sfence.vma 本身只作用于当前 hart，与 FlushTLBAll 相同
+ */
+static __always_inline void FlushTLBAllLocal() { FlushTLBAll(); }
+
+/**
+ * @brief 刷新指定 ASID 的所有 TLB 条目（不含全局项）
+ * @param asid 地址空间标识符，0 表示刷新全部
+ */
+static __always_inline void FlushTLBAsid(uint64_t asid) {
+  if (asid == 0) {
+    FlushTLBAll();
+  } else {
+    __asm__ volatile("sfence.vma zero, %0" : : "r"(asid) : "memory");
+  }
+}
+
 /**
  * @brief 计算地址范围包含的页数
  * @param start_addr 起始地址
@@ -270,6 +439,32 @@ static __always_inline auto GetPageCount(uint64_t start_addr, uint64_t end_addr)
   return (aligned_end - aligned_start) / kPageSize;
 }
 
+/**
+ * @brief 刷新虚拟地址范围内的 TLB
+ * @param start_addr 起始虚拟地址
+ * @param end_addr 结束虚拟地址（不包含）
+ * @param asid 地址空间标识符，0 表示所有地址空间
+ * @param threshold 页数超过该值时改为刷新整个地址空间
+ * @note 指定 ASID 时 sfence.vma 不会刷新全局映射
+ */
+static __always_inline void FlushTLBRange(
+    uint64_t start_addr, uint64_t end_addr, uint64_t asid = 0,
+    size_t threshold = kFlushTLBRangeThreshold) {
+  auto page_count = GetPageCount(start_addr, end_addr);
+  if (page_count == 0) {
+    return;
+  }
+  if (page_count > threshold) {
+    FlushTLBAsid(asid);
+    return;
+  }
+
+  auto addr = PageAlign(start_addr);
+  for (size_t i = 0; i < page_count; i++, addr += kPageSize) {
+    FlushTLBAddress(addr, asid);
+  }
+}
+
 /**
  * @brief 获取页表中间项权限
  * @return uint8_t 页表中间项权限标志
@@ -342,6 +537,37 @@ static __always_inline auto GetUserPagePermissions(bool readable = true,
 }
 
 }  // namespace virtual_memory
+
+namespace detail::tlb {
+
+/**
+ * @brief TlbBatch 使用的 RISC-V 失效操作
+ */
+struct BatchFlushPolicy {
+  static __always_inline auto ShouldFlushAll(size_t pages, size_t threshold,
+                                             uint64_t /*asid*/) -> bool {
+    return pages > threshold;
+  }
+
+  static __always_inline void FlushAll(uint64_t asid) {
+    virtual_memory::FlushTLBAsid(asid);
+  }
+
+  /// ranges 为 TlbRange 序列，定义见 tlb_batch.hpp
+  template <class Ranges>
+  static __always_inline void FlushRanges(const Ranges &ranges,
+                                          uint64_t asid) {
+    for (const auto &range : ranges) {
+      for (auto addr = range.start; addr < range.end;
+           addr += virtual_memory::kPageSize) {
+        virtual_memory::FlushTLBAddress(addr, asid);
+      }
+    }
+  }
+};
+
+}  // namespace detail::tlb
+
 }  // namespace cpu_io
 
 #endif  // CPU_IO_INCLUDE_RISCV64_VIRTUAL_MEMORY_HPP_
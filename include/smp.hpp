@@ -0,0 +1,108 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_SMP_HPP_
+#define CPU_IO_INCLUDE_SMP_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "cpu_io.h"
+
+namespace cpu_io {
+
+/**
+ * @brief 从核心启动的控制块
+ * 入口代码通过固定偏移访问，布局不能改变
+ */
+struct SecondaryBoot {
+  /// 栈顶地址表
+  const uint64_t *stacks;
+  /// 栈的数量
+  uint64_t count;
+  /// 下一个待领取的栈的下标，x86_64 的入口代码以 lock xadd 领取，
+  /// 不小于 count 时应停机
+  uint64_t next_stack;
+  /// 已完成初始化的从核心数，由 MarkSecondaryOnline() 增加
+  uint64_t online;
+};
+
+static_assert(offsetof(SecondaryBoot, stacks) == 0);
+static_assert(offsetof(SecondaryBoot, count) == 8);
+static_assert(offsetof(SecondaryBoot, next_stack) == 16);
+static_assert(offsetof(SecondaryBoot, online) == 24);
+
+/// StartSecondaryCores() 的默认超时 (纳秒)
+static constexpr uint64_t kSecondaryStartTimeout = 1000000000;
+
+namespace detail {
+/// 从核心启动的控制块
+inline SecondaryBoot secondary_boot{};
+}  // namespace detail
+
+/**
+ * @brief 获取从核心启动的控制块，用于将其地址写入入口代码
+ * @return SecondaryBoot& 控制块
+ */
+static __always_inline auto GetSecondaryBoot() -> SecondaryBoot & {
+  return detail::secondary_boot;
+}
+
+/**
+ * @brief 从核心完成初始化后调用，通知 StartSecondaryCores()
+ * @note AArch64 需在开启 MMU 与缓存后调用，否则原子操作可能不生效
+ */
+static __always_inline void MarkSecondaryOnline() {
+  __atomic_fetch_add(&detail::secondary_boot.online, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 并行启动从核心，等待它们全部调用 MarkSecondaryOnline()
+ * 先向所有目标发出启动请求，再等待共享的完成计数，
+ * 启动延时与固件调用的耗时只付一次，而不是逐个核心累加。
+ * - x86_64: INIT-SIPI-SIPI，hw_ids 为空时以目标简写广播到所有其它核心。
+ * 入口为实模式代码，通过 GetSecondaryBoot() 领取栈
+ * - AArch64: 对每个 MPIDR 调用 PSCI CPU_ON，入口的 x0 为栈顶
+ * - RISC-V: 对每个 hart ID 调用 SBI HSM hart_start，
+ * 入口的 a0 为 hart ID，a1 为栈顶
+ * @param entry 入口物理地址，x86_64 需 4KB 对齐且低于 1MB
+ * @param stacks 栈顶地址，按启动顺序排列
+ * @param hw_ids 目标核心的 APIC ID/MPIDR/hart ID，与 stacks 一一对应
+ * @param timeout_ns 超时 (纳秒)
+ * @return size_t 超时前完成初始化的从核心数
+ * @pre 已调用 CalibrateTimestamp()
+ */
+static __always_inline auto StartSecondaryCores(
+    uint64_t entry, std::span<const uint64_t> stacks,
+    std::span<const uint64_t> hw_ids = {},
+    uint64_t timeout_ns = kSecondaryStartTimeout) -> size_t {
+  auto &boot = detail::secondary_boot;
+  boot.stacks = stacks.data();
+  boot.count = stacks.size();
+  boot.next_stack = 0;
+  __atomic_store_n(&boot.online, 0, __ATOMIC_RELEASE);
+  // 入口代码在 MMU 与缓存开启前就会读取控制块与栈表
+  CleanDcacheRange(&boot, sizeof(boot));
+  CleanDcacheRange(stacks.data(), stacks.size_bytes());
+
+  auto expected = detail::StartCores(entry, stacks, hw_ids);
+  auto deadline = detail::CyclesDeadline(ReadCycles(), timeout_ns);
+  auto online = __atomic_load_n(&boot.online, __ATOMIC_ACQUIRE);
+  while (online < expected) {
+    auto now = ReadCycles();
+    if (now >= deadline) {
+      break;
+    }
+    auto remaining = (timeout_ns == kWaitForever) ? kWaitForever
+                                                  : CyclesToNs(deadline - now);
+    WaitOnAddress(&boot.online, online, remaining);
+    online = __atomic_load_n(&boot.online, __ATOMIC_ACQUIRE);
+  }
+  return online;
+}
+
+}  // namespace cpu_io
+
+#endif /* CPU_IO_INCLUDE_SMP_HPP_ */
@@ -0,0 +1,318 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_SPINLOCK_HPP_
+#define CPU_IO_INCLUDE_SPINLOCK_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cpu_io.h"
+#include "per_cpu.hpp"
+
+namespace cpu_io {
+
+/**
+ * @brief 排队自旋锁
+ * 按取号顺序获得锁，保证公平；等待者只读 owner_，
+ * 释放时只有一次普通写。
+ * 原子操作使用 __atomic 内建函数，AArch64 以 +lse 编译时为 LSE 指令
+ */
+class TicketLock {
+ public:
+  /// @name 构造/析构函数
+  /// @{
+  TicketLock() = default;
+  TicketLock(const TicketLock &) = delete;
+  TicketLock(TicketLock &&) = delete;
+  auto operator=(const TicketLock &) -> TicketLock & = delete;
+  auto operator=(TicketLock &&) -> TicketLock & = delete;
+  ~TicketLock() = default;
+  /// @}
+
+  /**
+   * @brief 获得锁
+   */
+  void Lock() {
+    auto ticket = __atomic_fetch_add(&next_, 1, __ATOMIC_RELAXED);
+    SpinUntil(&owner_, [ticket](uint32_t owner) { return owner == ticket; });
+  }
+
+  /**
+   * @brief 尝试获得锁，不等待
+   * @return true 获得了锁
+   * @note CAS 在 next_ 上，不与 Unlock() 对 owner_ 的 release 写同步，
+   * 由 owner_ 的 acquire 读保证看到上一个持有者的写
+   */
+  auto TryLock() -> bool {
+    auto owner = __atomic_load_n(&owner_, __ATOMIC_ACQUIRE);
+    return __atomic_compare_exchange_n(&next_, &owner, owner + 1, false,
+                                       __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+  }
+
+  /**
+   * @brief 释放锁
+   */
+  void Unlock() {
+    // 只有持有者修改 owner_，不需要读-改-写
+    __atomic_store_n(&owner_, owner_ + 1, __ATOMIC_RELEASE);
+  }
+
+  /**
+   * @brief 锁是否被持有
+   * @return true 被持有
+   */
+  [[nodiscard]] auto IsLocked() const -> bool {
+    return __atomic_load_n(&owner_, __ATOMIC_RELAXED) !=
+           __atomic_load_n(&next_, __ATOMIC_RELAXED);
+  }
+
+ private:
+  /// 当前持有者的号
+  uint32_t owner_ = 0;
+  /// 下一个取号者的号
+  uint32_t next_ = 0;
+};
+
+/**
+ * @brief MCS 锁的等待节点
+ * 每个等待者在自己的节点上自旋，锁释放时只有下一个等待者的缓存行失效。
+ * 节点通常放在每核心数据区中，中断处理中也会获得 MCS 锁时
+ * 每个嵌套层级 (线程/中断) 使用一个节点
+ */
+struct alignas(kCacheLineSize) McsNode {
+  /// 下一个等待者
+  McsNode *next;
+  /// 非 0 表示仍需等待
+  uint32_t locked;
+};
+
+/**
+ * @brief MCS 队列自旋锁
+ * 锁本身只有一个指向队尾的指针，争用时每个等待者只在自己的节点上自旋，
+ * 核心数很多时比 TicketLock 的扩展性更好
+ */
+class McsLock {
+ public:
+  /// @name 构造/析构函数
+  /// @{
+  McsLock() = default;
+  McsLock(const McsLock &) = delete;
+  McsLock(McsLock &&) = delete;
+  auto operator=(const McsLock &) -> McsLock & = delete;
+  auto operator=(McsLock &&) -> McsLock & = delete;
+  ~McsLock() = default;
+  /// @}
+
+  /**
+   * @brief 获得锁
+   * @param node 本次获得锁使用的节点，释放前不能复用
+   */
+  void Lock(McsNode &node) {
+    node.next = nullptr;
+    node.locked = 1;
+    auto prev = __atomic_exchange_n(&tail_, &node, __ATOMIC_ACQ_REL);
+    if (prev == nullptr) {
+      return;
+    }
+    __atomic_store_n(&prev->next, &node, __ATOMIC_RELEASE);
+    SpinUntil(&node.locked, [](uint32_t locked) { return locked == 0; });
+  }
+
+  /**
+   * @brief 尝试获得锁，不等待
+   * @param node 本次获得锁使用的节点
+   * @return true 获得了锁
+   */
+  auto TryLock(McsNode &node) -> bool {
+    node.next = nullptr;
+    node.locked = 1;
+    McsNode *expected = nullptr;
+    return __atomic_compare_exchange_n(&tail_, &expected, &node, false,
+                                       __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+  }
+
+  /**
+   * @brief 释放锁
+   * @param node Lock() 时使用的节点
+   */
+  void Unlock(McsNode &node) {
+    auto next = __atomic_load_n(&node.next, __ATOMIC_ACQUIRE);
+    if (next == nullptr) {
+      auto expected = &node;
+      if (__atomic_compare_exchange_n(&tail_, &expected, nullptr, false,
+                                      __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        return;
+      }
+      // 下一个等待者已交换队尾，但还未链接到本节点
+      next = SpinUntil(&node.next,
+                       [](McsNode *next) { return next != nullptr; });
+    }
+    __atomic_store_n(&next->locked, 0, __ATOMIC_RELEASE);
+  }
+
+  /**
+   * @brief 锁是否被持有
+   * @return true 被持有
+   */
+  [[nodiscard]] auto IsLocked() const -> bool {
+    return __atomic_load_n(&tail_, __ATOMIC_RELAXED) != nullptr;
+  }
+
+ private:
+  /// 等待队列的队尾，nullptr 表示未被持有
+  McsNode *tail_ = nullptr;
+};
+
+/**
+ * @brief 读写自旋锁
+ * 读者之间不互斥；写者等待时置位 kWriterWaiting，阻止新的读者进入，
+ * 避免持续的读者使写者饿死
+ */
+class RwLock {
+ public:
+  /// @name 构造/析构函数
+  /// @{
+  RwLock() = default;
+  RwLock(const RwLock &) = delete;
+  RwLock(RwLock &&) = delete;
+  auto operator=(const RwLock &) -> RwLock & = delete;
+  auto operator=(RwLock &&) -> RwLock & = delete;
+  ~RwLock() = default;
+  /// @}
+
+  /**
+   * @brief 以读者身份获得锁
+   */
+  void ReadLock() {
+    while (true) {
+      auto state = SpinUntil(&state_, [](uint32_t state) {
+        return (state & (kWriterLocked | kWriterWaiting)) == 0;
+      });
+      if (__atomic_compare_exchange_n(&state_, &state, state + kReader, true,
+                                      __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief 尝试以读者身份获得锁，不等待
+   * @return true 获得了锁
+   */
+  auto TryReadLock() -> bool {
+    auto state = __atomic_load_n(&state_, __ATOMIC_RELAXED);
+    if ((state & (kWriterLocked | kWriterWaiting)) != 0) {
+      return false;
+    }
+    return __atomic_compare_exchange_n(&state_, &state, state + kReader, false,
+                                       __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+  }
+
+  /**
+   * @brief 释放读者持有的锁
+   */
+  void ReadUnlock() { __atomic_fetch_sub(&state_, kReader, __ATOMIC_RELEASE); }
+
+  /**
+   * @brief 以写者身份获得锁
+   */
+  void WriteLock() {
+    while (true) {
+      __atomic_fetch_or(&state_, kWriterWaiting, __ATOMIC_RELAXED);
+      // 其它写者获得锁时清除 kWriterWaiting，此时退出等待并在下一轮
+      // 重新置位，保证等待期间新的读者始终无法进入
+      auto state = SpinUntil(&state_, [](uint32_t state) {
+        return (state & ~kWriterWaiting) == 0 || (state & kWriterWaiting) == 0;
+      });
+      if ((state & ~kWriterWaiting) == 0 &&
+          __atomic_compare_exchange_n(&state_, &state, kWriterLocked, false,
+                                      __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief 尝试以写者身份获得锁，不等待
+   * @return true 获得了锁
+   */
+  auto TryWriteLock() -> bool {
+    auto state = __atomic_load_n(&state_, __ATOMIC_RELAXED) & kWriterWaiting;
+    return __atomic_compare_exchange_n(&state_, &state, kWriterLocked, false,
+                                       __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+  }
+
+  /**
+   * @brief 释放写者持有的锁
+   */
+  void WriteUnlock() {
+    __atomic_fetch_and(&state_, ~kWriterLocked, __ATOMIC_RELEASE);
+  }
+
+ private:
+  /// 写者持有锁
+  static constexpr uint32_t kWriterLocked = 1U << 0;
+  /// 有写者在等待
+  static constexpr uint32_t kWriterWaiting = 1U << 1;
+  /// 每个读者在计数中的增量
+  static constexpr uint32_t kReader = 1U << 2;
+
+  /// 读者计数与写者标志
+  uint32_t state_ = 0;
+};
+
+/**
+ * @brief 在作用域内持有锁
+ * @tparam Lock 提供 Lock()/Unlock() 的锁类型，如 TicketLock
+ */
+template <class Lock>
+class LockGuard {
+ public:
+  /// @name 构造/析构函数
+  /// @{
+  explicit LockGuard(Lock &lock) : lock_(lock) { lock_.Lock(); }
+  LockGuard(const LockGuard &) = delete;
+  LockGuard(LockGuard &&) = delete;
+  auto operator=(const LockGuard &) -> LockGuard & = delete;
+  auto operator=(LockGuard &&) -> LockGuard & = delete;
+  ~LockGuard() { lock_.Unlock(); }
+  /// @}
+
+ private:
+  Lock &lock_;
+};
+
+/**
+ * @brief 在作用域内关闭中断并持有锁
+ * 先 IrqSave() 再获得锁，避免持锁时被同一核心上的中断处理重入
+ * @tparam Lock 提供 Lock()/Unlock() 的锁类型，如 TicketLock
+ */
+template <class Lock>
+class IrqLockGuard {
+ public:
+  /// @name 构造/析构函数
+  /// @{
+  explicit IrqLockGuard(Lock &lock) : lock_(lock), flags_(IrqSave()) {
+    lock_.Lock();
+  }
+  IrqLockGuard(const IrqLockGuard &) = delete;
+  IrqLockGuard(IrqLockGuard &&) = delete;
+  auto operator=(const IrqLockGuard &) -> IrqLockGuard & = delete;
+  auto operator=(IrqLockGuard &&) -> IrqLockGuard & = delete;
+  ~IrqLockGuard() {
+    lock_.Unlock();
+    IrqRestore(flags_);
+  }
+  /// @}
+
+ private:
+  Lock &lock_;
+  /// IrqSave() 保存的中断状态
+  uint64_t flags_;
+};
+
+}  // namespace cpu_io
+
+#endif /* CPU_IO_INCLUDE_SPINLOCK_HPP_ */
@@ -0,0 +1,184 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_TIME_SOURCE_HPP_
+#define CPU_IO_INCLUDE_TIME_SOURCE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cpu_io.h"
+
+namespace cpu_io {
+
+/**
+ * @brief 跨核心共享的时间源
+ * 负责计时的核心在定时器中断中调用 Tick()，发布节拍数与时间基准，
+ * 其它核心不加锁读取。GetJiffies() 为一次原子读，不会等待；
+ * 时间基准保存在两个快照中，写者只修改未发布的快照，再推进顺序计数发布，
+ * GetNs()/GetCoarseNs() 读取顺序计数选中的快照，不会等待写者，
+ * 只在读取期间又发布了新快照时重试。顺序计数与两个快照各占一个缓存行
+ * @note 只允许一个写者，Tick() 与 SetFrequency() 需在同一核心上调用
+ */
+class alignas(kCacheLineSize) TimeSource {
+ public:
+  /**
+   * @brief 构造函数
+   * @param frequency 时间戳计数器频率 (Hz)，默认使用校准后的频率
+   */
+  explicit TimeSource(uint64_t frequency = GetTimestampFrequency()) {
+    auto scale = ClockScale::Make(frequency, ClockScale::kNsPerSec);
+    snapshots_[0] = {ReadCycles(), 0, scale.mult, scale.shift};
+  }
+
+  /// @name 构造/析构函数
+  /// @{
+  TimeSource(const TimeSource &) = delete;
+  TimeSource(TimeSource &&) = delete;
+  auto operator=(const TimeSource &) -> TimeSource & = delete;
+  auto operator=(TimeSource &&) -> TimeSource & = delete;
+  ~TimeSource() = default;
+  /// @}
+
+  /**
+   * @brief 发布一次节拍，在负责计时的定时器中断中调用
+   * @param ticks 本次经过的节拍数，无节拍模式下可大于 1
+   */
+  void Tick(uint64_t ticks = 1) {
+    auto cycles = ReadCycles();
+    const auto &current = snapshots_[seq_ & 1];
+    Publish(cycles, {current.mult, current.shift});
+    Store(jiffies_, Load(jiffies_) + ticks);
+  }
+
+  /**
+   * @brief 修改时间戳计数器频率，已经过的时间保持连续
+   * @param frequency 时间戳计数器频率 (Hz)
+   */
+  void SetFrequency(uint64_t frequency) {
+    auto cycles = ReadCycles();
+    Publish(cycles, ClockScale::Make(frequency, ClockScale::kNsPerSec));
+  }
+
+  /**
+   * @brief 获取节拍数
+   * @return uint64_t 节拍数
+   */
+  [[nodiscard]] auto GetJiffies() const -> uint64_t { return Load(jiffies_); }
+
+  /**
+   * @brief 获取自构造以来经过的纳秒数
+   * @return uint64_t 纳秒，单调不减
+   */
+  [[nodiscard]] auto GetNs() const -> uint64_t {
+    uint64_t seq;
+    uint64_t base_cycles;
+    uint64_t base_ns;
+    ClockScale scale;
+    do {
+      seq = __atomic_load_n(&seq_, __ATOMIC_ACQUIRE);
+      const auto &snapshot = snapshots_[seq & 1];
+      base_cycles = Load(snapshot.base_cycles);
+      base_ns = Load(snapshot.base_ns);
+      scale = {Load(snapshot.mult), Load(snapshot.shift)};
+    } while (RetryRead(seq));
+    auto cycles = ReadCycles();
+    // 其它核心的计数器可能略落后于写者
+    if (cycles < base_cycles) {
+      return base_ns;
+    }
+    return base_ns + scale.Apply(cycles - base_cycles);
+  }
+
+  /**
+   * @brief 获取上一次 Tick() 时的纳秒数，不读取计数器
+   * @return uint64_t 纳秒，精度为一个节拍
+   */
+  [[nodiscard]] auto GetCoarseNs() const -> uint64_t {
+    uint64_t seq;
+    uint64_t base_ns;
+    do {
+      seq = __atomic_load_n(&seq_, __ATOMIC_ACQUIRE);
+      base_ns = Load(snapshots_[seq & 1].base_ns);
+    } while (RetryRead(seq));
+    return base_ns;
+  }
+
+ private:
+  /// 时间基准快照，独占缓存行
+  struct alignas(kCacheLineSize) Snapshot {
+    /// 上一次 Tick() 时的计数器值
+    uint64_t base_cycles;
+    /// 上一次 Tick() 时的纳秒数
+    uint64_t base_ns;
+    /// 计数到纳秒换算系数的乘数
+    uint64_t mult;
+    /// 计数到纳秒换算系数的右移位数
+    uint32_t shift;
+  };
+
+  /// 顺序计数，最低位选择已发布的快照
+  uint64_t seq_ = 0;
+  /// 节拍数
+  uint64_t jiffies_ = 0;
+  /// 已发布的快照为 snapshots_[seq_ & 1]，另一个只由写者修改
+  Snapshot snapshots_[2] = {};
+
+  /**
+   * @brief 原子读
+   * @param field 字段
+   * @return T 字段值
+   */
+  template <class T>
+  static __always_inline auto Load(const T &field) -> T {
+    return __atomic_load_n(&field, __ATOMIC_RELAXED);
+  }
+
+  /**
+   * @brief 原子写
+   * @param field 字段
+   * @param value 值
+   */
+  template <class T>
+  static __always_inline void Store(T &field, T value) {
+    __atomic_store_n(&field, value, __ATOMIC_RELAXED);
+  }
+
+  /**
+   * @brief 检查读取期间是否发布了新快照
+   * 发布一次后写者开始修改读者正在读的快照，因此顺序计数变化即需重试
+   * @param seq 读取开始时的顺序计数
+   * @return true 需要重试
+   */
+  [[nodiscard]] auto RetryRead(uint64_t seq) const -> bool {
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return Load(seq_) != seq;
+  }
+
+  /**
+   * @brief 将时间基准推进到 cycles，写入未发布的快照后发布
+   * @param cycles 当前计数器值
+   * @param scale 新快照使用的换算系数
+   */
+  void Publish(uint64_t cycles, ClockScale scale) {
+    const auto &current = snapshots_[seq_ & 1];
+    auto &next = snapshots_[(seq_ + 1) & 1];
+    auto base_ns = current.base_ns;
+    if (cycles > current.base_cycles) {
+      ClockScale current_scale{current.mult, current.shift};
+      base_ns += current_scale.Apply(cycles - current.base_cycles);
+    }
+    Store(next.base_cycles, cycles);
+    Store(next.base_ns, base_ns);
+    Store(next.mult, scale.mult);
+    Store(next.shift, scale.shift);
+    __atomic_store_n(&seq_, seq_ + 1, __ATOMIC_RELEASE);
+    // 下一次发布修改的是本次之前的快照，需排在本次发布之后
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+  }
+};
+
+}  // namespace cpu_io
+
+#endif /* CPU_IO_INCLUDE_TIME_SOURCE_HPP_ */
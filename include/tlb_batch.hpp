@@ -0,0 +1,146 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_TLB_BATCH_HPP_
+#define CPU_IO_INCLUDE_TLB_BATCH_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "cpu_io.h"
+
+namespace cpu_io {
+namespace virtual_memory {
+
+/**
+ * @brief 待失效的地址范围
+ */
+struct TlbRange {
+  /// 起始虚拟地址，按页对齐
+  uint64_t start;
+  /// 结束虚拟地址（不包含），按页对齐
+  uint64_t end;
+};
+
+/**
+ * @brief TLB 批量失效
+ * 收集待失效的地址范围，在 Commit() 时一次性发出失效指令
+ * @tparam FlushPolicy 架构的失效操作，需提供
+ * `static auto ShouldFlushAll(size_t pages, size_t threshold, uint64_t asid)
+ * -> bool`、`static void FlushAll(uint64_t asid)` 与
+ * `static void FlushRanges(std::span<const TlbRange> ranges, uint64_t asid)`，
+ * 由各架构的 virtual_memory.hpp 定义为 detail::tlb::BatchFlushPolicy
+ * @tparam kCapacity 最多缓存的范围数量，超出后 Commit() 改为整体刷新
+ * @note 一个批次只对应一个地址空间；析构时会自动提交未完成的失效
+ */
+template <class FlushPolicy, size_t kCapacity>
+class BasicTlbBatch {
+ public:
+  /**
+   * @brief 构造函数
+   * @param asid 地址空间标识符，语义与 FlushTLBRange 相同
+   * @param threshold 总页数超过该值时 Commit() 改为整体刷新
+   */
+  explicit BasicTlbBatch(uint64_t asid = 0,
+                         size_t threshold = kFlushTLBRangeThreshold)
+      : asid_(asid), threshold_(threshold) {}
+
+  /// @name 构造/析构函数
+  /// @{
+  BasicTlbBatch(const BasicTlbBatch &) = delete;
+  BasicTlbBatch(BasicTlbBatch &&) = delete;
+  auto operator=(const BasicTlbBatch &) -> BasicTlbBatch & = delete;
+  auto operator=(BasicTlbBatch &&) -> BasicTlbBatch & = delete;
+  ~BasicTlbBatch() { Commit(); }
+  /// @}
+
+  /**
+   * @brief 添加一个待失效的页
+   * @param virtual_addr 虚拟地址
+   */
+  __always_inline void Add(uint64_t virtual_addr) {
+    AddRange(virtual_addr, virtual_addr + kPageSize);
+  }
+
+  /**
+   * @brief 添加一个待失效的地址范围，与上一个范围相邻时合并
+   * @param start_addr 起始虚拟地址
+   * @param end_addr 结束虚拟地址（不包含）
+   */
+  __always_inline void AddRange(uint64_t start_addr, uint64_t end_addr) {
+    auto page_count = GetPageCount(start_addr, end_addr);
+    if (page_count == 0) {
+      return;
+    }
+    total_pages_ += page_count;
+    if (overflow_) {
+      return;
+    }
+    auto start = PageAlign(start_addr);
+    if (count_ > 0 && ranges_[count_ - 1].end == start) {
+      ranges_[count_ - 1].end = PageAlignUp(end_addr);
+      return;
+    }
+    if (count_ == kCapacity) {
+      overflow_ = true;
+      return;
+    }
+    ranges_[count_++] = {start, PageAlignUp(end_addr)};
+  }
+
+  /**
+   * @brief 获取待失效的页数
+   * @return size_t 页数
+   */
+  [[nodiscard]] __always_inline auto GetPendingPages() const -> size_t {
+    return total_pages_;
+  }
+
+  /**
+   * @brief 提交所有待失效的范围
+   */
+  __always_inline void Commit() {
+    if (total_pages_ == 0) {
+      return;
+    }
+    if (overflow_ ||
+        FlushPolicy::ShouldFlushAll(total_pages_, threshold_, asid_)) {
+      FlushPolicy::FlushAll(asid_);
+    } else {
+      FlushPolicy::FlushRanges(
+          std::span<const TlbRange>(ranges_.data(), count_), asid_);
+    }
+    count_ = 0;
+    total_pages_ = 0;
+    overflow_ = false;
+  }
+
+ private:
+  /// 地址空间标识符
+  uint64_t asid_;
+  /// 整体刷新阈值
+  size_t threshold_;
+  /// 已缓存的范围数量
+  size_t count_ = 0;
+  /// 待失效的总页数
+  size_t total_pages_ = 0;
+  /// 范围数量是否超出 kCapacity
+  bool overflow_ = false;
+  /// 缓存的范围
+  std::array<TlbRange, kCapacity> ranges_{};
+};
+
+/**
+ * @brief 当前架构的 TLB 批量失效
+ * @tparam kCapacity 最多缓存的范围数量，超出后 Commit() 改为整体刷新
+ */
+template <size_t kCapacity = 16>
+using TlbBatch = BasicTlbBatch<detail::tlb::BatchFlushPolicy, kCapacity>;
+
+}  // namespace virtual_memory
+}  // namespace cpu_io
+
+#endif /* CPU_IO_INCLUDE_TLB_BATCH_HPP_ */
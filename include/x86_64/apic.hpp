@@ -5,6 +5,11 @@
 #ifndef CPU_IO_INCLUDE_X86_64_APIC_HPP_
 #define CPU_IO_INCLUDE_X86_64_APIC_HPP_
 
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "../cpu_mask.hpp"
 #include "msr.h"
 #include "regs.hpp"
 
@@ -192,6 +197,24 @@ static __always_inline void WriteLvtTimer(uint32_t value) {
   detail::regs::Msr::Write(::cpu_io::msr::apic::kLvtTimer, value);
 }
 
+/**
+ * @brief 读取 LVT 性能监控计数器寄存器
+ * @return uint32_t LVT PMC 寄存器值
+ */
+static __always_inline auto ReadLvtPmc() -> uint32_t {
+  return static_cast<uint32_t>(
+      detail::regs::Msr::Read(::cpu_io::msr::apic::kLvtPmc));
+}
+
+/**
+ * @brief 写入 LVT 性能监控计数器寄存器
+ * @param value 要设置的 LVT PMC 值
+ * @note 产生溢出中断后处理器自动置位屏蔽位，需重新写入
+ */
+static __always_inline void WriteLvtPmc(uint32_t value) {
+  detail::regs::Msr::Write(::cpu_io::msr::apic::kLvtPmc, value);
+}
+
 /**
  * @brief 读取 LVT LINT0 寄存器
  * @return uint32_t LVT LINT0 寄存器值
@@ -288,6 +311,170 @@ static __always_inline void WriteTimerDivide(uint32_t value) {
 
 }  // namespace apic
 }  // namespace msr
+
+/**
+ * @brief x2APIC IPI 发送器
+ * 目标为核心集合时按 x2APIC 集群分组，使用逻辑目标模式，一次 ICR 写入
+ * 最多覆盖同一集群的 16 个核心；自身使用 SELF IPI 寄存器，所有核心使用
+ * 目标简写。x2APIC 模式下 ICR 写入不需要轮询投递状态
+ * @note 需启用 x2APIC；对象只保存只读的 ID 表，可在多个核心间共享。
+ * x2APIC MSR 写入不是串行化指令，每次发送前执行一次 mfence; lfence，
+ * 保证 IPI 处理程序能看到之前的内存写入
+ */
+class IpiSender {
+ public:
+  /**
+   * @brief 构造函数
+   * @param apic_ids 以 core id 为下标的 x2APIC ID 表，生命周期需长于本对象
+   */
+  explicit IpiSender(std::span<const uint32_t> apic_ids)
+      : apic_ids_(apic_ids) {}
+
+  /// @name 构造/析构函数
+  /// @{
+  IpiSender() = delete;
+  IpiSender(const IpiSender &) = delete;
+  IpiSender(IpiSender &&) = delete;
+  auto operator=(const IpiSender &) -> IpiSender & = delete;
+  auto operator=(IpiSender &&) -> IpiSender & = delete;
+  ~IpiSender() = default;
+  /// @}
+
+  /**
+   * @brief 向自身发送 IPI
+   * @param vector 中断向量
+   */
+  static void SendSelf(uint8_t vector) {
+    Fence();
+    detail::regs::Msr::Write(msr::apic::kSelfIpi, vector);
+  }
+
+  /**
+   * @brief 向包括自身在内的所有核心发送 IPI
+   * @param vector 中断向量
+   */
+  static void SendAll(uint8_t vector) {
+    Fence();
+    msr::apic::WriteIcr(msr::apic::icr::kShorthandAll | Command(vector));
+  }
+
+  /**
+   * @brief 向除自身外的所有核心发送 IPI
+   * @param vector 中断向量
+   */
+  static void SendAllButSelf(uint8_t vector) {
+    Fence();
+    msr::apic::WriteIcr(msr::apic::icr::kShorthandAllButSelf |
+                        Command(vector));
+  }
+
+  /**
+   * @brief 向单个核心发送 IPI
+   * @param core_id 目标 core id
+   * @param vector 中断向量
+   */
+  void Send(size_t core_id, uint8_t vector) const {
+    Fence();
+    msr::apic::WriteIcr(
+        (static_cast<uint64_t>(apic_ids_[core_id])
+         << msr::apic::icr::kDestinationShift) |
+        Command(vector));
+  }
+
+  /**
+   * @brief 向核心集合发送 IPI
+   * 相邻 core id 属于同一集群时合并为一次逻辑目标模式写入，
+   * apic_ids 按 x2APIC ID 升序排列时每个集群只写一次 ICR
+   * @param mask 目标核心集合
+   * @param vector 中断向量
+   * @return size_t ICR 写入次数
+   */
+  template <size_t kMaxCores>
+  auto Send(const CpuMask<kMaxCores> &mask, uint8_t vector) const -> size_t {
+    Fence();
+    size_t writes = 0;
+    uint32_t cluster = 0;
+    uint32_t targets = 0;
+    mask.ForEach([&](size_t core_id) {
+      auto apic_id = apic_ids_[core_id];
+      if (targets != 0 && GetCluster(apic_id) != cluster) {
+        SendLogical(cluster, targets, vector);
+        writes++;
+        targets = 0;
+      }
+      cluster = GetCluster(apic_id);
+      targets |= GetLogicalBit(apic_id);
+    });
+    if (targets != 0) {
+      SendLogical(cluster, targets, vector);
+      writes++;
+    }
+    return writes;
+  }
+
+  /**
+   * @brief 计算 x2APIC ID 在集群模式下的逻辑 ID
+   * @param apic_id x2APIC ID
+   * @return uint32_t 逻辑 ID，与该核心 LDR 寄存器的值相同
+   * @see Intel SDM Vol. 3A 11.12.10.2 Logical Destination Mode in x2APIC Mode
+   */
+  [[nodiscard]] static constexpr auto GetLogicalId(uint32_t apic_id)
+      -> uint32_t {
+    return (GetCluster(apic_id) << 16) | GetLogicalBit(apic_id);
+  }
+
+ private:
+  /// 以 core id 为下标的 x2APIC ID 表
+  std::span<const uint32_t> apic_ids_;
+
+  /**
+   * @brief 保证之前的内存写入先于 IPI 对目标核心可见
+   */
+  static __always_inline void Fence() {
+    __asm__ volatile("mfence\n\tlfence" ::: "memory");
+  }
+
+  /**
+   * @brief 生成 ICR 的低 32 位：固定投递、电平有效
+   * @param vector 中断向量
+   * @return uint64_t ICR 值
+   */
+  static constexpr auto Command(uint8_t vector) -> uint64_t {
+    return msr::apic::icr::kDeliveryFixed | msr::apic::icr::kAssert | vector;
+  }
+
+  /**
+   * @brief 获取 x2APIC ID 所在的集群
+   * @param apic_id x2APIC ID
+   * @return uint32_t 集群号
+   */
+  static constexpr auto GetCluster(uint32_t apic_id) -> uint32_t {
+    return apic_id >> 4;
+  }
+
+  /**
+   * @brief 获取 x2APIC ID 在集群内的位
+   * @param apic_id x2APIC ID
+   * @return uint32_t 集群内位掩码
+   */
+  static constexpr auto GetLogicalBit(uint32_t apic_id) -> uint32_t {
+    return 1U << (apic_id & 0xF);
+  }
+
+  /**
+   * @brief 以逻辑目标模式发送 IPI
+   * @param cluster 集群号
+   * @param targets 集群内位掩码
+   * @param vector 中断向量
+   */
+  static void SendLogical(uint32_t cluster, uint32_t targets, uint8_t vector) {
+    auto destination = (static_cast<uint64_t>(cluster) << 16) | targets;
+    msr::apic::WriteIcr(
+        (destination << msr::apic::icr::kDestinationShift) |
+        msr::apic::icr::kLogical | Command(vector));
+  }
+};
+
 }  // namespace cpu_io
 
 #endif  // CPU_IO_INCLUDE_X86_64_APIC_HPP_
@@ -0,0 +1,129 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_X86_64_CACHE_HPP_
+#define CPU_IO_INCLUDE_X86_64_CACHE_HPP_
+
+#include <sys/cdefs.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../cache_line.hpp"
+#include "../per_cpu.hpp"
+#include "cpuid.hpp"
+
+namespace cpu_io {
+
+namespace detail::cache {
+/**
+ * @brief 写回并失效缓存行，按支持情况选择 clflushopt 或 clflush
+ * @param addr 起始地址
+ * @param size 字节数
+ */
+static __always_inline void FlushRange(const void *addr, size_t size) {
+  if (cpuid::GetCpuFeatures().HasClflushopt()) {
+    ForEachCacheLine(addr, size, kCacheLineSize, [](uintptr_t line) {
+      __asm__ volatile("clflushopt %0" ::"m"(*reinterpret_cast<char *>(line))
+                       : "memory");
+    });
+    // clflushopt 之间、与之后的写之间无序，需要 sfence
+    __asm__ volatile("sfence" ::: "memory");
+  } else {
+    ForEachCacheLine(addr, size, kCacheLineSize, [](uintptr_t line) {
+      __asm__ volatile("clflush %0" ::"m"(*reinterpret_cast<char *>(line))
+                       : "memory");
+    });
+    __asm__ volatile("mfence" ::: "memory");
+  }
+}
+}  // namespace detail::cache
+
+/**
+ * @brief 将范围内的脏数据写回内存，缓存行保持有效
+ * 用于设备读取 CPU 写入的数据 (非一致性 DMA) 与持久内存
+ * @param addr 起始地址，不需要对齐
+ * @param size 字节数
+ * @note 不支持 clwb 时使用 clflushopt/clflush，缓存行同时被失效
+ */
+static __always_inline void CleanDcacheRange(const void *addr, size_t size) {
+  if (!cpuid::GetCpuFeatures().HasClwb()) {
+    detail::cache::FlushRange(addr, size);
+    return;
+  }
+  detail::ForEachCacheLine(addr, size, kCacheLineSize, [](uintptr_t line) {
+    __asm__ volatile("clwb %0" ::"m"(*reinterpret_cast<char *>(line))
+                     : "memory");
+  });
+  __asm__ volatile("sfence" ::: "memory");
+}
+
+/**
+ * @brief 失效范围内的缓存行，用于 CPU 读取设备写入的数据
+ * @param addr 起始地址，不需要对齐
+ * @param size 字节数
+ * @note x86 没有只失效单个缓存行的指令，脏数据会先被写回，
+ * 与 CleanInvalidateDcacheRange() 相同
+ */
+static __always_inline void InvalidateDcacheRange(const void *addr,
+                                                  size_t size) {
+  detail::cache::FlushRange(addr, size);
+}
+
+/**
+ * @brief 写回并失效范围内的缓存行
+ * @param addr 起始地址，不需要对齐
+ * @param size 字节数
+ */
+static __always_inline void CleanInvalidateDcacheRange(const void *addr,
+                                                       size_t size) {
+  detail::cache::FlushRange(addr, size);
+}
+
+/**
+ * @brief 使写入的指令对取指可见，用于 JIT 与加载模块
+ * x86 的指令缓存与数据缓存一致，只需执行串行化指令丢弃已预取的旧指令
+ * @param addr 起始地址
+ * @param size 字节数
+ * @note 只作用于当前核心，其它核心需各自调用
+ */
+static __always_inline void SyncIcacheRange([[maybe_unused]] const void *addr,
+                                            [[maybe_unused]] size_t size) {
+  uint32_t eax = 0;
+  uint32_t ebx;
+  uint32_t ecx = 0;
+  uint32_t edx;
+  __asm__ volatile("cpuid"
+                   : "+a"(eax), "=b"(ebx), "+c"(ecx), "=d"(edx)
+                   :
+                   : "memory");
+}
+
+/**
+ * @brief 预取缓存行
+ * @tparam kAccess 访问类型
+ * @tparam kLocality 时间局部性，3 (保留在所有级别) 到 0 (用后即弃)
+ * @param addr 地址
+ * @note 写预取使用 prefetchw，不支持的处理器上为空操作，忽略 kLocality
+ */
+template <PrefetchAccess kAccess = PrefetchAccess::kRead, int kLocality = 3>
+static __always_inline void Prefetch(const void *addr) {
+  static_assert(kLocality >= 0 && kLocality <= 3);
+  const auto &line = *static_cast<const char *>(addr);
+  if constexpr (kAccess == PrefetchAccess::kWrite) {
+    __asm__ volatile("prefetchw %0" ::"m"(line));
+  } else if constexpr (kLocality == 3) {
+    __asm__ volatile("prefetcht0 %0" ::"m"(line));
+  } else if constexpr (kLocality == 2) {
+    __asm__ volatile("prefetcht1 %0" ::"m"(line));
+  } else if constexpr (kLocality == 1) {
+    __asm__ volatile("prefetcht2 %0" ::"m"(line));
+  } else {
+    __asm__ volatile("prefetchnta %0" ::"m"(line));
+  }
+}
+
+}  // namespace cpu_io
+
+#endif  // CPU_IO_INCLUDE_X86_64_CACHE_HPP_
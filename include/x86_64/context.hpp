@@ -5,42 +5,162 @@
 #ifndef CPU_IO_INCLUDE_X86_64_CONTEXT_HPP_
 #define CPU_IO_INCLUDE_X86_64_CONTEXT_HPP_
 
+#include <cstddef>
 #include <cstdint>
 
 namespace cpu_io {
 
+/**
+ * @brief x86_64 寄存器上下文结构体
+ * 由低地址到高地址依次为：入口代码保存的 fs_base 与通用寄存器、
+ * 中断向量号、错误码 (cpu 不压入时由入口代码压入 0)，
+ * 以及 cpu 自动压入的 rip/cs/rflags/rsp/ss，
+ * 后者与 InterruptContextErrorCode 布局一致。
+ * 用于中断/异常处理 (保存完整现场)
+ *
+ * fs_base + _padding + 15 (通用寄存器) + vector + error_code + 5 (cpu 压入)
+ *   = 24 个 64 位寄存器，共 192 字节 (16 字节对齐)
+ *
+ * @note FPU/SIMD 状态由 XSAVE 区保存，不在此结构中
+ */
 struct TrapContext {
-  /// @todo
-
-  // 统一的跨架构访问器方法（占位实现）
-  __always_inline uint64_t& UserStackPointer() {
-    static uint64_t dummy = 0;
-    return dummy;
-  }
-  __always_inline uint64_t& ThreadPointer() {
-    static uint64_t dummy = 0;
-    return dummy;
-  }
-  __always_inline uint64_t& ReturnValue() {
-    static uint64_t dummy = 0;
-    return dummy;
-  }
+  // FS 基址 (rdfsbase 或 IA32_FS_BASE)
+  uint64_t fs_base;
+  uint64_t _padding;
+
+  uint64_t r15;
+  uint64_t r14;
+  uint64_t r13;
+  uint64_t r12;
+  uint64_t r11;
+  uint64_t r10;
+  uint64_t r9;
+  uint64_t r8;
+  uint64_t rbp;
+  uint64_t rdi;
+  uint64_t rsi;
+  uint64_t rdx;
+  uint64_t rcx;
+  uint64_t rbx;
+  // Return Value
+  uint64_t rax;
+
+  // 中断向量号，由入口代码压入
+  uint64_t vector;
+  // 错误码，cpu 不压入时由入口代码压入 0
+  uint64_t error_code;
+
+  // 以下由 cpu 自动压入
+  uint64_t rip;
+  uint64_t cs;
+  uint64_t rflags;
+  // Trap 发生时的 RSP
+  uint64_t rsp;
+  uint64_t ss;
+
+  // 统一的跨架构访问器方法
+  __always_inline uint64_t& UserStackPointer() { return rsp; }
+  __always_inline uint64_t& ThreadPointer() { return fs_base; }
+  __always_inline uint64_t& ReturnValue() { return rax; }
 };
 
+/**
+ * @brief 线程切换上下文 (SwitchTo)
+ * 仅包含 System V ABI 的 Callee-saved 寄存器
+ *
+ * rip, rsp, rbx, rbp, r12-r15 = 8 × 8 = 64 bytes
+ *
+ * 用于函数调用间的上下文切换 (Cooperative)。
+ * 新线程的 rip 指向 ThreadEntry()，跳板以 r13 为参数调用 r12
+ */
 struct CalleeSavedContext {
-  /// @todo x86_64 实现待补充
-  uint64_t return_address;
-  uint64_t stack_pointer;
-  uint64_t entry_function;
-  uint64_t entry_argument;
+  uint64_t rip;
+  uint64_t rsp;
+  uint64_t rbx;
+  uint64_t rbp;
+  uint64_t r12;
+  uint64_t r13;
+  uint64_t r14;
+  uint64_t r15;
 
   // 跨架构访问器方法
-  __always_inline uint64_t& ReturnAddress() { return return_address; }
-  __always_inline uint64_t& EntryFunction() { return entry_function; }
-  __always_inline uint64_t& EntryArgument() { return entry_argument; }
-  __always_inline uint64_t& StackPointer() { return stack_pointer; }
+  __always_inline uint64_t& ReturnAddress() { return rip; }
+  __always_inline uint64_t& EntryFunction() { return r12; }
+  __always_inline uint64_t& EntryArgument() { return r13; }
+  __always_inline uint64_t& StackPointer() { return rsp; }
 };
 
+static_assert(sizeof(TrapContext) == 192, "TrapContext size must be 192 bytes");
+static_assert(offsetof(TrapContext, r15) == 16);
+static_assert(offsetof(TrapContext, rax) == 128);
+static_assert(offsetof(TrapContext, vector) == 136);
+static_assert(offsetof(TrapContext, error_code) == 144);
+static_assert(offsetof(TrapContext, rip) == 152);
+static_assert(offsetof(TrapContext, ss) == 184);
+
+static_assert(sizeof(CalleeSavedContext) == 64,
+              "CalleeSavedContext size must be 64 bytes");
+static_assert(offsetof(CalleeSavedContext, rip) == 0);
+static_assert(offsetof(CalleeSavedContext, rsp) == 8);
+static_assert(offsetof(CalleeSavedContext, rbx) == 16);
+static_assert(offsetof(CalleeSavedContext, rbp) == 24);
+static_assert(offsetof(CalleeSavedContext, r12) == 32);
+static_assert(offsetof(CalleeSavedContext, r13) == 40);
+static_assert(offsetof(CalleeSavedContext, r14) == 48);
+static_assert(offsetof(CalleeSavedContext, r15) == 56);
+
+/**
+ * @brief 切换线程上下文
+ * 把当前 callee-saved 寄存器与返回地址保存到 prev，
+ * 从 next 恢复后跳转到 next->rip；之后切换回 prev 时，
+ * 本函数如同普通调用一样返回。
+ * 不需要单独的汇编文件，inline 使各编译单元共享同一份定义
+ * @param prev 保存当前上下文
+ * @param next 要切换到的上下文
+ * @note 偏移与 CalleeSavedContext 的 static_assert 一致
+ */
+__attribute__((naked, noinline)) inline void SwitchTo(
+    [[maybe_unused]] CalleeSavedContext* prev,
+    [[maybe_unused]] const CalleeSavedContext* next) {
+  __asm__(
+      // 返回地址与返回后的 rsp
+      "movq (%rsp), %rax\n\t"
+      "leaq 8(%rsp), %rcx\n\t"
+      "movq %rax, 0(%rdi)\n\t"
+      "movq %rcx, 8(%rdi)\n\t"
+      "movq %rbx, 16(%rdi)\n\t"
+      "movq %rbp, 24(%rdi)\n\t"
+      "movq %r12, 32(%rdi)\n\t"
+      "movq %r13, 40(%rdi)\n\t"
+      "movq %r14, 48(%rdi)\n\t"
+      "movq %r15, 56(%rdi)\n\t"
+      "movq 16(%rsi), %rbx\n\t"
+      "movq 24(%rsi), %rbp\n\t"
+      "movq 32(%rsi), %r12\n\t"
+      "movq 40(%rsi), %r13\n\t"
+      "movq 48(%rsi), %r14\n\t"
+      "movq 56(%rsi), %r15\n\t"
+      "movq 8(%rsi), %rsp\n\t"
+      "jmpq *0(%rsi)");
+}
+
+/**
+ * @brief 新线程的入口跳板
+ * 新线程的 CalleeSavedContext 中 rip 设为本函数，EntryFunction() (r12)
+ * 设为入口函数 void (*)(void *)，EntryArgument() (r13) 设为其参数，
+ * rsp 设为线程栈顶；首次 SwitchTo() 到该线程时以 r13 为参数调用 r12
+ * @note 调用前把 rsp 对齐到 16 字节并清零 rbp 以结束栈回溯；
+ * 入口函数不能返回，返回时执行 ud2
+ */
+__attribute__((naked, noinline)) inline void ThreadEntry() {
+  __asm__(
+      "andq $-16, %rsp\n\t"
+      "xorl %ebp, %ebp\n\t"
+      "movq %r13, %rdi\n\t"
+      "callq *%r12\n\t"
+      "ud2");
+}
+
 }  // namespace cpu_io
 
 #endif  // CPU_IO_INCLUDE_X86_64_CONTEXT_HPP_
@@ -8,15 +8,24 @@
 #include <sys/cdefs.h>
 
 #include <cstdint>
+#include <span>
 #include <type_traits>
 
+#include "../clock.hpp"
+#include "../per_cpu.hpp"
 #include "apic.hpp"
+#include "cache.hpp"
 #include "context.hpp"
 #include "cpuid.hpp"
+#include "fpu.hpp"
 #include "io.hpp"
+#include "ioapic.hpp"
+#include "lbr.hpp"
+#include "mtrr.hpp"
 #include "msr.h"
 #include "pic.hpp"
 #include "pit.hpp"
+#include "pmu.hpp"
 #include "regs.hpp"
 #include "serial.hpp"
 #include "virtual_memory.hpp"
@@ -52,6 +61,8 @@ using Cr3 = detail::regs::cr::Cr3;
 using Cr4 = detail::regs::cr::Cr4;
 using Cr8 = detail::regs::cr::Cr8;
 using Xcr0 = detail::regs::Xcr0;
+using FsBase = detail::regs::FsBase;
+using GsBase = detail::regs::GsBase;
 using Cs = detail::regs::segment_register::Cs;
 using Ss = detail::regs::segment_register::Ss;
 using Ds = detail::regs::segment_register::Ds;
@@ -59,6 +70,11 @@ using Es = detail::regs::segment_register::Es;
 using Fs = detail::regs::segment_register::Fs;
 using Gs = detail::regs::segment_register::Gs;
 
+template <class Reg>
+using CachedReg = detail::read_write::CachedReg<Reg>;
+template <uint32_t kOffset>
+using CachedMsr = CachedReg<detail::read_write::FixedMsr<kOffset>>;
+
 /**
  * @brief 内存屏障
  */
@@ -80,6 +96,23 @@ static __always_inline auto Wmb() -> void {
   __asm__ volatile("sfence" ::: "memory");
 }
 
+/**
+ * @brief 设备读屏障，在设备读之后调用，保证其先于之后的访存
+ * @note UC 映射的设备访问本身有序，只需阻止编译器重排
+ */
+static __always_inline auto IoRmb() -> void {
+  __asm__ volatile("" ::: "memory");
+}
+
+/**
+ * @brief 设备写屏障，在设备写之前调用，保证之前的写先于设备写
+ * @note UC 映射的设备访问本身有序，只需阻止编译器重排；
+ * WC 映射需使用 Wmb()
+ */
+static __always_inline auto IoWmb() -> void {
+  __asm__ volatile("" ::: "memory");
+}
+
 /// 中断上下文，由 cpu 自动压入，无错误码
 struct InterruptContext {
   uint64_t rip;
@@ -100,6 +133,14 @@ struct InterruptContextErrorCode {
   uint64_t ss;
 };
 
+// TrapContext 尾部与 cpu 压入的中断上下文布局一致
+static_assert(sizeof(TrapContext) - offsetof(TrapContext, error_code) ==
+              sizeof(InterruptContextErrorCode));
+static_assert(offsetof(TrapContext, rip) - offsetof(TrapContext, error_code) ==
+              offsetof(InterruptContextErrorCode, rip));
+static_assert(sizeof(TrapContext) - offsetof(TrapContext, rip) ==
+              sizeof(InterruptContext));
+
 /**
  * @brief 允许中断
  */
@@ -117,6 +158,28 @@ static __always_inline auto GetInterruptStatus() -> bool {
   return Rflags::If::Get();
 }
 
+/**
+ * @brief 保存中断状态并关闭中断
+ * pushfq/popq 后 cli，不经过 popfq
+ * @return uint64_t 关闭前的 RFLAGS，交给 IrqRestore()
+ */
+static __always_inline auto IrqSave() -> uint64_t {
+  uint64_t flags;
+  __asm__ volatile("pushfq\n\tpopq %0\n\tcli" : "=r"(flags) : : "memory");
+  return flags;
+}
+
+/**
+ * @brief 恢复 IrqSave() 保存的中断状态
+ * 只恢复 IF：保存时中断已打开才执行 sti
+ * @param flags IrqSave() 的返回值
+ */
+static __always_inline void IrqRestore(uint64_t flags) {
+  if (flags & RflagsInfo::If::kBitMask) {
+    __asm__ volatile("sti" ::: "memory");
+  }
+}
+
 /**
  * @brief 获取当前 core id
  * @return size_t core id
@@ -125,12 +188,499 @@ static __always_inline auto GetCurrentCoreId() -> size_t {
   return cpuid::GetExtendedApicId();
 }
 
+/**
+ * @brief 启用 RDFSBASE/WRFSBASE/RDGSBASE/WRGSBASE
+ * 处理器支持时置位当前核心的 CR4.FSGSBASE，之后该核心的 FsBase/GsBase
+ * 不再经过 MSR；未启用的核心与不支持的处理器继续使用 MSR
+ * @return true 已启用
+ * @note CR4.FSGSBASE 同时允许用户态修改 GS 基址，
+ * 入口代码不能再假设用户态的 GS 基址不是内核地址
+ */
+static __always_inline auto EnableFsgsbase() -> bool {
+  if (!cpuid::HasFsgsbase()) {
+    return false;
+  }
+  Cr4::Fsgsbase::Set();
+  return true;
+}
+
+/**
+ * @brief 交换 GS 基址与 IA32_KERNEL_GS_BASE
+ * 在从用户态进入内核及返回用户态时各调用一次
+ */
+static __always_inline void Swapgs() {
+  __asm__ volatile("swapgs" ::: "memory");
+}
+
+/**
+ * @brief 设置当前核心的每核心数据区
+ * 写入 IA32_GS_BASE，支持 RDTSCP 时同时把 core_id 写入 IA32_TSC_AUX
+ * @param header 每核心数据区，core_id 需已填写
+ * @note 进入用户态前需 swapgs，使内核 GS 基址保存在 IA32_KERNEL_GS_BASE
+ */
+static __always_inline void SetPerCpuBase(PerCpuHeader *header) {
+  header->self = header;
+  Msr::Write(msr::kIa32GsBase, reinterpret_cast<uint64_t>(header));
+  if (cpuid::HasRdtscp()) {
+    Msr::Write(msr::kIa32TscAux, header->core_id);
+  }
+}
+
+/**
+ * @brief 获取当前核心的每核心数据区
+ * @return PerCpuHeader* 每核心数据区，一次 %gs 相对读
+ */
+static __always_inline auto GetPerCpuBase() -> PerCpuHeader * {
+  PerCpuHeader *base;
+  __asm__ volatile("movq %%gs:%c1, %0"
+                   : "=r"(base)
+                   : "i"(offsetof(PerCpuHeader, self)));
+  return base;
+}
+
+/**
+ * @brief 从每核心数据区获取逻辑核心 ID
+ * @return size_t core id，一次 %gs 相对读
+ */
+static __always_inline auto GetPerCpuCoreId() -> size_t {
+  size_t core_id;
+  __asm__ volatile("movq %%gs:%c1, %0"
+                   : "=r"(core_id)
+                   : "i"(offsetof(PerCpuHeader, core_id)));
+  return core_id;
+}
+
+/**
+ * @brief 通过 IA32_TSC_AUX 获取逻辑核心 ID
+ * 不依赖 GS 基址，可在 swapgs 之前使用；优先使用 RDPID，否则使用 RDTSCP
+ * @return size_t SetPerCpuBase() 写入的 core id
+ */
+static __always_inline auto GetTscAuxCoreId() -> size_t {
+  uint64_t aux;
+  if (cpuid::GetCpuFeatures().HasRdpid()) {
+    __asm__ volatile("rdpid %0" : "=r"(aux));
+  } else {
+    uint32_t low;
+    uint32_t high;
+    uint32_t aux32;
+    __asm__ volatile("rdtscp" : "=a"(low), "=d"(high), "=c"(aux32));
+    aux = aux32;
+  }
+  return aux;
+}
+
+/**
+ * @brief 获取当前核心的每核心数据
+ * @tparam T 每核心数据类型，第一个成员须为 PerCpuHeader
+ * @return T& 每核心数据
+ */
+template <class T>
+static __always_inline auto PerCpu() -> T & {
+  static_assert(std::is_standard_layout_v<T>);
+  return *reinterpret_cast<T *>(GetPerCpuBase());
+}
+
 /**
  * @brief CPU 空转指令
  * @note x86_64 pause 指令
  */
 static __always_inline void Pause() { __asm__ volatile("pause" ::: "memory"); }
 
+/// SpinUntil() 两次读之间 pause 次数的上限
+static constexpr uint32_t kSpinBackoffLimit = 64;
+
+/**
+ * @brief 自旋等待，直到 *addr 满足条件
+ * 每次读失败后 pause 的次数加倍，降低对共享缓存行的争用
+ * @tparam T 整数或指针类型
+ * @param addr 等待的地址
+ * @param done 条件，参数为读到的值
+ * @return T 满足条件时读到的值，读带 acquire 语义
+ */
+template <class T, class Pred>
+static __always_inline auto SpinUntil(const T *addr, Pred done) -> T {
+  T value = __atomic_load_n(addr, __ATOMIC_ACQUIRE);
+  uint32_t backoff = 1;
+  while (!done(value)) {
+    for (uint32_t i = 0; i < backoff; i++) {
+      Pause();
+    }
+    if (backoff < kSpinBackoffLimit) {
+      backoff <<= 1;
+    }
+    value = __atomic_load_n(addr, __ATOMIC_ACQUIRE);
+  }
+  return value;
+}
+
+/**
+ * @brief 读取时间戳计数器，不等待之前的指令完成
+ * @return uint64_t TSC 值
+ */
+static __always_inline auto ReadCycles() -> uint64_t {
+  uint32_t low;
+  uint32_t high;
+  __asm__ volatile("rdtsc" : "=a"(low), "=d"(high));
+  return (static_cast<uint64_t>(high) << 32) | low;
+}
+
+/**
+ * @brief 读取时间戳计数器，之前的指令全部完成后才读取
+ * @return uint64_t TSC 值
+ * @note lfence; rdtsc
+ */
+static __always_inline auto ReadCyclesSerialized() -> uint64_t {
+  uint32_t low;
+  uint32_t high;
+  __asm__ volatile("lfence\n\trdtsc" : "=a"(low), "=d"(high) : : "memory");
+  return (static_cast<uint64_t>(high) << 32) | low;
+}
+
+/**
+ * @brief 使用 RDTSCP 读取时间戳计数器与 IA32_TSC_AUX
+ * 之前的指令全部完成后才读取，但之后的指令可能提前执行
+ * @param aux 输出 IA32_TSC_AUX，SetPerCpuBase() 后为 core id
+ * @return uint64_t TSC 值
+ * @note 需要 cpuid::HasRdtscp()
+ */
+static __always_inline auto ReadCyclesAux(uint32_t &aux) -> uint64_t {
+  uint32_t low;
+  uint32_t high;
+  __asm__ volatile("rdtscp" : "=a"(low), "=d"(high), "=c"(aux) : : "memory");
+  return (static_cast<uint64_t>(high) << 32) | low;
+}
+
+/**
+ * @brief 读取纳秒时间戳，不等待之前的指令完成
+ * @return uint64_t 纳秒，CalibrateTimestamp() 之前为 0
+ */
+static __always_inline auto ReadTimestamp() -> uint64_t {
+  return CyclesToNs(ReadCycles());
+}
+
+/**
+ * @brief 读取纳秒时间戳，之前的指令全部完成后才读取
+ * @return uint64_t 纳秒，CalibrateTimestamp() 之前为 0
+ */
+static __always_inline auto ReadTimestampSerialized() -> uint64_t {
+  return CyclesToNs(ReadCyclesSerialized());
+}
+
+namespace detail {
+/// Idle() 监视的缓存行，不会被写入
+alignas(kCacheLineSize) inline uint64_t idle_monitor_line = 0;
+}  // namespace detail
+
+/**
+ * @brief 等待 *addr 不再等于 expected
+ * 支持 WAITPKG 时 umonitor/umwait 进入 C0.2 并以 TSC 截止时间超时；
+ * 否则支持 MONITOR 且 CPUID.05H:ECX[1] 置位时 monitor/mwait 进入 C1，
+ * 被屏蔽的中断也能唤醒，超时只在被唤醒后检查；都不支持时以指数退避的
+ * pause 自旋
+ * @tparam T 4 或 8 字节的整数类型
+ * @param addr 等待的地址
+ * @param expected 继续等待的值
+ * @param timeout_ns 超时 (纳秒)，需先 CalibrateTimestamp()
+ * @return true *addr 已改变，false 超时
+ */
+template <class T>
+static __always_inline auto WaitOnAddress(const T *addr, T expected,
+                                          uint64_t timeout_ns = kWaitForever)
+    -> bool {
+  static_assert(sizeof(T) == 4 || sizeof(T) == 8);
+  const auto &features = cpuid::GetCpuFeatures();
+  auto deadline = detail::CyclesDeadline(ReadCycles(), timeout_ns);
+  uint32_t backoff = 1;
+  while (__atomic_load_n(addr, __ATOMIC_ACQUIRE) == expected) {
+    if (ReadCycles() >= deadline) {
+      return false;
+    }
+    if (features.HasWaitpkg()) {
+      __asm__ volatile("umonitor %0" : : "r"(addr) : "memory");
+      // 设置监视后再检查一次，避免错过之间的写
+      if (__atomic_load_n(addr, __ATOMIC_ACQUIRE) != expected) {
+        break;
+      }
+      __asm__ volatile("umwait %%ecx"
+                       :
+                       : "c"(0), "a"(static_cast<uint32_t>(deadline)),
+                         "d"(static_cast<uint32_t>(deadline >> 32))
+                       : "memory", "cc");
+    } else if (features.HasMonitor() && features.HasMwaitInterruptBreak()) {
+      __asm__ volatile("monitor" : : "a"(addr), "c"(0), "d"(0) : "memory");
+      if (__atomic_load_n(addr, __ATOMIC_ACQUIRE) != expected) {
+        break;
+      }
+      __asm__ volatile("mwait" : : "a"(0), "c"(1) : "memory");
+    } else {
+      for (uint32_t i = 0; i < backoff; i++) {
+        Pause();
+      }
+      if (backoff < kSpinBackoffLimit) {
+        backoff <<= 1;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief 使当前核心进入低功耗状态，直到有中断挂起
+ * 支持 MONITOR 且 CPUID.05H:ECX[1] 置位时使用 mwait，ECX[0] 置位使被屏蔽的
+ * 中断也能唤醒，返回时中断仍挂起，与 AArch64/RISC-V 的 wfi 相同；
+ * 否则使用 sti; hlt; cli，中断处理在返回前执行
+ * @param hint MWAIT 提示，[7:4] 为目标 C-state 减 1，[3:0] 为子状态，
+ * 0 为 C1，可用的值见 CPUID 5 与 ACPI _CST
+ * @pre 已关闭中断，并确认没有待处理的工作
+ * @note 两种情况下调用者都应在返回后开中断处理挂起的中断，
+ * 不能假定处理函数已经执行
+ */
+static __always_inline void Idle(uint32_t hint = 0) {
+  const auto &features = cpuid::GetCpuFeatures();
+  if (features.HasMonitor() && features.HasMwaitInterruptBreak()) {
+    __asm__ volatile("monitor"
+                     :
+                     : "a"(&detail::idle_monitor_line), "c"(0), "d"(0)
+                     : "memory");
+    __asm__ volatile("mwait" : : "a"(hint), "c"(1) : "memory");
+  } else {
+    __asm__ volatile("sti\n\thlt\n\tcli" ::: "memory");
+  }
+}
+
+/**
+ * @brief 使用 PIT 通道 2 校准 TSC 频率，并设置纳秒换算系数
+ * @param ms 校准时长 (毫秒)，按 Pit::OneShotCount() 限制在 1-54 内
+ * @return uint64_t TSC 频率 (Hz)
+ * @note 校准期间应关闭中断；只有 cpuid::HasInvariantTsc() 时 TSC
+ * 频率不随 P-state 变化
+ */
+static __always_inline auto CalibrateTimestamp(uint32_t ms = 10) -> uint64_t {
+  auto count = Pit::OneShotCount(ms);
+  Pit::StartChannel2OneShot(count);
+  auto start = ReadCyclesSerialized();
+  while (!Pit::IsChannel2Expired()) {
+    Pause();
+  }
+  auto end = ReadCyclesSerialized();
+  auto frequency = (end - start) * Pit::kMaxFrequency / count;
+  SetTimestampFrequency(frequency);
+  return frequency;
+}
+
+namespace detail {
+/// INIT 之后等待的时间 (纳秒)
+static constexpr uint64_t kInitDelay = 10000000;
+/// 两次 SIPI 之间等待的时间 (纳秒)
+static constexpr uint64_t kSipiDelay = 200000;
+
+/**
+ * @brief 以 TSC 忙等
+ * @param ns 等待时间 (纳秒)
+ */
+static __always_inline void SpinDelay(uint64_t ns) {
+  auto deadline = CyclesDeadline(ReadCycles(), ns);
+  while (ReadCycles() < deadline) {
+    Pause();
+  }
+}
+
+/**
+ * @brief 向目标发送同一个 ICR 命令
+ * @param command ICR 的低 32 位
+ * @param hw_ids x2APIC ID，为空时广播到除自身外的所有核心
+ */
+static __always_inline void SendStartupIpi(uint64_t command,
+                                           std::span<const uint64_t> hw_ids) {
+  if (hw_ids.empty()) {
+    msr::apic::WriteIcr(msr::apic::icr::kShorthandAllButSelf | command);
+    return;
+  }
+  for (auto apic_id : hw_ids) {
+    msr::apic::WriteIcr((apic_id << msr::apic::icr::kDestinationShift) |
+                        command);
+  }
+}
+
+/**
+ * @brief 以 INIT-SIPI-SIPI 启动从核心，见 StartSecondaryCores()
+ * 所有目标共用同一次 INIT 与 SIPI 延时
+ * @param entry 入口物理地址
+ * @param stacks 栈顶地址
+ * @param hw_ids x2APIC ID
+ * @return size_t 应完成初始化的从核心数
+ * @see sdm.pdf#9.4.4 MP Initialization Example
+ */
+static __always_inline auto StartCores(uint64_t entry,
+                                       std::span<const uint64_t> stacks,
+                                       std::span<const uint64_t> hw_ids)
+    -> size_t {
+  // 之前对控制块的写入需在 ICR 写入前可见
+  Mb();
+  SendStartupIpi(msr::apic::icr::kDeliveryInit | msr::apic::icr::kAssert,
+                 hw_ids);
+  SpinDelay(kInitDelay);
+  auto sipi = msr::apic::icr::kDeliveryStartup | msr::apic::icr::kAssert |
+              ((entry >> 12) & 0xFF);
+  // 第一次 SIPI 已启动的核心会忽略第二次
+  SendStartupIpi(sipi, hw_ids);
+  SpinDelay(kSipiDelay);
+  SendStartupIpi(sipi, hw_ids);
+  if (!hw_ids.empty() && hw_ids.size() < stacks.size()) {
+    return hw_ids.size();
+  }
+  return stacks.size();
+}
+}  // namespace detail
+
+/**
+ * @brief 本地 APIC 定时器
+ * 支持周期、单次与 TSC-deadline 三种模式，通过 x2APIC MSR 访问
+ * @note 每个核心一个实例，使用前需启用 x2APIC
+ */
+class LocalTimer {
+ public:
+  /**
+   * @brief 构造函数
+   * @param vector 定时器中断向量
+   */
+  explicit LocalTimer(uint8_t vector) : vector_(vector) {}
+
+  /// @name 构造/析构函数
+  /// @{
+  LocalTimer() = delete;
+  LocalTimer(const LocalTimer &) = delete;
+  LocalTimer(LocalTimer &&) = delete;
+  auto operator=(const LocalTimer &) -> LocalTimer & = delete;
+  auto operator=(LocalTimer &&) -> LocalTimer & = delete;
+  ~LocalTimer() = default;
+  /// @}
+
+  /**
+   * @brief 使用 PIT 通道 2 校准 APIC 定时器频率
+   * @param ms 校准时长 (毫秒)，按 Pit::OneShotCount() 限制在 1-54 内
+   * @return uint64_t 16 分频后的定时器频率 (Hz)
+   * @note 校准期间应关闭中断，校准后定时器处于屏蔽状态
+   */
+  auto Calibrate(uint32_t ms = 10) -> uint64_t {
+    auto count = Pit::OneShotCount(ms);
+    msr::apic::WriteTimerDivide(msr::apic::timer_divide::kDivideBy16);
+    msr::apic::WriteLvtTimer(msr::apic::lvt_timer::kMasked | vector_);
+    Pit::StartChannel2OneShot(count);
+    msr::apic::WriteTimerInitCount(UINT32_MAX);
+    while (!Pit::IsChannel2Expired()) {
+      Pause();
+    }
+    auto elapsed = UINT32_MAX - msr::apic::ReadTimerCurrCount();
+    msr::apic::WriteTimerInitCount(0);
+    mode_ = msr::apic::lvt_timer::kMasked;
+    frequency_ = static_cast<uint64_t>(elapsed) * Pit::kMaxFrequency / count;
+    ns_to_count_ = ClockScale::Make(ClockScale::kNsPerSec, frequency_);
+    return frequency_;
+  }
+
+  /**
+   * @brief 获取校准后的定时器频率
+   * @return uint64_t 定时器频率 (Hz)，未校准时为 0
+   */
+  [[nodiscard]] auto GetFrequency() const -> uint64_t { return frequency_; }
+
+  /**
+   * @brief 启动周期模式
+   * @param period_ns 周期 (纳秒)
+   * @pre 已调用 Calibrate()
+   */
+  void StartPeriodic(uint64_t period_ns) {
+    Program(msr::apic::lvt_timer::kPeriodic, ToCount(period_ns));
+  }
+
+  /**
+   * @brief 启动单次模式
+   * @param delay_ns 距现在的延迟 (纳秒)
+   * @pre 已调用 Calibrate()
+   */
+  void StartOneShot(uint64_t delay_ns) {
+    Program(msr::apic::lvt_timer::kOneShot, ToCount(delay_ns));
+  }
+
+  /**
+   * @brief 使用 TSC-deadline 模式在 TSC 到达 deadline 时触发一次中断
+   * 已处于 TSC-deadline 模式时只需一次 WRMSR
+   * @param deadline 绝对 TSC 值，可由 ReadCycles() + NsToCycles() 计算
+   * @pre IsDeadlineSupported()
+   */
+  void SetDeadline(uint64_t deadline) {
+    if (mode_ != msr::apic::lvt_timer::kTscDeadline) {
+      mode_ = msr::apic::lvt_timer::kTscDeadline;
+      msr::apic::WriteLvtTimer(mode_ | vector_);
+      // 保证 LVT 写入先于 IA32_TSC_DEADLINE 写入生效
+      Mb();
+    }
+    Msr::Write(msr::kIa32TscDeadline, deadline);
+  }
+
+  /**
+   * @brief 停止定时器
+   */
+  void Stop() {
+    if (mode_ == msr::apic::lvt_timer::kTscDeadline) {
+      Msr::Write(msr::kIa32TscDeadline, 0);
+    }
+    mode_ = msr::apic::lvt_timer::kMasked;
+    msr::apic::WriteLvtTimer(mode_ | vector_);
+    msr::apic::WriteTimerInitCount(0);
+  }
+
+  /**
+   * @brief 在定时器中断处理中调用
+   * @note APIC 定时器的周期模式由硬件重装，此处无需操作，EOI 由调用者发送
+   */
+  void Acknowledge() {}
+
+  /**
+   * @brief 是否支持 TSC-deadline 模式
+   * @return true 支持
+   */
+  [[nodiscard]] static auto IsDeadlineSupported() -> bool {
+    return cpuid::HasTscDeadline();
+  }
+
+ private:
+  /// 中断向量
+  uint8_t vector_;
+  /// 当前 LVT Timer 模式
+  uint32_t mode_ = msr::apic::lvt_timer::kMasked;
+  /// 定时器频率
+  uint64_t frequency_ = 0;
+  /// 纳秒到定时器计数的换算系数
+  ClockScale ns_to_count_{};
+
+  /**
+   * @brief 将纳秒换算为初始计数
+   * @param ns 纳秒
+   * @return uint32_t 初始计数，范围 [1, UINT32_MAX]
+   */
+  [[nodiscard]] auto ToCount(uint64_t ns) const -> uint32_t {
+    auto count = ns_to_count_.Apply(ns);
+    if (count == 0) {
+      return 1;
+    }
+    return count > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(count);
+  }
+
+  /**
+   * @brief 设置计数模式并开始计数
+   * @param mode 单次或周期模式
+   * @param count 初始计数
+   */
+  void Program(uint32_t mode, uint32_t count) {
+    mode_ = mode;
+    msr::apic::WriteTimerDivide(msr::apic::timer_divide::kDivideBy16);
+    msr::apic::WriteLvtTimer(mode_ | vector_);
+    msr::apic::WriteTimerInitCount(count);
+  }
+};
+
 }  // namespace cpu_io
 
 #endif  // CPU_IO_INCLUDE_X86_64_CPU_HPP_
@@ -45,6 +45,12 @@ static constexpr uint32_t kDirectCacheAccess = 0x00000009;
 static constexpr uint32_t kArchPerfMon = 0x0000000A;
 /// 扩展拓扑枚举
 static constexpr uint32_t kExtendedTopology = 0x0000000B;
+/// XSAVE 状态组件信息
+static constexpr uint32_t kXsaveInfo = 0x0000000D;
+/// 混合架构的核心类型
+static constexpr uint32_t kHybridInfo = 0x0000001A;
+/// 架构 LBR
+static constexpr uint32_t kArchLbr = 0x0000001C;
 
 /// 扩展功能号范围
 /// 获取最大扩展功能号
@@ -57,6 +63,8 @@ static constexpr uint32_t kBrandString1 = 0x80000002;
 static constexpr uint32_t kBrandString2 = 0x80000003;
 /// 品牌字符串部分3
 static constexpr uint32_t kBrandString3 = 0x80000004;
+/// 高级电源管理信息（不变 TSC）
+static constexpr uint32_t kAdvancedPowerManagement = 0x80000007;
 /// 虚拟和物理地址大小
 static constexpr uint32_t kAddressSize = 0x80000008;
 }  // namespace leaf
@@ -190,6 +198,86 @@ static constexpr uint32_t kRdrand = 1U << 30;
 /// 运行在虚拟机管理程序下
 static constexpr uint32_t kHypervisor = 1U << 31;
 }  // namespace ecx
+
+/// CPUID.(EAX=07H,ECX=0):EBX 特性位
+namespace ext_ebx {
+/// RDFSBASE/RDGSBASE/WRFSBASE/WRGSBASE 指令
+static constexpr uint32_t kFsgsbase = 1U << 0;
+/// IA32_TSC_ADJUST MSR
+static constexpr uint32_t kTscAdjust = 1U << 1;
+/// BMI1 指令
+static constexpr uint32_t kBmi1 = 1U << 3;
+/// AVX2 指令
+static constexpr uint32_t kAvx2 = 1U << 5;
+/// 管理模式执行保护
+static constexpr uint32_t kSmep = 1U << 7;
+/// BMI2 指令
+static constexpr uint32_t kBmi2 = 1U << 8;
+/// 增强 REP MOVSB/STOSB
+static constexpr uint32_t kErms = 1U << 9;
+/// INVPCID 指令
+static constexpr uint32_t kInvpcid = 1U << 10;
+/// 管理模式访问保护
+static constexpr uint32_t kSmap = 1U << 20;
+/// CLFLUSHOPT 指令
+static constexpr uint32_t kClflushopt = 1U << 23;
+/// CLWB 指令
+static constexpr uint32_t kClwb = 1U << 24;
+}  // namespace ext_ebx
+
+/// CPUID.(EAX=07H,ECX=0):ECX 特性位
+namespace ext_ecx {
+/// TPAUSE/UMONITOR/UMWAIT 指令
+static constexpr uint32_t kWaitpkg = 1U << 5;
+/// RDPID 指令
+static constexpr uint32_t kRdpid = 1U << 22;
+}  // namespace ext_ecx
+
+/// CPUID.(EAX=07H,ECX=0):EDX 特性位
+namespace ext7_edx {
+/// 混合架构，不同类型的核心 CPUID 0x1A/0x1C 等叶的结果不同
+static constexpr uint32_t kHybrid = 1U << 15;
+/// 架构 LBR
+static constexpr uint32_t kArchLbr = 1U << 19;
+}  // namespace ext7_edx
+
+/// CPUID.80000001H:EDX 特性位
+namespace ext_edx {
+/// SYSCALL/SYSRET 指令
+static constexpr uint32_t kSyscall = 1U << 11;
+/// 禁止执行位
+static constexpr uint32_t kNx = 1U << 20;
+/// 1GB 大页
+static constexpr uint32_t kPage1Gb = 1U << 26;
+/// RDTSCP 指令与 IA32_TSC_AUX
+static constexpr uint32_t kRdtscp = 1U << 27;
+/// 长模式
+static constexpr uint32_t kLm = 1U << 29;
+}  // namespace ext_edx
+
+/// CPUID.80000007H:EDX 特性位
+namespace apm_edx {
+/// 不变 TSC，频率不随 P/C 状态变化
+static constexpr uint32_t kInvariantTsc = 1U << 8;
+}  // namespace apm_edx
+
+/// CPUID.(EAX=0DH,ECX=1):EAX 特性位
+namespace xsave_eax {
+/// XSAVEOPT 指令
+static constexpr uint32_t kXsaveopt = 1U << 0;
+/// XSAVEC 指令 (压缩格式)
+static constexpr uint32_t kXsavec = 1U << 1;
+/// XSAVES/XRSTORS 指令与 IA32_XSS
+static constexpr uint32_t kXsaves = 1U << 3;
+}  // namespace xsave_eax
+
+/// CPUID.05H:ECX 特性位
+namespace mwait_ecx {
+/// 枚举 MWAIT 扩展
+static constexpr uint32_t kExtensions = 1U << 0;
+/// ECX[0] 置位时被屏蔽的中断也是唤醒事件
+static constexpr uint32_t kInterruptBreak = 1U << 1;
+}  // namespace mwait_ecx
 }  // namespace feature
 
 /// CPUID 结果结构
@@ -219,17 +307,6 @@ static __always_inline auto ExecuteCpuid(uint32_t leaf,
   return result;
 }
 
-/**
- * @brief 检查特性位是否设置
- * @param value 寄存器值
- * @param feature_bit 特性位掩码
- * @return bool 是否支持该特性
- */
-static __always_inline auto HasFeature(uint32_t value,
-                                       uint32_t feature_bit) -> bool {
-  return (value & feature_bit) != 0;
-}
-
 /**
  * @brief 获取最大基本功能号
  * @return uint32_t 最大基本功能号
@@ -239,28 +316,241 @@ static __always_inline auto GetMaxBasicLeaf() -> uint32_t {
   return result.eax;
 }
 
+}  // namespace detail
+
 /**
- * @brief 检查是否支持指定特性（基于 CPUID.01H:EDX）
- * @param feature_bit 特性位掩码
- * @return bool 是否支持该特性
+ * @brief CPUID 特性快照
+ * 一次性读取常用的 CPUID 叶，之后的特性查询只访问内存，
+ * 避免 CPUID 的串行化开销以及虚拟化环境下的 VM exit。
+ * 只读取混合架构上各类核心结果一致的叶 (0x1/0x5/0x7/0xD/0x80000001/0x80000007)，
+ * 随核心类型变化的叶 (0x4/0xA/0x1A/0x1C) 由使用者在当前核心上执行
  */
-static __always_inline auto HasFeatureEdx(uint32_t feature_bit) -> bool {
-  auto result = ExecuteCpuid(leaf::kVersionInfo);
-  return HasFeature(result.edx, feature_bit);
-}
+struct CpuFeatures {
+  /// 最大基本功能号
+  uint32_t max_basic_leaf = 0;
+  /// 最大扩展功能号
+  uint32_t max_extended_leaf = 0;
+  /// CPUID.01H:ECX
+  uint32_t ecx = 0;
+  /// CPUID.01H:EDX
+  uint32_t edx = 0;
+  /// CPUID.(EAX=07H,ECX=0):EBX
+  uint32_t ext_ebx = 0;
+  /// CPUID.(EAX=07H,ECX=0):ECX
+  uint32_t ext_ecx = 0;
+  /// CPUID.(EAX=07H,ECX=0):EDX
+  uint32_t ext7_edx = 0;
+  /// CPUID.80000001H:EDX
+  uint32_t ext_edx = 0;
+  /// CPUID.80000007H:EDX
+  uint32_t apm_edx = 0;
+  /// CPUID.05H:ECX
+  uint32_t mwait_ecx = 0;
+  /// CPUID.(EAX=0DH,ECX=0):EDX:EAX，XCR0 可设置的状态组件
+  uint64_t xsave_supported_mask = 0;
+  /// CPUID.(EAX=0DH,ECX=0):ECX，所有状态组件所需的 XSAVE 区域大小
+  uint32_t xsave_max_size = 0;
+  /// CPUID.(EAX=0DH,ECX=1):EAX
+  uint32_t xsave_eax = 0;
+
+  /**
+   * @brief 执行 CPUID 读取当前核心的特性
+   * @return CpuFeatures 特性快照
+   */
+  static auto Read() -> CpuFeatures {
+    CpuFeatures features;
+    features.max_basic_leaf = detail::GetMaxBasicLeaf();
+    auto version = detail::ExecuteCpuid(detail::leaf::kVersionInfo);
+    features.ecx = version.ecx;
+    features.edx = version.edx;
+    if (features.max_basic_leaf >= detail::leaf::kMonitorMwait) {
+      features.mwait_ecx =
+          detail::ExecuteCpuid(detail::leaf::kMonitorMwait).ecx;
+    }
+    if (features.max_basic_leaf >= detail::leaf::kExtendedFeatures) {
+      auto ext = detail::ExecuteCpuid(detail::leaf::kExtendedFeatures, 0);
+      features.ext_ebx = ext.ebx;
+      features.ext_ecx = ext.ecx;
+      features.ext7_edx = ext.edx;
+    }
+    if (features.max_basic_leaf >= detail::leaf::kXsaveInfo &&
+        features.HasXsave()) {
+      auto xsave = detail::ExecuteCpuid(detail::leaf::kXsaveInfo, 0);
+      features.xsave_supported_mask =
+          (static_cast<uint64_t>(xsave.edx) << 32) | xsave.eax;
+      features.xsave_max_size = xsave.ecx;
+      features.xsave_eax =
+          detail::ExecuteCpuid(detail::leaf::kXsaveInfo, 1).eax;
+    }
+    features.max_extended_leaf =
+        detail::ExecuteCpuid(detail::leaf::kExtendedInfo).eax;
+    if (features.max_extended_leaf >= detail::leaf::kExtendedVersionInfo) {
+      features.ext_edx =
+          detail::ExecuteCpuid(detail::leaf::kExtendedVersionInfo).edx;
+    }
+    if (features.max_extended_leaf >=
+        detail::leaf::kAdvancedPowerManagement) {
+      features.apm_edx =
+          detail::ExecuteCpuid(detail::leaf::kAdvancedPowerManagement).edx;
+    }
+    return features;
+  }
+
+  /// @name 特性查询
+  /// @{
+  [[nodiscard]] constexpr auto HasApic() const -> bool {
+    return (edx & detail::feature::edx::kApic) != 0;
+  }
+  [[nodiscard]] constexpr auto HasTsc() const -> bool {
+    return (edx & detail::feature::edx::kTsc) != 0;
+  }
+  [[nodiscard]] constexpr auto HasMsr() const -> bool {
+    return (edx & detail::feature::edx::kMsr) != 0;
+  }
+  [[nodiscard]] constexpr auto HasMtrr() const -> bool {
+    return (edx & detail::feature::edx::kMtrr) != 0;
+  }
+  [[nodiscard]] constexpr auto HasPat() const -> bool {
+    return (edx & detail::feature::edx::kPat) != 0;
+  }
+  [[nodiscard]] constexpr auto HasX2Apic() const -> bool {
+    return (ecx & detail::feature::ecx::kX2Apic) != 0;
+  }
+  [[nodiscard]] constexpr auto HasPcid() const -> bool {
+    return (ecx & detail::feature::ecx::kPcid) != 0;
+  }
+  [[nodiscard]] constexpr auto HasTscDeadline() const -> bool {
+    return (ecx & detail::feature::ecx::kTscDeadline) != 0;
+  }
+  [[nodiscard]] constexpr auto HasMonitor() const -> bool {
+    return (ecx & detail::feature::ecx::kMonitor) != 0;
+  }
+  /// MWAIT 的 ECX[0] 可用，被屏蔽的中断也能唤醒
+  [[nodiscard]] constexpr auto HasMwaitInterruptBreak() const -> bool {
+    constexpr auto kBits = detail::feature::mwait_ecx::kExtensions |
+                           detail::feature::mwait_ecx::kInterruptBreak;
+    return (mwait_ecx & kBits) == kBits;
+  }
+  [[nodiscard]] constexpr auto HasPdcm() const -> bool {
+    return (ecx & detail::feature::ecx::kPdcm) != 0;
+  }
+  [[nodiscard]] constexpr auto HasXsave() const -> bool {
+    return (ecx & detail::feature::ecx::kXsave) != 0;
+  }
+  [[nodiscard]] constexpr auto HasXsaveopt() const -> bool {
+    return (xsave_eax & detail::feature::xsave_eax::kXsaveopt) != 0;
+  }
+  [[nodiscard]] constexpr auto HasXsavec() const -> bool {
+    return (xsave_eax & detail::feature::xsave_eax::kXsavec) != 0;
+  }
+  [[nodiscard]] constexpr auto HasXsaves() const -> bool {
+    return (xsave_eax & detail::feature::xsave_eax::kXsaves) != 0;
+  }
+  /// 读取快照时 CR4.OSXSAVE 是否已置位
+  [[nodiscard]] constexpr auto HasOsxsave() const -> bool {
+    return (ecx & detail::feature::ecx::kOsxsave) != 0;
+  }
+  [[nodiscard]] constexpr auto HasFsgsbase() const -> bool {
+    return (ext_ebx & detail::feature::ext_ebx::kFsgsbase) != 0;
+  }
+  [[nodiscard]] constexpr auto HasInvpcid() const -> bool {
+    return (ext_ebx & detail::feature::ext_ebx::kInvpcid) != 0;
+  }
+  [[nodiscard]] constexpr auto HasClflushopt() const -> bool {
+    return (ext_ebx & detail::feature::ext_ebx::kClflushopt) != 0;
+  }
+  [[nodiscard]] constexpr auto HasClwb() const -> bool {
+    return (ext_ebx & detail::feature::ext_ebx::kClwb) != 0;
+  }
+  [[nodiscard]] constexpr auto HasHybrid() const -> bool {
+    return (ext7_edx & detail::feature::ext7_edx::kHybrid) != 0;
+  }
+  [[nodiscard]] constexpr auto HasArchLbr() const -> bool {
+    return (ext7_edx & detail::feature::ext7_edx::kArchLbr) != 0;
+  }
+  [[nodiscard]] constexpr auto HasWaitpkg() const -> bool {
+    return (ext_ecx & detail::feature::ext_ecx::kWaitpkg) != 0;
+  }
+  [[nodiscard]] constexpr auto HasRdpid() const -> bool {
+    return (ext_ecx & detail::feature::ext_ecx::kRdpid) != 0;
+  }
+  [[nodiscard]] constexpr auto HasNx() const -> bool {
+    return (ext_edx & detail::feature::ext_edx::kNx) != 0;
+  }
+  [[nodiscard]] constexpr auto HasPage1Gb() const -> bool {
+    return (ext_edx & detail::feature::ext_edx::kPage1Gb) != 0;
+  }
+  [[nodiscard]] constexpr auto HasRdtscp() const -> bool {
+    return (ext_edx & detail::feature::ext_edx::kRdtscp) != 0;
+  }
+  [[nodiscard]] constexpr auto HasInvariantTsc() const -> bool {
+    return (apm_edx & detail::feature::apm_edx::kInvariantTsc) != 0;
+  }
+  /// @}
+};
+
+namespace detail {
+
+/// cpu_features_state：未填充
+static constexpr uint32_t kFeaturesEmpty = 0;
+/// cpu_features_state：某个核心正在填充
+static constexpr uint32_t kFeaturesFilling = 1;
+/// cpu_features_state：已发布，之后只读
+static constexpr uint32_t kFeaturesReady = 2;
+
+/// 全局特性快照
+inline CpuFeatures cpu_features{};
+/// cpu_features 的状态，以 release 发布、acquire 读取
+inline uint32_t cpu_features_state = kFeaturesEmpty;
 
 /**
- * @brief 检查是否支持指定特性（基于 CPUID.01H:ECX）
- * @param feature_bit 特性位掩码
- * @return bool 是否支持该特性
+ * @brief 填充并发布全局特性快照，多个核心同时调用时只有一个执行 CPUID，
+ * 其它核心等待发布
  */
-static __always_inline auto HasFeatureEcx(uint32_t feature_bit) -> bool {
-  auto result = ExecuteCpuid(leaf::kVersionInfo);
-  return HasFeature(result.ecx, feature_bit);
+static inline void FillCpuFeaturesOnce() {
+  auto expected = kFeaturesEmpty;
+  if (__atomic_compare_exchange_n(&cpu_features_state, &expected,
+                                  kFeaturesFilling, false, __ATOMIC_ACQUIRE,
+                                  __ATOMIC_ACQUIRE)) {
+    cpu_features = CpuFeatures::Read();
+    __atomic_store_n(&cpu_features_state, kFeaturesReady, __ATOMIC_RELEASE);
+    return;
+  }
+  while (__atomic_load_n(&cpu_features_state, __ATOMIC_ACQUIRE) !=
+         kFeaturesReady) {
+    __asm__ volatile("pause" ::: "memory");
+  }
 }
 
 }  // namespace detail
 
+/**
+ * @brief 在启动核心上读取并发布全局特性快照
+ * 启动其它核心之前调用一次；修改 CR4.OSXSAVE 等会影响 CPUID 结果的设置后
+ * 可再次调用
+ * @pre 其它核心没有在使用 GetCpuFeatures() 的结果
+ */
+static __always_inline void RefreshCpuFeatures() {
+  detail::cpu_features = CpuFeatures::Read();
+  __atomic_store_n(&detail::cpu_features_state, detail::kFeaturesReady,
+                   __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 获取全局特性快照
+ * 未调用 RefreshCpuFeatures() 时由第一个调用者读取，并发的首次调用也是安全的
+ * @return const CpuFeatures& 特性快照，发布后只读
+ * @note 快照只包含各核心 (含混合架构的各类核心) 一致的叶；
+ * 需要单个核心的结果时使用 CpuFeatures::Read()
+ */
+static __always_inline auto GetCpuFeatures() -> const CpuFeatures & {
+  if (__atomic_load_n(&detail::cpu_features_state, __ATOMIC_ACQUIRE) !=
+      detail::kFeaturesReady) [[unlikely]] {
+    detail::FillCpuFeaturesOnce();
+  }
+  return detail::cpu_features;
+}
+
 /**
  * @brief 获取 CPU 厂商字符串
  * @return std::array<char, 13> 厂商字符串（包含 null 终止符）
@@ -308,7 +598,7 @@ static __always_inline auto GetBrandString() -> std::array<char, 49> {
  * @return bool 是否支持 APIC
  */
 static __always_inline auto HasApic() -> bool {
-  return detail::HasFeatureEdx(detail::feature::edx::kApic);
+  return GetCpuFeatures().HasApic();
 }
 
 /**
@@ -316,7 +606,7 @@ static __always_inline auto HasApic() -> bool {
  * @return bool 是否支持 x2APIC
  */
 static __always_inline auto HasX2Apic() -> bool {
-  return detail::HasFeatureEcx(detail::feature::ecx::kX2Apic);
+  return GetCpuFeatures().HasX2Apic();
 }
 
 /**
@@ -324,7 +614,7 @@ static __always_inline auto HasX2Apic() -> bool {
  * @return bool 是否支持 TSC
  */
 static __always_inline auto HasTsc() -> bool {
-  return detail::HasFeatureEdx(detail::feature::edx::kTsc);
+  return GetCpuFeatures().HasTsc();
 }
 
 /**
@@ -332,7 +622,71 @@ static __always_inline auto HasTsc() -> bool {
  * @return bool 是否支持 MSR
  */
 static __always_inline auto HasMsr() -> bool {
-  return detail::HasFeatureEdx(detail::feature::edx::kMsr);
+  return GetCpuFeatures().HasMsr();
+}
+
+/**
+ * @brief 检查是否支持 PCID
+ * @return bool 是否支持 PCID
+ */
+static __always_inline auto HasPcid() -> bool {
+  return GetCpuFeatures().HasPcid();
+}
+
+/**
+ * @brief 检查是否支持 INVPCID 指令
+ * @return bool 是否支持 INVPCID
+ */
+static __always_inline auto HasInvpcid() -> bool {
+  return GetCpuFeatures().HasInvpcid();
+}
+
+/**
+ * @brief 检查是否支持 1GB 大页
+ * @return bool 是否支持 1GB 大页
+ */
+static __always_inline auto HasPage1Gb() -> bool {
+  return GetCpuFeatures().HasPage1Gb();
+}
+
+/**
+ * @brief 检查是否支持 TSC-deadline 定时器模式
+ * @return bool 是否支持 TSC-deadline
+ */
+static __always_inline auto HasTscDeadline() -> bool {
+  return GetCpuFeatures().HasTscDeadline();
+}
+
+/**
+ * @brief 检查是否支持不变 TSC
+ * @return bool 是否支持不变 TSC
+ */
+static __always_inline auto HasInvariantTsc() -> bool {
+  return GetCpuFeatures().HasInvariantTsc();
+}
+
+/**
+ * @brief 检查是否支持 RDTSCP 指令
+ * @return bool 是否支持 RDTSCP
+ */
+static __always_inline auto HasRdtscp() -> bool {
+  return GetCpuFeatures().HasRdtscp();
+}
+
+/**
+ * @brief 检查是否支持 RDFSBASE/WRFSBASE 等指令
+ * @return bool 是否支持 FSGSBASE
+ */
+static __always_inline auto HasFsgsbase() -> bool {
+  return GetCpuFeatures().HasFsgsbase();
+}
+
+/**
+ * @brief 检查是否支持 XSAVE 指令
+ * @return bool 是否支持 XSAVE
+ */
+static __always_inline auto HasXsave() -> bool {
+  return GetCpuFeatures().HasXsave();
 }
 
 /**
@@ -365,6 +719,21 @@ static __always_inline auto GetLogicalProcessorCount() -> uint32_t {
   return (result.ebx >> 16) & 0xFF;
 }
 
+/**
+ * @brief 获取当前核心在混合架构中的类型，每次执行 CPUID
+ * 随核心类型变化的数据 (如 CPUID 0x1C 的 LBR 深度) 应按该值分别保存
+ * @return uint8_t CPUID.1AH:EAX[31:24]，Intel 上 0x20 为 Atom，0x40 为 Core；
+ * 非混合架构返回 0
+ */
+static __always_inline auto GetCoreType() -> uint8_t {
+  const auto &features = GetCpuFeatures();
+  if (!features.HasHybrid() ||
+      features.max_basic_leaf < detail::leaf::kHybridInfo) {
+    return 0;
+  }
+  return detail::ExecuteCpuid(detail::leaf::kHybridInfo).eax >> 24;
+}
+
 }  // namespace cpuid
 }  // namespace cpu_io
 
@@ -0,0 +1,292 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_X86_64_FPU_HPP_
+#define CPU_IO_INCLUDE_X86_64_FPU_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cpuid.hpp"
+#include "msr.h"
+#include "regs.hpp"
+
+namespace cpu_io {
+
+/// 扩展状态保存区的对齐要求
+static constexpr size_t kExtendedStateAlign = 64;
+
+namespace detail {
+
+/// 扩展状态保存区的大小
+inline size_t extended_state_size = 512;
+/// XCR0 中启用的状态组件
+inline uint64_t extended_state_mask = 0;
+
+/// FXSAVE 区中 FCW 的偏移
+static constexpr size_t kFcwOffset = 0;
+/// FXSAVE 区中 MXCSR 的偏移
+static constexpr size_t kMxcsrOffset = 24;
+/// XSAVE 头中 XCOMP_BV 的偏移
+static constexpr size_t kXcompBvOffset = 520;
+/// XCOMP_BV 压缩格式标志
+static constexpr uint64_t kXcompBvCompact = 1ULL << 63;
+/// FCW 初始值
+static constexpr uint16_t kFcwDefault = 0x037F;
+/// MXCSR 初始值，屏蔽所有 SIMD 浮点异常
+static constexpr uint32_t kMxcsrDefault = 0x1F80;
+
+/**
+ * @brief 按 XCR0 的依赖规则规范化状态组件，xsetbv 遇到不合法的组合会 #GP
+ * x87 与 SSE 总是启用；AVX-512 的三个组件须同时设置且需要 AVX；
+ * MPX 与 AMX 的两个组件须同时设置。不完整的组合整组清除
+ * @param mask 状态组件
+ * @return uint64_t 可以写入 XCR0 的状态组件
+ */
+static constexpr auto NormalizeXcr0(uint64_t mask) -> uint64_t {
+  using register_info::Xcr0Info;
+  constexpr auto kAvx512 = Xcr0Info::Opmask::kBitMask |
+                           Xcr0Info::ZmmHi256::kBitMask |
+                           Xcr0Info::Hi16Zmm::kBitMask;
+  constexpr auto kMpx =
+      Xcr0Info::Bndregs::kBitMask | Xcr0Info::Bndcsr::kBitMask;
+  constexpr auto kAmx =
+      Xcr0Info::XtileCfg::kBitMask | Xcr0Info::XtileData::kBitMask;
+  mask |= Xcr0Info::X87::kBitMask | Xcr0Info::Sse::kBitMask;
+  if ((mask & kAvx512) != kAvx512 || (mask & Xcr0Info::Avx::kBitMask) == 0) {
+    mask &= ~kAvx512;
+  }
+  if ((mask & kMpx) != kMpx) {
+    mask &= ~kMpx;
+  }
+  if ((mask & kAmx) != kAmx) {
+    mask &= ~kAmx;
+  }
+  return mask;
+}
+
+static_assert(NormalizeXcr0(0) == 0x3);
+static_assert(NormalizeXcr0(0xE7) == 0xE7);
+static_assert(NormalizeXcr0(0xE3) == 0x3);
+static_assert(NormalizeXcr0(0x67) == 0x7);
+static_assert(NormalizeXcr0(0x20007) == 0x7);
+static_assert(NormalizeXcr0(0x60207) == 0x60207);
+static_assert(NormalizeXcr0(0x0F) == 0x7);
+
+}  // namespace detail
+
+/**
+ * @brief 启用 x87/SSE 与 XSAVE 管理的扩展状态
+ * 设置 CR0/CR4，并把 XCR0 设为 mask 与处理器支持的组件的交集，
+ * 再按 XCR0 的依赖规则去掉不完整的组合，需在每个核心上调用一次
+ * @param mask 希望启用的 XCR0 状态组件，x87 与 SSE 总是启用
+ * @return uint64_t 实际启用的状态组件
+ */
+static __always_inline auto EnableExtendedState(uint64_t mask = ~0ULL)
+    -> uint64_t {
+  using detail::register_info::Xcr0Info;
+  const auto &features = cpuid::GetCpuFeatures();
+
+  detail::regs::cr::Cr0::Em::Clear();
+  detail::regs::cr::Cr0::Ts::Clear();
+  detail::regs::cr::Cr0::Mp::Set();
+  detail::regs::cr::Cr0::Ne::Set();
+  detail::regs::cr::Cr4::Osfxsr::Set();
+  detail::regs::cr::Cr4::Osxmmexcpt::Set();
+
+  if (!features.HasXsave()) {
+    detail::extended_state_mask = Xcr0Info::X87::kBitMask |
+                                  Xcr0Info::Sse::kBitMask;
+    detail::extended_state_size = 512;
+    return detail::extended_state_mask;
+  }
+
+  detail::regs::cr::Cr4::Osxsave::Set();
+  auto enabled =
+      detail::NormalizeXcr0(mask & features.xsave_supported_mask);
+  detail::regs::Xcr0::Write(enabled);
+  if (features.HasXsaves()) {
+    // 不管理管理态组件
+    detail::regs::Msr::Write(msr::kIa32Xss, 0);
+  }
+  // 保存区大小取决于当前 XCR0，需在写入后重新查询
+  auto leaf = cpuid::detail::ExecuteCpuid(cpuid::detail::leaf::kXsaveInfo,
+                                          features.HasXsaves() ? 1 : 0);
+  detail::extended_state_mask = enabled;
+  detail::extended_state_size = leaf.ebx;
+  return enabled;
+}
+
+/**
+ * @brief 获取扩展状态保存区的大小
+ * @return size_t 字节数，使用 XSAVES 时为压缩格式的大小
+ */
+static __always_inline auto GetExtendedStateSize() -> size_t {
+  return detail::extended_state_size;
+}
+
+/**
+ * @brief 初始化扩展状态保存区，恢复后所有组件为初始状态
+ * @param area 保存区，kExtendedStateAlign 对齐，大小为 GetExtendedStateSize()
+ */
+static __always_inline void InitExtendedState(void *area) {
+  auto bytes = static_cast<uint8_t *>(area);
+  __builtin_memset(bytes, 0, detail::extended_state_size);
+  *reinterpret_cast<uint16_t *>(bytes + detail::kFcwOffset) =
+      detail::kFcwDefault;
+  *reinterpret_cast<uint32_t *>(bytes + detail::kMxcsrOffset) =
+      detail::kMxcsrDefault;
+  if (cpuid::GetCpuFeatures().HasXsaves()) {
+    // XRSTORS 要求压缩格式
+    *reinterpret_cast<uint64_t *>(bytes + detail::kXcompBvOffset) =
+        detail::kXcompBvCompact | detail::extended_state_mask;
+  }
+}
+
+/**
+ * @brief 保存扩展状态
+ * 依次优先使用 XSAVES (压缩格式，跳过初始状态与未修改的组件)、
+ * XSAVEOPT (跳过未修改的组件)、XSAVE 与 FXSAVE
+ * @param area 保存区，kExtendedStateAlign 对齐
+ */
+static __always_inline void SaveExtendedState(void *area) {
+  const auto &features = cpuid::GetCpuFeatures();
+  if (features.HasXsaves()) {
+    __asm__ volatile("xsaves64 (%0)"
+                     :
+                     : "r"(area), "a"(~0U), "d"(~0U)
+                     : "memory");
+  } else if (features.HasXsaveopt()) {
+    __asm__ volatile("xsaveopt64 (%0)"
+                     :
+                     : "r"(area), "a"(~0U), "d"(~0U)
+                     : "memory");
+  } else if (features.HasXsave()) {
+    __asm__ volatile("xsave64 (%0)"
+                     :
+                     : "r"(area), "a"(~0U), "d"(~0U)
+                     : "memory");
+  } else {
+    __asm__ volatile("fxsave64 (%0)" : : "r"(area) : "memory");
+  }
+}
+
+/**
+ * @brief 恢复扩展状态
+ * @param area 由 SaveExtendedState() 或 InitExtendedState() 写入的保存区
+ */
+static __always_inline void RestoreExtendedState(const void *area) {
+  const auto &features = cpuid::GetCpuFeatures();
+  if (features.HasXsaves()) {
+    __asm__ volatile("xrstors64 (%0)"
+                     :
+                     : "r"(area), "a"(~0U), "d"(~0U)
+                     : "memory");
+  } else if (features.HasXsave()) {
+    __asm__ volatile("xrstor64 (%0)"
+                     :
+                     : "r"(area), "a"(~0U), "d"(~0U)
+                     : "memory");
+  } else {
+    __asm__ volatile("fxrstor64 (%0)" : : "r"(area) : "memory");
+  }
+}
+
+/**
+ * @brief 延迟切换扩展状态，每个核心一个实例
+ * 切换线程时不保存扩展状态，只在下一个线程不是寄存器中状态的所有者时
+ * 置位 CR0.TS；该线程首次使用 x87/SSE/AVX 时产生 #NM (向量 7)，
+ * 在处理中调用 HandleTrap() 保存所有者的状态并恢复当前线程的状态。
+ * 从不使用 SIMD 的线程不会产生任何保存/恢复
+ * @note 线程迁移到其它核心前需在原核心上调用 Flush()
+ */
+class LazyFpu {
+ public:
+  /// @name 构造/析构函数
+  /// @{
+  LazyFpu() = default;
+  LazyFpu(const LazyFpu &) = delete;
+  LazyFpu(LazyFpu &&) = delete;
+  auto operator=(const LazyFpu &) -> LazyFpu & = delete;
+  auto operator=(LazyFpu &&) -> LazyFpu & = delete;
+  ~LazyFpu() = default;
+  /// @}
+
+  /**
+   * @brief 切换线程时调用
+   * @param next 下一个线程的保存区
+   */
+  void Switch(const void *next) { SetAccess(next == owner_); }
+
+  /**
+   * @brief #NM 处理
+   * @param current 当前线程的保存区
+   */
+  void HandleTrap(void *current) {
+    SetAccess(true);
+    if (owner_ == current) {
+      return;
+    }
+    if (owner_ != nullptr) {
+      SaveExtendedState(owner_);
+    }
+    RestoreExtendedState(current);
+    owner_ = current;
+  }
+
+  /**
+   * @brief 把寄存器中的状态写回所有者的保存区并放弃所有权
+   */
+  void Flush() {
+    if (owner_ == nullptr) {
+      return;
+    }
+    SetAccess(true);
+    SaveExtendedState(owner_);
+    owner_ = nullptr;
+    SetAccess(false);
+  }
+
+  /**
+   * @brief 线程退出时调用，丢弃其寄存器中的状态
+   * @param area 退出线程的保存区
+   */
+  void Release(const void *area) {
+    if (owner_ == area) {
+      owner_ = nullptr;
+    }
+  }
+
+  /**
+   * @brief 获取寄存器中状态的所有者
+   * @return void* 所有者的保存区，没有所有者时为 nullptr
+   */
+  [[nodiscard]] auto GetOwner() const -> void * { return owner_; }
+
+ private:
+  /// 寄存器中状态的所有者
+  void *owner_ = nullptr;
+  /// CR0.TS 是否已清除，避免重复写 CR0
+  bool access_ = true;
+
+  /**
+   * @brief 允许或禁止访问扩展状态
+   * @param access true 清除 CR0.TS
+   */
+  void SetAccess(bool access) {
+    if (access == access_) {
+      return;
+    }
+    if (access) {
+      __asm__ volatile("clts" ::: "memory");
+    } else {
+      detail::regs::cr::Cr0::Ts::Set();
+    }
+    access_ = access;
+  }
+};
+
+}  // namespace cpu_io
+
+#endif  // CPU_IO_INCLUDE_X86_64_FPU_HPP_
@@ -5,6 +5,7 @@
 #ifndef CPU_IO_INCLUDE_X86_64_IO_HPP_
 #define CPU_IO_INCLUDE_X86_64_IO_HPP_
 
+#include <cstddef>
 #include <cstdint>
 
 namespace cpu_io {
@@ -48,6 +49,174 @@ static __always_inline void Out(const uint16_t port, const T data) {
   }
 }
 
+/**
+ * @brief  从端口连续读数据 (rep ins)
+ * @tparam T              要读的数据类型
+ * @param  port           要读的端口
+ * @param  buf            输出缓冲区
+ * @param  count          要读的元素个数
+ */
+template <class T>
+static __always_inline void InBlock(const uint16_t port, T *buf,
+                                    size_t count) {
+  if constexpr (std::is_same_v<T, uint8_t>) {
+    __asm__ volatile("rep insb"
+                     : "+D"(buf), "+c"(count)
+                     : "d"(port)
+                     : "memory");
+  } else if constexpr (std::is_same_v<T, uint16_t>) {
+    __asm__ volatile("rep insw"
+                     : "+D"(buf), "+c"(count)
+                     : "d"(port)
+                     : "memory");
+  } else if constexpr (std::is_same_v<T, uint32_t>) {
+    __asm__ volatile("rep insl"
+                     : "+D"(buf), "+c"(count)
+                     : "d"(port)
+                     : "memory");
+  } else {
+    static_assert(sizeof(T) == 0);
+  }
+}
+
+/**
+ * @brief  向端口连续写数据 (rep outs)
+ * @tparam T              要写的数据类型
+ * @param  port           要写的端口
+ * @param  buf            要写的数据
+ * @param  count          要写的元素个数
+ */
+template <class T>
+static __always_inline void OutBlock(const uint16_t port, const T *buf,
+                                     size_t count) {
+  if constexpr (std::is_same_v<T, uint8_t>) {
+    __asm__ volatile("rep outsb"
+                     : "+S"(buf), "+c"(count)
+                     : "d"(port)
+                     : "memory");
+  } else if constexpr (std::is_same_v<T, uint16_t>) {
+    __asm__ volatile("rep outsw"
+                     : "+S"(buf), "+c"(count)
+                     : "d"(port)
+                     : "memory");
+  } else if constexpr (std::is_same_v<T, uint32_t>) {
+    __asm__ volatile("rep outsl"
+                     : "+S"(buf), "+c"(count)
+                     : "d"(port)
+                     : "memory");
+  } else {
+    static_assert(sizeof(T) == 0);
+  }
+}
+
+/**
+ * @brief  从同一 MMIO 寄存器连续读数据 (如设备 FIFO)
+ * @tparam T              要读的数据类型
+ * @param  addr           寄存器地址
+ * @param  buf            输出缓冲区
+ * @param  count          要读的元素个数
+ */
+template <class T>
+static __always_inline void MmioInBlock(const uintptr_t addr, T *buf,
+                                        size_t count) {
+  static_assert(std::is_integral_v<T> && sizeof(T) <= sizeof(uint64_t));
+  auto reg = reinterpret_cast<const volatile T *>(addr);
+  for (size_t i = 0; i < count; i++) {
+    buf[i] = *reg;
+  }
+}
+
+/**
+ * @brief  向同一 MMIO 寄存器连续写数据 (如设备 FIFO)
+ * @tparam T              要写的数据类型
+ * @param  addr           寄存器地址
+ * @param  buf            要写的数据
+ * @param  count          要写的元素个数
+ */
+template <class T>
+static __always_inline void MmioOutBlock(const uintptr_t addr, const T *buf,
+                                         size_t count) {
+  static_assert(std::is_integral_v<T> && sizeof(T) <= sizeof(uint64_t));
+  auto reg = reinterpret_cast<volatile T *>(addr);
+  for (size_t i = 0; i < count; i++) {
+    *reg = buf[i];
+  }
+}
+
+/**
+ * @brief  从 MMIO 区域复制到内存 (rep movs)
+ * 每次访问宽度固定为 sizeof(T)，适用于要求按宽度访问的设备内存
+ * @tparam T              访问宽度对应的类型
+ * @param  addr           MMIO 区域起始地址
+ * @param  buf            输出缓冲区
+ * @param  count          要复制的元素个数
+ */
+template <class T>
+static __always_inline void MmioCopyFrom(const uintptr_t addr, T *buf,
+                                         size_t count) {
+  auto src = reinterpret_cast<const volatile T *>(addr);
+  if constexpr (std::is_same_v<T, uint8_t>) {
+    __asm__ volatile("rep movsb"
+                     : "+S"(src), "+D"(buf), "+c"(count)
+                     :
+                     : "memory");
+  } else if constexpr (std::is_same_v<T, uint16_t>) {
+    __asm__ volatile("rep movsw"
+                     : "+S"(src), "+D"(buf), "+c"(count)
+                     :
+                     : "memory");
+  } else if constexpr (std::is_same_v<T, uint32_t>) {
+    __asm__ volatile("rep movsl"
+                     : "+S"(src), "+D"(buf), "+c"(count)
+                     :
+                     : "memory");
+  } else if constexpr (std::is_same_v<T, uint64_t>) {
+    __asm__ volatile("rep movsq"
+                     : "+S"(src), "+D"(buf), "+c"(count)
+                     :
+                     : "memory");
+  } else {
+    static_assert(sizeof(T) == 0);
+  }
+}
+
+/**
+ * @brief  从内存复制到 MMIO 区域 (rep movs)
+ * 每次访问宽度固定为 sizeof(T)，适用于要求按宽度访问的设备内存
+ * @tparam T              访问宽度对应的类型
+ * @param  addr           MMIO 区域起始地址
+ * @param  buf            要复制的数据
+ * @param  count          要复制的元素个数
+ */
+template <class T>
+static __always_inline void MmioCopyTo(const uintptr_t addr, const T *buf,
+                                       size_t count) {
+  auto dst = reinterpret_cast<volatile T *>(addr);
+  if constexpr (std::is_same_v<T, uint8_t>) {
+    __asm__ volatile("rep movsb"
+                     : "+S"(buf), "+D"(dst), "+c"(count)
+                     :
+                     : "memory");
+  } else if constexpr (std::is_same_v<T, uint16_t>) {
+    __asm__ volatile("rep movsw"
+                     : "+S"(buf), "+D"(dst), "+c"(count)
+                     :
+                     : "memory");
+  } else if constexpr (std::is_same_v<T, uint32_t>) {
+    __asm__ volatile("rep movsl"
+                     : "+S"(buf), "+D"(dst), "+c"(count)
+                     :
+                     : "memory");
+  } else if constexpr (std::is_same_v<T, uint64_t>) {
+    __asm__ volatile("rep movsq"
+                     : "+S"(buf), "+D"(dst), "+c"(count)
+                     :
+                     : "memory");
+  } else {
+    static_assert(sizeof(T) == 0);
+  }
+}
+
 }  // namespace cpu_io
 
 #endif  // CPU_IO_INCLUDE_X86_64_IO_HPP_
@@ -0,0 +1,355 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_X86_64_IOAPIC_HPP_
+#define CPU_IO_INCLUDE_X86_64_IOAPIC_HPP_
+
+#include <sys/cdefs.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cpu_io {
+
+/**
+ * @brief 中断投递目标
+ * @note 未启用中断重映射时，I/O APIC 与 MSI 的目标字段只有 8 位：
+ * 物理模式下为 APIC ID (0-254)，逻辑模式下为 xAPIC 逻辑 ID
+ */
+struct InterruptDestination {
+  /// 目标 APIC ID 或逻辑 ID
+  uint8_t id = 0;
+  /// true 为逻辑目标模式
+  bool logical = false;
+};
+
+/**
+ * @brief I/O APIC
+ * 通过 IOREGSEL/IOWIN 间接访问重定向表，每个引脚对应一个全局系统中断
+ * (GSI)，GSI = gsi_base + pin
+ * @see 82093AA I/O Advanced Programmable Interrupt Controller (IOAPIC)
+ * @note 地址为已映射的虚拟地址；IOREGSEL/IOWIN 为两步访问，
+ * 多核并发访问同一个 I/O APIC 时调用者需加锁
+ */
+class IoApic {
+ public:
+  /// 重定向表项配置
+  struct Route {
+    /// 中断向量
+    uint8_t vector = 0;
+    /// 投递目标
+    InterruptDestination destination{};
+    /// true 为电平触发，false 为边沿触发
+    bool level_triggered = false;
+    /// true 为低电平有效
+    bool active_low = false;
+    /// true 为屏蔽
+    bool masked = true;
+  };
+
+  /**
+   * @brief 构造函数
+   * @param base I/O APIC 寄存器基址，来自 ACPI MADT
+   * @param gsi_base 第一个引脚对应的 GSI，来自 ACPI MADT
+   */
+  explicit IoApic(uint64_t base, uint32_t gsi_base = 0)
+      : base_(base), gsi_base_(gsi_base) {}
+
+  /// @name 构造/析构函数
+  /// @{
+  IoApic() = delete;
+  IoApic(const IoApic &) = delete;
+  IoApic(IoApic &&) = delete;
+  auto operator=(const IoApic &) -> IoApic & = delete;
+  auto operator=(IoApic &&) -> IoApic & = delete;
+  ~IoApic() = default;
+  /// @}
+
+  /**
+   * @brief 获取 I/O APIC ID
+   * @return uint8_t I/O APIC ID
+   */
+  [[nodiscard]] auto GetId() const -> uint8_t {
+    return static_cast<uint8_t>((Read(kId) >> 24) & 0xF);
+  }
+
+  /**
+   * @brief 获取引脚数量
+   * @return size_t 重定向表项数
+   */
+  [[nodiscard]] auto GetPinCount() const -> size_t {
+    return ((Read(kVersion) >> 16) & 0xFF) + 1;
+  }
+
+  /**
+   * @brief 获取第一个引脚对应的 GSI
+   * @return uint32_t GSI 基址
+   */
+  [[nodiscard]] auto GetGsiBase() const -> uint32_t { return gsi_base_; }
+
+  /**
+   * @brief 检查 GSI 是否由本 I/O APIC 处理
+   * @param gsi 全局系统中断号
+   * @return true 由本 I/O APIC 处理
+   */
+  [[nodiscard]] auto HandlesGsi(uint32_t gsi) const -> bool {
+    return gsi >= gsi_base_ && gsi - gsi_base_ < GetPinCount();
+  }
+
+  /**
+   * @brief 写入重定向表项
+   * 先屏蔽原表项，再写高 32 位与低 32 位，避免中间状态被投递
+   * @param pin 引脚号
+   * @param route 表项配置
+   */
+  void SetRoute(size_t pin, const Route &route) const {
+    Write(GetEntryLow(pin), Read(GetEntryLow(pin)) | kMasked);
+    Write(GetEntryHigh(pin), static_cast<uint32_t>(route.destination.id)
+                                 << kDestinationShift);
+    uint32_t low = route.vector;
+    if (route.destination.logical) {
+      low |= kLogical;
+    }
+    if (route.active_low) {
+      low |= kActiveLow;
+    }
+    if (route.level_triggered) {
+      low |= kLevelTriggered;
+    }
+    if (route.masked) {
+      low |= kMasked;
+    }
+    Write(GetEntryLow(pin), low);
+  }
+
+  /**
+   * @brief 读取重定向表项
+   * @param pin 引脚号
+   * @return Route 表项配置
+   */
+  [[nodiscard]] auto GetRoute(size_t pin) const -> Route {
+    auto low = Read(GetEntryLow(pin));
+    auto high = Read(GetEntryHigh(pin));
+    Route route;
+    route.vector = static_cast<uint8_t>(low & 0xFF);
+    route.destination.id = static_cast<uint8_t>(high >> kDestinationShift);
+    route.destination.logical = (low & kLogical) != 0;
+    route.active_low = (low & kActiveLow) != 0;
+    route.level_triggered = (low & kLevelTriggered) != 0;
+    route.masked = (low & kMasked) != 0;
+    return route;
+  }
+
+  /**
+   * @brief 修改引脚的投递目标，其它配置不变
+   * @param pin 引脚号
+   * @param destination 投递目标
+   */
+  void SetAffinity(size_t pin, InterruptDestination destination) const {
+    auto route = GetRoute(pin);
+    route.destination = destination;
+    SetRoute(pin, route);
+  }
+
+  /**
+   * @brief 屏蔽引脚
+   * @param pin 引脚号
+   */
+  void Mask(size_t pin) const {
+    Write(GetEntryLow(pin), Read(GetEntryLow(pin)) | kMasked);
+  }
+
+  /**
+   * @brief 取消屏蔽引脚
+   * @param pin 引脚号
+   */
+  void Unmask(size_t pin) const {
+    Write(GetEntryLow(pin), Read(GetEntryLow(pin)) & ~kMasked);
+  }
+
+  /**
+   * @brief 屏蔽所有引脚
+   */
+  void MaskAll() const {
+    auto count = GetPinCount();
+    for (size_t pin = 0; pin < count; pin++) {
+      Mask(pin);
+    }
+  }
+
+ private:
+  /// IOREGSEL 偏移
+  static constexpr uint64_t kRegisterSelect = 0x00;
+  /// IOWIN 偏移
+  static constexpr uint64_t kWindow = 0x10;
+
+  /// I/O APIC ID 寄存器
+  static constexpr uint32_t kId = 0x00;
+  /// I/O APIC 版本寄存器
+  static constexpr uint32_t kVersion = 0x01;
+  /// 重定向表起始寄存器
+  static constexpr uint32_t kRedirectionTable = 0x10;
+
+  /// 逻辑目标模式
+  static constexpr uint32_t kLogical = 1U << 11;
+  /// 低电平有效
+  static constexpr uint32_t kActiveLow = 1U << 13;
+  /// 电平触发
+  static constexpr uint32_t kLevelTriggered = 1U << 15;
+  /// 屏蔽
+  static constexpr uint32_t kMasked = 1U << 16;
+  /// 目标字段在高 32 位中的偏移
+  static constexpr uint32_t kDestinationShift = 24;
+
+  /// 寄存器基址
+  uint64_t base_;
+  /// 第一个引脚对应的 GSI
+  uint32_t gsi_base_;
+
+  /**
+   * @brief 获取重定向表项低 32 位的寄存器号
+   * @param pin 引脚号
+   * @return uint32_t 寄存器号
+   */
+  static constexpr auto GetEntryLow(size_t pin) -> uint32_t {
+    return kRedirectionTable + static_cast<uint32_t>(pin) * 2;
+  }
+
+  /**
+   * @brief 获取重定向表项高 32 位的寄存器号
+   * @param pin 引脚号
+   * @return uint32_t 寄存器号
+   */
+  static constexpr auto GetEntryHigh(size_t pin) -> uint32_t {
+    return GetEntryLow(pin) + 1;
+  }
+
+  /**
+   * @brief 读取间接寄存器
+   * @param reg 寄存器号
+   * @return uint32_t 寄存器值
+   */
+  [[nodiscard]] auto Read(uint32_t reg) const -> uint32_t {
+    *reinterpret_cast<volatile uint32_t *>(base_ + kRegisterSelect) = reg;
+    return *reinterpret_cast<volatile uint32_t *>(base_ + kWindow);
+  }
+
+  /**
+   * @brief 写入间接寄存器
+   * @param reg 寄存器号
+   * @param value 寄存器值
+   */
+  void Write(uint32_t reg, uint32_t value) const {
+    *reinterpret_cast<volatile uint32_t *>(base_ + kRegisterSelect) = reg;
+    *reinterpret_cast<volatile uint32_t *>(base_ + kWindow) = value;
+  }
+};
+
+/**
+ * @brief MSI/MSI-X 消息组装
+ * @see Intel SDM Vol. 3A 11.11 Message Signalled Interrupts
+ */
+namespace msi {
+
+/// MSI 消息
+struct Message {
+  /// 写入 MSI 地址寄存器 (Message Address/Upper Address) 的值
+  uint64_t address;
+  /// 写入 MSI 数据寄存器 (Message Data) 的值
+  uint32_t data;
+};
+
+/// MSI 地址的固定高位
+static constexpr uint64_t kAddressBase = 0xFEE00000;
+/// 地址中的目标字段偏移
+static constexpr uint64_t kAddressDestinationShift = 12;
+/// 地址中的 Redirection Hint 位
+static constexpr uint64_t kAddressRedirectionHint = 1ULL << 3;
+/// 地址中的逻辑目标模式位
+static constexpr uint64_t kAddressLogical = 1ULL << 2;
+/// 数据中的最低优先级投递模式
+static constexpr uint32_t kDataLowestPriority = 1U << 8;
+
+/// MSI-X 表项大小
+static constexpr size_t kMsixEntrySize = 16;
+/// MSI-X 表项 Vector Control 中的屏蔽位
+static constexpr uint32_t kMsixVectorMasked = 1U << 0;
+
+/**
+ * @brief 组装固定投递模式、边沿触发的 MSI 消息
+ * @param destination 投递目标
+ * @param vector 中断向量
+ * @return Message MSI 消息
+ * @note RH 为 0 时硬件忽略 DM 位并按物理目标投递，
+ * 因此逻辑目标同时置位 RH 与 DM
+ */
+static constexpr auto Compose(InterruptDestination destination,
+                              uint8_t vector) -> Message {
+  auto address =
+      kAddressBase | (static_cast<uint64_t>(destination.id)
+                      << kAddressDestinationShift);
+  if (destination.logical) {
+    address |= kAddressRedirectionHint | kAddressLogical;
+  }
+  return {address, vector};
+}
+
+static_assert(Compose({1, false}, 0x40).address == 0xFEE01000);
+static_assert(Compose({1, true}, 0x40).address == 0xFEE0100C);
+static_assert(Compose({3, false}, 0x40).address == 0xFEE03000);
+static_assert(Compose({3, false}, 0x40).data == 0x40);
+
+/**
+ * @brief 组装最低优先级投递的 MSI 消息，由硬件在逻辑目标中选择核心
+ * @param logical_id xAPIC 逻辑目标
+ * @param vector 中断向量
+ * @return Message MSI 消息
+ */
+static constexpr auto ComposeLowestPriority(uint8_t logical_id, uint8_t vector)
+    -> Message {
+  auto message = Compose({logical_id, true}, vector);
+  message.data |= kDataLowestPriority;
+  return message;
+}
+
+/**
+ * @brief 写入 MSI-X 表项
+ * 先屏蔽表项，再写入地址与数据，最后按 masked 恢复 Vector Control
+ * @param table MSI-X 表的虚拟地址 (BAR + Table Offset)
+ * @param index 表项下标
+ * @param message MSI 消息
+ * @param masked 写入后是否保持屏蔽
+ */
+static __always_inline void WriteMsixEntry(uint64_t table, size_t index,
+                                           const Message &message,
+                                           bool masked = false) {
+  auto entry = reinterpret_cast<volatile uint32_t *>(table +
+                                                     index * kMsixEntrySize);
+  entry[3] = entry[3] | kMsixVectorMasked;
+  entry[0] = static_cast<uint32_t>(message.address);
+  entry[1] = static_cast<uint32_t>(message.address >> 32);
+  entry[2] = message.data;
+  entry[3] = masked ? (entry[3] | kMsixVectorMasked)
+                    : (entry[3] & ~kMsixVectorMasked);
+}
+
+/**
+ * @brief 屏蔽或取消屏蔽 MSI-X 表项
+ * @param table MSI-X 表的虚拟地址
+ * @param index 表项下标
+ * @param masked true 为屏蔽
+ */
+static __always_inline void SetMsixMasked(uint64_t table, size_t index,
+                                          bool masked) {
+  auto entry = reinterpret_cast<volatile uint32_t *>(table +
+                                                     index * kMsixEntrySize);
+  entry[3] = masked ? (entry[3] | kMsixVectorMasked)
+                    : (entry[3] & ~kMsixVectorMasked);
+}
+
+}  // namespace msi
+
+}  // namespace cpu_io
+
+#endif  // CPU_IO_INCLUDE_X86_64_IOAPIC_HPP_
@@ -0,0 +1,291 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_X86_64_LBR_HPP_
+#define CPU_IO_INCLUDE_X86_64_LBR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cpuid.hpp"
+#include "msr.h"
+#include "regs.hpp"
+
+namespace cpu_io {
+/**
+ * @brief 最近分支记录 (LBR)
+ * 支持架构 LBR 与 Nehalem 之后大核上的传统 LBR (格式 3 及以上)。
+ * 记录只在当前核心上有效，需在每个核心上分别 Init()/Enable()
+ * @see sdm.pdf#18.1 Last Branch Records
+ */
+namespace lbr {
+
+/// 记录用户态 (CPL > 0) 的分支
+static constexpr uint32_t kUser = 1U << 0;
+/// 记录内核态 (CPL 0) 的分支
+static constexpr uint32_t kKernel = 1U << 1;
+/// 性能计数器溢出中断 (PMI) 时冻结记录，处理后需 Unfreeze()
+static constexpr uint32_t kFreezeOnPmi = 1U << 2;
+
+/**
+ * @brief LBR 能力
+ */
+struct Info {
+  /// 是否为架构 LBR
+  bool arch;
+  /// 传统 LBR 的格式 (IA32_PERF_CAPABILITIES[5:0])
+  uint8_t format;
+  /// 记录深度，0 表示不支持
+  uint8_t depth;
+};
+
+/**
+ * @brief 一条分支记录
+ */
+struct Entry {
+  /// 分支指令地址
+  uint64_t from;
+  /// 分支目标地址
+  uint64_t to;
+  /// 与上一条记录之间的周期数，不支持时为 0
+  uint16_t cycles;
+  /// 分支是否预测错误
+  bool mispredicted;
+};
+
+namespace detail {
+/// Init() 读取的能力
+inline Info info{};
+
+/// IA32_DEBUGCTL 位
+static constexpr uint64_t kDebugCtlLbr = 1ULL << 0;
+static constexpr uint64_t kDebugCtlFreezeLbrsOnPmi = 1ULL << 11;
+
+/// MSR_LBR_SELECT 位，置位表示不记录
+static constexpr uint64_t kSelectCplEq0 = 1ULL << 0;
+static constexpr uint64_t kSelectCplNeq0 = 1ULL << 1;
+
+/// IA32_LBR_CTL 位
+static constexpr uint64_t kCtlLbrEn = 1ULL << 0;
+static constexpr uint64_t kCtlOs = 1ULL << 1;
+static constexpr uint64_t kCtlUsr = 1ULL << 2;
+/// JCC、间接/相对 JMP、间接/相对 CALL、RET 与其它分支
+static constexpr uint64_t kCtlAllBranches = 0x7FULL << 16;
+
+/// LBR_INFO 位
+static constexpr uint64_t kInfoMispred = 1ULL << 63;
+static constexpr uint64_t kInfoCycleCount = 0xFFFF;
+
+/// IA32_PERF_GLOBAL_STATUS 中的 LBR 冻结位
+static constexpr uint64_t kGlobalLbrFrozen = 1ULL << 58;
+
+/// 传统 LBR 格式
+static constexpr uint8_t kFormatEipFlags = 3;
+static constexpr uint8_t kFormatEipFlagsTsx = 4;
+/// Skylake 起预测错误与周期数在 MSR_LBR_INFO_x 中，From 只是符号扩展的地址
+static constexpr uint8_t kFormatInfo = 5;
+
+/**
+ * @brief 去掉传统 LBR 的 From 中的标志位并符号扩展
+ * @param from MSR_LASTBRANCH_x_FROM_IP 的值
+ * @return uint64_t 分支指令地址
+ */
+static __always_inline auto LegacyFromIp(uint64_t from) -> uint64_t {
+  // 格式 3 在 [63] 保存预测错误标志，格式 4 在 [62:61] 还有 TSX 标志，
+  // 格式 5 及以上的 From 已是符号扩展的地址
+  if (info.format >= kFormatInfo) {
+    return from;
+  }
+  auto shift = (info.format == kFormatEipFlagsTsx) ? 3 : 1;
+  return static_cast<uint64_t>(static_cast<int64_t>(from << shift) >> shift);
+}
+
+/**
+ * @brief 停止记录
+ * @return uint64_t 停止前的控制寄存器的值，用于 Restore()
+ */
+static __always_inline auto Suspend() -> uint64_t {
+  if (info.arch) {
+    auto ctl = cpu_io::detail::regs::Msr::Read(msr::kIa32LbrCtl);
+    cpu_io::detail::regs::Msr::Write(msr::kIa32LbrCtl, ctl & ~kCtlLbrEn);
+    return ctl;
+  }
+  auto debug_ctl = cpu_io::detail::regs::Msr::Read(msr::kIa32DebugCtl);
+  cpu_io::detail::regs::Msr::Write(msr::kIa32DebugCtl,
+                                   debug_ctl & ~kDebugCtlLbr);
+  return debug_ctl;
+}
+
+/**
+ * @brief 恢复 Suspend() 之前的记录状态
+ * @param value Suspend() 的返回值
+ */
+static __always_inline void Restore(uint64_t value) {
+  cpu_io::detail::regs::Msr::Write(
+      info.arch ? msr::kIa32LbrCtl : msr::kIa32DebugCtl, value);
+}
+}  // namespace detail
+
+/**
+ * @brief 检测 LBR，架构 LBR 的深度设为最大值
+ * @param depth 传统 LBR 的深度，0 表示按格式推断 (格式 5 及以上为 32，否则为
+ * 16)；无法推断的核心 (如 Atom) 需传入正确的值
+ * @return Info LBR 能力
+ */
+static __always_inline auto Init(uint8_t depth = 0) -> Info {
+  Info info{};
+  const auto &features = cpuid::GetCpuFeatures();
+  if (features.HasArchLbr() &&
+      features.max_basic_leaf >= cpuid::detail::leaf::kArchLbr) {
+    // EAX[7:0] 的第 n 位表示支持深度 8 * (n + 1)
+    auto depths =
+        cpuid::detail::ExecuteCpuid(cpuid::detail::leaf::kArchLbr, 0).eax &
+        0xFF;
+    if (depths != 0) {
+      info.arch = true;
+      info.depth = 8 * (32 - __builtin_clz(depths));
+      cpu_io::detail::regs::Msr::Write(msr::kIa32LbrCtl, 0);
+      cpu_io::detail::regs::Msr::Write(msr::kIa32LbrDepth, info.depth);
+    }
+  } else if (features.HasPdcm()) {
+    info.format =
+        cpu_io::detail::regs::Msr::Read(msr::kIa32PerfCapabilities) & 0x3F;
+    if (depth != 0) {
+      info.depth = depth;
+    } else if (info.format >= detail::kFormatInfo) {
+      info.depth = 32;
+    } else if (info.format >= detail::kFormatEipFlags) {
+      info.depth = 16;
+    }
+  }
+  detail::info = info;
+  return info;
+}
+
+/**
+ * @brief 获取 Init() 读取的能力
+ * @return const Info& LBR 能力
+ */
+static __always_inline auto GetInfo() -> const Info & { return detail::info; }
+
+/**
+ * @brief 开始记录
+ * @param flags kUser/kKernel/kFreezeOnPmi 的组合
+ */
+static __always_inline void Enable(uint32_t flags) {
+  if (detail::info.depth == 0) {
+    return;
+  }
+  auto debug_ctl = cpu_io::detail::regs::Msr::Read(msr::kIa32DebugCtl) &
+                   ~detail::kDebugCtlFreezeLbrsOnPmi;
+  if (flags & kFreezeOnPmi) {
+    debug_ctl |= detail::kDebugCtlFreezeLbrsOnPmi;
+  }
+  if (detail::info.arch) {
+    uint64_t ctl = detail::kCtlLbrEn | detail::kCtlAllBranches;
+    if (flags & kUser) {
+      ctl |= detail::kCtlUsr;
+    }
+    if (flags & kKernel) {
+      ctl |= detail::kCtlOs;
+    }
+    cpu_io::detail::regs::Msr::Write(msr::kIa32DebugCtl, debug_ctl);
+    cpu_io::detail::regs::Msr::Write(msr::kIa32LbrCtl, ctl);
+    return;
+  }
+  uint64_t select = 0;
+  if ((flags & kUser) == 0) {
+    select |= detail::kSelectCplNeq0;
+  }
+  if ((flags & kKernel) == 0) {
+    select |= detail::kSelectCplEq0;
+  }
+  cpu_io::detail::regs::Msr::Write(msr::kLbrSelect, select);
+  cpu_io::detail::regs::Msr::Write(msr::kIa32DebugCtl,
+                                   debug_ctl | detail::kDebugCtlLbr);
+}
+
+/**
+ * @brief 停止记录，已有的记录保持不变
+ */
+static __always_inline void Disable() {
+  if (detail::info.depth == 0) {
+    return;
+  }
+  detail::Suspend();
+}
+
+/**
+ * @brief 解除 PMI 造成的冻结，继续记录
+ */
+static __always_inline void Unfreeze() {
+  cpu_io::detail::regs::Msr::Write(msr::kIa32PerfGlobalOvfCtrl,
+                                   detail::kGlobalLbrFrozen);
+}
+
+/**
+ * @brief 复制当前的记录，从最新的一条开始
+ * 复制期间暂停记录，避免记录复制过程本身的分支
+ * @param entries 输出缓冲区
+ * @param count 缓冲区可容纳的记录数
+ * @return size_t 复制的记录数
+ */
+static __always_inline auto Snapshot(Entry *entries, size_t count) -> size_t {
+  const auto &info = detail::info;
+  if (info.depth == 0) {
+    return 0;
+  }
+  if (count > info.depth) {
+    count = info.depth;
+  }
+  auto saved = detail::Suspend();
+  size_t copied = 0;
+  if (info.arch) {
+    // 架构 LBR 的第 0 项总是最新的，未使用的项为 0
+    for (size_t i = 0; i < count; i++) {
+      auto from = cpu_io::detail::regs::Msr::Read(msr::kIa32LbrFromIp0 + i);
+      if (from == 0) {
+        break;
+      }
+      auto branch_info =
+          cpu_io::detail::regs::Msr::Read(msr::kIa32LbrInfo0 + i);
+      entries[copied++] = {
+          from, cpu_io::detail::regs::Msr::Read(msr::kIa32LbrToIp0 + i),
+          static_cast<uint16_t>(branch_info & detail::kInfoCycleCount),
+          (branch_info & detail::kInfoMispred) != 0};
+    }
+  } else {
+    // 传统 LBR 是环形缓冲区，TOS 指向最新的一项
+    auto tos = cpu_io::detail::regs::Msr::Read(msr::kLastBranchTos);
+    for (size_t i = 0; i < count; i++) {
+      auto index = (tos - i) & (info.depth - 1);
+      auto from =
+          cpu_io::detail::regs::Msr::Read(msr::kLastBranchFrom0 + index);
+      if (from == 0) {
+        break;
+      }
+      Entry entry{detail::LegacyFromIp(from),
+                  cpu_io::detail::regs::Msr::Read(msr::kLastBranchTo0 + index),
+                  0, false};
+      if (info.format < detail::kFormatInfo) {
+        // 格式 3/4 的预测错误标志在 From[63]
+        entry.mispredicted = (from & detail::kInfoMispred) != 0;
+      } else {
+        auto branch_info =
+            cpu_io::detail::regs::Msr::Read(msr::kLbrInfo0 + index);
+        entry.cycles =
+            static_cast<uint16_t>(branch_info & detail::kInfoCycleCount);
+        entry.mispredicted = (branch_info & detail::kInfoMispred) != 0;
+      }
+      entries[copied++] = entry;
+    }
+  }
+  detail::Restore(saved);
+  return copied;
+}
+
+}  // namespace lbr
+}  // namespace cpu_io
+
+#endif  // CPU_IO_INCLUDE_X86_64_LBR_HPP_
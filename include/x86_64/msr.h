@@ -32,6 +32,8 @@ static constexpr uint32_t kIa32FsBase = 0xC0000100;
 static constexpr uint32_t kIa32GsBase = 0xC0000101;
 /// SwapGS GS shadow
 static constexpr uint32_t kIa32KernelGsBase = 0xC0000102;
+/// RDTSCP/RDPID 返回的辅助值
+static constexpr uint32_t kIa32TscAux = 0xC0000103;
 
 /// 基本 MSR
 
@@ -43,8 +45,12 @@ static constexpr uint32_t kIa32ApicBase = 0x0000001B;
 static constexpr uint32_t kIa32FeatureControl = 0x0000003A;
 /// Time Stamp Counter
 static constexpr uint32_t kIa32Tsc = 0x00000010;
+/// TSC-deadline 模式的到期时间
+static constexpr uint32_t kIa32TscDeadline = 0x000006E0;
 /// Misc Enable
 static constexpr uint32_t kIa32MiscEnable = 0x000001A0;
+/// XSAVES/XRSTORS 管理的管理态状态组件
+static constexpr uint32_t kIa32Xss = 0x00000DA0;
 
 /// 性能监控相关 MSR
 
@@ -54,6 +60,16 @@ static constexpr uint32_t kIa32PerfGlobalCtrl = 0x0000038F;
 static constexpr uint32_t kIa32PerfGlobalStatus = 0x0000038E;
 /// Performance Global Overflow Control
 static constexpr uint32_t kIa32PerfGlobalOvfCtrl = 0x00000390;
+/// Performance Event Select 0，其余计数器的地址依次加 1
+static constexpr uint32_t kIa32PerfEvtSel0 = 0x00000186;
+/// General Performance Counter 0，其余计数器的地址依次加 1
+static constexpr uint32_t kIa32Pmc0 = 0x000000C1;
+/// Fixed-Function Performance Counter 0，其余计数器的地址依次加 1
+static constexpr uint32_t kIa32FixedCtr0 = 0x00000309;
+/// Fixed-Function Performance Counter Control
+static constexpr uint32_t kIa32FixedCtrCtrl = 0x0000038D;
+/// Performance Capabilities，需要 CPUID.01H:ECX.PDCM
+static constexpr uint32_t kIa32PerfCapabilities = 0x00000345;
 
 /// 内存类型范围寄存器 (MTRR)
 
@@ -61,10 +77,12 @@ static constexpr uint32_t kIa32PerfGlobalOvfCtrl = 0x00000390;
 static constexpr uint32_t kIa32MtrrCap = 0x000000FE;
 /// MTRR Default Type
 static constexpr uint32_t kIa32MtrrDefType = 0x000002FF;
-/// MTRR Physical Base 0
+/// MTRR Physical Base 0，其余范围的地址依次加 2
 static constexpr uint32_t kIa32MtrrPhysBase0 = 0x00000200;
-/// MTRR Physical Mask 0
+/// MTRR Physical Mask 0，其余范围的地址依次加 2
 static constexpr uint32_t kIa32MtrrPhysMask0 = 0x00000201;
+/// Page Attribute Table
+static constexpr uint32_t kIa32Pat = 0x00000277;
 
 /// 调试相关 MSR
 
@@ -75,6 +93,30 @@ static constexpr uint32_t kIa32LastBranchFromIp = 0x000001DB;
 /// Last Branch To IP
 static constexpr uint32_t kIa32LastBranchToIp = 0x000001DC;
 
+/// 传统 LBR (Nehalem 及之后的大核)，其余表项的地址依次加 1
+/// LBR Select
+static constexpr uint32_t kLbrSelect = 0x000001C8;
+/// Last Branch Record Stack TOS
+static constexpr uint32_t kLastBranchTos = 0x000001C9;
+/// Last Branch Record 0 From IP
+static constexpr uint32_t kLastBranchFrom0 = 0x00000680;
+/// Last Branch Record 0 To IP
+static constexpr uint32_t kLastBranchTo0 = 0x000006C0;
+/// Last Branch Record 0 Additional Information (LBR 格式 5 及以上)
+static constexpr uint32_t kLbrInfo0 = 0x00000DC0;
+
+/// 架构 LBR，其余表项的地址依次加 1
+/// Last Branch Record Enabling and Configuration Control
+static constexpr uint32_t kIa32LbrCtl = 0x000014CE;
+/// Last Branch Record Maximum Stack Depth
+static constexpr uint32_t kIa32LbrDepth = 0x000014CF;
+/// Last Branch Record 0 Source IP
+static constexpr uint32_t kIa32LbrFromIp0 = 0x00001500;
+/// Last Branch Record 0 Destination IP
+static constexpr uint32_t kIa32LbrToIp0 = 0x00001600;
+/// Last Branch Record 0 Additional Information
+static constexpr uint32_t kIa32LbrInfo0 = 0x00001200;
+
 /**
  * @brief APIC 相关 MSR 专用命名空间
  */
@@ -91,12 +133,16 @@ static constexpr uint32_t kVersion = 0x803;
 static constexpr uint32_t kTpr = 0x808;
 /// End of Interrupt Register
 static constexpr uint32_t kEoi = 0x80B;
+/// Logical Destination Register
+static constexpr uint32_t kLdr = 0x80D;
 /// Spurious Interrupt Vector Register
 static constexpr uint32_t kSivr = 0x80F;
 /// Interrupt Command Register
 static constexpr uint32_t kIcr = 0x830;
 /// LVT Timer Register
 static constexpr uint32_t kLvtTimer = 0x832;
+/// LVT Performance Monitoring Counters Register
+static constexpr uint32_t kLvtPmc = 0x834;
 /// LVT LINT0 Register
 static constexpr uint32_t kLvtLint0 = 0x835;
 /// LVT LINT1 Register
@@ -109,6 +155,8 @@ static constexpr uint32_t kTimerInitCount = 0x838;
 static constexpr uint32_t kTimerCurrCount = 0x839;
 /// Timer Divide Configuration Register
 static constexpr uint32_t kTimerDivide = 0x83E;
+/// SELF IPI Register
+static constexpr uint32_t kSelfIpi = 0x83F;
 
 /// APIC Base MSR 位域定义
 namespace base {
@@ -122,6 +170,50 @@ static constexpr uint64_t kX2ApicEnableBit = 1ULL << 10;
 static constexpr uint64_t kBaseMask = 0xFFFFF000ULL;
 
 }  // namespace base
+
+/// LVT Timer 寄存器位域定义
+namespace lvt_timer {
+/// 中断向量掩码
+static constexpr uint32_t kVectorMask = 0xFF;
+/// 屏蔽位
+static constexpr uint32_t kMasked = 1U << 16;
+/// 单次模式
+static constexpr uint32_t kOneShot = 0U << 17;
+/// 周期模式
+static constexpr uint32_t kPeriodic = 1U << 17;
+/// TSC-deadline 模式
+static constexpr uint32_t kTscDeadline = 2U << 17;
+}  // namespace lvt_timer
+
+/// Timer Divide Configuration 寄存器取值
+namespace timer_divide {
+/// 1 分频
+static constexpr uint32_t kDivideBy1 = 0xB;
+/// 16 分频
+static constexpr uint32_t kDivideBy16 = 0x3;
+}  // namespace timer_divide
+
+/// x2APIC ICR 位域定义
+namespace icr {
+/// 固定投递模式
+static constexpr uint64_t kDeliveryFixed = 0ULL << 8;
+/// INIT 投递模式
+static constexpr uint64_t kDeliveryInit = 5ULL << 8;
+/// 启动 (SIPI) 投递模式，向量为入口物理页号
+static constexpr uint64_t kDeliveryStartup = 6ULL << 8;
+/// 逻辑目标模式
+static constexpr uint64_t kLogical = 1ULL << 11;
+/// 电平有效
+static constexpr uint64_t kAssert = 1ULL << 14;
+/// 目标简写：自身
+static constexpr uint64_t kShorthandSelf = 1ULL << 18;
+/// 目标简写：包括自身在内的所有核心
+static constexpr uint64_t kShorthandAll = 2ULL << 18;
+/// 目标简写：除自身外的所有核心
+static constexpr uint64_t kShorthandAllButSelf = 3ULL << 18;
+/// 目标字段偏移
+static constexpr uint64_t kDestinationShift = 32;
+}  // namespace icr
 }  // namespace apic
 }  // namespace msr
 }  // namespace cpu_io
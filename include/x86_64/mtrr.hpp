@@ -0,0 +1,213 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_X86_64_MTRR_HPP_
+#define CPU_IO_INCLUDE_X86_64_MTRR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "cpuid.hpp"
+#include "msr.h"
+#include "regs.hpp"
+#include "virtual_memory.hpp"
+
+namespace cpu_io {
+/**
+ * @brief 内存类型范围寄存器 (可变范围 MTRR)
+ * 固件通常已经设置好内存与 MMIO 的类型，这里用于枚举与追加范围，
+ * 如将帧缓冲设为写合并。修改需在每个核心上以相同的值进行
+ * @see sdm.pdf#11.11 Memory Type Range Registers (MTRRs)
+ */
+namespace mtrr {
+
+/// MTRR 内存类型编码
+static constexpr uint8_t kUncached = 0x00;
+static constexpr uint8_t kWriteCombining = 0x01;
+static constexpr uint8_t kWriteThrough = 0x04;
+static constexpr uint8_t kWriteProtect = 0x05;
+static constexpr uint8_t kWriteBack = 0x06;
+
+/**
+ * @brief MTRR 能力
+ */
+struct Info {
+  /// 可变范围的数量，0 表示不支持 MTRR
+  uint8_t variable_ranges;
+  /// 是否支持固定范围 (1MB 以下)
+  bool fixed_ranges;
+  /// 是否支持写合并类型
+  bool write_combining;
+  /// 物理地址位数，决定 PhysMask 的有效位
+  uint8_t physical_address_bits;
+};
+
+/**
+ * @brief 一个可变范围
+ */
+struct Range {
+  /// 物理基地址
+  uint64_t base;
+  /// 大小，0 表示该范围未使用
+  uint64_t size;
+  /// 内存类型
+  uint8_t type;
+};
+
+namespace detail {
+/// IA32_MTRRCAP 位
+static constexpr uint64_t kCapVcntMask = 0xFF;
+static constexpr uint64_t kCapFix = 1ULL << 8;
+static constexpr uint64_t kCapWc = 1ULL << 10;
+
+/// IA32_MTRR_DEF_TYPE 位
+static constexpr uint64_t kDefTypeMask = 0xFF;
+static constexpr uint64_t kDefTypeEnable = 1ULL << 11;
+
+/// IA32_MTRR_PHYSBASEn/PHYSMASKn 位
+static constexpr uint64_t kBaseTypeMask = 0xFF;
+static constexpr uint64_t kMaskValid = 1ULL << 11;
+static constexpr uint64_t kAddressMask = ~0xFFFULL;
+
+/// 最小的范围大小
+static constexpr uint64_t kMinSize = 4096;
+/// CPUID.80000008H 不可用时假定的物理地址位数
+static constexpr uint8_t kDefaultPhysicalAddressBits = 36;
+
+/**
+ * @brief 物理地址范围的掩码
+ * @param bits 物理地址位数
+ * @return uint64_t 低 bits 位全为 1
+ */
+static constexpr auto PhysicalMask(uint8_t bits) -> uint64_t {
+  return (1ULL << bits) - 1;
+}
+
+/**
+ * @brief 写入一个可变范围的寄存器
+ * @param index 范围编号
+ * @param base IA32_MTRR_PHYSBASEn 的值
+ * @param mask IA32_MTRR_PHYSMASKn 的值
+ */
+static __always_inline void WriteRange(size_t index, uint64_t base,
+                                       uint64_t mask) {
+  auto cr4 = cpu_io::detail::cache::Disable();
+  auto def_type = cpu_io::detail::regs::Msr::Read(msr::kIa32MtrrDefType);
+  cpu_io::detail::regs::Msr::Write(msr::kIa32MtrrDefType,
+                                   def_type & ~kDefTypeEnable);
+  cpu_io::detail::regs::Msr::Write(msr::kIa32MtrrPhysBase0 + 2 * index, base);
+  cpu_io::detail::regs::Msr::Write(msr::kIa32MtrrPhysMask0 + 2 * index, mask);
+  cpu_io::detail::regs::Msr::Write(msr::kIa32MtrrDefType, def_type);
+  cpu_io::detail::cache::Enable(cr4);
+}
+}  // namespace detail
+
+/**
+ * @brief 读取 MTRR 能力
+ * @return Info MTRR 能力
+ */
+static __always_inline auto GetInfo() -> Info {
+  Info info{};
+  const auto &features = cpuid::GetCpuFeatures();
+  info.physical_address_bits = detail::kDefaultPhysicalAddressBits;
+  if (features.max_extended_leaf >= cpuid::detail::leaf::kAddressSize) {
+    info.physical_address_bits =
+        cpuid::detail::ExecuteCpuid(cpuid::detail::leaf::kAddressSize).eax &
+        0xFF;
+  }
+  if (!features.HasMtrr()) {
+    return info;
+  }
+  auto cap = cpu_io::detail::regs::Msr::Read(msr::kIa32MtrrCap);
+  info.variable_ranges = cap & detail::kCapVcntMask;
+  info.fixed_ranges = (cap & detail::kCapFix) != 0;
+  info.write_combining = (cap & detail::kCapWc) != 0;
+  return info;
+}
+
+/**
+ * @brief 获取未被任何范围覆盖的内存的类型
+ * @return uint8_t 内存类型
+ */
+static __always_inline auto GetDefaultType() -> uint8_t {
+  return cpu_io::detail::regs::Msr::Read(msr::kIa32MtrrDefType) &
+         detail::kDefTypeMask;
+}
+
+/**
+ * @brief 读取一个可变范围
+ * @param index 范围编号，小于 Info::variable_ranges
+ * @return Range 范围，未使用时 size 为 0
+ */
+static __always_inline auto ReadRange(size_t index) -> Range {
+  auto mask =
+      cpu_io::detail::regs::Msr::Read(msr::kIa32MtrrPhysMask0 + 2 * index);
+  if ((mask & detail::kMaskValid) == 0) {
+    return {0, 0, 0};
+  }
+  auto base =
+      cpu_io::detail::regs::Msr::Read(msr::kIa32MtrrPhysBase0 + 2 * index);
+  auto physical_mask = detail::PhysicalMask(GetInfo().physical_address_bits);
+  // 范围大小为 PhysMask 中最低的置位
+  auto address_mask = mask & detail::kAddressMask & physical_mask;
+  return {base & detail::kAddressMask & physical_mask,
+          address_mask & (~address_mask + 1),
+          static_cast<uint8_t>(base & detail::kBaseTypeMask)};
+}
+
+/**
+ * @brief 查找未使用的可变范围
+ * @return std::optional<size_t> 范围编号，没有空闲范围时为空
+ */
+static __always_inline auto FindFreeRange() -> std::optional<size_t> {
+  auto count = GetInfo().variable_ranges;
+  for (size_t i = 0; i < count; i++) {
+    if ((cpu_io::detail::regs::Msr::Read(msr::kIa32MtrrPhysMask0 + 2 * i) &
+         detail::kMaskValid) == 0) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+/**
+ * @brief 设置一个可变范围
+ * @param index 范围编号，小于 Info::variable_ranges
+ * @param base 物理基地址，需按 size 对齐
+ * @param size 大小，需为 2 的幂且不小于 4KB
+ * @param type 内存类型
+ * @return true 成功
+ * @return false 参数不满足要求
+ * @pre 已关闭中断；其它核心需同时以相同的值调用
+ */
+static __always_inline auto SetRange(size_t index, uint64_t base,
+                                     uint64_t size, uint8_t type) -> bool {
+  auto info = GetInfo();
+  if (index >= info.variable_ranges || size < detail::kMinSize ||
+      (size & (size - 1)) != 0 || (base & (size - 1)) != 0) {
+    return false;
+  }
+  if (type == kWriteCombining && !info.write_combining) {
+    return false;
+  }
+  auto physical_mask = detail::PhysicalMask(info.physical_address_bits);
+  detail::WriteRange(index, (base & physical_mask) | type,
+                     (~(size - 1) & physical_mask) | detail::kMaskValid);
+  return true;
+}
+
+/**
+ * @brief 清除一个可变范围
+ * @param index 范围编号
+ * @pre 同 SetRange()
+ */
+static __always_inline void ClearRange(size_t index) {
+  detail::WriteRange(index, 0, 0);
+}
+
+}  // namespace mtrr
+}  // namespace cpu_io
+
+#endif  // CPU_IO_INCLUDE_X86_64_MTRR_HPP_
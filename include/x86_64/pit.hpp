@@ -45,22 +45,76 @@ class Pit {
 
   /**
    * 计数器更新
+   * @note 原子操作，可在任意核心的中断处理中调用
    */
-  void Ticks() { ticks_ += 1; }
+  void Ticks() { __atomic_fetch_add(&ticks_, 1, __ATOMIC_RELAXED); }
 
   /**
    * 获取时钟中断次数
-   * @return size_t 时钟中断次数
+   * @return size_t 时钟中断次数，不会读到撕裂的值
    */
-  [[nodiscard]] auto GetTicks() const -> size_t { return ticks_; }
+  [[nodiscard]] auto GetTicks() const -> size_t {
+    return __atomic_load_n(&ticks_, __ATOMIC_RELAXED);
+  }
+
+  /**
+   * 以模式 0 启动通道 2 单次计数，不产生中断，用于校准其它时钟源
+   * @param count 计数初值，计数到 0 时通道 2 输出变为高电平
+   */
+  static void StartChannel2OneShot(uint16_t count) {
+    // 打开通道 2 门控，关闭扬声器输出
+    Out<uint8_t>(kChannel2Control,
+                 (In<uint8_t>(kChannel2Control) & ~kSpeakerEnable) |
+                     kChannel2Gate);
+    Out<uint8_t>(kCommand, static_cast<uint8_t>(kChannel2) |
+                               static_cast<uint8_t>(kHighAndLow) |
+                               static_cast<uint8_t>(kInterruptOnTerminalCount));
+    Out<uint8_t>(kChannel2Data, count & 0xFF);
+    Out<uint8_t>(kChannel2Data, count >> 8);
+  }
+
+  /**
+   * 通道 2 单次计数是否已结束
+   * @return true 计数已到 0
+   */
+  [[nodiscard]] static auto IsChannel2Expired() -> bool {
+    return (In<uint8_t>(kChannel2Control) & kChannel2Output) != 0;
+  }
+
+  /**
+   * 计算通道 2 单次计数的初值
+   * @param ms 计数时长 (毫秒)，超出 [1, kMaxOneShotMs] 时取最近的边界
+   * @return uint16_t 计数初值，不为 0
+   */
+  [[nodiscard]] static constexpr auto OneShotCount(uint32_t ms) -> uint16_t {
+    if (ms < 1) {
+      ms = 1;
+    } else if (ms > kMaxOneShotMs) {
+      ms = kMaxOneShotMs;
+    }
+    return static_cast<uint16_t>(kMaxFrequency * ms / 1000);
+  }
 
- private:
   /// 最大频率
   static constexpr size_t kMaxFrequency = 1193180;
+  /// 单次计数的最长时长 (毫秒)，更长的时长超出 16 位计数初值
+  static constexpr uint32_t kMaxOneShotMs = 54;
+
+ private:
   /// 通道 0 数据端口
   static constexpr size_t kChannel0Data = 0x40;
+  /// 通道 2 数据端口
+  static constexpr size_t kChannel2Data = 0x42;
   /// 模式/命令端口
   static constexpr size_t kCommand = 0x43;
+  /// 通道 2 门控与状态端口 (NMI Status and Control)
+  static constexpr size_t kChannel2Control = 0x61;
+  /// 通道 2 门控位
+  static constexpr uint8_t kChannel2Gate = 1U << 0;
+  /// 扬声器输出使能位
+  static constexpr uint8_t kSpeakerEnable = 1U << 1;
+  /// 通道 2 输出状态位
+  static constexpr uint8_t kChannel2Output = 1U << 5;
 
   /**
    * Bits         Usage
@@ -113,8 +167,8 @@ class Pit {
     kHardwareTriggeredStrobe = 0xA,
   };
 
-  /// 计数器
-  volatile size_t ticks_ = 0;
+  /// 计数器，只通过 __atomic 内建函数访问
+  size_t ticks_ = 0;
 };
 
 }  // namespace cpu_io
@@ -0,0 +1,285 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#ifndef CPU_IO_INCLUDE_X86_64_PMU_HPP_
+#define CPU_IO_INCLUDE_X86_64_PMU_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "apic.hpp"
+#include "cpuid.hpp"
+#include "msr.h"
+#include "regs.hpp"
+
+namespace cpu_io {
+/**
+ * @brief 性能监控计数器 (Intel 架构性能监控)
+ * 通用计数器 i 对应计数器掩码的第 i 位，
+ * 固定计数器 i 对应 FixedCounterBit(i)
+ * @see sdm.pdf#20
+ */
+namespace pmu {
+
+/// 统计用户态
+static constexpr uint32_t kUser = 1U << 0;
+/// 统计内核态
+static constexpr uint32_t kKernel = 1U << 1;
+/// 溢出时产生中断
+static constexpr uint32_t kInterrupt = 1U << 2;
+
+/**
+ * @brief 架构事件，低 8 位为事件号，[15:8] 为 umask
+ */
+namespace event {
+/// 未停机的核心周期
+static constexpr uint64_t kCpuCycles = 0x003C;
+/// 退休的指令
+static constexpr uint64_t kInstructions = 0x00C0;
+/// 末级缓存访问
+static constexpr uint64_t kCacheReferences = 0x4F2E;
+/// 末级缓存缺失
+static constexpr uint64_t kCacheMisses = 0x412E;
+/// 退休的分支指令
+static constexpr uint64_t kBranchInstructions = 0x00C4;
+/// 预测错误的分支指令
+static constexpr uint64_t kBranchMisses = 0x00C5;
+}  // namespace event
+
+/// 固定计数器 0：退休的指令
+static constexpr size_t kFixedInstructions = 0;
+/// 固定计数器 1：未停机的核心周期
+static constexpr size_t kFixedCycles = 1;
+/// 固定计数器 2：未停机的参考周期
+static constexpr size_t kFixedRefCycles = 2;
+
+/**
+ * @brief 性能监控能力
+ */
+struct Info {
+  /// 架构性能监控版本，0 表示不支持
+  uint8_t version;
+  /// 通用计数器数量
+  uint8_t counters;
+  /// 通用计数器位宽
+  uint8_t counter_width;
+  /// 固定计数器数量
+  uint8_t fixed_counters;
+  /// 固定计数器位宽
+  uint8_t fixed_width;
+};
+
+namespace detail {
+/// Init() 读取的能力
+inline Info info{};
+
+/// IA32_PERFEVTSELx 位
+static constexpr uint64_t kEvtSelUsr = 1ULL << 16;
+static constexpr uint64_t kEvtSelOs = 1ULL << 17;
+static constexpr uint64_t kEvtSelInt = 1ULL << 20;
+static constexpr uint64_t kEvtSelEn = 1ULL << 22;
+
+/// IA32_FIXED_CTR_CTRL 中每个固定计数器占 4 位
+static constexpr uint64_t kFixedCtrlWidth = 4;
+static constexpr uint64_t kFixedCtrlOs = 1ULL << 0;
+static constexpr uint64_t kFixedCtrlUsr = 1ULL << 1;
+static constexpr uint64_t kFixedCtrlPmi = 1ULL << 3;
+
+/// IA32_PERF_GLOBAL_CTRL 等寄存器中固定计数器的起始位
+static constexpr uint64_t kGlobalFixedShift = 32;
+/// RDPMC 读固定计数器时 ECX 的标志
+static constexpr uint32_t kRdpmcFixed = 1U << 30;
+}  // namespace detail
+
+/**
+ * @brief 固定计数器在计数器掩码中的位
+ * @param index 固定计数器
+ * @return uint64_t 掩码
+ */
+static constexpr auto FixedCounterBit(size_t index) -> uint64_t {
+  return 1ULL << (detail::kGlobalFixedShift + index);
+}
+
+/**
+ * @brief 读取 CPUID 0xA 并停止所有计数器，需在每个核心上调用一次
+ * @return Info 性能监控能力
+ */
+static __always_inline auto Init() -> Info {
+  Info info{};
+  if (cpuid::GetCpuFeatures().max_basic_leaf >=
+      cpuid::detail::leaf::kArchPerfMon) {
+    auto leaf = cpuid::detail::ExecuteCpuid(cpuid::detail::leaf::kArchPerfMon);
+    info.version = leaf.eax & 0xFF;
+    info.counters = (leaf.eax >> 8) & 0xFF;
+    info.counter_width = (leaf.eax >> 16) & 0xFF;
+    if (info.version >= 2) {
+      info.fixed_counters = leaf.edx & 0x1F;
+      info.fixed_width = (leaf.edx >> 5) & 0xFF;
+    }
+  }
+  detail::info = info;
+  if (info.version >= 2) {
+    cpu_io::detail::regs::Msr::Write(msr::kIa32PerfGlobalCtrl, 0);
+    cpu_io::detail::regs::Msr::Write(msr::kIa32FixedCtrCtrl, 0);
+  }
+  for (size_t i = 0; i < info.counters; i++) {
+    cpu_io::detail::regs::Msr::Write(msr::kIa32PerfEvtSel0 + i, 0);
+  }
+  return info;
+}
+
+/**
+ * @brief 获取 Init() 读取的能力
+ * @return const Info& 性能监控能力
+ */
+static __always_inline auto GetInfo() -> const Info & { return detail::info; }
+
+/**
+ * @brief 配置通用计数器并清零
+ * 版本 2 及以上还需 Start() 打开全局控制
+ * @param index 通用计数器
+ * @param event 事件，见 pmu::event
+ * @param flags kUser/kKernel/kInterrupt 的组合
+ */
+static __always_inline void Program(size_t index, uint64_t event,
+                                    uint32_t flags) {
+  uint64_t select = (event & 0xFFFF) | detail::kEvtSelEn;
+  if (flags & kUser) {
+    select |= detail::kEvtSelUsr;
+  }
+  if (flags & kKernel) {
+    select |= detail::kEvtSelOs;
+  }
+  if (flags & kInterrupt) {
+    select |= detail::kEvtSelInt;
+  }
+  cpu_io::detail::regs::Msr::Write(msr::kIa32PerfEvtSel0 + index, 0);
+  cpu_io::detail::regs::Msr::Write(msr::kIa32Pmc0 + index, 0);
+  cpu_io::detail::regs::Msr::Write(msr::kIa32PerfEvtSel0 + index, select);
+}
+
+/**
+ * @brief 配置固定计数器并清零
+ * @param index 固定计数器，如 kFixedCycles
+ * @param flags kUser/kKernel/kInterrupt 的组合
+ */
+static __always_inline void ProgramFixed(size_t index, uint32_t flags) {
+  uint64_t ctrl = 0;
+  if (flags & kUser) {
+    ctrl |= detail::kFixedCtrlUsr;
+  }
+  if (flags & kKernel) {
+    ctrl |= detail::kFixedCtrlOs;
+  }
+  if (flags & kInterrupt) {
+    ctrl |= detail::kFixedCtrlPmi;
+  }
+  auto shift = index * detail::kFixedCtrlWidth;
+  auto value = cpu_io::detail::regs::Msr::Read(msr::kIa32FixedCtrCtrl);
+  value &= ~(0xFULL << shift);
+  cpu_io::detail::regs::Msr::Write(msr::kIa32FixedCtr0 + index, 0);
+  cpu_io::detail::regs::Msr::Write(msr::kIa32FixedCtrCtrl,
+                                   value | (ctrl << shift));
+}
+
+/**
+ * @brief 开始计数
+ * @param mask 计数器掩码
+ */
+static __always_inline void Start(uint64_t mask) {
+  if (detail::info.version < 2) {
+    return;
+  }
+  auto value = cpu_io::detail::regs::Msr::Read(msr::kIa32PerfGlobalCtrl);
+  cpu_io::detail::regs::Msr::Write(msr::kIa32PerfGlobalCtrl, value | mask);
+}
+
+/**
+ * @brief 停止计数，计数值保持不变
+ * @param mask 计数器掩码
+ */
+static __always_inline void Stop(uint64_t mask) {
+  if (detail::info.version < 2) {
+    return;
+  }
+  auto value = cpu_io::detail::regs::Msr::Read(msr::kIa32PerfGlobalCtrl);
+  cpu_io::detail::regs::Msr::Write(msr::kIa32PerfGlobalCtrl, value & ~mask);
+}
+
+/**
+ * @brief 使用 RDPMC 读取通用计数器
+ * @param index 通用计数器
+ * @return uint64_t 计数值
+ * @note 用户态使用前需 EnableUserRead()
+ */
+static __always_inline auto ReadCounter(size_t index) -> uint64_t {
+  uint32_t low;
+  uint32_t high;
+  __asm__ volatile("rdpmc"
+                   : "=a"(low), "=d"(high)
+                   : "c"(static_cast<uint32_t>(index)));
+  return (static_cast<uint64_t>(high) << 32) | low;
+}
+
+/**
+ * @brief 使用 RDPMC 读取固定计数器
+ * @param index 固定计数器
+ * @return uint64_t 计数值
+ */
+static __always_inline auto ReadFixedCounter(size_t index) -> uint64_t {
+  uint32_t low;
+  uint32_t high;
+  __asm__ volatile("rdpmc"
+                   : "=a"(low), "=d"(high)
+                   : "c"(detail::kRdpmcFixed | static_cast<uint32_t>(index)));
+  return (static_cast<uint64_t>(high) << 32) | low;
+}
+
+/**
+ * @brief 设置通用计数器的值，用于采样：写入 -period 后每 period 个事件溢出一次
+ * @param index 通用计数器
+ * @param value 计数值，只写入低 32 位并符号扩展
+ */
+static __always_inline void SetCounter(size_t index, uint64_t value) {
+  cpu_io::detail::regs::Msr::Write(msr::kIa32Pmc0 + index, value);
+}
+
+/**
+ * @brief 获取溢出的计数器
+ * @return uint64_t 计数器掩码
+ */
+static __always_inline auto GetOverflow() -> uint64_t {
+  return cpu_io::detail::regs::Msr::Read(msr::kIa32PerfGlobalStatus);
+}
+
+/**
+ * @brief 清除溢出状态
+ * @param mask 计数器掩码
+ */
+static __always_inline void ClearOverflow(uint64_t mask) {
+  cpu_io::detail::regs::Msr::Write(msr::kIa32PerfGlobalOvfCtrl, mask);
+}
+
+/**
+ * @brief 设置溢出中断的向量
+ * 以 kInterrupt 配置的计数器溢出时通过 LVT PMC 产生中断
+ * @param vector 中断向量
+ * @note 需要 x2APIC；处理器产生中断后屏蔽 LVT PMC，
+ * 处理中在 ClearOverflow() 后需再次调用以解除屏蔽
+ */
+static __always_inline void EnableOverflowInterrupt(uint8_t vector) {
+  msr::apic::WriteLvtPmc(vector);
+}
+
+/**
+ * @brief 允许用户态执行 RDPMC，置位 CR4.PCE
+ */
+static __always_inline void EnableUserRead() {
+  cpu_io::detail::regs::cr::Cr4::Pce::Set();
+}
+
+}  // namespace pmu
+}  // namespace cpu_io
+
+#endif  // CPU_IO_INCLUDE_X86_64_PMU_HPP_
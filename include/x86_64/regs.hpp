@@ -22,7 +22,9 @@ namespace detail {
 
 namespace regs {
 
-struct Rbp : public read_write::ReadWriteRegBase<register_info::RbpInfo> {};
+/// 通用寄存器不会陷入，不跟踪
+struct Rbp : public read_write::ReadWriteRegBase<register_info::RbpInfo,
+                                                 read_write::NoRegTrace> {};
 
 struct Msr : public read_write::ReadWriteRegBase<register_info::MsrInfo> {};
 
@@ -30,6 +32,9 @@ struct Rflags : public read_write::ReadWriteRegBase<register_info::RflagsInfo> {
   using If = read_write::ReadWriteField<
       read_write::ReadWriteRegBase<register_info::RflagsInfo>,
       register_info::RflagsInfo::If>;
+  using Df = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::RflagsInfo>,
+      register_info::RflagsInfo::Df>;
 };
 
 struct Gdtr : public read_write::ReadWriteRegBase<register_info::GdtrInfo> {
@@ -60,6 +65,24 @@ struct Cr0 : public read_write::ReadWriteRegBase<register_info::cr::Cr0Info> {
   using Pe = read_write::ReadWriteField<
       read_write::ReadWriteRegBase<register_info::cr::Cr0Info>,
       register_info::cr::Cr0Info::Pe>;
+  using Mp = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::cr::Cr0Info>,
+      register_info::cr::Cr0Info::Mp>;
+  using Em = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::cr::Cr0Info>,
+      register_info::cr::Cr0Info::Em>;
+  using Ts = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::cr::Cr0Info>,
+      register_info::cr::Cr0Info::Ts>;
+  using Ne = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::cr::Cr0Info>,
+      register_info::cr::Cr0Info::Ne>;
+  using Nw = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::cr::Cr0Info>,
+      register_info::cr::Cr0Info::Nw>;
+  using Cd = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::cr::Cr0Info>,
+      register_info::cr::Cr0Info::Cd>;
   using Pg = read_write::ReadWriteField<
       read_write::ReadWriteRegBase<register_info::cr::Cr0Info>,
       register_info::cr::Cr0Info::Pg>;
@@ -77,19 +100,93 @@ struct Cr3 : public read_write::ReadWriteRegBase<register_info::cr::Cr3Info> {
   using PageDirectoryBase = read_write::ReadWriteField<
       read_write::ReadWriteRegBase<register_info::cr::Cr3Info>,
       register_info::cr::Cr3Info::PageDirectoryBase>;
+  using Pcid = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::cr::Cr3Info>,
+      register_info::cr::Cr3Info::Pcid>;
+  using NoFlush = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::cr::Cr3Info>,
+      register_info::cr::Cr3Info::NoFlush>;
 };
 
 struct Cr4 : public read_write::ReadWriteRegBase<register_info::cr::Cr4Info> {
   using Pae = read_write::ReadWriteField<
       read_write::ReadWriteRegBase<register_info::cr::Cr4Info>,
       register_info::cr::Cr4Info::Pae>;
+
+  using Pge = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::cr::Cr4Info>,
+      register_info::cr::Cr4Info::Pge>;
+
+  using Pcide = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::cr::Cr4Info>,
+      register_info::cr::Cr4Info::Pcide>;
+
+  using Pce = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::cr::Cr4Info>,
+      register_info::cr::Cr4Info::Pce>;
+
+  using Osfxsr = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::cr::Cr4Info>,
+      register_info::cr::Cr4Info::Osfxsr>;
+
+  using Osxmmexcpt = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::cr::Cr4Info>,
+      register_info::cr::Cr4Info::Osxmmexcpt>;
+
+  using Fsgsbase = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::cr::Cr4Info>,
+      register_info::cr::Cr4Info::Fsgsbase>;
+
+  using Osxsave = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::cr::Cr4Info>,
+      register_info::cr::Cr4Info::Osxsave>;
 };
 
 struct Cr8 : public read_write::ReadWriteRegBase<register_info::cr::Cr8Info> {};
 
 }  // namespace cr
 
-struct Xcr0 : public read_write::ReadWriteRegBase<register_info::Xcr0Info> {};
+struct Xcr0 : public read_write::ReadWriteRegBase<register_info::Xcr0Info> {
+  using X87 = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::Xcr0Info>,
+      register_info::Xcr0Info::X87>;
+  using Sse = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::Xcr0Info>,
+      register_info::Xcr0Info::Sse>;
+  using Avx = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::Xcr0Info>,
+      register_info::Xcr0Info::Avx>;
+  using Bndregs = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::Xcr0Info>,
+      register_info::Xcr0Info::Bndregs>;
+  using Bndcsr = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::Xcr0Info>,
+      register_info::Xcr0Info::Bndcsr>;
+  using Opmask = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::Xcr0Info>,
+      register_info::Xcr0Info::Opmask>;
+  using ZmmHi256 = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::Xcr0Info>,
+      register_info::Xcr0Info::ZmmHi256>;
+  using Hi16Zmm = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::Xcr0Info>,
+      register_info::Xcr0Info::Hi16Zmm>;
+  using Pkru = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::Xcr0Info>,
+      register_info::Xcr0Info::Pkru>;
+  using XtileCfg = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::Xcr0Info>,
+      register_info::Xcr0Info::XtileCfg>;
+  using XtileData = read_write::ReadWriteField<
+      read_write::ReadWriteRegBase<register_info::Xcr0Info>,
+      register_info::Xcr0Info::XtileData>;
+};
+
+struct FsBase
+    : public read_write::ReadWriteRegBase<register_info::FsBaseInfo> {};
+
+struct GsBase
+    : public read_write::ReadWriteRegBase<register_info::GsBaseInfo> {};
 
 namespace segment_register {
 struct Cs : public read_write::ReadWriteRegBase<
@@ -5,20 +5,115 @@
 #ifndef CPU_IO_INCLUDE_X86_64_READ_WRITE_HPP_
 #define CPU_IO_INCLUDE_X86_64_READ_WRITE_HPP_
 
+#include <cstddef>
 #include <cstdint>
 
+#include "../../reg_trace.hpp"
+#include "../msr.h"
 #include "register_info.hpp"
 
 namespace cpu_io {
 
 namespace detail {
 
+/**
+ * @brief 当前核心是否可以使用 RDFSBASE 等指令访问 FS/GS 基址
+ * CR4.FSGSBASE 在各核心上分别置位，这里直接读当前核心的 CR4，
+ * 不依赖 GS 基址，swapgs 前后与 SetPerCpuBase() 之前都可以使用
+ * @return bool 当前核心已置位 CR4.FSGSBASE
+ * @note 读 CR4 不经过寄存器访问跟踪，开销远小于 RDMSR/WRMSR
+ */
+static __always_inline auto FsgsbaseEnabled() -> bool {
+  uint64_t cr4;
+  __asm__ volatile("movq %%cr4, %0" : "=r"(cr4));
+  return (cr4 & register_info::cr::Cr4Info::Fsgsbase::kBitMask) != 0;
+}
+
+namespace register_info {
+
+__always_inline auto FsBaseInfo::Read() -> DataType {
+  DataType value{};
+  if (FsgsbaseEnabled()) {
+    __asm__ volatile("rdfsbase %0" : "=r"(value) : :);
+  } else {
+    value = MsrInfo::Read(msr::kIa32FsBase);
+  }
+  return value;
+}
+
+__always_inline void FsBaseInfo::Write(DataType value) {
+  if (FsgsbaseEnabled()) {
+    __asm__ volatile("wrfsbase %0" : : "r"(value) : "memory");
+  } else {
+    MsrInfo::Write(msr::kIa32FsBase, value);
+  }
+}
+
+__always_inline auto GsBaseInfo::Read() -> DataType {
+  DataType value{};
+  if (FsgsbaseEnabled()) {
+    __asm__ volatile("rdgsbase %0" : "=r"(value) : :);
+  } else {
+    value = MsrInfo::Read(msr::kIa32GsBase);
+  }
+  return value;
+}
+
+__always_inline void GsBaseInfo::Write(DataType value) {
+  if (FsgsbaseEnabled()) {
+    __asm__ volatile("wrgsbase %0" : : "r"(value) : "memory");
+  } else {
+    MsrInfo::Write(msr::kIa32GsBase, value);
+  }
+}
+
+}  // namespace register_info
+
 namespace read_write {
+
+/**
+ * 寄存器访问跟踪使用的计数器，直接读取，本身不被跟踪
+ */
+struct TraceClock {
+  static __always_inline auto Read() -> uint64_t {
+    uint32_t low;
+    uint32_t high;
+    __asm__ volatile("rdtsc" : "=a"(low), "=d"(high));
+    return (static_cast<uint64_t>(high) << 32) | low;
+  }
+};
+
+/// 寄存器访问跟踪策略，定义 CPU_IO_REG_TRACE 时调用 SetRegTraceHook() 的钩子
+#ifdef CPU_IO_REG_TRACE
+using DefaultRegTrace = HookRegTrace<TraceClock>;
+#else
+using DefaultRegTrace = NoRegTrace;
+#endif
+
+/**
+ * 位域值，由位域的掩码与移位后的值组成
+ * @note 多个位域值可以合并后一次性写入寄存器，见 ReadWriteRegBase::Modify
+ */
+struct FieldValue {
+  /// 位域掩码
+  uint64_t mask;
+  /// 已移位到位域位置的值
+  uint64_t value;
+
+  /**
+   * | 重载，合并两个位域值
+   */
+  constexpr auto operator|(const FieldValue &other) const -> FieldValue {
+    return {mask | other.mask, value | other.value};
+  }
+};
+
 /**
  * 只读接口
  * @tparam 寄存器类型
+ * @tparam Trace 访问跟踪策略，见 reg_trace.hpp
  */
-template <class RegInfo>
+template <class RegInfo, class Trace = DefaultRegTrace>
 class ReadOnlyRegBase {
  public:
   /// @name 构造/析构函数
@@ -36,72 +131,23 @@ class ReadOnlyRegBase {
    * @return RegInfo::DataType 寄存器的值
    */
   static __always_inline auto Read() -> typename RegInfo::DataType {
-    typename RegInfo::DataType value{};
-    if constexpr (std::is_same_v<RegInfo, register_info::RbpInfo>) {
-      __asm__ volatile("mov %%rbp, %0" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::RflagsInfo>) {
-      __asm__ volatile("pushfq; popq %0" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::GdtrInfo>) {
-      __asm__ volatile("sgdt %0" : "=m"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::LdtrInfo>) {
-      static_assert(sizeof(RegInfo) == 0);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::IdtrInfo>) {
-      __asm__ volatile("sidt %0" : "=m"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::TrInfo>) {
-      static_assert(sizeof(RegInfo) == 0);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr0Info>) {
-      __asm__ volatile("mov %%cr0, %0" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr2Info>) {
-      __asm__ volatile("mov %%cr2, %0" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr3Info>) {
-      __asm__ volatile("mov %%cr3, %0" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr4Info>) {
-      __asm__ volatile("mov %%cr4, %0" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr8Info>) {
-      __asm__ volatile("mov %%cr8, %0" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::Xcr0Info>) {
-      static_assert(sizeof(RegInfo) == 0);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::segment_register::CsInfo>) {
-      __asm__ volatile("mov %%cs, %0" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::segment_register::SsInfo>) {
-      __asm__ volatile("mov %%ss, %0" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::segment_register::DsInfo>) {
-      __asm__ volatile("mov %%ds, %0" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::segment_register::EsInfo>) {
-      __asm__ volatile("mov %%es, %0" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::segment_register::FsInfo>) {
-      __asm__ volatile("mov %%fs, %0" : "=r"(value) : :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::segment_register::GsInfo>) {
-      __asm__ volatile("mov %%gs, %0" : "=r"(value) : :);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    auto trace_start = Trace::Begin();
+    auto value = RegInfo::Read();
+    Trace::template End<RegInfo>(RegAccess::kRead, value, trace_start);
     return value;
   }
 
+  /**
+   * 读需要偏移的寄存器，如 MSR
+   * @param offset 偏移
+   * @return RegInfo::DataType 寄存器的值
+   */
   static __always_inline auto Read(uint32_t offset) ->
       typename RegInfo::DataType {
-    typename RegInfo::DataType value{};
-    if constexpr (std::is_same_v<RegInfo, register_info::MsrInfo>) {
-      uint32_t low{};
-      uint32_t high{};
-      __asm__ volatile("rdmsr" : "=a"(low), "=d"(high) : "c"(offset) :);
-      value = (static_cast<uint64_t>(high) << 32) | low;
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    auto trace_start = Trace::Begin();
+    auto value = RegInfo::Read(offset);
+    Trace::template End<RegInfo>(RegAccess::kRead, value, trace_start,
+                                 offset);
     return value;
   }
 
@@ -116,8 +162,9 @@ class ReadOnlyRegBase {
 /**
  * 只写接口
  * @tparam 寄存器类型
+ * @tparam Trace 访问跟踪策略，见 reg_trace.hpp
  */
-template <class RegInfo>
+template <class RegInfo, class Trace = DefaultRegTrace>
 class WriteOnlyRegBase {
  public:
   /// @name 构造/析构函数
@@ -135,78 +182,22 @@ class WriteOnlyRegBase {
    * @param value 要写的值
    */
   static __always_inline void Write(typename RegInfo::DataType value) {
-    if constexpr (std::is_same_v<RegInfo, register_info::RbpInfo>) {
-      __asm__ volatile("mov %0, %%rbp" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::RflagsInfo>) {
-      __asm__ volatile("pushq %0; popfq" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::GdtrInfo>) {
-      __asm__ volatile("lgdt %0" : : "m"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::LdtrInfo>) {
-      static_assert(sizeof(RegInfo) == 0);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::IdtrInfo>) {
-      __asm__ volatile("lidt %0" : : "m"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::TrInfo>) {
-      static_assert(sizeof(RegInfo) == 0);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr0Info>) {
-      __asm__ volatile("mov %0, %%cr0" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr2Info>) {
-      __asm__ volatile("mov %0, %%cr2" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr3Info>) {
-      __asm__ volatile("mov %0, %%cr3" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr4Info>) {
-      __asm__ volatile("mov %0, %%cr4" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr8Info>) {
-      __asm__ volatile("mov %0, %%cr8" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::Xcr0Info>) {
-      static_assert(sizeof(RegInfo) == 0);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::segment_register::CsInfo>) {
-      auto JumpFunction = [=](uint16_t value) {
-        __asm__ volatile(
-            "push %0\n\t"
-            "pushq $WriteCsLabel\n\t"
-            "retfq\n\t"
-            "WriteCsLabel: \n\t"
-            :
-            : "r"(value)
-            :);
-      };
-      JumpFunction(value);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::segment_register::SsInfo>) {
-      __asm__ volatile("mov %0, %%ss" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::segment_register::DsInfo>) {
-      __asm__ volatile("mov %0, %%ds" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::segment_register::EsInfo>) {
-      __asm__ volatile("mov %0, %%es" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::segment_register::FsInfo>) {
-      __asm__ volatile("mov %0, %%fs" : : "r"(value) :);
-    } else if constexpr (std::is_same_v<
-                             RegInfo,
-                             register_info::segment_register::GsInfo>) {
-      __asm__ volatile("mov %0, %%gs" : : "r"(value) :);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    auto trace_start = Trace::Begin();
+    RegInfo::Write(value);
+    Trace::template End<RegInfo>(RegAccess::kWrite, value, trace_start);
   }
 
+  /**
+   * 写需要偏移的寄存器，如 MSR
+   * @param offset 偏移
+   * @param value 要写的值
+   */
   static __always_inline void Write(uint32_t offset,
                                     typename RegInfo::DataType value) {
-    if constexpr (std::is_same_v<RegInfo, register_info::MsrInfo>) {
-      uint32_t low = value & 0xFFFFFFFF;
-      uint32_t high = value >> 32;
-      __asm__ volatile("wrmsr" : : "c"(offset), "a"(low), "d"(high) :);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    auto trace_start = Trace::Begin();
+    RegInfo::Write(offset, value);
+    Trace::template End<RegInfo>(RegAccess::kWrite, value, trace_start,
+                                 offset);
   }
 
   /**
@@ -214,40 +205,9 @@ class WriteOnlyRegBase {
    * @param offset 位偏移
    */
   static __always_inline void SetBits(uint64_t offset) {
-    if constexpr (std::is_same_v<RegInfo, register_info::RbpInfo>) {
-      __asm__ volatile("bts %%rbp, %0" : : "r"(offset) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::RflagsInfo>) {
-      if (offset == register_info::RflagsInfo::If::kBitOffset) {
-        __asm__ volatile("sti");
-      } else {
-        typename RegInfo::DataType old_value = 0;
-        __asm__ volatile("pushfq; popq %0" : "=r"(old_value) : :);
-        auto new_value = old_value | (1 << offset);
-        Write(new_value);
-      }
-    } else if constexpr (std::is_same_v<RegInfo, register_info::GdtrInfo>) {
-      static_assert(sizeof(RegInfo) == 0);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::LdtrInfo>) {
-      static_assert(sizeof(RegInfo) == 0);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::IdtrInfo>) {
-      static_assert(sizeof(RegInfo) == 0);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::TrInfo>) {
-      static_assert(sizeof(RegInfo) == 0);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr0Info>) {
-      __asm__ volatile("bts %%cr0, %0" : : "r"(offset) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr2Info>) {
-      __asm__ volatile("bts %%cr2, %0" : : "r"(offset) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr3Info>) {
-      __asm__ volatile("bts %%cr3, %0" : : "r"(offset) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr4Info>) {
-      __asm__ volatile("bts %%cr4, %0" : : "r"(offset) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr8Info>) {
-      __asm__ volatile("bts %%cr8, %0" : : "r"(offset) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::Xcr0Info>) {
-      static_assert(sizeof(RegInfo) == 0);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    auto trace_start = Trace::Begin();
+    RegInfo::SetBits(offset);
+    Trace::template End<RegInfo>(RegAccess::kSetBits, offset, trace_start);
   }
 
   /**
@@ -255,55 +215,37 @@ class WriteOnlyRegBase {
    * @param offset 位偏移
    */
   static __always_inline void ClearBits(uint64_t offset) {
-    if constexpr (std::is_same_v<RegInfo, register_info::RbpInfo>) {
-      __asm__ volatile("btr %%rbp, %0" : : "r"(offset) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::RflagsInfo>) {
-      if (offset == register_info::RflagsInfo::If::kBitOffset) {
-        __asm__ volatile("cli");
-      } else {
-        typename RegInfo::DataType old_value = 0;
-        __asm__ volatile("pushfq; popq %0" : "=r"(old_value) : :);
-        auto new_value = old_value & (~(1ULL << offset));
-        Write(new_value);
-      }
-    } else if constexpr (std::is_same_v<RegInfo, register_info::GdtrInfo>) {
-      static_assert(sizeof(RegInfo) == 0);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::LdtrInfo>) {
-      static_assert(sizeof(RegInfo) == 0);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::IdtrInfo>) {
-      static_assert(sizeof(RegInfo) == 0);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::TrInfo>) {
-      static_assert(sizeof(RegInfo) == 0);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr0Info>) {
-      __asm__ volatile("btr %%cr0, %0" : : "r"(offset) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr2Info>) {
-      __asm__ volatile("btr %%cr2, %0" : : "r"(offset) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr3Info>) {
-      __asm__ volatile("btr %%cr3, %0" : : "r"(offset) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr4Info>) {
-      __asm__ volatile("btr %%cr4, %0" : : "r"(offset) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::cr::Cr8Info>) {
-      __asm__ volatile("btr %%cr8, %0" : : "r"(offset) :);
-    } else if constexpr (std::is_same_v<RegInfo, register_info::Xcr0Info>) {
-      static_assert(sizeof(RegInfo) == 0);
-    } else {
-      static_assert(sizeof(RegInfo) == 0);
-    }
+    auto trace_start = Trace::Begin();
+    RegInfo::ClearBits(offset);
+    Trace::template End<RegInfo>(RegAccess::kClearBits, offset, trace_start);
   }
 
   /**
    * |= 重载
    */
   __always_inline void operator|=(uint64_t offset) { SetBits(offset); }
+
+  /**
+   * 将多个位域值合并后直接写入寄存器，未指定的位写 0
+   * @param first 第一个位域值
+   * @param rest 其余位域值
+   * @note 不读寄存器，适用于只写寄存器或需要整体赋值的场景
+   */
+  template <class... Rest>
+  static __always_inline void WriteFields(FieldValue first, Rest... rest) {
+    static_assert((std::is_same_v<Rest, FieldValue> && ...));
+    Write(static_cast<typename RegInfo::DataType>((first | ... | rest).value));
+  }
 };
 
 /**
  * 读写接口
  * @tparam 寄存器类型
+ * @tparam Trace 访问跟踪策略，见 reg_trace.hpp
  */
-template <class RegInfo>
-class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo>,
-                         public WriteOnlyRegBase<RegInfo> {
+template <class RegInfo, class Trace = DefaultRegTrace>
+class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo, Trace>,
+                         public WriteOnlyRegBase<RegInfo, Trace> {
  public:
   /// @name 构造/析构函数
   /// @{
@@ -322,8 +264,8 @@ class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo>,
    */
   static __always_inline auto ReadWrite(typename RegInfo::DataType value) ->
       typename RegInfo::DataType {
-    auto old_value = ReadOnlyRegBase<RegInfo>::Read();
-    WriteOnlyRegBase<RegInfo>::Write(value);
+    auto old_value = ReadOnlyRegBase<RegInfo, Trace>::Read();
+    WriteOnlyRegBase<RegInfo, Trace>::Write(value);
     return old_value;
   }
 
@@ -334,8 +276,8 @@ class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo>,
    */
   static __always_inline auto ReadSetBits(uint64_t offset) ->
       typename RegInfo::DataType {
-    auto old_value = ReadOnlyRegBase<RegInfo>::Read();
-    WriteOnlyRegBase<RegInfo>::SetBits(offset);
+    auto old_value = ReadOnlyRegBase<RegInfo, Trace>::Read();
+    WriteOnlyRegBase<RegInfo, Trace>::SetBits(offset);
     return old_value;
   }
 
@@ -346,10 +288,38 @@ class ReadWriteRegBase : public ReadOnlyRegBase<RegInfo>,
    */
   static __always_inline auto ReadClearBits(uint64_t offset) ->
       typename RegInfo::DataType {
-    auto old_value = ReadOnlyRegBase<RegInfo>::Read();
-    WriteOnlyRegBase<RegInfo>::ClearBits(offset);
+    auto old_value = ReadOnlyRegBase<RegInfo, Trace>::Read();
+    WriteOnlyRegBase<RegInfo, Trace>::ClearBits(offset);
     return old_value;
   }
+
+  /**
+   * 一次读改写同时修改多个位域
+   * @tparam kFields 编译期确定的位域值
+   * @note 只进行一次读与一次写，屏障由调用者在整个配置序列完成后添加
+   */
+  template <FieldValue... kFields>
+  static __always_inline void Modify() {
+    static_assert(sizeof...(kFields) > 0);
+    constexpr auto kMerged = (kFields | ...);
+    Modify(kMerged);
+  }
+
+  /**
+   * 一次读改写同时修改多个位域
+   * @param first 第一个位域值
+   * @param rest 其余位域值
+   * @note 只进行一次读与一次写，屏障由调用者在整个配置序列完成后添加
+   */
+  template <class... Rest>
+  static __always_inline void Modify(FieldValue first, Rest... rest) {
+    static_assert((std::is_same_v<Rest, FieldValue> && ...));
+    auto merged = (first | ... | rest);
+    auto org_value = ReadOnlyRegBase<RegInfo, Trace>::Read();
+    WriteOnlyRegBase<RegInfo, Trace>::Write(
+        static_cast<typename RegInfo::DataType>((org_value & ~merged.mask) |
+                                                merged.value));
+  }
 };
 
 /**
@@ -387,8 +357,7 @@ class ReadOnlyField {
                                         register_info::IdtrInfo::Base>) {
       return Reg::Read().base;
     } else {
-      return static_cast<typename RegInfo::DataType>(
-          (Reg::Read() & RegInfo::kBitMask) >> RegInfo::kBitOffset);
+      return RegInfo::Decode(Reg::Read());
     }
   }
 
@@ -411,8 +380,7 @@ class ReadOnlyField {
                                         register_info::IdtrInfo::Base>) {
       return value;
     } else {
-      return static_cast<typename RegInfo::DataType>(
-          (value & RegInfo::kBitMask) >> RegInfo::kBitOffset);
+      return RegInfo::Decode(value);
     }
   }
 };
@@ -444,6 +412,15 @@ class WriteOnlyField {
    * 清零对应 Reg 的由 RegInfo 规定的指定位
    */
   static __always_inline void Clear() { Reg::ClearBits(RegInfo::kBitOffset); }
+
+  /**
+   * 生成由 RegInfo 规定的位域值，用于批量修改
+   * @param value 位域的值
+   * @return FieldValue 位域值
+   */
+  static constexpr auto Value(typename RegInfo::DataType value) -> FieldValue {
+    return {RegInfo::kBitMask, RegInfo::Encode(value)};
+  }
 };
 
 /**
@@ -471,8 +448,8 @@ class ReadWriteField : public ReadOnlyField<Reg, RegInfo>,
    */
   static __always_inline void Write(typename RegInfo::DataType value) {
     auto org_value = Reg::Read();
-    auto new_value = (org_value & ~RegInfo::kBitMask) |
-                     ((value << RegInfo::kBitOffset) & RegInfo::kBitMask);
+    auto new_value = static_cast<decltype(org_value)>(
+        RegInfo::Insert(org_value, value));
     Reg::Write(new_value);
   }
 
@@ -484,11 +461,137 @@ class ReadWriteField : public ReadOnlyField<Reg, RegInfo>,
   static __always_inline auto ReadWrite(typename RegInfo::DataType value) ->
       typename RegInfo::DataType {
     auto org_value = Reg::Read();
-    auto new_value = (org_value & ~RegInfo::kBitMask) |
-                     ((value << RegInfo::kBitOffset) & RegInfo::kBitMask);
+    auto new_value = static_cast<decltype(org_value)>(
+        RegInfo::Insert(org_value, value));
     Reg::Write(new_value);
-    return static_cast<typename RegInfo::DataType>(
-        (org_value & RegInfo::kBitMask) >> RegInfo::kBitOffset);
+    return RegInfo::Decode(org_value);
+  }
+};
+
+/**
+ * 带软件影子的寄存器接口
+ * @tparam Reg 寄存器类型，需要提供 Read() 与 Write()
+ * @note 对于在虚拟化环境下读操作会陷入的寄存器，读操作由影子提供，
+ *  只有第一次读或 Invalidate() 之后的读会访问硬件。
+ *  影子保存在对象中，每个核心应当持有自己的实例（如放在 per-CPU 数据中）；
+ *  若寄存器被本对象之外的途径修改，需要调用 Invalidate()
+ */
+template <class Reg>
+class CachedReg {
+ public:
+  using DataType = decltype(Reg::Read());
+
+  /// @name 构造/析构函数
+  /// @{
+  CachedReg() = default;
+  CachedReg(const CachedReg &) = delete;
+  CachedReg(CachedReg &&) = delete;
+  auto operator=(const CachedReg &) -> CachedReg & = delete;
+  auto operator=(CachedReg &&) -> CachedReg & = delete;
+  ~CachedReg() = default;
+  /// @}
+
+  /**
+   * 读寄存器，影子有效时不访问硬件
+   * @return DataType 寄存器的值
+   */
+  __always_inline auto Read() -> DataType {
+    if (!valid_) {
+      value_ = Reg::Read();
+      valid_ = true;
+    }
+    return value_;
+  }
+
+  /**
+   * 写寄存器并更新影子
+   * @param value 要写的值
+   */
+  __always_inline void Write(DataType value) {
+    Reg::Write(value);
+    value_ = value;
+    valid_ = true;
+  }
+
+  /**
+   * 通过偏移设置寄存器
+   * @param offset 位偏移
+   * @note 影子有效时只写不读
+   */
+  __always_inline void SetBits(uint64_t offset) {
+    Write(static_cast<DataType>(Read() | (1ULL << offset)));
+  }
+
+  /**
+   * 通过偏移清零寄存器
+   * @param offset 位偏移
+   * @note 影子有效时只写不读
+   */
+  __always_inline void ClearBits(uint64_t offset) {
+    Write(static_cast<DataType>(Read() & ~(1ULL << offset)));
+  }
+
+  /**
+   * 从影子获取指定位域的值
+   * @tparam Field 位域类型，如 Cr0::Pg
+   * @return 位域的值
+   */
+  template <class Field>
+  __always_inline auto Get() {
+    return Field::Get(static_cast<uint64_t>(Read()));
+  }
+
+  /**
+   * 同时修改多个位域，影子有效时只写不读
+   * @param first 第一个位域值
+   * @param rest 其余位域值
+   */
+  template <class... Rest>
+  __always_inline void Modify(FieldValue first, Rest... rest) {
+    static_assert((std::is_same_v<Rest, FieldValue> && ...));
+    auto merged = (first | ... | rest);
+    Write(static_cast<DataType>((static_cast<uint64_t>(Read()) & ~merged.mask) |
+                                merged.value));
+  }
+
+  /**
+   * 使影子失效，下一次读会访问硬件
+   */
+  __always_inline void Invalidate() { valid_ = false; }
+
+  /**
+   * 影子是否有效
+   * @return true 有效
+   */
+  [[nodiscard]] __always_inline auto IsValid() const -> bool { return valid_; }
+
+ private:
+  /// 影子值
+  DataType value_{};
+  /// 影子是否有效
+  bool valid_{false};
+};
+
+/**
+ * 固定地址的 MSR，用于配合 CachedReg 使用
+ * @tparam kOffset MSR 地址
+ */
+template <uint32_t kOffset>
+struct FixedMsr {
+  /**
+   * 读 MSR
+   * @return uint64_t MSR 的值
+   */
+  static __always_inline auto Read() -> uint64_t {
+    return ReadOnlyRegBase<register_info::MsrInfo>::Read(kOffset);
+  }
+
+  /**
+   * 写 MSR
+   * @param value 要写的值
+   */
+  static __always_inline void Write(uint64_t value) {
+    WriteOnlyRegBase<register_info::MsrInfo>::Write(kOffset, value);
   }
 };
 
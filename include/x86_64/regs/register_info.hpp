@@ -5,6 +5,8 @@
 #ifndef CPU_IO_INCLUDE_X86_64_REGISTER_INFO_HPP_
 #define CPU_IO_INCLUDE_X86_64_REGISTER_INFO_HPP_
 
+#include <sys/cdefs.h>
+
 #include <array>
 #include <cstdint>
 
@@ -17,28 +19,110 @@ namespace detail {
 namespace register_info {
 
 /// 通用寄存器
-struct RbpInfo : public RegInfoBase {};
+struct RbpInfo : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mov %%rbp, %0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("mov %0, %%rbp" : : "r"(value) :);
+  }
+
+  /// 置位 offset 指定的位
+  static __always_inline void SetBits(uint64_t offset) {
+    __asm__ volatile("bts %%rbp, %0" : : "r"(offset) :);
+  }
+
+  /// 清零 offset 指定的位
+  static __always_inline void ClearBits(uint64_t offset) {
+    __asm__ volatile("btr %%rbp, %0" : : "r"(offset) :);
+  }
+};
 
 /**
  * @brief efer 寄存器
  * @see sdm.pdf#2.2.1
  */
-struct MsrInfo : public RegInfoBase {};
+struct MsrInfo : public RegInfoBase {
+  /**
+   * @brief 读 MSR
+   * @param offset MSR 地址
+   * @return DataType MSR 的值
+   */
+  static __always_inline auto Read(uint32_t offset) -> DataType {
+    uint32_t low{};
+    uint32_t high{};
+    __asm__ volatile("rdmsr" : "=a"(low), "=d"(high) : "c"(offset) :);
+    return (static_cast<uint64_t>(high) << 32) | low;
+  }
+
+  /**
+   * @brief 写 MSR
+   * @param offset MSR 地址
+   * @param value 要写的值
+   */
+  static __always_inline void Write(uint32_t offset, DataType value) {
+    uint32_t low = value & 0xFFFFFFFF;
+    uint32_t high = value >> 32;
+    __asm__ volatile("wrmsr" : : "c"(offset), "a"(low), "d"(high) :);
+  }
+};
 
 /**
  * @brief rflags 寄存器
  * @see sdm.pdf#2.3
  */
 struct RflagsInfo : public RegInfoBase {
-  struct If {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 9;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct If : public BitField<bool, 9, 1> {};
+
+  /// 方向标志，串操作指令递减地址
+  struct Df : public BitField<bool, 10, 1> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("pushfq; popq %0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("pushq %0; popfq" : : "r"(value) :);
+  }
+
+  /// 置位 offset 指定的位
+  static __always_inline void SetBits(uint64_t offset) {
+    // IF/DF 有专用指令，避免 popfq
+    if (offset == If::kBitOffset) {
+      __asm__ volatile("sti" ::: "memory");
+    } else if (offset == Df::kBitOffset) {
+      __asm__ volatile("std" ::: "cc");
+    } else {
+      DataType old_value = 0;
+      __asm__ volatile("pushfq; popq %0" : "=r"(old_value) : :);
+      auto new_value = old_value | (1ULL << offset);
+      Write(new_value);
+    }
+  }
+
+  /// 清零 offset 指定的位
+  static __always_inline void ClearBits(uint64_t offset) {
+    // IF/DF 有专用指令，避免 popfq
+    if (offset == If::kBitOffset) {
+      __asm__ volatile("cli" ::: "memory");
+    } else if (offset == Df::kBitOffset) {
+      __asm__ volatile("cld" ::: "cc");
+    } else {
+      DataType old_value = 0;
+      __asm__ volatile("pushfq; popq %0" : "=r"(old_value) : :);
+      auto new_value = old_value & (~(1ULL << offset));
+      Write(new_value);
+    }
+  }
 };
 
 /**
@@ -205,25 +289,21 @@ struct GdtrInfo : public RegInfoBase {
 
   using DataType = Gdtr;
 
-  struct Limit {
-    using DataType = uint16_t;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 16;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Limit : public BitField<uint16_t, 0, 16> {};
 
-  struct Base {
-    using DataType = SegmentDescriptor *;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 64;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Base : public BitField<SegmentDescriptor *, 0, 64> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("sgdt %0" : "=m"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("lgdt %0" : : "m"(value) :);
+  }
 };
 
 /**
@@ -461,25 +541,21 @@ struct IdtrInfo : public RegInfoBase {
   using DataType = Idtr;
   static constexpr uint64_t kBitWidth = 80;
 
-  struct Limit {
-    using DataType = uint16_t;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 16;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Limit : public BitField<uint16_t, 0, 16> {};
 
-  struct Base {
-    using DataType = uint64_t;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 64;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Base : public BitField<uint64_t, 0, 64> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("sidt %0" : "=m"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("lidt %0" : : "m"(value) :);
+  }
 };
 
 /**
@@ -495,74 +571,219 @@ struct TrInfo : public RegInfoBase {};
 namespace cr {
 
 struct Cr0Info : public RegInfoBase {
-  struct Pe {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
-
-  struct Pg {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 31;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Pe : public BitField<bool, 0, 1> {};
+
+  /// 监控协处理器，与 Ts 一起使 WAIT/FWAIT 产生 #NM
+  struct Mp : public BitField<bool, 1, 1> {};
+
+  /// 模拟 x87，置位时 x87/SSE 指令产生 #UD
+  struct Em : public BitField<bool, 2, 1> {};
+
+  /// 任务切换，置位时 x87/SSE/AVX 指令产生 #NM，用于延迟切换
+  struct Ts : public BitField<bool, 3, 1> {};
+
+  /// x87 错误使用 #MF 报告
+  struct Ne : public BitField<bool, 5, 1> {};
+
+  /// 不写透
+  struct Nw : public BitField<bool, 29, 1> {};
+
+  /// 禁用缓存
+  struct Cd : public BitField<bool, 30, 1> {};
+
+  struct Pg : public BitField<bool, 31, 1> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mov %%cr0, %0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("mov %0, %%cr0" : : "r"(value) :);
+  }
+
+  /// 置位 offset 指定的位
+  static __always_inline void SetBits(uint64_t offset) {
+    uint64_t value = 0;
+    __asm__ volatile("mov %%cr0, %0\n\tbts %1, %0\n\tmov %0, %%cr0"
+                     : "=&r"(value)
+                     : "r"(offset)
+                     : "memory");
+  }
+
+  /// 清零 offset 指定的位
+  static __always_inline void ClearBits(uint64_t offset) {
+    uint64_t value = 0;
+    __asm__ volatile("mov %%cr0, %0\n\tbtr %1, %0\n\tmov %0, %%cr0"
+                     : "=&r"(value)
+                     : "r"(offset)
+                     : "memory");
+  }
 };
 
-struct Cr2Info : public RegInfoBase {};
+struct Cr2Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mov %%cr2, %0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("mov %0, %%cr2" : : "r"(value) :);
+  }
+
+  /// 置位 offset 指定的位
+  static __always_inline void SetBits(uint64_t offset) {
+    uint64_t value = 0;
+    __asm__ volatile("mov %%cr2, %0\n\tbts %1, %0\n\tmov %0, %%cr2"
+                     : "=&r"(value)
+                     : "r"(offset)
+                     : "memory");
+  }
+
+  /// 清零 offset 指定的位
+  static __always_inline void ClearBits(uint64_t offset) {
+    uint64_t value = 0;
+    __asm__ volatile("mov %%cr2, %0\n\tbtr %1, %0\n\tmov %0, %%cr2"
+                     : "=&r"(value)
+                     : "r"(offset)
+                     : "memory");
+  }
+};
 
 struct Cr3Info : public RegInfoBase {
-  struct Pwt {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 3;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
-
-  struct Pcd {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 4;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
-
-  struct PageDirectoryBase {
-    using DataType = uint64_t;
-    static constexpr uint64_t kBitOffset = 12;
-    static constexpr uint64_t kBitWidth = 52;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Pwt : public BitField<bool, 3, 1> {};
+
+  struct Pcd : public BitField<bool, 4, 1> {};
+
+  struct PageDirectoryBase : public BitField<uint64_t, 12, 40> {};
+
+  /// CR4.PCIDE = 1 时低 12 位为 PCID，与 Pwt/Pcd 重叠
+  struct Pcid : public BitField<uint64_t, 0, 12> {};
+
+  /// 写 CR3 时置位则不刷新该 PCID 的 TLB 项，读出恒为 0
+  struct NoFlush : public BitField<bool, 63, 1> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mov %%cr3, %0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("mov %0, %%cr3" : : "r"(value) :);
+  }
+
+  /// 置位 offset 指定的位
+  static __always_inline void SetBits(uint64_t offset) {
+    uint64_t value = 0;
+    __asm__ volatile("mov %%cr3, %0\n\tbts %1, %0\n\tmov %0, %%cr3"
+                     : "=&r"(value)
+                     : "r"(offset)
+                     : "memory");
+  }
+
+  /// 清零 offset 指定的位
+  static __always_inline void ClearBits(uint64_t offset) {
+    uint64_t value = 0;
+    __asm__ volatile("mov %%cr3, %0\n\tbtr %1, %0\n\tmov %0, %%cr3"
+                     : "=&r"(value)
+                     : "r"(offset)
+                     : "memory");
+  }
 };
 
 struct Cr4Info : public RegInfoBase {
-  struct Pae {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 5;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Pae : public BitField<bool, 5, 1> {};
+
+  struct Pge : public BitField<bool, 7, 1> {};
+
+  struct Pcide : public BitField<bool, 17, 1> {};
+
+  /// 允许任意特权级执行 RDPMC
+  struct Pce : public BitField<bool, 8, 1> {};
+
+  /// 操作系统支持 FXSAVE/FXRSTOR 与 SSE
+  struct Osfxsr : public BitField<bool, 9, 1> {};
+
+  /// 操作系统支持 SIMD 浮点异常 #XM
+  struct Osxmmexcpt : public BitField<bool, 10, 1> {};
+
+  /// 允许使用 RDFSBASE/WRFSBASE/RDGSBASE/WRGSBASE
+  struct Fsgsbase : public BitField<bool, 16, 1> {};
+
+  /// 操作系统支持 XSAVE 与 XGETBV/XSETBV
+  struct Osxsave : public BitField<bool, 18, 1> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mov %%cr4, %0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("mov %0, %%cr4" : : "r"(value) :);
+  }
+
+  /// 置位 offset 指定的位
+  static __always_inline void SetBits(uint64_t offset) {
+    uint64_t value = 0;
+    __asm__ volatile("mov %%cr4, %0\n\tbts %1, %0\n\tmov %0, %%cr4"
+                     : "=&r"(value)
+                     : "r"(offset)
+                     : "memory");
+  }
+
+  /// 清零 offset 指定的位
+  static __always_inline void ClearBits(uint64_t offset) {
+    uint64_t value = 0;
+    __asm__ volatile("mov %%cr4, %0\n\tbtr %1, %0\n\tmov %0, %%cr4"
+                     : "=&r"(value)
+                     : "r"(offset)
+                     : "memory");
+  }
 };
 
-struct Cr8Info : public RegInfoBase {};
+struct Cr8Info : public RegInfoBase {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mov %%cr8, %0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("mov %0, %%cr8" : : "r"(value) :);
+  }
+
+  /// 置位 offset 指定的位
+  static __always_inline void SetBits(uint64_t offset) {
+    uint64_t value = 0;
+    __asm__ volatile("mov %%cr8, %0\n\tbts %1, %0\n\tmov %0, %%cr8"
+                     : "=&r"(value)
+                     : "r"(offset)
+                     : "memory");
+  }
+
+  /// 清零 offset 指定的位
+  static __always_inline void ClearBits(uint64_t offset) {
+    uint64_t value = 0;
+    __asm__ volatile("mov %%cr8, %0\n\tbtr %1, %0\n\tmov %0, %%cr8"
+                     : "=&r"(value)
+                     : "r"(offset)
+                     : "memory");
+  }
+};
 
 }  // namespace cr
 
@@ -570,7 +791,89 @@ struct Cr8Info : public RegInfoBase {};
  * @brief xcr0 寄存器
  * @see sdm.pdf#2.6
  */
-struct Xcr0Info : public RegInfoBase {};
+struct Xcr0Info : public RegInfoBase {
+  /// x87 状态，必须为 1
+  struct X87 : public BitField<bool, 0, 1> {};
+
+  /// SSE 状态 (XMM0-15, MXCSR)
+  struct Sse : public BitField<bool, 1, 1> {};
+
+  /// AVX 状态 (YMM0-15 高 128 位)
+  struct Avx : public BitField<bool, 2, 1> {};
+
+  /// MPX 边界寄存器 (BND0-3)，须与 Bndcsr 同时设置
+  struct Bndregs : public BitField<bool, 3, 1> {};
+
+  /// MPX BNDCFGU/BNDSTATUS，须与 Bndregs 同时设置
+  struct Bndcsr : public BitField<bool, 4, 1> {};
+
+  /// AVX-512 opmask 状态 (k0-k7)
+  struct Opmask : public BitField<bool, 5, 1> {};
+
+  /// AVX-512 ZMM0-15 高 256 位
+  struct ZmmHi256 : public BitField<bool, 6, 1> {};
+
+  /// AVX-512 ZMM16-31
+  struct Hi16Zmm : public BitField<bool, 7, 1> {};
+
+  /// PKRU 状态
+  struct Pkru : public BitField<bool, 9, 1> {};
+
+  /// AMX TILECFG，须与 XtileData 同时设置
+  struct XtileCfg : public BitField<bool, 17, 1> {};
+
+  /// AMX TILEDATA，须与 XtileCfg 同时设置
+  struct XtileData : public BitField<bool, 18, 1> {};
+
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    uint32_t low{};
+    uint32_t high{};
+    __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0) :);
+    return (static_cast<uint64_t>(high) << 32) | low;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    uint32_t low = value & 0xFFFFFFFF;
+    uint32_t high = value >> 32;
+    __asm__ volatile("xsetbv" : : "c"(0), "a"(low), "d"(high) : "memory");
+  }
+
+  /// 置位 offset 指定的位
+  static __always_inline void SetBits(uint64_t offset) {
+    Write(Read() | (1ULL << offset));
+  }
+
+  /// 清零 offset 指定的位
+  static __always_inline void ClearBits(uint64_t offset) {
+    Write(Read() & ~(1ULL << offset));
+  }
+};
+
+/**
+ * @brief FS 段基址
+ * CR4.FSGSBASE 置位时使用 RDFSBASE/WRFSBASE，否则使用 IA32_FS_BASE
+ * @see sdm.pdf#3.4.4
+ */
+struct FsBaseInfo : public RegInfoBase {
+  /// 读寄存器，依赖 FsgsbaseEnabled()，定义见 read_write.hpp
+  static __always_inline auto Read() -> DataType;
+  /// 写寄存器，依赖 FsgsbaseEnabled()，定义见 read_write.hpp
+  static __always_inline void Write(DataType value);
+};
+
+/**
+ * @brief GS 段基址
+ * CR4.FSGSBASE 置位时使用 RDGSBASE/WRGSBASE，否则使用 IA32_GS_BASE
+ * @see sdm.pdf#3.4.4
+ */
+struct GsBaseInfo : public RegInfoBase {
+  /// 读寄存器，依赖 FsgsbaseEnabled()，定义见 read_write.hpp
+  static __always_inline auto Read() -> DataType;
+  /// 写寄存器，依赖 FsgsbaseEnabled()，定义见 read_write.hpp
+  static __always_inline void Write(DataType value);
+};
 
 /**
  * @brief 段寄存器
@@ -587,49 +890,107 @@ namespace segment_register {
 struct SegmentSelector : public RegInfoBase {
   using DataType = uint16_t;
   static constexpr uint64_t kBitWidth = 16;
-  struct Rpl {
-    using DataType = uint8_t;
-    static constexpr uint64_t kBitOffset = 0;
-    static constexpr uint64_t kBitWidth = 2;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Rpl : public BitField<uint8_t, 0, 2> {};
 
-  struct Ti {
-    using DataType = bool;
-    static constexpr uint64_t kBitOffset = 2;
-    static constexpr uint64_t kBitWidth = 1;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Ti : public BitField<bool, 2, 1> {};
 
-  struct Index {
-    using DataType = uint16_t;
-    static constexpr uint64_t kBitOffset = 3;
-    static constexpr uint64_t kBitWidth = 13;
-    static constexpr uint64_t kBitMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-    static constexpr uint64_t kAllSetMask =
-        (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-  };
+  struct Index : public BitField<uint16_t, 3, 13> {};
 };
 
 /// 无法直接写入，通常是在调用远跳转、调用或返回时更改
-struct CsInfo : public SegmentSelector {};
+struct CsInfo : public SegmentSelector {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mov %%cs, %0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    auto JumpFunction = [=](uint16_t value) {
+      __asm__ volatile(
+          "push %0\n\t"
+          "pushq $WriteCsLabel\n\t"
+          "retfq\n\t"
+          "WriteCsLabel: \n\t"
+          :
+          : "r"(value)
+          :);
+    };
+    JumpFunction(value);
+  }
+};
 
-struct SsInfo : public SegmentSelector {};
+struct SsInfo : public SegmentSelector {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mov %%ss, %0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("mov %0, %%ss" : : "r"(value) :);
+  }
+};
 
-struct DsInfo : public SegmentSelector {};
+struct DsInfo : public SegmentSelector {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mov %%ds, %0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("mov %0, %%ds" : : "r"(value) :);
+  }
+};
 
-struct EsInfo : public SegmentSelector {};
+struct EsInfo : public SegmentSelector {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mov %%es, %0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("mov %0, %%es" : : "r"(value) :);
+  }
+};
 
-struct FsInfo : public SegmentSelector {};
+struct FsInfo : public SegmentSelector {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mov %%fs, %0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("mov %0, %%fs" : : "r"(value) :);
+  }
+};
 
-struct GsInfo : public SegmentSelector {};
+struct GsInfo : public SegmentSelector {
+  /// 读寄存器
+  static __always_inline auto Read() -> DataType {
+    DataType value{};
+    __asm__ volatile("mov %%gs, %0" : "=r"(value) : :);
+    return value;
+  }
+
+  /// 写寄存器
+  static __always_inline void Write(DataType value) {
+    __asm__ volatile("mov %0, %%gs" : : "r"(value) :);
+  }
+};
 
 }  // namespace segment_register
 
@@ -7,26 +7,20 @@
 
 #include <cstdint>
 
+#include "../../bit_field.hpp"
+
 namespace cpu_io {
 
 namespace detail {
 
 namespace register_info {
 
-struct RegInfoBase {
-  /// 寄存器数据类型
-  using DataType = uint64_t;
-  /// 起始位
-  static constexpr uint64_t kBitOffset = 0;
-  /// 位宽
-  static constexpr uint64_t kBitWidth = 64;
-  /// 掩码，(val & kBitMask) == 对应当前位的值
-  static constexpr uint64_t kBitMask =
-      (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) << kBitOffset : ~0ULL;
-  /// 对应位置位掩码
-  static constexpr uint64_t kAllSetMask =
-      (kBitWidth < 64) ? ((1ULL << kBitWidth) - 1) : ~0ULL;
-};
+/**
+ * @brief 寄存器描述的基类，整个寄存器视为一个 64 位的字段
+ * 派生的寄存器描述以静态成员 Read()/Write() 等给出该寄存器的访问指令，
+ * read_write.hpp 的访问接口直接调用这些成员并负责跟踪
+ */
+struct RegInfoBase : public BitField<uint64_t, 0, 64> {};
 
 }  // namespace register_info
 
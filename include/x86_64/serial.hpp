@@ -5,6 +5,13 @@
 #ifndef CPU_IO_INCLUDE_X86_64_SERIAL_HPP_
 #define CPU_IO_INCLUDE_X86_64_SERIAL_HPP_
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "../ring_buffer.hpp"
 #include "io.hpp"
 
 namespace cpu_io {
@@ -77,8 +84,70 @@ class Serial {
     Out<uint8_t>(port_, byte);
   }
 
- private:
-  uint32_t port_;
+  /**
+   * @brief 批量写
+   * 每次发送保持寄存器空时一次写入最多 kFifoSize 个字节，
+   * 而不是每个字节都查询一次线路状态
+   * @param data 要写的数据
+   */
+  void Write(std::span<const uint8_t> data) const {
+    while (!data.empty()) {
+      while (!IsTransmitEmpty()) {
+        ;
+      }
+      data = data.subspan(FillFifo(data));
+    }
+  }
+
+  /**
+   * @brief 读一个字节，不等待
+   * @return std::optional<uint8_t> 读取到的数据，没有数据时为空
+   */
+  [[nodiscard]] auto TryRead() const -> std::optional<uint8_t> {
+    if (!SerialReceived()) {
+      return std::nullopt;
+    }
+    return In<uint8_t>(port_);
+  }
+
+  /**
+   * @brief 向发送 FIFO 写入最多 kFifoSize 个字节
+   * @param data 要写的数据
+   * @return size_t 写入的字节数
+   * @pre 发送保持寄存器为空 (THRE)
+   */
+  auto FillFifo(std::span<const uint8_t> data) const -> size_t {
+    auto count = data.size() < kFifoSize ? data.size() : kFifoSize;
+    for (size_t i = 0; i < count; i++) {
+      Out<uint8_t>(port_, data[i]);
+    }
+    return count;
+  }
+
+  /**
+   * @brief 设置中断使能寄存器 (IER)
+   * @param value kIerReceive/kIerTransmit 的组合
+   */
+  void SetInterruptEnable(uint8_t value) const {
+    Out<uint8_t>(port_ + 1, value);
+  }
+
+  /**
+   * @brief 读取中断标识寄存器 (IIR)
+   * @return uint8_t IIR 值
+   */
+  [[nodiscard]] auto GetInterruptId() const -> uint8_t {
+    return In<uint8_t>(port_ + 2);
+  }
+
+  /// 16550A 发送 FIFO 大小
+  static constexpr size_t kFifoSize = 16;
+  /// IER: 接收数据可用中断
+  static constexpr uint8_t kIerReceive = 1U << 0;
+  /// IER: 发送保持寄存器空中断
+  static constexpr uint8_t kIerTransmit = 1U << 1;
+  /// IIR: 没有待处理的中断
+  static constexpr uint8_t kIirNoInterrupt = 1U << 0;
 
   /**
    * @brief 串口是否接收到数据
@@ -97,6 +166,119 @@ class Serial {
   [[nodiscard]] auto IsTransmitEmpty() const -> bool {
     return bool((In<uint8_t>(port_ + 5) & 0x20) != 0);
   }
+
+ private:
+  uint32_t port_;
+};
+
+/**
+ * 中断驱动的缓冲串口
+ * 发送与接收各使用一个单生产者单消费者环形缓冲区。Write() 只写入发送
+ * 缓冲区并打开 THRE 中断，HandleInterrupt() 在每次 THRE 时向 FIFO
+ * 写入最多 16 个字节，并把接收到的数据放入接收缓冲区
+ * @tparam kTxSize 发送缓冲区大小，必须是 2 的幂
+ * @tparam kRxSize 接收缓冲区大小，必须是 2 的幂
+ * @note 串口中断 (COM1 为 IRQ 4) 需由调用者通过 Pic 或 IoApic 路由，
+ * 并在中断处理中调用 HandleInterrupt() 后发送 EOI。
+ * Write() 与 Read() 各自只允许一个调用者，多核输出时需由调用者串行化
+ */
+template <size_t kTxSize = 4096, size_t kRxSize = 256>
+class BufferedSerial {
+ public:
+  /**
+   * 构造函数
+   * @param port 串口端口
+   */
+  explicit BufferedSerial(uint32_t port) : serial_(port) {
+    serial_.SetInterruptEnable(Serial::kIerReceive);
+  }
+
+  /// @name 构造/析构函数
+  /// @{
+  BufferedSerial() = delete;
+  BufferedSerial(const BufferedSerial&) = delete;
+  BufferedSerial(BufferedSerial&&) = delete;
+  auto operator=(const BufferedSerial&) -> BufferedSerial& = delete;
+  auto operator=(BufferedSerial&&) -> BufferedSerial& = delete;
+  ~BufferedSerial() = default;
+  /// @}
+
+  /**
+   * @brief 写入发送缓冲区，不等待硬件
+   * @param data 要写的数据
+   * @return size_t 放入缓冲区的字节数，缓冲区满时小于 data.size()
+   */
+  auto Write(std::span<const uint8_t> data) -> size_t {
+    auto count = tx_.Push(data);
+    if (count != 0) {
+      // 发送保持寄存器为空时，打开 THRE 中断会立即触发一次中断
+      serial_.SetInterruptEnable(Serial::kIerReceive | Serial::kIerTransmit);
+    }
+    return count;
+  }
+
+  /**
+   * @brief 从接收缓冲区读取，不等待硬件
+   * @param data 输出缓冲区
+   * @return size_t 读取的字节数
+   */
+  auto Read(std::span<uint8_t> data) -> size_t { return rx_.Pop(data); }
+
+  /**
+   * @brief 串口中断处理
+   * 接收 FIFO 中的数据全部移入接收缓冲区，接收缓冲区满时丢弃；
+   * 发送 FIFO 空时写入最多 16 个字节，发送缓冲区为空时关闭 THRE 中断
+   */
+  void HandleInterrupt() {
+    while ((serial_.GetInterruptId() & Serial::kIirNoInterrupt) == 0) {
+      while (auto byte = serial_.TryRead()) {
+        rx_.Push(*byte);
+      }
+      Transmit();
+    }
+  }
+
+  /**
+   * @brief 获取发送缓冲区中尚未发送的字节数
+   * @return size_t 字节数
+   */
+  [[nodiscard]] auto GetPendingTx() const -> size_t { return tx_.Size(); }
+
+ private:
+  /// 底层串口
+  Serial serial_;
+  /// 发送缓冲区，生产者为 Write()，消费者为中断处理
+  SpscRing<uint8_t, kTxSize> tx_;
+  /// 接收缓冲区，生产者为中断处理，消费者为 Read()
+  SpscRing<uint8_t, kRxSize> rx_;
+
+  /**
+   * @brief 发送 FIFO 空时从发送缓冲区填充
+   */
+  void Transmit() {
+    if (!IsTransmitEmpty()) {
+      return;
+    }
+    std::array<uint8_t, Serial::kFifoSize> chunk;
+    auto count = tx_.Pop(chunk);
+    if (count != 0) {
+      serial_.FillFifo(std::span<const uint8_t>(chunk.data(), count));
+      return;
+    }
+    serial_.SetInterruptEnable(Serial::kIerReceive);
+    // 关闭 THRE 中断与 Write() 之间可能有新数据写入
+    if (!tx_.IsEmpty()) {
+      serial_.SetInterruptEnable(Serial::kIerReceive | Serial::kIerTransmit);
+    }
+  }
+
+  /**
+   * @brief 发送保持寄存器是否为空
+   * @return true 为空
+   */
+  [[nodiscard]] auto IsTransmitEmpty() const -> bool {
+    return serial_.IsTransmitEmpty();
+  }
 };
 
 }  // namespace cpu_io
@@ -5,13 +5,105 @@
 #ifndef CPU_IO_INCLUDE_X86_64_VIRTUAL_MEMORY_HPP_
 #define CPU_IO_INCLUDE_X86_64_VIRTUAL_MEMORY_HPP_
 
+#include <array>
 #include <cstdint>
 #include <cstdlib>
 
+#include "cpuid.hpp"
+#include "msr.h"
 #include "regs.hpp"
 
 namespace cpu_io {
 
+namespace detail {
+
+namespace tlb {
+
+/// INVPCID 失效类型
+enum class InvpcidType : uint64_t {
+  /// 单个地址，指定 PCID
+  kAddress = 0,
+  /// 指定 PCID 的所有非全局项
+  kSingleContext = 1,
+  /// 所有 PCID 的所有项，包括全局项
+  kAllContextGlobal = 2,
+  /// 所有 PCID 的所有非全局项
+  kAllContext = 3,
+};
+
+/**
+ * @brief 执行 INVPCID 指令
+ * @param type 失效类型
+ * @param pcid 进程上下文标识符
+ * @param virtual_addr 虚拟地址，仅 kAddress 类型使用
+ */
+static __always_inline void Invpcid(InvpcidType type, uint64_t pcid,
+                                    uint64_t virtual_addr = 0) {
+  struct {
+    uint64_t pcid;
+    uint64_t addr;
+  } descriptor = {pcid, virtual_addr};
+  __asm__ volatile("invpcid %0, %1"
+                   :
+                   : "m"(descriptor), "r"(static_cast<uint64_t>(type))
+                   : "memory");
+}
+
+/**
+ * @brief 刷新所有 PCID 的 TLB，包括全局项
+ * @note 不支持 INVPCID 时通过翻转 CR4.PGE 实现
+ */
+static __always_inline void FlushAllContexts() {
+  if (cpuid::HasInvpcid()) {
+    Invpcid(InvpcidType::kAllContextGlobal, 0);
+    return;
+  }
+  auto cr4 = regs::cr::Cr4::Read();
+  regs::cr::Cr4::Write(cr4 ^ register_info::cr::Cr4Info::Pge::kBitMask);
+  regs::cr::Cr4::Write(cr4);
+}
+
+}  // namespace tlb
+
+namespace cache {
+
+/**
+ * @brief 修改内存类型前关闭缓存
+ * 置 CR0.CD、清 CR0.NW，写回并失效缓存，再刷新 TLB
+ * @return uint64_t 修改前的 CR4，用于 Enable()
+ * @see sdm.pdf#11.11.7.2 MemTypeSet() Function
+ */
+static __always_inline auto Disable() -> uint64_t {
+  using Cr0Info = register_info::cr::Cr0Info;
+  using Cr4Info = register_info::cr::Cr4Info;
+  auto cr0 = regs::cr::Cr0::Read();
+  regs::cr::Cr0::Write((cr0 | Cr0Info::Cd::kBitMask) &
+                       ~Cr0Info::Nw::kBitMask);
+  __asm__ volatile("wbinvd" ::: "memory");
+  auto cr4 = regs::cr::Cr4::Read();
+  if ((cr4 & Cr4Info::Pge::kBitMask) != 0) {
+    regs::cr::Cr4::Write(cr4 & ~Cr4Info::Pge::kBitMask);
+  } else {
+    regs::cr::Cr3::Write(regs::cr::Cr3::Read());
+  }
+  return cr4;
+}
+
+/**
+ * @brief 修改内存类型后重新开启缓存
+ * @param cr4 Disable() 的返回值
+ */
+static __always_inline void Enable(uint64_t cr4) {
+  __asm__ volatile("wbinvd" ::: "memory");
+  regs::cr::Cr3::Write(regs::cr::Cr3::Read());
+  regs::cr::Cr0::Cd::Clear();
+  regs::cr::Cr4::Write(cr4);
+}
+
+}  // namespace cache
+
+}  // namespace detail
+
 namespace virtual_memory {
 
 /// 页表项位偏移定义
@@ -27,6 +119,10 @@ static constexpr uint8_t kGlobalOffset = 8;
 // Software defined bits (Available to software in x86_64: bits 9-11)
 static constexpr uint8_t kReadOffset = 9;
 static constexpr uint8_t kExecOffset = 10;
+static constexpr uint8_t kPatOffset = 11;
+/// PAT 位在 4KB 页表项与大页页表项中的位置
+static constexpr uint8_t kPtePatOffset = 7;
+static constexpr uint8_t kLargePatOffset = 12;
 
 /// 页表项权限位定义
 static constexpr uint64_t kValid = 1ULL << kValidOffset;
@@ -40,6 +136,45 @@ static constexpr uint64_t kHugePage = 1ULL << kHugePageOffset;
 static constexpr uint64_t kGlobal = 1ULL << kGlobalOffset;
 static constexpr uint64_t kRead = 1ULL << kReadOffset;
 static constexpr uint64_t kExec = 1ULL << kExecOffset;
+/// 软件位：PAT 索引的最高位，CreateBlockEntry() 时复制到对应级别的 PAT 位
+static constexpr uint64_t kPat = 1ULL << kPatOffset;
+static constexpr uint64_t kPtePat = 1ULL << kPtePatOffset;
+static constexpr uint64_t kLargePat = 1ULL << kLargePatOffset;
+
+/**
+ * @brief 内存类型，值为 ConfigurePat() 安装的 PAT 索引
+ * 0~3 与上电默认值相同；上电默认的 PA4 为写回、PA5 为写透，
+ * 未调用 ConfigurePat() 时 kWriteCombining 按写回、kWriteProtect 按写透生效
+ */
+enum class MemoryType : uint8_t {
+  /// 写回，普通内存
+  kWriteBack = 0,
+  /// 写透
+  kWriteThrough = 1,
+  /// 不缓存，可被 MTRR 的 WC 覆盖
+  kUncachedMinus = 2,
+  /// 不缓存，强序，适用于 MMIO
+  kUncached = 3,
+  /// 写合并，适用于帧缓冲与设备环形缓冲区
+  kWriteCombining = 4,
+  /// 写保护
+  kWriteProtect = 5,
+};
+
+/// PAT 内存类型编码
+static constexpr uint64_t kPatUncached = 0x00;
+static constexpr uint64_t kPatWriteCombining = 0x01;
+static constexpr uint64_t kPatWriteThrough = 0x04;
+static constexpr uint64_t kPatWriteProtect = 0x05;
+static constexpr uint64_t kPatWriteBack = 0x06;
+static constexpr uint64_t kPatUncachedMinus = 0x07;
+
+/// 与 MemoryType 对应的 IA32_PAT，PA6/PA7 保留默认值
+static constexpr uint64_t kPatLayout =
+    (kPatWriteBack << 0) | (kPatWriteThrough << 8) |
+    (kPatUncachedMinus << 16) | (kPatUncached << 24) |
+    (kPatWriteCombining << 32) | (kPatWriteProtect << 40) |
+    (kPatUncachedMinus << 48) | (kPatUncached << 56);
 
 /// 页大小常量 (4KB)
 static constexpr size_t kPageSize = 4096;
@@ -57,6 +192,30 @@ static constexpr size_t kVpnBits = 9;
 static constexpr size_t kVpnMask = 0x1FF;
 /// 页表级数（四级页表）
 static constexpr size_t kPageTableLevels = 4;
+/// FlushTLBRange 的默认阈值，超过该页数时改为整体刷新
+static constexpr size_t kFlushTLBRangeThreshold = 64;
+
+/**
+ * @brief 安装 kPatLayout，使 MemoryType 的每个值生效
+ * @pre 已关闭中断；需在每个核心上以相同的值调用
+ * @see sdm.pdf#11.12.4 Programming the PAT
+ */
+static __always_inline void ConfigurePat() {
+  auto cr4 = detail::cache::Disable();
+  detail::regs::Msr::Write(msr::kIa32Pat, kPatLayout);
+  detail::cache::Enable(cr4);
+}
+
+/**
+ * @brief 获取内存类型对应的页表项标志
+ * @param memory_type 内存类型
+ * @return uint64_t PWT/PCD/kPat 的组合
+ */
+static constexpr auto GetMemoryTypeFlags(MemoryType memory_type) -> uint64_t {
+  auto index = static_cast<uint8_t>(memory_type);
+  return ((index & 1) ? kWriteThrough : 0) | ((index & 2) ? kCacheDisable : 0) |
+         ((index & 4) ? kPat : 0);
+}
 
 /**
  * @brief 开启分页
@@ -93,6 +252,49 @@ static __always_inline auto GetPageDirectory() -> uint64_t {
          << detail::register_info::cr::Cr3Info::PageDirectoryBase::kBitOffset;
 }
 
+/**
+ * @brief 在当前核心开启 PCID (CR4.PCIDE)
+ * @return true 支持 PCID 且已开启
+ * @return false 不支持 PCID
+ * @pre 当前 CR3[11:0] 为 0，否则置位 PCIDE 会触发 #GP
+ * @note 每个核心都需要调用一次
+ */
+static __always_inline auto EnablePcid() -> bool {
+  if (!cpuid::HasPcid()) {
+    return false;
+  }
+  detail::regs::cr::Cr4::Pcide::Set();
+  return true;
+}
+
+/**
+ * @brief 切换地址空间，CR3 中同时带上 PCID
+ * @param pgd 页表物理地址
+ * @param pcid 地址空间对应的 PCID（0-4095）
+ * @param preserve 为 true 时置 CR3 bit 63，保留该 PCID 已缓存的 TLB 项；
+ * PCID 刚被分配给新的地址空间时必须为 false
+ * @pre EnablePcid() 已在当前核心成功调用，否则 pcid 必须为 0 且 preserve 为
+ * false
+ */
+static __always_inline void SwitchAddressSpace(uint64_t pgd, uint16_t pcid,
+                                               bool preserve) {
+  using Cr3Info = detail::register_info::cr::Cr3Info;
+  auto value = (pgd & Cr3Info::PageDirectoryBase::kBitMask) |
+               (pcid & Cr3Info::Pcid::kBitMask);
+  if (preserve) {
+    value |= Cr3Info::NoFlush::kBitMask;
+  }
+  detail::regs::cr::Cr3::Write(value);
+}
+
+/**
+ * @brief 获取当前 PCID
+ * @return uint16_t CR3[11:0]
+ */
+static __always_inline auto GetCurrentPcid() -> uint16_t {
+  return static_cast<uint16_t>(detail::regs::cr::Cr3::Pcid::Get());
+}
+
 /**
  * @brief 物理地址转换为页表项
  * @param physical_addr 物理地址
@@ -148,6 +350,57 @@ static __always_inline auto GetPageTableLevelShift(size_t level) -> size_t {
   return kPageOffsetBits + (level * kVpnBits);
 }
 
+/**
+ * @brief 获取指定级别页表项映射的大小
+ * @param level 页表级别，0 为 4KB 页
+ * @return uint64_t 映射大小
+ */
+static __always_inline auto GetLevelPageSize(size_t level) -> uint64_t {
+  return 1ULL << GetPageTableLevelShift(level);
+}
+
+/**
+ * @brief 获取可用于大页映射的最高页表级别
+ * @return size_t 1 表示支持 2MB 大页，2 表示还支持 1GB 大页
+ */
+static __always_inline auto GetMaxBlockLevel() -> size_t {
+  return cpuid::HasPage1Gb() ? 2 : 1;
+}
+
+/**
+ * @brief 创建指定级别的叶子页表项
+ * level 大于 0 时置 PS 位，生成 2MB PDE 或 1GB PDPTE
+ * @param level 页表级别
+ * @param physical_addr 物理地址，需按 GetLevelPageSize(level) 对齐
+ * @param flags 页表项标志位，同 PhysicalToPageTableEntry
+ * @return uint64_t 页表项值
+ */
+static __always_inline auto CreateBlockEntry(size_t level,
+                                             uint64_t physical_addr,
+                                             uint64_t flags) -> uint64_t {
+  // 4KB 页表项的 bit 7 为 PAT 位，而非 PS 位；大页的 PAT 位在 bit 12
+  if (level > 0) {
+    return PhysicalToPageTableEntry(physical_addr, flags | kHugePage) |
+           ((flags & kPat) ? kLargePat : 0);
+  }
+  flags &= ~kHugePage;
+  if (flags & kPat) {
+    flags |= kPtePat;
+  }
+  return PhysicalToPageTableEntry(physical_addr, flags);
+}
+
+/**
+ * @brief 检查页表项是否为有效的叶子项（4KB 页或大页）
+ * @param pte 页表项
+ * @param level 页表项所在的级别
+ * @return true 叶子页表项
+ * @return false 无效项或指向下一级页表
+ */
+static __always_inline auto IsLeafEntry(uint64_t pte, size_t level) -> bool {
+  return IsPageTableEntryValid(pte) && (level == 0 || (pte & kHugePage) != 0);
+}
+
 /**
  * @brief 虚拟地址转物理地址（简单的内核空间映射）
  * @param virtual_addr 虚拟地址
@@ -213,13 +466,15 @@ static __always_inline auto GetPageOffset(uint64_t addr) -> uint64_t {
  * @param executable 可执行标志
  * @param user_accessible 用户可访问标志
  * @param global 全局标志
+ * @param memory_type 内存类型
  * @return uint64_t 页表项
  */
 static __always_inline auto CreatePageTableEntry(
     uint64_t physical_addr, bool readable = true, bool writable = false,
-    bool executable = false, bool user_accessible = false, bool global = false)
-    -> uint64_t {
-  uint64_t flags = kValid;
+    bool executable = false, bool user_accessible = false, bool global = false,
+    MemoryType memory_type = MemoryType::kWriteBack) -> uint64_t {
+  uint64_t flags = kValid | GetMemoryTypeFlags(memory_type);
+  if (flags & kPat) flags |= kPtePat;
   if (readable) flags |= kRead;
   if (writable) flags |= kWrite;
   if (executable) flags |= kExec;  // Software bit, also implies NX=0 (default)
@@ -262,11 +517,19 @@ static __always_inline auto CheckPageTableEntryPermissions(
 /**
  * @brief 刷新特定地址的 TLB
  * @param virtual_addr 要刷新的虚拟地址
- * @param asid 地址空间标识符（当前忽略）
+ * @param asid 地址空间标识符 (PCID)，0 表示当前地址空间
+ * @note 非 0 的 PCID 需要 INVPCID，不支持时刷新所有上下文
  */
-static __always_inline void FlushTLBAddress(
-    uint64_t virtual_addr, [[maybe_unused]] uint64_t asid = 0) {
-  __asm__ volatile("invlpg (%0)" : : "r"(virtual_addr) : "memory");
+static __always_inline void FlushTLBAddress(uint64_t virtual_addr,
+                                            uint64_t asid = 0) {
+  if (asid == 0) {
+    __asm__ volatile("invlpg (%0)" : : "r"(virtual_addr) : "memory");
+  } else if (cpuid::HasInvpcid()) {
+    detail::tlb::Invpcid(detail::tlb::InvpcidType::kAddress, asid,
+                         virtual_addr);
+  } else {
+    detail::tlb::FlushAllContexts();
+  }
 }
 
 /**
@@ -278,6 +541,20 @@ static __always_inline void FlushTLBAll() {
   __asm__ volatile("mov %%cr3, %0; mov %0, %%cr3" : "=r"(val) : : "memory");
 }
 
+/**
+ * @brief 刷新指定地址空间的所有 TLB 条目（不含全局项）
+ * @param asid 地址空间标识符 (PCID)，0 表示当前地址空间
+ */
+static __always_inline void FlushTLBAsid(uint64_t asid) {
+  if (asid == 0) {
+    FlushTLBAll();
+  } else if (cpuid::HasInvpcid()) {
+    detail::tlb::Invpcid(detail::tlb::InvpcidType::kSingleContext, asid);
+  } else {
+    detail::tlb::FlushAllContexts();
+  }
+}
+
 /**
  * @brief 计算地址范围包含的页数
  * @param start_addr 起始地址
@@ -291,6 +568,41 @@ static __always_inline auto GetPageCount(uint64_t start_addr, uint64_t end_addr)
   return (aligned_end - aligned_start) / kPageSize;
 }
 
+/**
+ * @brief 刷新虚拟地址范围内的 TLB
+ * @param start_addr 起始虚拟地址
+ * @param end_addr 结束虚拟地址（不包含）
+ * @param asid 地址空间标识符 (PCID)，0 表示当前地址空间
+ * @param threshold 页数超过该值时改为刷新整个地址空间
+ * @note 当前地址空间逐页 invlpg；其它 PCID 使用 INVPCID，
+ * 不支持时刷新所有上下文
+ */
+static __always_inline void FlushTLBRange(
+    uint64_t start_addr, uint64_t end_addr, uint64_t asid = 0,
+    size_t threshold = kFlushTLBRangeThreshold) {
+  auto page_count = GetPageCount(start_addr, end_addr);
+  if (page_count == 0) {
+    return;
+  }
+  if (page_count > threshold) {
+    FlushTLBAsid(asid);
+    return;
+  }
+  if (asid != 0 && !cpuid::HasInvpcid()) {
+    detail::tlb::FlushAllContexts();
+    return;
+  }
+
+  auto addr = PageAlign(start_addr);
+  for (size_t i = 0; i < page_count; i++, addr += kPageSize) {
+    if (asid == 0) {
+      __asm__ volatile("invlpg (%0)" : : "r"(addr) : "memory");
+    } else {
+      detail::tlb::Invpcid(detail::tlb::InvpcidType::kAddress, asid, addr);
+    }
+  }
+}
+
 /**
  * @brief 获取页表中间项权限
  * @return uint8_t 页表中间项权限标志
@@ -310,14 +622,14 @@ static __always_inline auto GetTableEntryPermissions() -> uint64_t {
  * @param writable 可写标志
  * @param executable 可执行标志
  * @param global 全局标志
+ * @param memory_type 内存类型
  * @return uint64_t 内核页表权限标志
  */
-static __always_inline auto GetKernelPagePermissions(bool readable = true,
-                                                     bool writable = true,
-                                                     bool executable = true,
-                                                     bool global = true)
+static __always_inline auto GetKernelPagePermissions(
+    bool readable = true, bool writable = true, bool executable = true,
+    bool global = true, MemoryType memory_type = MemoryType::kWriteBack)
     -> uint64_t {
-  uint64_t flags = kValid;
+  uint64_t flags = kValid | GetMemoryTypeFlags(memory_type);
   if (readable) {
     flags |= kRead;
   }
@@ -341,15 +653,15 @@ static __always_inline auto GetKernelPagePermissions(bool readable = true,
  * @param writable 可写标志
  * @param executable 可执行标志
  * @param global 全局标志
+ * @param memory_type 内存类型
  * @return uint64_t 用户页表权限标志
  */
-static __always_inline auto GetUserPagePermissions(bool readable = true,
-                                                   bool writable = false,
-                                                   bool executable = false,
-                                                   bool global = false)
+static __always_inline auto GetUserPagePermissions(
+    bool readable = true, bool writable = false, bool executable = false,
+    bool global = false, MemoryType memory_type = MemoryType::kWriteBack)
     -> uint64_t {
   // User pages must have User bit
-  uint64_t flags = kValid | kUser;
+  uint64_t flags = kValid | kUser | GetMemoryTypeFlags(memory_type);
   if (readable) {
     flags |= kRead;
   }
@@ -366,7 +678,125 @@ static __always_inline auto GetUserPagePermissions(bool readable = true,
   return flags;
 }
 
+/**
+ * @brief 单核心的 PCID 分配器，按 LRU 在 kSlots 个 PCID 间轮换
+ * 地址空间以非 0 的 id（如页表物理地址）标识，PCID 0 保留给未使用 PCID 的
+ * 场景。命中时切换可保留 TLB 项，换出或失效后再次使用时需要刷新
+ * @tparam kSlots 每个核心同时缓存的地址空间数量
+ * @note 不是线程安全的，每个核心应持有自己的实例
+ */
+template <size_t kSlots = 6>
+class PcidAllocator {
+ public:
+  static_assert(kSlots > 0 && kSlots < 4096);
+
+  /// 分配结果
+  struct Result {
+    /// 分配到的 PCID（1 - kSlots）
+    uint16_t pcid;
+    /// 该 PCID 上的 TLB 项是否需要刷新
+    bool need_flush;
+  };
+
+  /// @name 构造/析构函数
+  /// @{
+  PcidAllocator() = default;
+  PcidAllocator(const PcidAllocator &) = delete;
+  PcidAllocator(PcidAllocator &&) = delete;
+  auto operator=(const PcidAllocator &) -> PcidAllocator & = delete;
+  auto operator=(PcidAllocator &&) -> PcidAllocator & = delete;
+  ~PcidAllocator() = default;
+  /// @}
+
+  /**
+   * @brief 获取地址空间对应的 PCID，未命中时换出最久未使用的 PCID
+   * @param id 地址空间标识，非 0
+   * @return Result 分配结果
+   */
+  auto Get(uint64_t id) -> Result {
+    size_t victim = 0;
+    for (size_t i = 0; i < kSlots; i++) {
+      if (owners_[i] == id) {
+        last_use_[i] = ++clock_;
+        return {static_cast<uint16_t>(i + 1), false};
+      }
+      if (last_use_[i] < last_use_[victim]) {
+        victim = i;
+      }
+    }
+    owners_[victim] = id;
+    last_use_[victim] = ++clock_;
+    return {static_cast<uint16_t>(victim + 1), true};
+  }
+
+  /**
+   * @brief 切换到 id 对应的地址空间
+   * @param id 地址空间标识，非 0
+   * @param pgd 页表物理地址
+   * @return uint16_t 使用的 PCID
+   */
+  auto Switch(uint64_t id, uint64_t pgd) -> uint16_t {
+    auto result = Get(id);
+    SwitchAddressSpace(pgd, result.pcid, !result.need_flush);
+    return result.pcid;
+  }
+
+  /**
+   * @brief 使 id 的缓存失效，下次 Get 时重新分配并刷新
+   * @param id 地址空间标识
+   * @note 地址空间销毁，或其映射在本核心未被刷新地修改后调用
+   */
+  void Invalidate(uint64_t id) {
+    for (size_t i = 0; i < kSlots; i++) {
+      if (owners_[i] == id) {
+        owners_[i] = 0;
+        last_use_[i] = 0;
+      }
+    }
+  }
+
+ private:
+  /// 每个 PCID 当前对应的地址空间，0 表示空闲
+  std::array<uint64_t, kSlots> owners_{};
+  /// 每个 PCID 最近一次使用的时间戳
+  std::array<uint64_t, kSlots> last_use_{};
+  /// 单调递增的时间戳
+  uint64_t clock_ = 0;
+};
+
 }  // namespace virtual_memory
+
+namespace detail::tlb {
+
+/**
+ * @brief TlbBatch 使用的 x86_64 失效操作
+ */
+struct BatchFlushPolicy {
+  /// 没有 INVPCID 时无法按 PCID 逐页失效，只能刷新所有上下文
+  static __always_inline auto ShouldFlushAll(size_t pages, size_t threshold,
+                                             uint64_t asid) -> bool {
+    return pages > threshold || (asid != 0 && !cpuid::HasInvpcid());
+  }
+
+  static __always_inline void FlushAll(uint64_t asid) {
+    virtual_memory::FlushTLBAsid(asid);
+  }
+
+  /// ranges 为 TlbRange 序列，定义见 tlb_batch.hpp
+  template <class Ranges>
+  static __always_inline void FlushRanges(const Ranges &ranges,
+                                          uint64_t asid) {
+    for (const auto &range : ranges) {
+      for (auto addr = range.start; addr < range.end;
+           addr += virtual_memory::kPageSize) {
+        virtual_memory::FlushTLBAddress(addr, asid);
+      }
+    }
+  }
+};
+
+}  // namespace detail::tlb
+
 }  // namespace cpu_io
 
 #endif  // CPU_IO_INCLUDE_X86_64_VIRTUAL_MEMORY_HPP_
@@ -0,0 +1,87 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#include "bit_field.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+namespace {
+
+using cpu_io::detail::BitField;
+using cpu_io::detail::EncodeFields;
+using cpu_io::detail::kFieldsDisjoint;
+
+using Low = BitField<uint8_t, 0, 4>;
+using Mid = BitField<uint8_t, 4, 2>;
+using Flag = BitField<bool, 8, 1>;
+using Top = BitField<bool, 63, 1>;
+using Whole = BitField<uint64_t, 0, 64>;
+
+TEST(BitFieldTest, Masks) {
+  EXPECT_EQ(Mid::kBitOffset, 4);
+  EXPECT_EQ(Mid::kBitWidth, 2);
+  EXPECT_EQ(Mid::kAllSetMask, 0x3);
+  EXPECT_EQ(Mid::kBitMask, 0x30);
+  EXPECT_EQ(Top::kBitMask, 1ULL << 63);
+  EXPECT_EQ(Whole::kAllSetMask, ~0ULL);
+  EXPECT_EQ(Whole::kBitMask, ~0ULL);
+}
+
+TEST(BitFieldTest, Encode) {
+  EXPECT_EQ(Mid::Encode(2), 0x20);
+  // 超出位宽的部分被丢弃
+  EXPECT_EQ(Mid::Encode(0xFF), 0x30);
+  EXPECT_EQ(Flag::Encode(true), 0x100);
+  EXPECT_EQ(Flag::Encode(false), 0);
+  EXPECT_EQ(Top::Encode(true), 1ULL << 63);
+  EXPECT_EQ(Whole::Encode(0x123456789ABCDEF0), 0x123456789ABCDEF0);
+}
+
+TEST(BitFieldTest, Decode) {
+  EXPECT_EQ(Mid::Decode(0xFF), 0x3);
+  EXPECT_EQ(Mid::Decode(0x20), 0x2);
+  EXPECT_EQ(Mid::Decode(0xCF), 0x0);
+  EXPECT_TRUE(Flag::Decode(0x100));
+  EXPECT_FALSE(Flag::Decode(0xFF));
+  EXPECT_TRUE(Top::Decode(1ULL << 63));
+  EXPECT_EQ(Whole::Decode(~0ULL), ~0ULL);
+}
+
+TEST(BitFieldTest, Insert) {
+  EXPECT_EQ(Mid::Insert(0xFF, 1), 0xDF);
+  EXPECT_EQ(Mid::Insert(0x00, 3), 0x30);
+  EXPECT_EQ(Mid::Insert(0xFF, 0xFF), 0xFF);
+  EXPECT_EQ(Flag::Insert(~0ULL, false), ~0x100ULL);
+  EXPECT_EQ(Top::Insert(0, true), 1ULL << 63);
+  EXPECT_EQ(Whole::Insert(0x1234, 0x5678), 0x5678);
+}
+
+TEST(BitFieldTest, RoundTrip) {
+  for (uint8_t value = 0; value < 16; value++) {
+    EXPECT_EQ(Low::Decode(Low::Encode(value)), value);
+    EXPECT_EQ(Low::Decode(Low::Insert(~0ULL, value)), value);
+  }
+}
+
+TEST(BitFieldTest, EncodeFields) {
+  EXPECT_EQ((EncodeFields<Low, Flag>(0xA, true)), 0x10A);
+  EXPECT_EQ((EncodeFields<Low, Mid, Flag, Top>(0xF, 0x1, false, true)),
+            (1ULL << 63) | 0x1F);
+  EXPECT_EQ((EncodeFields<Mid>(0x3)), 0x30);
+  EXPECT_EQ(EncodeFields<>(), 0);
+  static_assert(EncodeFields<Low, Flag>(0xA, true) == 0x10A);
+}
+
+TEST(BitFieldTest, OverlapRejected) {
+  EXPECT_TRUE((kFieldsDisjoint<Low, Mid, Flag, Top>));
+  EXPECT_TRUE((kFieldsDisjoint<Whole>));
+  EXPECT_TRUE(kFieldsDisjoint<>);
+  EXPECT_FALSE((kFieldsDisjoint<Low, BitField<uint8_t, 3, 2>>));
+  EXPECT_FALSE((kFieldsDisjoint<Whole, Flag>));
+  EXPECT_FALSE((kFieldsDisjoint<Flag, Flag>));
+}
+
+}  // namespace
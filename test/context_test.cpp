@@ -0,0 +1,68 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "cpu_io.h"
+
+namespace {
+
+using cpu_io::CalleeSavedContext;
+using cpu_io::SwitchTo;
+using cpu_io::ThreadEntry;
+
+constexpr int kRounds = 3;
+
+/// 线程栈，刻意不按 16 字节对齐栈顶以检查 ThreadEntry() 的对齐
+alignas(16) uint8_t thread_stack[64 * 1024];
+
+CalleeSavedContext main_context;
+CalleeSavedContext thread_context;
+
+void *received_argument;
+uint64_t entry_frame;
+uint64_t entry_caller_frame;
+int thread_steps;
+
+[[noreturn]] void ThreadMain(void *argument) {
+  received_argument = argument;
+  auto *frame = static_cast<uint64_t *>(__builtin_frame_address(0));
+  entry_frame = reinterpret_cast<uint64_t>(frame);
+  entry_caller_frame = *frame;
+  while (true) {
+    thread_steps++;
+    SwitchTo(&thread_context, &main_context);
+  }
+}
+
+TEST(ContextTest, SwitchToThreadEntryRoundTrip) {
+  int argument = 0;
+  thread_context = {};
+  thread_context.ReturnAddress() = reinterpret_cast<uint64_t>(&ThreadEntry);
+  thread_context.StackPointer() =
+      reinterpret_cast<uint64_t>(thread_stack + sizeof(thread_stack) - 8);
+  thread_context.EntryFunction() = reinterpret_cast<uint64_t>(&ThreadMain);
+  thread_context.EntryArgument() = reinterpret_cast<uint64_t>(&argument);
+
+  // 跨越切换保存的局部变量依赖 callee-saved 寄存器被恢复
+  volatile uint64_t marker = 0x5A5A5A5A5A5A5A5A;
+  for (int i = 1; i <= kRounds; i++) {
+    SwitchTo(&main_context, &thread_context);
+    EXPECT_EQ(thread_steps, i);
+  }
+  EXPECT_EQ(marker, 0x5A5A5A5A5A5A5A5A);
+
+  EXPECT_EQ(received_argument, &argument);
+  // 入口函数调用前 rsp 已按 16 字节对齐，压入返回地址与 rbp 后仍对齐
+  EXPECT_EQ(entry_frame % 16, 0);
+  EXPECT_GT(entry_frame, reinterpret_cast<uint64_t>(thread_stack));
+  EXPECT_LT(entry_frame,
+            reinterpret_cast<uint64_t>(thread_stack + sizeof(thread_stack)));
+  // rbp 被清零，栈回溯在入口处结束
+  EXPECT_EQ(entry_caller_frame, 0);
+}
+
+}  // namespace
@@ -0,0 +1,224 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#include "page_table.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using cpu_io::virtual_memory::GetLevelPageSize;
+using cpu_io::virtual_memory::kPageSize;
+using cpu_io::virtual_memory::kPageTableLevels;
+using cpu_io::virtual_memory::PageTable;
+
+/// 主机上虚拟地址即物理地址，从堆中分配清零的页表页
+class FakeAllocator {
+ public:
+  FakeAllocator() = default;
+  FakeAllocator(const FakeAllocator &) = delete;
+  FakeAllocator(FakeAllocator &&) = delete;
+  auto operator=(const FakeAllocator &) -> FakeAllocator & = delete;
+  auto operator=(FakeAllocator &&) -> FakeAllocator & = delete;
+  ~FakeAllocator() {
+    for (auto *page : pages_) {
+      std::free(page);
+    }
+  }
+
+  auto Allocate() -> void * {
+    if (pages_.size() >= limit_) {
+      return nullptr;
+    }
+    auto *page = std::aligned_alloc(kPageSize, kPageSize);
+    std::memset(page, 0, kPageSize);
+    pages_.push_back(page);
+    return page;
+  }
+
+  [[nodiscard]] auto Count() const -> size_t { return pages_.size(); }
+
+  void SetLimit(size_t limit) { limit_ = limit; }
+
+ private:
+  std::vector<void *> pages_;
+  size_t limit_ = SIZE_MAX;
+};
+
+constexpr uint64_t kFlags =
+    cpu_io::virtual_memory::kValid | cpu_io::virtual_memory::kWrite;
+constexpr uint64_t kReadOnlyFlags = cpu_io::virtual_memory::kValid;
+constexpr uint64_t kBlockSize = 2 * 1024 * 1024;
+
+class PageTableTest : public ::testing::Test {
+ protected:
+  FakeAllocator allocator_;
+  uint64_t *root_ = static_cast<uint64_t *>(allocator_.Allocate());
+  PageTable<FakeAllocator> page_table_{root_, allocator_};
+};
+
+TEST_F(PageTableTest, MapTranslate) {
+  ASSERT_TRUE(page_table_.Map(0x400000, 0x10000000, 3 * kPageSize, kFlags));
+  EXPECT_EQ(page_table_.Translate(0x400000), 0x10000000);
+  EXPECT_EQ(page_table_.Translate(0x401234), 0x10001234);
+  EXPECT_EQ(page_table_.Translate(0x402FFF), 0x10002FFF);
+  EXPECT_FALSE(page_table_.Translate(0x403000).has_value());
+  EXPECT_FALSE(page_table_.Translate(0x3FF000).has_value());
+  // 根页表 + 三级中间页表
+  EXPECT_EQ(allocator_.Count(), kPageTableLevels);
+}
+
+TEST_F(PageTableTest, MapRoundsToPages) {
+  // 未对齐的起始地址与大小覆盖两页
+  ASSERT_TRUE(page_table_.Map(0x400800, 0x10000800, kPageSize, kFlags));
+  EXPECT_EQ(page_table_.Translate(0x400000), 0x10000000);
+  EXPECT_EQ(page_table_.Translate(0x401FFF), 0x10001FFF);
+  EXPECT_FALSE(page_table_.Translate(0x402000).has_value());
+}
+
+TEST_F(PageTableTest, MapZeroSize) {
+  EXPECT_TRUE(page_table_.Map(0, 0, 0, kFlags));
+  EXPECT_EQ(page_table_.Unmap(0, 0), 0);
+  EXPECT_EQ(page_table_.Protect(0, 0, kFlags), 0);
+  EXPECT_EQ(allocator_.Count(), 1);
+}
+
+TEST_F(PageTableTest, Unmap) {
+  ASSERT_TRUE(page_table_.Map(0x400000, 0x10000000, 4 * kPageSize, kFlags));
+  EXPECT_EQ(page_table_.Unmap(0x401000, 2 * kPageSize), 2);
+  EXPECT_TRUE(page_table_.Translate(0x400000).has_value());
+  EXPECT_FALSE(page_table_.Translate(0x401000).has_value());
+  EXPECT_FALSE(page_table_.Translate(0x402000).has_value());
+  EXPECT_TRUE(page_table_.Translate(0x403000).has_value());
+  // 未映射的页不计入
+  EXPECT_EQ(page_table_.Unmap(0x400000, 4 * kPageSize), 2);
+}
+
+TEST_F(PageTableTest, Protect) {
+  ASSERT_TRUE(page_table_.Map(0x400000, 0x10000000, 2 * kPageSize, kFlags));
+  EXPECT_EQ(page_table_.Protect(0x400000, 4 * kPageSize, kReadOnlyFlags), 2);
+  auto *entry = page_table_.FindEntry(0x401000);
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(*entry & cpu_io::virtual_memory::kWrite, 0);
+  EXPECT_EQ(page_table_.Translate(0x401000), 0x10001000);
+}
+
+TEST_F(PageTableTest, MapBlock) {
+  ASSERT_TRUE(
+      page_table_.Map(kBlockSize, 4 * kBlockSize, 2 * kBlockSize, kFlags));
+  size_t level = 0;
+  ASSERT_NE(page_table_.FindEntry(kBlockSize + 0x1000, &level), nullptr);
+  EXPECT_EQ(level, 1);
+  EXPECT_EQ(page_table_.Translate(2 * kBlockSize + 0x12345),
+            5 * kBlockSize + 0x12345);
+  // 根页表 + 两级中间页表，不需要 4KB 页表
+  EXPECT_EQ(allocator_.Count(), kPageTableLevels - 1);
+}
+
+TEST_F(PageTableTest, MapBlockNeedsPhysicalAlignment) {
+  ASSERT_TRUE(
+      page_table_.Map(kBlockSize, kBlockSize + kPageSize, kBlockSize, kFlags));
+  size_t level = 1;
+  ASSERT_NE(page_table_.FindEntry(kBlockSize, &level), nullptr);
+  EXPECT_EQ(level, 0);
+}
+
+TEST_F(PageTableTest, MaxBlockLevel) {
+  page_table_.SetMaxBlockLevel(0);
+  ASSERT_TRUE(page_table_.Map(kBlockSize, kBlockSize, kBlockSize, kFlags));
+  size_t level = 1;
+  ASSERT_NE(page_table_.FindEntry(kBlockSize, &level), nullptr);
+  EXPECT_EQ(level, 0);
+}
+
+TEST_F(PageTableTest, ProtectSplitsBlock) {
+  ASSERT_TRUE(page_table_.Map(kBlockSize, 4 * kBlockSize, kBlockSize, kFlags));
+  auto tables = allocator_.Count();
+  EXPECT_EQ(page_table_.Protect(kBlockSize + 5 * kPageSize, kPageSize,
+                                kReadOnlyFlags),
+            1);
+  EXPECT_EQ(allocator_.Count(), tables + 1);
+
+  size_t level = 1;
+  auto *entry = page_table_.FindEntry(kBlockSize + 5 * kPageSize, &level);
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(level, 0);
+  EXPECT_EQ(*entry & cpu_io::virtual_memory::kWrite, 0);
+
+  // 拆分后其余页的映射与标志不变
+  entry = page_table_.FindEntry(kBlockSize + 4 * kPageSize, &level);
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(level, 0);
+  EXPECT_NE(*entry & cpu_io::virtual_memory::kWrite, 0);
+  for (uint64_t offset = 0; offset < kBlockSize; offset += kPageSize) {
+    EXPECT_EQ(page_table_.Translate(kBlockSize + offset),
+              4 * kBlockSize + offset);
+  }
+}
+
+TEST_F(PageTableTest, UnmapSplitsBlock) {
+  ASSERT_TRUE(page_table_.Map(kBlockSize, 4 * kBlockSize, kBlockSize, kFlags));
+  EXPECT_EQ(page_table_.Unmap(kBlockSize + kBlockSize - kPageSize, kPageSize),
+            1);
+  EXPECT_FALSE(
+      page_table_.Translate(kBlockSize + kBlockSize - kPageSize).has_value());
+  EXPECT_EQ(page_table_.Translate(kBlockSize), 4 * kBlockSize);
+  // 完整覆盖的大页只清除一项
+  ASSERT_TRUE(
+      page_table_.Map(4 * kBlockSize, 4 * kBlockSize, kBlockSize, kFlags));
+  EXPECT_EQ(page_table_.Unmap(4 * kBlockSize, kBlockSize), 1);
+}
+
+TEST_F(PageTableTest, SplitFailureKeepsBlock) {
+  ASSERT_TRUE(page_table_.Map(kBlockSize, 4 * kBlockSize, kBlockSize, kFlags));
+  allocator_.SetLimit(allocator_.Count());
+  EXPECT_EQ(page_table_.Unmap(kBlockSize, kPageSize), 0);
+  size_t level = 0;
+  ASSERT_NE(page_table_.FindEntry(kBlockSize, &level), nullptr);
+  EXPECT_EQ(level, 1);
+}
+
+TEST_F(PageTableTest, MapAllocationFailure) {
+  allocator_.SetLimit(2);
+  EXPECT_FALSE(page_table_.Map(0x400000, 0x10000000, kPageSize, kFlags));
+  EXPECT_FALSE(page_table_.Translate(0x400000).has_value());
+}
+
+TEST_F(PageTableTest, RangeAcrossTables) {
+  // 跨越两张 4KB 页表与两张 2MB 页表的边界
+  auto start = GetLevelPageSize(2) - 2 * kPageSize;
+  ASSERT_TRUE(page_table_.Map(start, 0x10000000, 4 * kPageSize, kFlags));
+  for (uint64_t i = 0; i < 4; i++) {
+    EXPECT_EQ(page_table_.Translate(start + i * kPageSize),
+              0x10000000 + i * kPageSize);
+  }
+  EXPECT_EQ(page_table_.Unmap(start, 4 * kPageSize), 4);
+}
+
+TEST_F(PageTableTest, RangeEndsAtTopOfAddressSpace) {
+  // 结束地址 virtual_addr + size 回绕为 0
+  constexpr uint64_t kTop = ~0ULL - 2 * kPageSize + 1;
+  ASSERT_TRUE(page_table_.Map(kTop, 0x10000000, 2 * kPageSize, kFlags));
+  EXPECT_EQ(page_table_.Translate(kTop), 0x10000000);
+  EXPECT_EQ(page_table_.Translate(~0ULL), 0x10001FFF);
+  EXPECT_EQ(page_table_.Protect(kTop, 2 * kPageSize, kReadOnlyFlags), 2);
+  EXPECT_EQ(page_table_.Unmap(kTop, 2 * kPageSize), 2);
+  EXPECT_FALSE(page_table_.Translate(kTop).has_value());
+}
+
+TEST_F(PageTableTest, TopBlockEndsAtTopOfAddressSpace) {
+  constexpr uint64_t kTop = ~0ULL - kBlockSize + 1;
+  ASSERT_TRUE(page_table_.Map(kTop, 4 * kBlockSize, kBlockSize, kFlags));
+  size_t level = 0;
+  ASSERT_NE(page_table_.FindEntry(~0ULL, &level), nullptr);
+  EXPECT_EQ(level, 1);
+  EXPECT_EQ(page_table_.Unmap(kTop, kBlockSize), 1);
+}
+
+}  // namespace
@@ -0,0 +1,144 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "cpu_io.h"
+
+namespace {
+
+using cpu_io::detail::BitField;
+using cpu_io::detail::read_write::CachedReg;
+using cpu_io::detail::read_write::FieldValue;
+using cpu_io::detail::read_write::ReadWriteField;
+using cpu_io::detail::read_write::ReadWriteRegBase;
+
+/// 以内存变量代替硬件的寄存器描述，记录访问次数
+struct FakeRegInfo : public cpu_io::detail::register_info::RegInfoBase {
+  static inline uint64_t value = 0;
+  static inline int reads = 0;
+  static inline int writes = 0;
+
+  static void Reset(uint64_t initial) {
+    value = initial;
+    reads = 0;
+    writes = 0;
+  }
+
+  static auto Read() -> DataType {
+    reads++;
+    return value;
+  }
+
+  static void Write(DataType new_value) {
+    writes++;
+    value = new_value;
+  }
+
+  static void SetBits(uint64_t offset) { Write(Read() | (1ULL << offset)); }
+
+  static void ClearBits(uint64_t offset) { Write(Read() & ~(1ULL << offset)); }
+
+  struct Low : public BitField<uint8_t, 0, 8> {};
+  struct Mode : public BitField<uint8_t, 8, 3> {};
+  struct Enable : public BitField<bool, 12, 1> {};
+  struct High : public BitField<uint16_t, 48, 16> {};
+};
+
+struct FakeReg : public ReadWriteRegBase<FakeRegInfo> {
+  using Low = ReadWriteField<ReadWriteRegBase<FakeRegInfo>, FakeRegInfo::Low>;
+  using Mode =
+      ReadWriteField<ReadWriteRegBase<FakeRegInfo>, FakeRegInfo::Mode>;
+  using Enable =
+      ReadWriteField<ReadWriteRegBase<FakeRegInfo>, FakeRegInfo::Enable>;
+  using High =
+      ReadWriteField<ReadWriteRegBase<FakeRegInfo>, FakeRegInfo::High>;
+};
+
+TEST(FieldValueTest, Value) {
+  constexpr auto kMode = FakeReg::Mode::Value(5);
+  EXPECT_EQ(kMode.mask, 0x700);
+  EXPECT_EQ(kMode.value, 0x500);
+  // 超出位宽的部分被丢弃
+  constexpr auto kOverflow = FakeReg::Mode::Value(0xFF);
+  EXPECT_EQ(kOverflow.value, 0x700);
+}
+
+TEST(FieldValueTest, Merge) {
+  constexpr auto kMerged = FakeReg::Low::Value(0x12) |
+                           FakeReg::Enable::Value(true) |
+                           FakeReg::High::Value(0xBEEF);
+  EXPECT_EQ(kMerged.mask, 0xFFFF0000000010FFULL);
+  EXPECT_EQ(kMerged.value, 0xBEEF000000001012ULL);
+}
+
+TEST(ReadWriteRegBaseTest, ModifyRuntime) {
+  FakeRegInfo::Reset(0xFFFFFFFFFFFFFFFFULL);
+  FakeReg::Modify(FakeReg::Low::Value(0x34), FakeReg::Enable::Value(false),
+                  FakeReg::Mode::Value(2));
+  EXPECT_EQ(FakeRegInfo::value, 0xFFFFFFFFFFFFEA34ULL);
+  EXPECT_EQ(FakeRegInfo::reads, 1);
+  EXPECT_EQ(FakeRegInfo::writes, 1);
+}
+
+TEST(ReadWriteRegBaseTest, ModifyConstant) {
+  FakeRegInfo::Reset(0x0000000000FF0000ULL);
+  FakeReg::Modify<FakeReg::Mode::Value(7), FakeReg::High::Value(0x1234)>();
+  EXPECT_EQ(FakeRegInfo::value, 0x1234000000FF0700ULL);
+  EXPECT_EQ(FakeRegInfo::reads, 1);
+  EXPECT_EQ(FakeRegInfo::writes, 1);
+}
+
+TEST(ReadWriteRegBaseTest, WriteFields) {
+  FakeRegInfo::Reset(0xFFFFFFFFFFFFFFFFULL);
+  FakeReg::WriteFields(FakeReg::Low::Value(0x56), FakeReg::Enable::Value(true));
+  // 不读寄存器，未指定的位写 0
+  EXPECT_EQ(FakeRegInfo::value, 0x1056);
+  EXPECT_EQ(FakeRegInfo::reads, 0);
+  EXPECT_EQ(FakeRegInfo::writes, 1);
+}
+
+TEST(ReadWriteFieldTest, GetWrite) {
+  FakeRegInfo::Reset(0xABCD000000001234ULL);
+  EXPECT_EQ(FakeReg::Low::Get(), 0x34);
+  EXPECT_EQ(FakeReg::Mode::Get(), 0x2);
+  EXPECT_TRUE(FakeReg::Enable::Get());
+  EXPECT_EQ(FakeReg::High::Get(), 0xABCD);
+
+  FakeReg::Mode::Write(5);
+  EXPECT_EQ(FakeRegInfo::value, 0xABCD000000001534ULL);
+  EXPECT_EQ(FakeReg::High::ReadWrite(0x1111), 0xABCD);
+  EXPECT_EQ(FakeRegInfo::value, 0x1111000000001534ULL);
+}
+
+TEST(ReadWriteFieldTest, SetClear) {
+  FakeRegInfo::Reset(0);
+  FakeReg::Enable::Set();
+  EXPECT_EQ(FakeRegInfo::value, 0x1000);
+  FakeReg::Enable::Clear();
+  EXPECT_EQ(FakeRegInfo::value, 0);
+}
+
+TEST(CachedRegTest, ModifyUsesShadow) {
+  FakeRegInfo::Reset(0xF0);
+  CachedReg<FakeReg> cached;
+  cached.Modify(FakeReg::Low::Value(0x0F), FakeReg::Enable::Value(true));
+  EXPECT_EQ(FakeRegInfo::value, 0x100F);
+  cached.Modify(FakeReg::Mode::Value(1));
+  EXPECT_EQ(FakeRegInfo::value, 0x110F);
+  // 第一次修改读一次硬件，之后只写
+  EXPECT_EQ(FakeRegInfo::reads, 1);
+  EXPECT_EQ(FakeRegInfo::writes, 2);
+  EXPECT_EQ(cached.Get<FakeReg::Mode>(), 1);
+  EXPECT_EQ(FakeRegInfo::reads, 1);
+
+  FakeRegInfo::value = 0;
+  cached.Invalidate();
+  EXPECT_EQ(cached.Read(), 0);
+  EXPECT_EQ(FakeRegInfo::reads, 2);
+}
+
+}  // namespace
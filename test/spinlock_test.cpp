@@ -0,0 +1,67 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#include "spinlock.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using cpu_io::TicketLock;
+
+TEST(TicketLockTest, TryLock) {
+  TicketLock lock;
+  EXPECT_FALSE(lock.IsLocked());
+  ASSERT_TRUE(lock.TryLock());
+  EXPECT_TRUE(lock.IsLocked());
+  EXPECT_FALSE(lock.TryLock());
+  lock.Unlock();
+  EXPECT_FALSE(lock.IsLocked());
+}
+
+TEST(TicketLockTest, TryLockAfterUnlock) {
+  TicketLock lock;
+  for (int i = 0; i < 3; i++) {
+    lock.Lock();
+    EXPECT_FALSE(lock.TryLock());
+    lock.Unlock();
+    ASSERT_TRUE(lock.TryLock());
+    lock.Unlock();
+  }
+  EXPECT_FALSE(lock.IsLocked());
+}
+
+/// 各线程只用 TryLock() 获得锁并修改非原子计数，
+/// TryLock() 成功后须看到上一个持有者在 Unlock() 前的写
+TEST(TicketLockTest, TryLockSeesPreviousHolder) {
+  constexpr int kThreads = 4;
+  constexpr uint64_t kIterations = 20000;
+  TicketLock lock;
+  uint64_t counter = 0;
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; i++) {
+    threads.emplace_back([&] {
+      for (uint64_t n = 0; n < kIterations; n++) {
+        while (!lock.TryLock()) {
+          std::this_thread::yield();
+        }
+        counter++;
+        lock.Unlock();
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(counter, kThreads * kIterations);
+  EXPECT_FALSE(lock.IsLocked());
+}
+
+}  // namespace
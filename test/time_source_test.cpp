@@ -0,0 +1,85 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#include "time_source.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using cpu_io::TimeSource;
+
+constexpr uint64_t kFrequency = 1000000000;
+
+TEST(TimeSourceTest, Tick) {
+  TimeSource time_source(kFrequency);
+  EXPECT_EQ(time_source.GetJiffies(), 0);
+  time_source.Tick();
+  time_source.Tick(3);
+  EXPECT_EQ(time_source.GetJiffies(), 4);
+  auto coarse = time_source.GetCoarseNs();
+  EXPECT_LE(coarse, time_source.GetNs());
+  EXPECT_EQ(time_source.GetCoarseNs(), coarse);
+}
+
+TEST(TimeSourceTest, SetFrequencyKeepsTimeContinuous) {
+  TimeSource time_source(kFrequency);
+  auto before = time_source.GetNs();
+  time_source.SetFrequency(kFrequency / 2);
+  EXPECT_GE(time_source.GetNs(), before);
+  time_source.SetFrequency(kFrequency * 2);
+  EXPECT_GE(time_source.GetNs(), before);
+}
+
+/// 一个写者不断发布新快照，多个读者检查时间单调不减。
+/// 频率取 1GHz 使换算没有舍入，读到不一致的快照才会使时间回退
+TEST(TimeSourceTest, ReadersRaceWriter) {
+  constexpr int kReaders = 4;
+  constexpr uint64_t kTicks = 1000000;
+  TimeSource time_source(kFrequency);
+  std::atomic<bool> stop{false};
+  std::atomic<int> errors{0};
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < kReaders; i++) {
+    readers.emplace_back([&] {
+      uint64_t last_ns = 0;
+      uint64_t last_coarse = 0;
+      uint64_t last_jiffies = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        auto jiffies = time_source.GetJiffies();
+        auto coarse = time_source.GetCoarseNs();
+        auto ns = time_source.GetNs();
+        if (jiffies < last_jiffies || coarse < last_coarse || ns < last_ns ||
+            ns < coarse) {
+          errors.fetch_add(1, std::memory_order_relaxed);
+        }
+        last_jiffies = jiffies;
+        last_coarse = coarse;
+        last_ns = ns;
+      }
+    });
+  }
+
+  for (uint64_t i = 0; i < kTicks; i++) {
+    time_source.Tick();
+    if (i % 64 == 0) {
+      time_source.SetFrequency(kFrequency);
+    }
+  }
+  stop.store(true, std::memory_order_relaxed);
+  for (auto &reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_EQ(errors.load(), 0);
+  EXPECT_EQ(time_source.GetJiffies(), kTicks);
+}
+
+}  // namespace
@@ -0,0 +1,101 @@
+/**
+ * @copyright Copyright The cpu_io Contributors
+ */
+
+#include "tlb_batch.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using cpu_io::virtual_memory::BasicTlbBatch;
+using cpu_io::virtual_memory::kPageSize;
+using cpu_io::virtual_memory::TlbRange;
+
+/// 记录 BasicTlbBatch 发出的失效操作
+struct FakeFlushPolicy {
+  static inline std::vector<TlbRange> ranges;
+  static inline int flush_all_count = 0;
+  static inline uint64_t last_asid = 0;
+
+  static void Reset() {
+    ranges.clear();
+    flush_all_count = 0;
+    last_asid = 0;
+  }
+
+  static auto ShouldFlushAll(size_t pages, size_t threshold,
+                             uint64_t /*asid*/) -> bool {
+    return pages > threshold;
+  }
+
+  static void FlushAll(uint64_t asid) {
+    flush_all_count++;
+    last_asid = asid;
+  }
+
+  template <class Ranges>
+  static void FlushRanges(const Ranges &flush_ranges, uint64_t asid) {
+    for (const auto &range : flush_ranges) {
+      ranges.push_back(range);
+    }
+    last_asid = asid;
+  }
+};
+
+using TestBatch = BasicTlbBatch<FakeFlushPolicy, 4>;
+
+class TlbBatchTest : public ::testing::Test {
+ protected:
+  void SetUp() override { FakeFlushPolicy::Reset(); }
+};
+
+TEST_F(TlbBatchTest, MergesAdjacentRanges) {
+  TestBatch batch(7);
+  batch.Add(0x400000);
+  batch.Add(0x401000);
+  batch.AddRange(0x402800, 0x403001);
+  EXPECT_EQ(batch.GetPendingPages(), 4);
+  batch.Commit();
+
+  ASSERT_EQ(FakeFlushPolicy::ranges.size(), 1);
+  EXPECT_EQ(FakeFlushPolicy::ranges[0].start, 0x400000);
+  EXPECT_EQ(FakeFlushPolicy::ranges[0].end, 0x404000);
+  EXPECT_EQ(FakeFlushPolicy::last_asid, 7);
+  EXPECT_EQ(FakeFlushPolicy::flush_all_count, 0);
+  EXPECT_EQ(batch.GetPendingPages(), 0);
+}
+
+TEST_F(TlbBatchTest, OverflowFlushesAll) {
+  TestBatch batch;
+  for (uint64_t i = 0; i < 5; i++) {
+    batch.Add(0x400000 + 2 * i * kPageSize);
+  }
+  batch.Commit();
+  EXPECT_TRUE(FakeFlushPolicy::ranges.empty());
+  EXPECT_EQ(FakeFlushPolicy::flush_all_count, 1);
+}
+
+TEST_F(TlbBatchTest, ThresholdFlushesAll) {
+  TestBatch batch(0, 2);
+  batch.AddRange(0x400000, 0x400000 + 3 * kPageSize);
+  batch.Commit();
+  EXPECT_TRUE(FakeFlushPolicy::ranges.empty());
+  EXPECT_EQ(FakeFlushPolicy::flush_all_count, 1);
+}
+
+TEST_F(TlbBatchTest, DestructorCommits) {
+  {
+    TestBatch batch;
+    batch.AddRange(0x400000, 0x400000);
+    batch.Commit();
+    EXPECT_TRUE(FakeFlushPolicy::ranges.empty());
+    batch.Add(0x400000);
+  }
+  EXPECT_EQ(FakeFlushPolicy::ranges.size(), 1);
+}
+
+}  // namespace